@@ -994,6 +994,19 @@ void memtuple_deform(MemTuple mtup, MemTupleBinding *pbind, Datum *datum, bool *
 	memtuple_get_values(mtup, pbind, datum, isnull, true /* aligned */);
 }
 
+/*
+ * Deform only the first natts attributes of a memtuple, as slot_getsomeattrs
+ * does for a slot.
+ */
+void memtuple_getsomeattrs(MemTuple mtup, MemTupleBinding *pbind, int natts, Datum *datum, bool *isnull)
+{
+	int i;
+
+	Assert(natts <= pbind->tupdesc->natts);
+	for(i=0; i<natts; ++i)
+		datum[i] = memtuple_getattr_by_alignment(mtup, pbind, i+1, &isnull[i], true /* aligned */);
+}
+
 /*
  * Get the Oid assigned to this tuple (when WITH OIDS is used).
  *
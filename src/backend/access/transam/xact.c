@@ -31,9 +31,11 @@
 #include "access/xlogutils.h"
 #include "access/fileam.h"
 #include "catalog/namespace.h"
+#include "codegen/codegen_wrapper.h"
 #include "commands/async.h"
 #include "commands/tablecmds.h"
 #include "commands/trigger.h"
+#include "executor/instrument.h"
 #include "executor/spi.h"
 #include "libpq/be-fsstubs.h"
 #include "miscadmin.h"
@@ -3566,6 +3568,7 @@ CommitTransaction(void)
 	AtEOXact_Files();
 	AtEOXact_ComboCid();
 	AtEOXact_HashTables(true);
+	AtEOXact_InstrProfile();
 	AtEOXact_PgStat(true);
 	pgstat_report_xact_timestamp(0);
 
@@ -3851,6 +3854,7 @@ PrepareTransaction(void)
 	AtEOXact_Files();
 	AtEOXact_ComboCid();
 	AtEOXact_HashTables(true);
+	AtEOXact_InstrProfile();
 	/* don't call AtEOXact_PgStat here */
 
 	CurrentResourceOwner = NULL;
@@ -4076,6 +4080,8 @@ AbortTransaction(void)
 		AtEOXact_Files();
 		AtEOXact_ComboCid();
 		AtEOXact_HashTables(false);
+		AtEOXact_InstrProfile();
+		CodeGeneratorManagerAbortAsyncCompile(1);
 		AtEOXact_PgStat(false);
 		pgstat_report_xact_timestamp(0);
 	}
@@ -6264,6 +6270,7 @@ AbortSubTransaction(void)
 		AtEOSubXact_Files(false, s->subTransactionId,
 						  s->parent->subTransactionId);
 		AtEOSubXact_HashTables(false, s->nestingLevel);
+		CodeGeneratorManagerAbortAsyncCompile(s->nestingLevel);
 		AtEOSubXact_PgStat(false, s->nestingLevel);
 	}
 
@@ -54,6 +54,7 @@
 #include "catalog/gp_persistent.h"
 #include "catalog/gp_global_sequence.h"
 #include "catalog/gp_id.h"
+#include "catalog/gp_optimizer_cost_params.h"
 #include "catalog/gp_version.h"
 #include "catalog/toasting.h"
 #include "catalog/gp_policy.h"
@@ -656,7 +657,8 @@ IsSharedRelation(Oid relationId)
 		relationId == GpSegmentConfigRelationId ||
 		relationId == FileSpaceEntryRelationId ||
 
-		relationId == AuthTimeConstraintRelationId)
+		relationId == AuthTimeConstraintRelationId ||
+		relationId == GpOptimizerCostParamsRelationId)
 		return true;
 
 	/* These are their indexes (see indexing.h) */
@@ -2183,6 +2183,204 @@ ORDER BY segid;
 
 GRANT SELECT ON gp_toolkit.gp_workfile_mgr_used_diskspace TO public;
 
+--------------------------------------------------------------------------------
+-- Plan node profile views
+--------------------------------------------------------------------------------
+
+--------------------------------------------------------------------------------
+-- @function:
+--        gp_toolkit.__gp_plan_node_profile_f
+--
+-- @in:
+--
+-- @out:
+--        int - segment id,
+--        int - pid of the backend running the node,
+--        int - sessionid,
+--        int - command_cnt,
+--        int - containing slice,
+--        int - plan node id,
+--        text - type of the node,
+--        bigint - number of calls of the node,
+--        bigint - number of calls that were timed,
+--        float8 - time in the node in seconds, extrapolated from the samples,
+--        bigint - bytes written to workfiles,
+--        bigint - hash table entries compared in vain,
+--        float8 - time waiting on the interconnect in seconds,
+--        float8 - time decompressing append-only blocks in seconds
+--
+-- @doc:
+--        UDF to retrieve the always-on profile of the plan nodes of the
+--        queries currently running on one segment
+--
+--------------------------------------------------------------------------------
+
+CREATE FUNCTION gp_toolkit.__gp_plan_node_profile_f()
+RETURNS SETOF record
+AS '$libdir/gp_instr_profile', 'gp_instr_profile_nodes'
+LANGUAGE C IMMUTABLE;
+
+GRANT EXECUTE ON FUNCTION gp_toolkit.__gp_plan_node_profile_f() TO public;
+
+--------------------------------------------------------------------------------
+-- @view:
+--        gp_toolkit.gp_plan_node_profile
+--
+-- @doc:
+--        Profile of the plan nodes of the currently running queries, one row
+--        per node for each segment and slice
+--
+--------------------------------------------------------------------------------
+
+CREATE VIEW gp_toolkit.gp_plan_node_profile AS
+WITH all_entries AS (
+   SELECT C.*
+          FROM gp_toolkit.__gp_localid, gp_toolkit.__gp_plan_node_profile_f() AS C (
+            segid int,
+            pid int,
+            sessionid int,
+            commandid int,
+            slice int,
+            plan_node_id int,
+            node_type text,
+            calls bigint,
+            samples bigint,
+            est_time float8,
+            spill_bytes bigint,
+            hash_collisions bigint,
+            motion_stall_time float8,
+            decompress_time float8
+          )
+    UNION ALL
+    SELECT C.*
+          FROM gp_toolkit.__gp_masterid, gp_toolkit.__gp_plan_node_profile_f() AS C (
+            segid int,
+            pid int,
+            sessionid int,
+            commandid int,
+            slice int,
+            plan_node_id int,
+            node_type text,
+            calls bigint,
+            samples bigint,
+            est_time float8,
+            spill_bytes bigint,
+            hash_collisions bigint,
+            motion_stall_time float8,
+            decompress_time float8
+          ))
+SELECT S.datname,
+       C.sessionid as sess_id,
+       C.commandid as command_cnt,
+       S.usename,
+       S.current_query,
+       C.segid,
+       C.slice,
+       C.pid,
+       C.plan_node_id,
+       C.node_type,
+       C.calls,
+       C.samples,
+       C.est_time,
+       C.spill_bytes,
+       C.hash_collisions,
+       C.motion_stall_time,
+       C.decompress_time
+FROM all_entries C LEFT OUTER JOIN
+pg_stat_activity as S
+ON C.sessionid = S.sess_id;
+
+GRANT SELECT ON gp_toolkit.gp_plan_node_profile TO public;
+
+--------------------------------------------------------------------------------
+-- @function:
+--        gp_toolkit.__gp_slice_waits_f
+--
+-- @in:
+--
+-- @out:
+--        int - segment id,
+--        int - pid of the backend running the slice,
+--        int - sessionid,
+--        int - command_cnt,
+--        int - slice,
+--        float8 - time receiving from the interconnect in seconds,
+--        float8 - time waiting for interconnect send buffers in seconds,
+--        float8 - time reading append-only files in seconds,
+--        float8 - time writing workfiles in seconds,
+--        float8 - time waiting for locks in seconds
+--
+-- @doc:
+--        UDF to retrieve the time the queries currently running on one
+--        segment waited, by class of wait
+--
+--------------------------------------------------------------------------------
+
+CREATE FUNCTION gp_toolkit.__gp_slice_waits_f()
+RETURNS SETOF record
+AS '$libdir/gp_instr_profile', 'gp_instr_profile_waits'
+LANGUAGE C IMMUTABLE;
+
+GRANT EXECUTE ON FUNCTION gp_toolkit.__gp_slice_waits_f() TO public;
+
+--------------------------------------------------------------------------------
+-- @view:
+--        gp_toolkit.gp_slice_waits
+--
+-- @doc:
+--        Time the currently running queries waited on the interconnect, I/O
+--        and locks, one row per segment and slice
+--
+--------------------------------------------------------------------------------
+
+CREATE VIEW gp_toolkit.gp_slice_waits AS
+WITH all_entries AS (
+   SELECT C.*
+          FROM gp_toolkit.__gp_localid, gp_toolkit.__gp_slice_waits_f() AS C (
+            segid int,
+            pid int,
+            sessionid int,
+            commandid int,
+            slice int,
+            motion_recv_time float8,
+            motion_send_time float8,
+            read_io_time float8,
+            workfile_write_time float8,
+            lock_time float8
+          )
+    UNION ALL
+    SELECT C.*
+          FROM gp_toolkit.__gp_masterid, gp_toolkit.__gp_slice_waits_f() AS C (
+            segid int,
+            pid int,
+            sessionid int,
+            commandid int,
+            slice int,
+            motion_recv_time float8,
+            motion_send_time float8,
+            read_io_time float8,
+            workfile_write_time float8,
+            lock_time float8
+          ))
+SELECT S.datname,
+       C.sessionid as sess_id,
+       C.commandid as command_cnt,
+       S.usename,
+       S.current_query,
+       C.segid,
+       C.slice,
+       C.pid,
+       C.motion_recv_time,
+       C.motion_send_time,
+       C.read_io_time,
+       C.workfile_write_time,
+       C.lock_time
+FROM all_entries C LEFT OUTER JOIN
+pg_stat_activity as S
+ON C.sessionid = S.sess_id;
+
+GRANT SELECT ON gp_toolkit.gp_slice_waits TO public;
+
 --------------------------------------------------------------------------------
 -- @function:
 --        gp_toolkit.gp_dump_query_oids(text)
@@ -21,6 +21,7 @@
 #include "cdb/cdbappendonlystoragelayer.h"
 #include "cdb/cdbappendonlystorageformat.h"
 #include "cdb/cdbappendonlystorageread.h"
+#include "executor/instrument.h"
 #include "utils/guc.h"
 
 
@@ -1388,6 +1389,7 @@ AppendOnlyStorageRead_Content(AppendOnlyStorageRead *storageRead,
 			 */
 			PGFunction	decompressor;
 			PGFunction *cfns = storageRead->compression_functions;
+			uint64		startCycles = 0;
 
 			/*
 			 * How can it be valid that decompressor is NULL,
@@ -1398,6 +1400,9 @@ AppendOnlyStorageRead_Content(AppendOnlyStorageRead *storageRead,
 			else
 				decompressor = cfns[COMPRESSION_DECOMPRESS];
 
+			if (CurrentInstrProfile)
+				startCycles = INSTR_CYCLES_GET_CURRENT();
+
 			gp_decompress_new(content,	/* Compressed data in block. */
 							  storageRead->current.compressedLen,
 							  contentOut,
@@ -1406,6 +1411,9 @@ AppendOnlyStorageRead_Content(AppendOnlyStorageRead *storageRead,
 							  storageRead->compressionState,
 							  storageRead->bufferCount);
 
+			if (CurrentInstrProfile)
+				CurrentInstrProfile->decompressCycles += INSTR_CYCLES_GET_CURRENT() - startCycles;
+
 			if (Debug_appendonly_print_scan)
 				elog(LOG,
 				"Append-only Storage Read decompressed block for table '%s' "
@@ -12,6 +12,7 @@
 #include "cdb/cdbbufferedread.h"
 #include <unistd.h>				/* for read() */
 #include "utils/guc.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 
 static void BufferedReadIo(
@@ -188,11 +189,14 @@ static void BufferedReadIo(
 	offset = 0;
 	while (largeReadLen > 0) 
 	{
+		uint64 waitStart = InstrWaitStart();
 		int actualLen = FileRead(
 							bufferedRead->file,
 							(char*)largeReadMemory,
 							largeReadLen);
 
+		InstrWaitEnd(INSTR_WAIT_READ_IO, waitStart);
+
 		if (actualLen == 0) 
 			ereport(ERROR, (errcode_for_file_access(),
 							errmsg("read beyond eof in table \"%s\" in file \"%s\","
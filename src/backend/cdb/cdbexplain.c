@@ -13,6 +13,7 @@
 #include "cdb/cdbconn.h"                /* SegmentDatabaseDescriptor */
 #include "cdb/cdbdispatchresult.h"      /* CdbDispatchResults */
 #include "cdb/cdbexplain.h"             /* me */
+#include "cdb/cdbmotion.h"              /* getMotionNodeTupleBytesRecvd() */
 #include "cdb/cdbpartition.h"
 #include "cdb/cdbvars.h"                /* Gp_segment */
 #include "executor/execUtils.h"
@@ -47,6 +48,14 @@ typedef struct CdbExplain_StatInst
 	instr_time	firststart;		/* Start time of first iteration of node */
 	double		peakMemBalance; /* Max mem account balance */
 	int		numPartScanned; /* Number of part tables scanned */
+    /* Always-on profile (see InstrProfile), converted to seconds by qExec */
+    double      profileSamples; /* # of timed calls of the node */
+    double      profileTime;    /* time in node, extrapolated from samples */
+    double      spillBytes;     /* bytes written to workfiles */
+    double      hashCollisions; /* hash table entries compared in vain */
+    double      motionStall;    /* time waiting on the interconnect */
+    double      decompressTime; /* time decompressing AO blocks */
+    double      motionBytes;    /* tuple bytes received by a Motion */
     int         bnotes;         /* Offset to beginning of node's extra text */
     int         enotes;         /* Offset to end of node's extra text */
 } CdbExplain_StatInst;
@@ -58,6 +67,7 @@ typedef struct CdbExplain_SliceWorker
     double      peakmemused;    /* bytes alloc in per-query mem context tree */
     double		vmem_reserved;	/* vmem reserved by a QE */
     double		memory_accounting_global_peak;	/* peak memory observed during memory accounting */
+    double      waitTime[INSTR_NUM_WAIT_CLASSES];   /* seconds, by InstrWaitClass */
 } CdbExplain_SliceWorker;
 
 
@@ -111,6 +121,15 @@ typedef struct CdbExplain_NodeSummary
     CdbExplain_Agg  peakMemBalance;
     /* Used for DynamicTableScan, DynamicIndexScan and DynamicBitmapTableScan */
     CdbExplain_Agg  totalPartTableScanned;
+    /* Always-on profile */
+    CdbExplain_Agg  profileSamples;
+    CdbExplain_Agg  profileTime;
+    CdbExplain_Agg  spillBytes;
+    CdbExplain_Agg  hashCollisions;
+    CdbExplain_Agg  motionStall;
+    CdbExplain_Agg  decompressTime;
+    /* Receiving Motion */
+    CdbExplain_Agg  motionBytes;
 
     /* insts array info */
     int             segindex0;      /* segment id of insts[0] */
@@ -144,6 +163,8 @@ typedef struct CdbExplain_SliceSummary
 
     CdbExplain_Agg	memory_accounting_global_peak; /* Peak memory accounting balance by QEs */
 
+    CdbExplain_Agg  waitTime[INSTR_NUM_WAIT_CLASSES];  /* Wait times of QEs, by InstrWaitClass */
+
     /* Rollup of per-node stats over all of the slice's workers and nodes */
     double          workmemused_max;
     double          workmemwanted_max;
@@ -660,6 +681,7 @@ cdbexplain_collectSliceStats(PlanState                 *planstate,
                              CdbExplain_SliceWorker    *out_worker)
 {
     EState     *estate = planstate->state;
+    int         i;
 
     /* Max bytes malloc'ed under executor's per-query memory context. */
     out_worker->peakmemused =
@@ -669,6 +691,9 @@ cdbexplain_collectSliceStats(PlanState                 *planstate,
 
     out_worker->memory_accounting_global_peak = (double) MemoryAccounting_GetGlobalPeak();
 
+    /* Time the top-level query of this process waited, by class of wait. */
+    for (i = 0; i < INSTR_NUM_WAIT_CLASSES; i++)
+        out_worker->waitTime[i] = InstrProfileCyclesToSeconds(InstrWaitCycles[i]);
 }                               /* cdbexplain_collectSliceStats */
 
 
@@ -693,6 +718,7 @@ cdbexplain_depositSliceStats(CdbExplain_StatHdr        *hdr,
     CdbExplain_SliceSummary    *ss = &showstatctx->slices[sliceIndex];
     CdbExplain_SliceWorker     *ssw;
     int                         iworker;
+    int                         i;
 
     Insist(sliceIndex >= 0 &&
            sliceIndex < showstatctx->nslice);
@@ -750,6 +776,8 @@ cdbexplain_depositSliceStats(CdbExplain_StatHdr        *hdr,
     cdbexplain_agg_upd(&ss->peakmemused, hdr->worker.peakmemused, hdr->segindex);
     cdbexplain_agg_upd(&ss->vmem_reserved, hdr->worker.vmem_reserved, hdr->segindex);
     cdbexplain_agg_upd(&ss->memory_accounting_global_peak, hdr->worker.memory_accounting_global_peak, hdr->segindex);
+    for (i = 0; i < INSTR_NUM_WAIT_CLASSES; i++)
+        cdbexplain_agg_upd(&ss->waitTime[i], hdr->worker.waitTime[i], hdr->segindex);
 
     /* Rollup of per-node stats over all nodes of the slice into SliceSummary */
     ss->workmemused_max = recvstatctx->workmemused_max;
@@ -811,6 +839,30 @@ cdbexplain_collectStatsFromNode(PlanState *planstate, CdbExplain_SendStatCtx *ct
 	si->peakMemBalance	 = MemoryAccounting_GetAccountPeakBalance(planstate->plan->memoryAccountId);
 	si->firststart      = instr->firststart;
 	si->numPartScanned = instr->numPartScanned;
+
+    /*
+     * Transfer the always-on profile, if the node has one.  The cycles are
+     * converted here, as the rate of the counter may differ between hosts.
+     */
+    if (planstate->profile)
+    {
+        InstrProfile   *profile = planstate->profile;
+
+        si->profileSamples = profile->nsamples;
+        if (profile->nsamples > 0)
+            si->profileTime = InstrProfileCyclesToSeconds(profile->sampleCycles) *
+                              profile->ncalls / profile->nsamples;
+        si->spillBytes      = profile->spillBytes;
+        si->hashCollisions  = profile->hashCollisions;
+        si->motionStall     = InstrProfileCyclesToSeconds(profile->motionStallCycles);
+        si->decompressTime  = InstrProfileCyclesToSeconds(profile->decompressCycles);
+    }
+
+    /* Bytes received by a Motion, to show the skew of a redistribution. */
+    if (IsA(planstate, MotionState) &&
+        ((MotionState *)planstate)->mstype == MOTIONSTATE_RECV)
+        si->motionBytes = getMotionNodeTupleBytesRecvd(planstate->state->motionlayer_context,
+                                                       ((Motion *)planstate->plan)->motionID);
 }                               /* cdbexplain_collectStatsFromNode */
 
 
@@ -935,6 +987,13 @@ cdbexplain_depositStatsToNode(PlanState *planstate, CdbExplain_RecvStatCtx *ctx)
     CdbExplain_DepStatAcc		memory_accounting_global_peak;
     CdbExplain_DepStatAcc       peakMemBalance;
     CdbExplain_DepStatAcc       totalPartTableScanned;
+    CdbExplain_DepStatAcc       profileSamples;
+    CdbExplain_DepStatAcc       profileTime;
+    CdbExplain_DepStatAcc       spillBytes;
+    CdbExplain_DepStatAcc       hashCollisions;
+    CdbExplain_DepStatAcc       motionStall;
+    CdbExplain_DepStatAcc       decompressTime;
+    CdbExplain_DepStatAcc       motionBytes;
     int                         imsgptr;
     int                         nInst;
 
@@ -959,6 +1018,13 @@ cdbexplain_depositStatsToNode(PlanState *planstate, CdbExplain_RecvStatCtx *ctx)
 	cdbexplain_depStatAcc_init0(&totalWorkfileCreated);
     cdbexplain_depStatAcc_init0(&peakMemBalance);
     cdbexplain_depStatAcc_init0(&totalPartTableScanned);
+    cdbexplain_depStatAcc_init0(&profileSamples);
+    cdbexplain_depStatAcc_init0(&profileTime);
+    cdbexplain_depStatAcc_init0(&spillBytes);
+    cdbexplain_depStatAcc_init0(&hashCollisions);
+    cdbexplain_depStatAcc_init0(&motionStall);
+    cdbexplain_depStatAcc_init0(&decompressTime);
+    cdbexplain_depStatAcc_init0(&motionBytes);
 
     /* Initialize per-slice accumulators. */
     cdbexplain_depStatAcc_init0(&peakmemused);
@@ -1005,6 +1071,13 @@ cdbexplain_depositStatsToNode(PlanState *planstate, CdbExplain_RecvStatCtx *ctx)
 		cdbexplain_depStatAcc_upd(&totalWorkfileCreated, (rsi->workfileCreated ? 1 : 0), rsh, rsi, nsi);
         cdbexplain_depStatAcc_upd(&peakMemBalance, rsi->peakMemBalance, rsh, rsi, nsi);
         cdbexplain_depStatAcc_upd(&totalPartTableScanned, rsi->numPartScanned, rsh, rsi, nsi);
+        cdbexplain_depStatAcc_upd(&profileSamples, rsi->profileSamples, rsh, rsi, nsi);
+        cdbexplain_depStatAcc_upd(&profileTime, rsi->profileTime, rsh, rsi, nsi);
+        cdbexplain_depStatAcc_upd(&spillBytes, rsi->spillBytes, rsh, rsi, nsi);
+        cdbexplain_depStatAcc_upd(&hashCollisions, rsi->hashCollisions, rsh, rsi, nsi);
+        cdbexplain_depStatAcc_upd(&motionStall, rsi->motionStall, rsh, rsi, nsi);
+        cdbexplain_depStatAcc_upd(&decompressTime, rsi->decompressTime, rsh, rsi, nsi);
+        cdbexplain_depStatAcc_upd(&motionBytes, rsi->motionBytes, rsh, rsi, nsi);
 
         /* Update per-slice accumulators. */
         cdbexplain_depStatAcc_upd(&peakmemused, rsh->worker.peakmemused, rsh, rsi, nsi);
@@ -1020,6 +1093,13 @@ cdbexplain_depositStatsToNode(PlanState *planstate, CdbExplain_RecvStatCtx *ctx)
 	ns->totalWorkfileCreated = totalWorkfileCreated.agg;
     ns->peakMemBalance = peakMemBalance.agg;
     ns->totalPartTableScanned = totalPartTableScanned.agg;
+    ns->profileSamples = profileSamples.agg;
+    ns->profileTime = profileTime.agg;
+    ns->spillBytes = spillBytes.agg;
+    ns->hashCollisions = hashCollisions.agg;
+    ns->motionStall = motionStall.agg;
+    ns->decompressTime = decompressTime.agg;
+    ns->motionBytes = motionBytes.agg;
 
     /* Roll up summary over all nodes of slice into RecvStatCtx. */
     ctx->workmemused_max = Max(ctx->workmemused_max, workmemused.agg.vmax);
@@ -1255,6 +1335,75 @@ cdbexplain_formatSeg(char *outbuf, int bufsize, int segindex, int nInst)
 }                               /* cdbexplain_formatSeg */
 
 
+/*
+ * cdbexplain_showMotionSkew
+ *    Show how skewed the rows and bytes that a Redistribute Motion sent to
+ *    the segments were, as received by its workers, and the segments that
+ *    received the most rows.
+ */
+#define CDBEXPLAIN_SKEW_TOP_SEGMENTS 3
+
+static void
+cdbexplain_showMotionSkew(StringInfo str, int indent, CdbExplain_NodeSummary *ns)
+{
+    int         top[CDBEXPLAIN_SKEW_TOP_SEGMENTS];
+    int         ntop;
+    int         i;
+    char        bytesbuf[50];
+    char        segbuf[50];
+
+    appendStringInfoFill(str, 2*indent, ' ');
+    cdbexplain_formatSeg(segbuf, sizeof(segbuf), ns->ntuples.imax, ns->ninst);
+    appendStringInfo(str, "Skew: max/avg %.1f rows%s",
+                     ns->ntuples.vmax * ns->ninst / ns->ntuples.vsum,
+                     segbuf);
+    if (ns->motionBytes.vcnt > 0)
+    {
+        cdbexplain_formatSeg(segbuf, sizeof(segbuf), ns->motionBytes.imax, ns->ninst);
+        appendStringInfo(str, ", %.1f bytes%s",
+                         ns->motionBytes.vmax * ns->ninst / ns->motionBytes.vsum,
+                         segbuf);
+    }
+
+    /* Pick the workers that received the most rows. */
+    for (ntop = 0; ntop < CDBEXPLAIN_SKEW_TOP_SEGMENTS; ntop++)
+    {
+        int         imax = -1;
+
+        for (i = 0; i < ns->ninst; i++)
+        {
+            int         j;
+
+            for (j = 0; j < ntop && top[j] != i; j++)
+                ;
+            if (j == ntop &&
+                ns->insts[i].ntuples > 0 &&
+                (imax < 0 || ns->insts[i].ntuples > ns->insts[imax].ntuples))
+                imax = i;
+        }
+        if (imax < 0)
+            break;
+        top[ntop] = imax;
+    }
+
+    for (i = 0; i < ntop; i++)
+    {
+        CdbExplain_StatInst *nsi = &ns->insts[top[i]];
+
+        appendStringInfo(str, "%s seg%d %.0f rows",
+                         (i == 0) ? "; top segments:" : ",",
+                         ns->segindex0 + top[i],
+                         nsi->ntuples);
+        if (ns->motionBytes.vcnt > 0)
+        {
+            cdbexplain_formatMemory(bytesbuf, sizeof(bytesbuf), nsi->motionBytes);
+            appendStringInfo(str, " %s", bytesbuf);
+        }
+    }
+    appendStringInfoString(str, ".\n");
+}                               /* cdbexplain_showMotionSkew */
+
+
 /*
  * cdbexplain_showExecStatsBegin
  *    Called by qDisp process to create a CdbExplain_ShowStatCtx structure
@@ -1676,7 +1825,63 @@ cdbexplain_showExecStats(struct PlanState              *planstate,
     		}
     	}
     }
-	
+
+    /*
+     * Always-on profile of the node, if requested.
+     */
+    if (gp_enable_explain_profile && ns->profileSamples.vcnt > 0)
+    {
+        appendStringInfoFill(str, 2*indent, ' ');
+        appendStringInfoString(str, "Profile: ");
+        cdbexplain_formatSeconds(maxbuf, sizeof(maxbuf), ns->profileTime.vmax);
+        cdbexplain_formatSeg(segbuf, sizeof(segbuf), ns->profileTime.imax, ns->ninst);
+        if (ns->profileTime.vcnt > 1)
+        {
+            cdbexplain_formatSeconds(avgbuf, sizeof(avgbuf), cdbexplain_agg_avg(&ns->profileTime));
+            appendStringInfo(str, " %s avg, %s max%s", avgbuf, maxbuf, segbuf);
+        }
+        else
+            appendStringInfo(str, " %s%s", maxbuf, segbuf);
+        appendStringInfo(str, " from %.0f samples", ns->profileSamples.vsum);
+
+        if (ns->spillBytes.vcnt > 0)
+        {
+            cdbexplain_formatMemory(maxbuf, sizeof(maxbuf), ns->spillBytes.vmax);
+            cdbexplain_formatSeg(segbuf, sizeof(segbuf), ns->spillBytes.imax, ns->ninst);
+            appendStringInfo(str, ", spilled %s max%s", maxbuf, segbuf);
+        }
+        if (ns->hashCollisions.vcnt > 0)
+        {
+            cdbexplain_formatSeg(segbuf, sizeof(segbuf), ns->hashCollisions.imax, ns->ninst);
+            appendStringInfo(str, ", %.0f hash collisions max%s",
+                             ns->hashCollisions.vmax, segbuf);
+        }
+        if (ns->motionStall.vcnt > 0)
+        {
+            cdbexplain_formatSeconds(maxbuf, sizeof(maxbuf), ns->motionStall.vmax);
+            cdbexplain_formatSeg(segbuf, sizeof(segbuf), ns->motionStall.imax, ns->ninst);
+            appendStringInfo(str, ", %s motion stall max%s", maxbuf, segbuf);
+        }
+        if (ns->decompressTime.vcnt > 0)
+        {
+            cdbexplain_formatSeconds(maxbuf, sizeof(maxbuf), ns->decompressTime.vmax);
+            cdbexplain_formatSeg(segbuf, sizeof(segbuf), ns->decompressTime.imax, ns->ninst);
+            appendStringInfo(str, ", %s decompressing max%s", maxbuf, segbuf);
+        }
+        appendStringInfoString(str, ".\n");
+    }
+
+    /*
+     * Skew of a Redistribute Motion, if it passes gp_motion_skew_threshold.
+     */
+    if (gp_motion_skew_threshold > 0 &&
+        IsA(planstate, MotionState) &&
+        ((Motion *)planstate->plan)->motionType == MOTIONTYPE_HASH &&
+        ns->ninst > 1 &&
+        ns->ntuples.vsum > 0 &&
+        ns->ntuples.vmax * ns->ninst > gp_motion_skew_threshold * ns->ntuples.vsum)
+        cdbexplain_showMotionSkew(str, indent, ns);
+
     /*
      * Extra message text.
      */
@@ -1947,6 +2152,37 @@ cdbexplain_showExecStatsEnd(struct PlannedStmt *stmt,
 			}
         }
 
+        /* Time waited on the interconnect, I/O and locks */
+        if (gp_enable_explain_waits)
+        {
+            const char *sep = "  Waits: ";
+            int         i;
+
+            for (i = 0; i < INSTR_NUM_WAIT_CLASSES; i++)
+            {
+                CdbExplain_Agg *agg = &ss->waitTime[i];
+
+                if (agg->vcnt <= 0)
+                    continue;
+
+                cdbexplain_formatSeconds(maxbuf, sizeof(maxbuf), agg->vmax);
+                if (agg->vcnt == 1)
+                    appendStringInfo(str, "%s%s %s", sep,
+                                     InstrWaitClassNames[i], maxbuf);
+                else
+                {
+                    cdbexplain_formatSeconds(avgbuf, sizeof(avgbuf), cdbexplain_agg_avg(agg));
+                    cdbexplain_formatSeg(segbuf, sizeof(segbuf), agg->imax, ss->nworker);
+                    appendStringInfo(str, "%s%s %s avg x %d workers, %s max%s",
+                                     sep, InstrWaitClassNames[i],
+                                     avgbuf, agg->vcnt, maxbuf, segbuf);
+                }
+                sep = "; ";
+            }
+            if (sep[0] == ';')
+                appendStringInfoChar(str, '.');
+        }
+
         /* Work_mem used/wanted (max over all nodes and workers of slice) */
         if (ss->workmemused_max + ss->workmemwanted_max > 0)
         {
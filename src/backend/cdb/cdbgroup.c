@@ -727,6 +727,34 @@ cdb_grouping_planner(PlannerInfo* root,
 		if ( is_grpext )
 			possible_agg &= ~ (AGG_2PHASE_DQA | AGG_3PHASE);
 		
+		/* When the Agg node can eliminate the duplicates of every DQA with
+		 * a hash set (see nodeAgg.c), a single GroupAgg over the input
+		 * redistributed on the grouping key computes all the DQAs in one
+		 * pass.  Prefer that to joining a DQA pruning coplan per distinct
+		 * argument.
+		 */
+		if ( has_groups && list_length(agg_counts->dqaArgs) > 1 &&
+			 plan_1p.group_prep != MPP_GRP_PREP_FOCUS_QE &&
+			 root->config->enable_groupagg &&
+			 ! root->config->gp_eager_dqa_pruning &&
+			 root->config->gp_enable_agg_distinct_hash &&
+			 ! agg_counts->missing_prelimfunc )
+		{
+			bool can_hash = true;
+			
+			foreach ( lc, agg_counts->dqaArgs )
+			{
+				if ( ! hash_safe_type(exprType((Node *) lfirst(lc))) )
+				{
+					can_hash = false;
+					break;
+				}
+			}
+			
+			if ( can_hash )
+				allowed_agg &= ~ AGG_3PHASE;
+		}
+		
 		consider_agg = allowed_agg & possible_agg;
 	}
 	Assert( consider_agg & AGG_1PHASE ); /* Always possible! */
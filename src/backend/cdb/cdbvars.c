@@ -245,6 +245,7 @@ bool		gp_selectivity_damping_sigsort = true;
 
 int			gp_hashjoin_tuples_per_bucket = 5;
 int			gp_hashagg_groups_per_bucket = 5;
+bool		gp_enable_agg_distinct_hash = true;
 int			gp_hashjoin_metadata_memory_percent = 20;
 
 
@@ -255,6 +256,9 @@ int 		gp_hashagg_spillbatch_max = 0;
 /* hash join to use bloom filter: default to 0, means not used */
 int 	 	gp_hashjoin_bloomfilter = 0;
 
+/* number of outer tuples hash join probes as a batch: 0 means one at a time */
+int			gp_hashjoin_probe_batch_size = 0;
+
 /* Analyzing aid */
 int 		gp_motion_slice_noop = 0;
 #ifdef ENABLE_LTRACE
@@ -270,6 +274,10 @@ bool		gp_parquet_insert_sort = true;
 /* Greenplum Database Experimental Feature GUCs */
 int         gp_distinct_grouping_sets_threshold = 32;
 bool		gp_enable_explain_allstat = FALSE;
+bool		gp_enable_explain_profile = FALSE;
+bool		gp_enable_explain_waits = FALSE;
+double		gp_motion_skew_threshold = 2.0;
+int			gp_instrument_profile_interval = 100;
 bool		gp_enable_motion_deadlock_sanity = FALSE; /* planning time sanity check */
 
 #ifdef USE_ASSERT_CHECKING
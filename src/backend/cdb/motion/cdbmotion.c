@@ -20,6 +20,7 @@
 #include "cdb/htupfifo.h"
 #include "cdb/ml_ipc.h"
 #include "cdb/tupser.h"
+#include "executor/instrument.h"
 #include "libpq/pqformat.h"
 #include "utils/hsearch.h"
 #include "utils/memutils.h"
@@ -30,6 +31,9 @@
  */
 int			Gp_max_tuple_chunk_size;
 
+/* Sends before the skew of the routes of a motion node is first checked */
+#define MOTION_SKEW_MIN_SENDS (1 << 16)
+
 /*
  * STATIC STATE VARS
  *
@@ -64,6 +68,8 @@ static inline void reconstructTuple(MotionNodeEntry * pMNEntry, ChunkSorterEntry
 
 /* Stats-function declarations. */
 static void statSendTuple(MotionLayerState *mlStates, MotionNodeEntry * pMNEntry, TupleChunkList tcList);
+static void statSendTupleToRoute(MotionLayerState *mlStates, ChunkTransportState *transportStates,
+								 MotionNodeEntry * pMNEntry, int16 targetRoute, TupleChunkList tcList);
 static void statSendEOS(MotionLayerState *mlStates, MotionNodeEntry * pMNEntry);
 static void statChunksProcessed(MotionLayerState *mlStates, MotionNodeEntry * pMNEntry, int chunksProcessed, int chunkBytes, int tupleBytes);
 static void statNewTupleArrived(MotionNodeEntry * pMNEntry, ChunkSorterEntry * pCSEntry);
@@ -351,6 +357,10 @@ UpdateMotionLayerNode(MotionLayerState *mlStates, int16 motNodeID, bool preserve
 	pEntry->stat_total_chunks_recvd = 0;
 	pEntry->stat_total_bytes_recvd = 0;
 	pEntry->stat_tuple_bytes_recvd = 0;
+	pEntry->stat_num_routes = 0;
+	pEntry->stat_route_tuples_sent = NULL;
+	pEntry->stat_route_bytes_sent = NULL;
+	pEntry->stat_route_skew_logged = false;
 	pEntry->sel_rd_wait = 0;
 	pEntry->sel_wr_wait = 0;
 
@@ -397,6 +407,7 @@ SendTuple(MotionLayerState *mlStates,
 	TupleChunkListData tcList;
 	MemoryContext oldCtxt;
 	SendReturnCode rc;
+	uint64		startCycles = 0;
 
 	AssertArg(tuple != NULL);
 		
@@ -438,6 +449,7 @@ SendTuple(MotionLayerState *mlStates,
 			
 				/* update stats */
 				statSendTuple(mlStates, pMNEntry, &tcList);
+				statSendTupleToRoute(mlStates, transportStates, pMNEntry, targetRoute, &tcList);
 
 				return SEND_COMPLETE;
 			}
@@ -462,7 +474,13 @@ SendTuple(MotionLayerState *mlStates,
 		 tcList.num_chunks);
 #endif
 
-	/* do the send. */
+	/*
+	 * Do the send.  This is where the sender waits for the interconnect,
+	 * when the buffer of the route is full.
+	 */
+	if (CurrentInstrProfile)
+		startCycles = INSTR_CYCLES_GET_CURRENT();
+
 	if (!SendTupleChunkToAMS(mlStates, transportStates, motNodeID, targetRoute, tcList.p_first))
 	{
 		pMNEntry->stopped = true;
@@ -472,10 +490,15 @@ SendTuple(MotionLayerState *mlStates,
 	{
 		/* update stats */
 		statSendTuple(mlStates, pMNEntry, &tcList);
+		if (targetRoute != BROADCAST_SEGIDX)
+			statSendTupleToRoute(mlStates, transportStates, pMNEntry, targetRoute, &tcList);
 
 		rc = SEND_COMPLETE;
 	}
 
+	if (CurrentInstrProfile)
+		CurrentInstrProfile->motionStallCycles += INSTR_CYCLES_GET_CURRENT() - startCycles;
+
 	/* cleanup */
 	clearTCList(&pMNEntry->ser_tup_info.chunkCache, &tcList);
 
@@ -653,18 +676,25 @@ processIncomingChunks(MotionLayerState *mlStates,
 	int			numChunks,
 				chunkBytes,
 				tupleBytes;
+	uint64		startCycles = 0;
 
 	oldCtxt = MemoryContextSwitchTo(mlStates->motion_layer_mctx);
 
 	/*
 	 * Get all of the currently available tuple-chunks, and push each one into
-	 * the chunk-sorter.
+	 * the chunk-sorter.  The receiver waits for the senders here.
 	 */
+	if (CurrentInstrProfile)
+		startCycles = INSTR_CYCLES_GET_CURRENT();
+
 	if (srcRoute == ANY_ROUTE)
 		tcItem = transportStates->RecvTupleChunkFromAny(mlStates, transportStates, motNodeID, &srcRoute);
 	else
 		tcItem = transportStates->RecvTupleChunkFrom(transportStates, motNodeID, srcRoute);
 
+	if (CurrentInstrProfile)
+		CurrentInstrProfile->motionStallCycles += INSTR_CYCLES_GET_CURRENT() - startCycles;
+
 	numChunks = 0;
 	chunkBytes = 0;
 	tupleBytes = 0;
@@ -861,6 +891,21 @@ getMotionNodeEntry(MotionLayerState *mlStates, int16 motNodeID, char *errString
 	return pMNEntry;
 }
 
+/*
+ * Return the bytes of tuple-data that a motion node received, or 0 if it is
+ * not set up in this process.  This is used by EXPLAIN ANALYZE.
+ */
+uint64
+getMotionNodeTupleBytesRecvd(MotionLayerState *mlStates, int16 motNodeID)
+{
+	if (mlStates == NULL ||
+		motNodeID < 1 || motNodeID > mlStates->mneCount ||
+		!mlStates->mnEntries[motNodeID - 1].valid)
+		return 0;
+
+	return mlStates->mnEntries[motNodeID - 1].stat_tuple_bytes_recvd;
+}
+
 /*
  * Retrieve the chunk-sorter entry for the specified motion-node/source pair.
  * If one doesn't exist, it is created and initialized.
@@ -1170,6 +1215,74 @@ statSendTuple(MotionLayerState *mlStates, MotionNodeEntry * pMNEntry, TupleChunk
 
 }
 
+/*
+ * Count a tuple sent to a single route, and LOG once if the routes of the
+ * motion node are skewed by more than gp_motion_skew_threshold, which is
+ * checked each time the number of sends reaches a power of 2.
+ */
+static void
+statSendTupleToRoute(MotionLayerState *mlStates, ChunkTransportState *transportStates,
+					 MotionNodeEntry * pMNEntry, int16 targetRoute, TupleChunkList tcList)
+{
+	uint64		nsends;
+
+	AssertArg(pMNEntry != NULL);
+
+	if (pMNEntry->stat_route_tuples_sent == NULL)
+	{
+		ChunkTransportStateEntry *pEntry = NULL;
+
+		getChunkTransportState(transportStates, pMNEntry->motion_node_id, &pEntry);
+
+		pMNEntry->stat_num_routes = pEntry->numConns;
+		pMNEntry->stat_route_tuples_sent = (uint64 *)
+			MemoryContextAllocZero(mlStates->motion_layer_mctx,
+								   pEntry->numConns * sizeof(uint64));
+		pMNEntry->stat_route_bytes_sent = (uint64 *)
+			MemoryContextAllocZero(mlStates->motion_layer_mctx,
+								   pEntry->numConns * sizeof(uint64));
+	}
+
+	Assert(targetRoute >= 0 && targetRoute < pMNEntry->stat_num_routes);
+	pMNEntry->stat_route_tuples_sent[targetRoute]++;
+	pMNEntry->stat_route_bytes_sent[targetRoute] += tcList->serialized_data_length;
+
+	nsends = pMNEntry->stat_total_sends;
+	if (gp_motion_skew_threshold > 0 &&
+		!pMNEntry->stat_route_skew_logged &&
+		nsends >= MOTION_SKEW_MIN_SENDS &&
+		(nsends & (nsends - 1)) == 0)
+	{
+		double		avg = (double) nsends / pMNEntry->stat_num_routes;
+		uint64		totalBytes = 0;
+		int			maxRoute = 0;
+		int			i;
+
+		for (i = 0; i < pMNEntry->stat_num_routes; i++)
+		{
+			totalBytes += pMNEntry->stat_route_bytes_sent[i];
+			if (pMNEntry->stat_route_tuples_sent[i] >
+				pMNEntry->stat_route_tuples_sent[maxRoute])
+				maxRoute = i;
+		}
+
+		if (pMNEntry->stat_route_tuples_sent[maxRoute] > gp_motion_skew_threshold * avg)
+		{
+			double		avgBytes = (double) totalBytes / pMNEntry->stat_num_routes;
+
+			pMNEntry->stat_route_skew_logged = true;
+			ereport(LOG,
+					(errmsg("motion %d is skewed: segment %d got " UINT64_FORMAT " of the " UINT64_FORMAT " tuples sent by this segment, %.1f times the average",
+							pMNEntry->motion_node_id, maxRoute,
+							pMNEntry->stat_route_tuples_sent[maxRoute], nsends,
+							pMNEntry->stat_route_tuples_sent[maxRoute] / avg),
+					 errdetail("It got " UINT64_FORMAT " of the " UINT64_FORMAT " bytes, %.1f times the average.",
+							   pMNEntry->stat_route_bytes_sent[maxRoute], totalBytes,
+							   avgBytes > 0 ? pMNEntry->stat_route_bytes_sent[maxRoute] / avgBytes : 0.0)));
+		}
+	}
+}
+
 static void
 statSendEOS(MotionLayerState *mlStates, MotionNodeEntry * pMNEntry)
 {
@@ -22,6 +22,7 @@
 #include <pthread.h>
 
 #include "access/transam.h"
+#include "executor/instrument.h"
 #include "nodes/execnodes.h"
 #include "nodes/pg_list.h"
 #include "nodes/print.h"
@@ -3816,6 +3817,7 @@ RecvTupleChunkFromAnyUDPIFC(MotionLayerState *mlStates,
 						 int16 *srcRoute)
 {
 	TupleChunkListItem icItem = NULL;
+	uint64		waitStart = InstrWaitStart();
 
 	PG_TRY();
 	{
@@ -3833,6 +3835,8 @@ RecvTupleChunkFromAnyUDPIFC(MotionLayerState *mlStates,
 	}
 	PG_END_TRY();
 
+	InstrWaitEnd(INSTR_WAIT_MOTION_RECV, waitStart);
+
 	return icItem;
 }
 
@@ -3921,6 +3925,7 @@ RecvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
 					  int16		srcRoute)
 {
 	TupleChunkListItem icItem = NULL;
+	uint64		waitStart = InstrWaitStart();
 
 	PG_TRY();
 	{
@@ -3938,6 +3943,8 @@ RecvTupleChunkFromUDPIFC(ChunkTransportState *transportStates,
 	}
 	PG_END_TRY();
 
+	InstrWaitEnd(INSTR_WAIT_MOTION_RECV, waitStart);
+
 	return icItem;
 }
 
@@ -5175,6 +5182,7 @@ SendChunkUDPIFC(MotionLayerState *mlStates,
 	int		retry = 0;
 	bool	doCheckExpiration = false;
 	bool	gotStops = false;
+	uint64	waitStart;
 
 	Assert(conn->msgSize > 0);
 
@@ -5217,6 +5225,7 @@ SendChunkUDPIFC(MotionLayerState *mlStates,
 	ic_control_info.lastPacketSendTime = 0;
 	conn->deadlockCheckBeginTime = now;
 
+	waitStart = InstrWaitStart();
 	while (doCheckExpiration || (conn->curBuff = getSndBuffer(conn)) == NULL)
 	{
 		int timeout =  (doCheckExpiration ? 0 : computeTimeout(conn, retry));
@@ -5237,6 +5246,7 @@ SendChunkUDPIFC(MotionLayerState *mlStates,
 		checkExceptions(transportStates, pEntry, conn, retry++, timeout);
 		doCheckExpiration = false;
 	}
+	InstrWaitEnd(INSTR_WAIT_MOTION_SEND, waitStart);
 
 	conn->pBuff = (uint8 *) conn->curBuff->pkt;
 
@@ -0,0 +1,206 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    agg_hash_entry_match_codegen.cc
+//
+//  @doc:
+//    Generates code for agg_hash_entry_match function.
+//
+//---------------------------------------------------------------------------
+#include "codegen/agg_hash_entry_match_codegen.h"
+#include "codegen/op_expr_tree_generator.h"
+#include "codegen/pg_func_generator_interface.h"
+
+#include "codegen/utils/gp_codegen_utils.h"
+#include "codegen/utils/utility.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "access/memtup.h"
+#include "executor/tuptable.h"
+#include "nodes/execnodes.h"
+#include "utils/elog.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+using gpcodegen::AggHashEntryMatchCodegen;
+
+constexpr char AggHashEntryMatchCodegen::kAggHashEntryMatchPrefix[];
+
+AggHashEntryMatchCodegen::AggHashEntryMatchCodegen(
+    CodegenManager* manager,
+    AggHashEntryMatchFn regular_func_ptr,
+    AggHashEntryMatchFn* ptr_to_regular_func_ptr,
+    AggState *aggstate)
+: BaseCodegen(manager,
+              kAggHashEntryMatchPrefix,
+              regular_func_ptr,
+              ptr_to_regular_func_ptr),
+              aggstate_(aggstate) {
+}
+
+bool AggHashEntryMatchCodegen::GenerateAggHashEntryMatch(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+
+  assert(NULL != codegen_utils);
+  if (nullptr == aggstate_ ||
+      nullptr == aggstate_->eqfunctions) {
+    return false;
+  }
+
+  Agg *agg = reinterpret_cast<Agg*>(aggstate_->ss.ps.plan);
+  if (agg->numCols <= 0) {
+    return false;
+  }
+
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Function* agg_hash_entry_match_func =
+      CreateFunction<AggHashEntryMatchFn>(codegen_utils, GetUniqueFuncName());
+
+  // BasicBlock of function entry.
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry_block", agg_hash_entry_match_func);
+  llvm::BasicBlock* mismatch_block = codegen_utils->CreateBasicBlock(
+      "mismatch_block", agg_hash_entry_match_func);
+  llvm::BasicBlock* error_block = codegen_utils->CreateBasicBlock(
+      "error_block", agg_hash_entry_match_func);
+
+  // External functions
+  llvm::Function* llvm_slot_getattr =
+      codegen_utils->GetOrRegisterExternalFunction(slot_getattr_regular,
+                                                   "slot_getattr_regular");
+  llvm::Function* llvm_memtuple_getattr =
+      codegen_utils->GetOrRegisterExternalFunction(memtuple_getattr,
+                                                   "memtuple_getattr");
+
+  // Function arguments to agg_hash_entry_match
+  llvm::Value* llvm_aggstate_arg = ArgumentByPosition(
+      agg_hash_entry_match_func, 0);
+  llvm::Value* llvm_inputslot_arg = ArgumentByPosition(
+      agg_hash_entry_match_func, 1);
+  llvm::Value* llvm_entry_tuple_arg = ArgumentByPosition(
+      agg_hash_entry_match_func, 2);
+
+  // entry block
+  // ----------
+  irb->SetInsertPoint(entry_block);
+
+#ifdef CODEGEN_DEBUG
+  codegen_utils->CreateElog(DEBUG1, "Codegen'ed agg_hash_entry_match called!");
+#endif
+
+  llvm::Value* llvm_input_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "input_isNull");
+  llvm::Value* llvm_entry_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "entry_isNull");
+
+  // mt_bind = aggstate->hashslot->tts_mt_bind;
+  llvm::Value* llvm_hashslot = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_aggstate_arg,
+                                        &AggState::hashslot));
+  llvm::Value* llvm_mt_bind = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_hashslot,
+                                        &TupleTableSlot::tts_mt_bind));
+
+  for (int i = 0; i < agg->numCols; i++) {
+    Oid eqfn = aggstate_->eqfunctions[i].fn_oid;
+    gpcodegen::PGFuncGeneratorInterface* pg_func_gen =
+        gpcodegen::OpExprTreeGenerator::GetPGFuncGenerator(eqfn);
+    if (nullptr == pg_func_gen) {
+      elog(DEBUG1, "We do not support equality function with oid = %d", eqfn);
+      return false;
+    }
+
+    AttrNumber att = agg->grpColIdx[i];
+    llvm::BasicBlock* null_block = codegen_utils->CreateBasicBlock(
+        "null_block_col" + std::to_string(i), agg_hash_entry_match_func);
+    llvm::BasicBlock* compare_block = codegen_utils->CreateBasicBlock(
+        "compare_block_col" + std::to_string(i), agg_hash_entry_match_func);
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "next_block_col" + std::to_string(i), agg_hash_entry_match_func);
+
+    // input_datum = slot_getattr(inputslot, att, &input_isNull);
+    // entry_datum = memtuple_getattr(mtup, mt_bind, att, &entry_isNull);
+    llvm::Value* llvm_input_datum = irb->CreateCall(llvm_slot_getattr, {
+        llvm_inputslot_arg,
+        codegen_utils->GetConstant<int32_t>(att),
+        llvm_input_isnull_ptr});
+    llvm::Value* llvm_entry_datum = irb->CreateCall(llvm_memtuple_getattr, {
+        llvm_entry_tuple_arg,
+        llvm_mt_bind,
+        codegen_utils->GetConstant<int32_t>(att),
+        llvm_entry_isnull_ptr});
+    llvm::Value* llvm_input_isnull = irb->CreateLoad(llvm_input_isnull_ptr);
+    llvm::Value* llvm_entry_isnull = irb->CreateLoad(llvm_entry_isnull_ptr);
+    irb->CreateCondBr(irb->CreateOr(llvm_input_isnull, llvm_entry_isnull),
+                      null_block /* true */,
+                      compare_block /* false */);
+
+    // null block
+    // ----------
+    // NULLs match in group keys.
+    irb->SetInsertPoint(null_block);
+    irb->CreateCondBr(irb->CreateAnd(llvm_input_isnull, llvm_entry_isnull),
+                      next_block /* true */,
+                      mismatch_block /* false */);
+
+    // compare block
+    // ----------
+    // Both non-NULL, compare them with the equality function.
+    irb->SetInsertPoint(compare_block);
+    gpcodegen::PGFuncGeneratorInfo pg_func_info(
+        agg_hash_entry_match_func,
+        error_block,
+        {llvm_input_datum, llvm_entry_datum},
+        {codegen_utils->GetConstant<bool>(false),
+         codegen_utils->GetConstant<bool>(false)});
+    llvm::Value* llvm_equal = nullptr;
+    if (!pg_func_gen->GenerateCode(codegen_utils, pg_func_info, &llvm_equal,
+                                   llvm_input_isnull_ptr)) {
+      elog(DEBUG1, "Equality function with oid = %d was not generated "
+           "successfully!", eqfn);
+      return false;
+    }
+    irb->CreateCondBr(llvm_equal,
+                      next_block /* true */,
+                      mismatch_block /* false */);
+
+    irb->SetInsertPoint(next_block);
+  }
+
+  irb->CreateRet(codegen_utils->GetConstant<bool>(true));
+
+  // Mismatch block
+  // ---------------
+  irb->SetInsertPoint(mismatch_block);
+  irb->CreateRet(codegen_utils->GetConstant<bool>(false));
+
+  // Error block
+  // ---------------
+  // The equality functions don't report errors, so this is never reached.
+  irb->SetInsertPoint(error_block);
+  irb->CreateRet(codegen_utils->GetConstant<bool>(false));
+
+  return true;
+}
+
+bool AggHashEntryMatchCodegen::GenerateCodeInternal(
+    GpCodegenUtils* codegen_utils) {
+  bool isGenerated = GenerateAggHashEntryMatch(codegen_utils);
+
+  if (isGenerated) {
+    elog(DEBUG1, "agg_hash_entry_match was generated successfully!");
+    return true;
+  } else {
+    elog(DEBUG1, "agg_hash_entry_match generation failed!");
+    return false;
+  }
+}
@@ -0,0 +1,359 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    agg_scan_pipeline_codegen.cc
+//
+//  @doc:
+//    Generates code for agg_scan_pipeline function.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "codegen/advance_aggregates_codegen.h"
+#include "codegen/agg_scan_pipeline_codegen.h"
+#include "codegen/op_expr_tree_generator.h"
+#include "codegen/slot_getattr_codegen.h"
+#include "codegen/utils/gp_codegen_utils.h"
+#include "codegen/utils/utility.h"
+
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Constant.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "cdb/cdbvars.h"
+#include "executor/executor.h"
+#include "executor/nodeAgg.h"
+#include "executor/nodeTableScan.h"
+#include "executor/tuptable.h"
+#include "nodes/execnodes.h"
+#include "nodes/pg_list.h"
+#include "utils/elog.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+using gpcodegen::AggScanPipelineCodegen;
+using gpcodegen::AdvanceAggregatesCodegen;
+using gpcodegen::SlotGetAttrCodegen;
+
+constexpr char AggScanPipelineCodegen::kAggScanPipelinePrefix[];
+
+AggScanPipelineCodegen::AggScanPipelineCodegen(
+    CodegenManager* manager,
+    AggScanPipelineFn regular_func_ptr,
+    AggScanPipelineFn* ptr_to_regular_func_ptr,
+    AggState *aggstate)
+: BaseCodegen(manager,
+              kAggScanPipelinePrefix,
+              regular_func_ptr,
+              ptr_to_regular_func_ptr),
+              aggstate_(aggstate),
+              scan_state_(nullptr),
+              gen_info_(nullptr, nullptr, nullptr, nullptr, 0),
+              slot_getattr_codegen_(nullptr) {
+}
+
+bool AggScanPipelineCodegen::InitDependencies() {
+  assert(nullptr != aggstate_);
+  PlanState* outer_plan_state = outerPlanState(aggstate_);
+  // Instrumentation and gpperfmon count the rows in ExecProcNode and
+  // ExecTableScan, which the pipeline skips. The always-on profile of the
+  // scan is kept by ExecTableScanFetch instead.
+  if (nullptr == outer_plan_state ||
+      T_TableScanState != nodeTag(outer_plan_state) ||
+      nullptr != outer_plan_state->instrument ||
+      gp_enable_gpperfmon) {
+    elog(DEBUG1, "agg_scan_pipeline is only generated for TableScans "
+         "without instrumentation");
+    return true;
+  }
+  scan_state_ = reinterpret_cast<ScanState*>(outer_plan_state);
+  gen_info_.econtext = scan_state_->ps.ps_ExprContext;
+
+  // Inline the quals only if all of them are supported; otherwise they are
+  // checked by calling ExecQual.
+  OpExprTreeGenerator::InitializeSupportedFunction();
+  ListCell* qual;
+  foreach(qual, scan_state_->ps.qual) {
+    std::unique_ptr<ExprTreeGenerator> qual_tree;
+    if (!ExprTreeGenerator::VerifyAndCreateExprTree(
+        reinterpret_cast<ExprState*>(lfirst(qual)), &gen_info_, &qual_tree)) {
+      qual_trees_.clear();
+      break;
+    }
+    qual_trees_.push_back(std::move(qual_tree));
+  }
+
+  // Prepare dependent slot_getattr() generation for the scan tuples
+  if (!qual_trees_.empty() && gen_info_.max_attr > 0) {
+    slot_getattr_codegen_ = SlotGetAttrCodegen::GetCodegenInstance(
+        manager(), scan_state_->ss_ScanTupleSlot, gen_info_.max_attr);
+  }
+  return true;
+}
+
+bool AggScanPipelineCodegen::GenerateQuals(
+    gpcodegen::GpCodegenUtils* codegen_utils,
+    llvm::BasicBlock* qual_pass_block,
+    llvm::BasicBlock* qual_fail_block) {
+  auto irb = codegen_utils->ir_builder();
+  List* quals = scan_state_->ps.qual;
+
+  if (NIL == quals) {
+    irb->CreateBr(qual_pass_block);
+    return true;
+  }
+
+  if (qual_trees_.empty()) {
+    // if (ExecQual(qual, econtext, false))
+    llvm::Function* llvm_ExecQual =
+        codegen_utils->GetOrRegisterExternalFunction(ExecQual, "ExecQual");
+    llvm::Value* llvm_qual_result = irb->CreateCall(llvm_ExecQual, {
+        codegen_utils->GetConstant(quals),
+        codegen_utils->GetConstant(gen_info_.econtext),
+        codegen_utils->GetConstant<bool>(false)});
+    irb->CreateCondBr(
+        irb->CreateICmpNE(llvm_qual_result,
+                          codegen_utils->GetConstant<bool>(false)),
+        qual_pass_block /* true */,
+        qual_fail_block /* false */);
+    return true;
+  }
+
+  // If slot_getattr_codegen_ is not set or generation fails
+  // we revert to use the external slot_getattr()
+  if (nullptr == slot_getattr_codegen_ ||
+      false == slot_getattr_codegen_->GenerateCode(codegen_utils)) {
+    gen_info_.llvm_slot_getattr_func =
+        codegen_utils->GetOrRegisterExternalFunction(slot_getattr_regular,
+                                                     "slot_getattr_regular");
+  } else {
+    gen_info_.llvm_slot_getattr_func =
+        slot_getattr_codegen_->GetGeneratedFunction();
+    assert(nullptr != gen_info_.llvm_slot_getattr_func);
+  }
+
+  // As in ExecQual with resultForNull = false, a tuple passes if every qual
+  // is true; a qual that is false or NULL rejects it.
+  llvm::Value* llvm_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "qual_isnull");
+  for (size_t i = 0; i < qual_trees_.size(); ++i) {
+    llvm::BasicBlock* next_block = i + 1 < qual_trees_.size() ?
+        codegen_utils->CreateBasicBlock("qual_" + std::to_string(i + 1),
+                                        gen_info_.llvm_main_func) :
+        qual_pass_block;
+    llvm::BasicBlock* not_null_block = codegen_utils->CreateBasicBlock(
+        "qual_not_null_" + std::to_string(i), gen_info_.llvm_main_func);
+
+    llvm::Value* llvm_value = nullptr;
+    if (!qual_trees_[i]->GenerateCode(codegen_utils, gen_info_,
+                                      &llvm_value, llvm_isnull_ptr) ||
+        nullptr == llvm_value) {
+      return false;
+    }
+    irb->CreateCondBr(irb->CreateLoad(llvm_isnull_ptr),
+                      qual_fail_block /* true */,
+                      not_null_block /* false */);
+
+    irb->SetInsertPoint(not_null_block);
+    irb->CreateCondBr(
+        irb->CreateICmpNE(codegen_utils->CreateCppTypeToDatumCast(llvm_value),
+                          codegen_utils->GetConstant<Datum>(0)),
+        next_block /* true */,
+        qual_fail_block /* false */);
+    if (next_block != qual_pass_block) {
+      irb->SetInsertPoint(next_block);
+    }
+  }
+  return true;
+}
+
+bool AggScanPipelineCodegen::GenerateAggScanPipeline(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+  assert(NULL != codegen_utils);
+  if (nullptr == aggstate_ || nullptr == scan_state_) {
+    return false;
+  }
+
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Function* pipeline_func = CreateFunction<AggScanPipelineFn>(
+      codegen_utils, GetUniqueFuncName());
+
+  // BasicBlock of function entry.
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry_block", pipeline_func);
+  llvm::BasicBlock* fetch_block = codegen_utils->CreateBasicBlock(
+      "fetch_block", pipeline_func);
+  llvm::BasicBlock* qual_block = codegen_utils->CreateBasicBlock(
+      "qual_block", pipeline_func);
+  llvm::BasicBlock* advance_block = codegen_utils->CreateBasicBlock(
+      "advance_block", pipeline_func);
+  llvm::BasicBlock* qual_fail_block = codegen_utils->CreateBasicBlock(
+      "qual_fail_block", pipeline_func);
+  llvm::BasicBlock* done_block = codegen_utils->CreateBasicBlock(
+      "done_block", pipeline_func);
+  llvm::BasicBlock* error_block = codegen_utils->CreateBasicBlock(
+      "error_block", pipeline_func);
+
+  gen_info_.llvm_main_func = pipeline_func;
+  gen_info_.llvm_error_block = error_block;
+
+  // External functions
+  llvm::Function* llvm_ExecTableScanFetch =
+      codegen_utils->GetOrRegisterExternalFunction(ExecTableScanFetch,
+                                                   "ExecTableScanFetch");
+  llvm::Function* llvm_ResetExprContext =
+      codegen_utils->GetOrRegisterExternalFunction(ResetExprContext,
+                                                   "ResetExprContext");
+
+  // Call the generated advance_aggregates of this manager directly, if any.
+  llvm::Function* llvm_advance_aggregates = nullptr;
+  AdvanceAggregatesCodegen* advance_aggregates_gen =
+      static_cast<AdvanceAggregatesCodegen*>(
+          aggstate_->AdvanceAggregates_gen_info.code_generator);
+  if (nullptr != advance_aggregates_gen &&
+      advance_aggregates_gen->IsGenerated()) {
+    llvm_advance_aggregates = codegen_utils->module()->getFunction(
+        advance_aggregates_gen->GetUniqueFuncName());
+  }
+  if (nullptr == llvm_advance_aggregates) {
+    llvm_advance_aggregates = codegen_utils->GetOrRegisterExternalFunction(
+        advance_aggregates, "advance_aggregates");
+  }
+
+  // Function arguments to agg_scan_pipeline
+  llvm::Value* llvm_aggstate_arg = ArgumentByPosition(pipeline_func, 0);
+  llvm::Value* llvm_pergroup_arg = ArgumentByPosition(pipeline_func, 1);
+  llvm::Value* llvm_mem_manager_arg = ArgumentByPosition(pipeline_func, 2);
+
+  // Generation-time constants
+  ExprContext* scan_econtext = scan_state_->ps.ps_ExprContext;
+  ProjectionInfo* proj_info = scan_state_->ps.ps_ProjInfo;
+  bool reset_scan_econtext = NIL != scan_state_->ps.qual ||
+      nullptr != proj_info;
+  llvm::Value* llvm_scan_econtext = codegen_utils->GetConstant(scan_econtext);
+  llvm::Value* llvm_tmpcontext = codegen_utils->GetConstant(
+      aggstate_->tmpcontext);
+
+  // entry block
+  // ----------
+  irb->SetInsertPoint(entry_block);
+
+#ifdef CODEGEN_DEBUG
+  codegen_utils->CreateElog(DEBUG1, "Codegen'ed agg_scan_pipeline called!");
+#endif
+
+  irb->CreateBr(fetch_block);
+
+  // fetch block
+  // ----------
+  // slot = ExecTableScanFetch(scan_state);
+  // if (slot == NULL) return true;
+  irb->SetInsertPoint(fetch_block);
+  llvm::Value* llvm_slot = irb->CreateCall(llvm_ExecTableScanFetch, {
+      codegen_utils->GetConstant(
+          reinterpret_cast<TableScanState*>(scan_state_))});
+  irb->CreateCondBr(
+      irb->CreateIsNull(llvm_slot),
+      done_block /* true */,
+      qual_block /* false */);
+
+  // qual block
+  // ----------
+  // econtext->ecxt_scantuple = slot;
+  irb->SetInsertPoint(qual_block);
+  irb->CreateStore(llvm_slot, codegen_utils->GetConstant(
+      &scan_econtext->ecxt_scantuple));
+  if (!GenerateQuals(codegen_utils, advance_block, qual_fail_block)) {
+    return false;
+  }
+
+  // advance block
+  // ----------
+  // tmpcontext->ecxt_outertuple = projInfo ? ExecProject(projInfo) : slot;
+  // advance_aggregates(aggstate, pergroup, mem_manager);
+  irb->SetInsertPoint(advance_block);
+  llvm::Value* llvm_outer_slot = llvm_slot;
+  if (nullptr != proj_info) {
+    llvm::Function* llvm_ExecProject =
+        codegen_utils->GetOrRegisterExternalFunction(ExecProject,
+                                                     "ExecProject");
+    llvm_outer_slot = irb->CreateCall(llvm_ExecProject, {
+        codegen_utils->GetConstant(proj_info),
+        codegen_utils->GetConstant<ExprDoneCond *>(nullptr)});
+  }
+  irb->CreateStore(llvm_outer_slot, codegen_utils->GetConstant(
+      &aggstate_->tmpcontext->ecxt_outertuple));
+  irb->CreateCall(llvm_advance_aggregates, {
+      llvm_aggstate_arg, llvm_pergroup_arg, llvm_mem_manager_arg});
+  // Reset per-input-tuple context after each tuple
+  irb->CreateCall(llvm_ResetExprContext, {llvm_tmpcontext});
+  if (reset_scan_econtext) {
+    irb->CreateCall(llvm_ResetExprContext, {llvm_scan_econtext});
+  }
+  irb->CreateBr(fetch_block);
+
+  // qual fail block
+  // ----------
+  // Tuple fails qual, so free per-tuple memory and try again.
+  irb->SetInsertPoint(qual_fail_block);
+  irb->CreateCall(llvm_ResetExprContext, {llvm_scan_econtext});
+  irb->CreateBr(fetch_block);
+
+  // done block
+  // ----------
+  irb->SetInsertPoint(done_block);
+  irb->CreateRet(codegen_utils->GetConstant<bool>(true));
+
+  // error block
+  // ----------
+  // We error out during the execution of built-in function.
+  irb->SetInsertPoint(error_block);
+  irb->CreateRet(codegen_utils->GetConstant<bool>(false));
+
+  // The expression trees allocate their temporaries where they generate
+  // code, i.e. inside the loop. Hoist them to the entry block so that the
+  // stack does not grow with every tuple.
+  llvm::Instruction* entry_terminator = entry_block->getTerminator();
+  for (llvm::BasicBlock& block : *pipeline_func) {
+    if (&block == entry_block) {
+      continue;
+    }
+    for (auto it = block.begin(); it != block.end();) {
+      llvm::AllocaInst* llvm_alloca = llvm::dyn_cast<llvm::AllocaInst>(&*it++);
+      if (nullptr != llvm_alloca &&
+          llvm::isa<llvm::Constant>(llvm_alloca->getArraySize())) {
+        llvm_alloca->moveBefore(entry_terminator);
+      }
+    }
+  }
+
+  return true;
+}
+
+bool AggScanPipelineCodegen::GenerateCodeInternal(
+    GpCodegenUtils* codegen_utils) {
+  bool isGenerated = GenerateAggScanPipeline(codegen_utils);
+
+  if (isGenerated) {
+    elog(DEBUG1, "agg_scan_pipeline was generated successfully!");
+    return true;
+  } else {
+    elog(DEBUG1, "agg_scan_pipeline generation failed!");
+    return false;
+  }
+}
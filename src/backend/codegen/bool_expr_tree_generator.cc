@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    bool_expr_tree_generator.cc
+//
+//  @doc:
+//    Object that generate code for boolean (AND, OR, NOT) expression.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "codegen/bool_expr_tree_generator.h"
+#include "codegen/expr_tree_generator.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+#include "llvm/IR/IRBuilder.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "nodes/execnodes.h"
+#include "nodes/nodes.h"
+#include "nodes/pg_list.h"
+#include "nodes/primnodes.h"
+#include "utils/elog.h"
+}
+
+namespace llvm {
+class Value;
+}  // namespace llvm
+
+using gpcodegen::BoolExprTreeGenerator;
+using gpcodegen::ExprTreeGenerator;
+using gpcodegen::GpCodegenUtils;
+
+bool BoolExprTreeGenerator::VerifyAndCreateExprTree(
+    const ExprState* expr_state,
+    ExprTreeGeneratorInfo* gen_info,
+    std::unique_ptr<ExprTreeGenerator>* expr_tree) {
+  assert(nullptr != expr_state &&
+         nullptr != expr_state->expr &&
+         T_BoolExpr == nodeTag(expr_state->expr) &&
+         nullptr != expr_tree);
+
+  expr_tree->reset(nullptr);
+  List *arguments = reinterpret_cast<const BoolExprState*>(expr_state)->args;
+  assert(nullptr != arguments);
+
+  ListCell *arg = nullptr;
+  std::vector<std::unique_ptr<ExprTreeGenerator>> expr_tree_arguments;
+  foreach(arg, arguments) {
+    ExprState *argstate = reinterpret_cast<ExprState*>(lfirst(arg));
+    assert(nullptr != argstate);
+    std::unique_ptr<ExprTreeGenerator> arg_tree(nullptr);
+    if (!ExprTreeGenerator::VerifyAndCreateExprTree(argstate,
+                                                    gen_info,
+                                                    &arg_tree)) {
+      return false;
+    }
+    assert(nullptr != arg_tree);
+    expr_tree_arguments.push_back(std::move(arg_tree));
+  }
+
+  expr_tree->reset(new BoolExprTreeGenerator(expr_state,
+                                             std::move(expr_tree_arguments)));
+  return true;
+}
+
+BoolExprTreeGenerator::BoolExprTreeGenerator(
+    const ExprState* expr_state,
+    std::vector<
+        std::unique_ptr<
+            ExprTreeGenerator>>&& arguments) :  // NOLINT(build/c++11)
+    ExprTreeGenerator(expr_state, ExprTreeNodeType::kBoolExpr),
+    arguments_(std::move(arguments)) {
+}
+
+bool BoolExprTreeGenerator::GenerateCode(GpCodegenUtils* codegen_utils,
+                                         const ExprTreeGeneratorInfo& gen_info,
+                                         llvm::Value** llvm_out_value,
+                                         llvm::Value* const llvm_isnull_ptr) {
+  assert(nullptr != llvm_out_value);
+  assert(nullptr != llvm_isnull_ptr);
+  *llvm_out_value = nullptr;
+  BoolExpr* bool_expr = reinterpret_cast<BoolExpr*>(expr_state()->expr);
+  auto irb = codegen_utils->ir_builder();
+
+  if (NOT_EXPR == bool_expr->boolop) {
+    assert(1 == arguments_.size());
+    // As in ExecEvalNot, a NULL argument is cascaded back to the caller.
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isnull_ptr);
+    llvm::Value* llvm_arg = nullptr;
+    if (!arguments_[0]->GenerateCode(codegen_utils,
+                                     gen_info,
+                                     &llvm_arg,
+                                     llvm_isnull_ptr)) {
+      return false;
+    }
+    *llvm_out_value = codegen_utils->CreateCppTypeToDatumCast(
+        irb->CreateNot(
+            codegen_utils->CreateDatumToCppTypeCast<bool>(llvm_arg)));
+    return true;
+  }
+
+  if (AND_EXPR != bool_expr->boolop &&
+      OR_EXPR != bool_expr->boolop) {
+    elog(DEBUG1, "Unsupported boolean expression %d", bool_expr->boolop);
+    return false;
+  }
+  bool is_and = (AND_EXPR == bool_expr->boolop);
+
+  // AND stops at the first non-NULL false argument, and OR at the first
+  // non-NULL true argument. Otherwise, the result is NULL if any argument
+  // was NULL.
+  llvm::BasicBlock* short_circuit_block = codegen_utils->CreateBasicBlock(
+      is_and ? "and_false_block" : "or_true_block", gen_info.llvm_main_func);
+  llvm::BasicBlock* end_block = codegen_utils->CreateBasicBlock(
+      is_and ? "and_end_block" : "or_end_block", gen_info.llvm_main_func);
+
+  llvm::Value* llvm_any_null_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "any_null");
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_any_null_ptr);
+
+  for (size_t i = 0; i < arguments_.size(); ++i) {
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "bool_expr_next_arg_" + std::to_string(i), gen_info.llvm_main_func);
+
+    llvm::Value* llvm_arg_isnull_ptr = irb->CreateAlloca(
+        codegen_utils->GetType<bool>(), nullptr, "isNull");
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                     llvm_arg_isnull_ptr);
+    llvm::Value* llvm_arg = nullptr;
+    if (!arguments_[i]->GenerateCode(codegen_utils,
+                                     gen_info,
+                                     &llvm_arg,
+                                     llvm_arg_isnull_ptr)) {
+      return false;
+    }
+    llvm::Value* llvm_arg_isnull = irb->CreateLoad(llvm_arg_isnull_ptr);
+    irb->CreateStore(
+        irb->CreateOr(irb->CreateLoad(llvm_any_null_ptr), llvm_arg_isnull),
+        llvm_any_null_ptr);
+
+    llvm::Value* llvm_arg_value =
+        codegen_utils->CreateDatumToCppTypeCast<bool>(llvm_arg);
+    llvm::Value* llvm_decides = is_and ?
+        irb->CreateNot(llvm_arg_value) : llvm_arg_value;
+    irb->CreateCondBr(
+        irb->CreateAnd(irb->CreateNot(llvm_arg_isnull), llvm_decides),
+        short_circuit_block /* true */,
+        next_block /* false */);
+
+    irb->SetInsertPoint(next_block);
+  }
+
+  // None of the arguments decided the result.
+  llvm::Value* llvm_any_null = irb->CreateLoad(llvm_any_null_ptr);
+  irb->CreateStore(llvm_any_null, llvm_isnull_ptr);
+  llvm::Value* llvm_no_short_circuit_value = is_and ?
+      irb->CreateNot(llvm_any_null) : codegen_utils->GetConstant<bool>(false);
+  llvm::BasicBlock* no_short_circuit_block = irb->GetInsertBlock();
+  irb->CreateBr(end_block);
+
+  irb->SetInsertPoint(short_circuit_block);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isnull_ptr);
+  irb->CreateBr(end_block);
+
+  irb->SetInsertPoint(end_block);
+  llvm::PHINode* llvm_result = irb->CreatePHI(
+      codegen_utils->GetType<bool>(), 2);
+  llvm_result->addIncoming(llvm_no_short_circuit_value,
+                           no_short_circuit_block);
+  llvm_result->addIncoming(codegen_utils->GetConstant<bool>(!is_and),
+                           short_circuit_block);
+
+  *llvm_out_value = codegen_utils->CreateCppTypeToDatumCast(llvm_result);
+  return true;
+}
@@ -0,0 +1,189 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    calc_hash_value_codegen.cc
+//
+//  @doc:
+//    Generates code for calc_hash_value function.
+//
+//---------------------------------------------------------------------------
+#include "codegen/calc_hash_value_codegen.h"
+#include "codegen/op_expr_tree_generator.h"
+#include "codegen/pg_func_generator_interface.h"
+
+#include "codegen/utils/gp_codegen_utils.h"
+#include "codegen/utils/utility.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "access/hash.h"
+#include "executor/execHHashagg.h"
+#include "nodes/execnodes.h"
+#include "utils/elog.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+using gpcodegen::CalcHashValueCodegen;
+
+constexpr char CalcHashValueCodegen::kCalcHashValuePrefix[];
+
+CalcHashValueCodegen::CalcHashValueCodegen(
+    CodegenManager* manager,
+    CalcHashValueFn regular_func_ptr,
+    CalcHashValueFn* ptr_to_regular_func_ptr,
+    AggState *aggstate)
+: BaseCodegen(manager,
+              kCalcHashValuePrefix,
+              regular_func_ptr,
+              ptr_to_regular_func_ptr),
+              aggstate_(aggstate) {
+}
+
+bool CalcHashValueCodegen::GenerateCalcHashValue(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+
+  assert(NULL != codegen_utils);
+  if (nullptr == aggstate_ ||
+      nullptr == aggstate_->hashfunctions) {
+    return false;
+  }
+
+  Agg *agg = reinterpret_cast<Agg*>(aggstate_->ss.ps.plan);
+  if (agg->numCols <= 0) {
+    return false;
+  }
+
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Function* calc_hash_value_func = CreateFunction<CalcHashValueFn>(
+      codegen_utils, GetUniqueFuncName());
+
+  // BasicBlock of function entry.
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry_block", calc_hash_value_func);
+  llvm::BasicBlock* error_block = codegen_utils->CreateBasicBlock(
+      "error_block", calc_hash_value_func);
+
+  // External functions
+  llvm::Function* llvm_slot_getattr =
+      codegen_utils->GetOrRegisterExternalFunction(slot_getattr_regular,
+                                                   "slot_getattr_regular");
+  llvm::Function* llvm_hash_any =
+      codegen_utils->GetOrRegisterExternalFunction(hash_any, "hash_any");
+
+  // Function arguments to calc_hash_value
+  llvm::Value* llvm_inputslot_arg = ArgumentByPosition(
+      calc_hash_value_func, 1);
+
+  // entry block
+  // ----------
+  irb->SetInsertPoint(entry_block);
+
+#ifdef CODEGEN_DEBUG
+  codegen_utils->CreateElog(DEBUG1, "Codegen'ed calc_hash_value called!");
+#endif
+
+  // The hash values of the grouping columns are kept on the stack, instead
+  // of hashtable->hashkey_buf.
+  llvm::Value* llvm_hashkey_buf = irb->CreateAlloca(
+      codegen_utils->GetType<HashKey>(),
+      codegen_utils->GetConstant<int32_t>(agg->numCols),
+      "hashkey_buf");
+  llvm::Value* llvm_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "isNull");
+
+  for (int i = 0; i < agg->numCols; i++) {
+    Oid hashfn = aggstate_->hashfunctions[i].fn_oid;
+    gpcodegen::PGFuncGeneratorInterface* pg_func_gen =
+        gpcodegen::OpExprTreeGenerator::GetPGFuncGenerator(hashfn);
+    if (nullptr == pg_func_gen) {
+      elog(DEBUG1, "We do not support hash function with oid = %d", hashfn);
+      return false;
+    }
+
+    llvm::BasicBlock* null_block = codegen_utils->CreateBasicBlock(
+        "null_block_col" + std::to_string(i), calc_hash_value_func);
+    llvm::BasicBlock* hash_block = codegen_utils->CreateBasicBlock(
+        "hash_block_col" + std::to_string(i), calc_hash_value_func);
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "next_block_col" + std::to_string(i), calc_hash_value_func);
+
+    llvm::Value* llvm_hashkey_ptr = irb->CreateInBoundsGEP(
+        codegen_utils->GetType<HashKey>(),
+        llvm_hashkey_buf,
+        codegen_utils->GetConstant(i));
+
+    // value = slot_getattr(inputslot, att, &isnull);
+    llvm::Value* llvm_value = irb->CreateCall(llvm_slot_getattr, {
+        llvm_inputslot_arg,
+        codegen_utils->GetConstant<int32_t>(agg->grpColIdx[i]),
+        llvm_isnull_ptr});
+    irb->CreateCondBr(irb->CreateLoad(llvm_isnull_ptr),
+                      null_block /* true */,
+                      hash_block /* false */);
+
+    // null block
+    // ----------
+    // treat nulls as having hash key 0xdeadbeef
+    irb->SetInsertPoint(null_block);
+    irb->CreateStore(codegen_utils->GetConstant<HashKey>(0xdeadbeef),
+                     llvm_hashkey_ptr);
+    irb->CreateBr(next_block);
+
+    // hash block
+    // ----------
+    irb->SetInsertPoint(hash_block);
+    gpcodegen::PGFuncGeneratorInfo pg_func_info(
+        calc_hash_value_func,
+        error_block,
+        {llvm_value},
+        {codegen_utils->GetConstant<bool>(false)});
+    llvm::Value* llvm_hkey = nullptr;
+    if (!pg_func_gen->GenerateCode(codegen_utils, pg_func_info, &llvm_hkey,
+                                   llvm_isnull_ptr)) {
+      elog(DEBUG1, "Hash function with oid = %d was not generated "
+           "successfully!", hashfn);
+      return false;
+    }
+    irb->CreateStore(llvm_hkey, llvm_hashkey_ptr);
+    irb->CreateBr(next_block);
+
+    irb->SetInsertPoint(next_block);
+  }
+
+  // return hash_any(hashkey_buf, numCols * sizeof(HashKey));
+  llvm::Value* llvm_hash = irb->CreateCall(llvm_hash_any, {
+      irb->CreateBitCast(llvm_hashkey_buf,
+                         codegen_utils->GetType<const unsigned char*>()),
+      codegen_utils->GetConstant<int32_t>(agg->numCols * sizeof(HashKey))});
+  irb->CreateRet(
+      codegen_utils->CreateDatumToCppTypeCast<uint32_t>(llvm_hash));
+
+  // Error block
+  // ---------------
+  // The hash functions don't report errors, so this is never reached.
+  irb->SetInsertPoint(error_block);
+  irb->CreateRet(codegen_utils->GetConstant<uint32_t>(0));
+
+  return true;
+}
+
+bool CalcHashValueCodegen::GenerateCodeInternal(
+    GpCodegenUtils* codegen_utils) {
+  bool isGenerated = GenerateCalcHashValue(codegen_utils);
+
+  if (isGenerated) {
+    elog(DEBUG1, "calc_hash_value was generated successfully!");
+    return true;
+  } else {
+    elog(DEBUG1, "calc_hash_value generation failed!");
+    return false;
+  }
+}
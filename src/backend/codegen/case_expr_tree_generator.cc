@@ -0,0 +1,177 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    case_expr_tree_generator.cc
+//
+//  @doc:
+//    Object that generate code for CASE expression.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "codegen/case_expr_tree_generator.h"
+#include "codegen/expr_tree_generator.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+#include "llvm/IR/IRBuilder.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "nodes/execnodes.h"
+#include "nodes/nodes.h"
+#include "nodes/pg_list.h"
+#include "nodes/primnodes.h"
+#include "utils/elog.h"
+}
+
+namespace llvm {
+class Value;
+}  // namespace llvm
+
+using gpcodegen::CaseExprTreeGenerator;
+using gpcodegen::ExprTreeGenerator;
+using gpcodegen::GpCodegenUtils;
+
+bool CaseExprTreeGenerator::VerifyAndCreateExprTree(
+    const ExprState* expr_state,
+    ExprTreeGeneratorInfo* gen_info,
+    std::unique_ptr<ExprTreeGenerator>* expr_tree) {
+  assert(nullptr != expr_state &&
+         nullptr != expr_state->expr &&
+         T_CaseExpr == nodeTag(expr_state->expr) &&
+         nullptr != expr_tree);
+
+  expr_tree->reset(nullptr);
+  const CaseExprState* case_state =
+      reinterpret_cast<const CaseExprState*>(expr_state);
+  if (nullptr != case_state->arg) {
+    elog(DEBUG1, "Unsupported CASE expression with a test expression");
+    return false;
+  }
+
+  ListCell *clause = nullptr;
+  std::vector<std::pair<std::unique_ptr<ExprTreeGenerator>,
+                        std::unique_ptr<ExprTreeGenerator>>> when_clauses;
+  foreach(clause, case_state->args) {
+    CaseWhenState *wclause = reinterpret_cast<CaseWhenState*>(lfirst(clause));
+    assert(nullptr != wclause);
+    std::unique_ptr<ExprTreeGenerator> expr(nullptr);
+    std::unique_ptr<ExprTreeGenerator> result(nullptr);
+    if (!ExprTreeGenerator::VerifyAndCreateExprTree(wclause->expr,
+                                                    gen_info,
+                                                    &expr) ||
+        !ExprTreeGenerator::VerifyAndCreateExprTree(wclause->result,
+                                                    gen_info,
+                                                    &result)) {
+      return false;
+    }
+    when_clauses.emplace_back(std::move(expr), std::move(result));
+  }
+
+  std::unique_ptr<ExprTreeGenerator> defresult(nullptr);
+  if (nullptr != case_state->defresult &&
+      !ExprTreeGenerator::VerifyAndCreateExprTree(case_state->defresult,
+                                                  gen_info,
+                                                  &defresult)) {
+    return false;
+  }
+
+  expr_tree->reset(new CaseExprTreeGenerator(expr_state,
+                                             std::move(when_clauses),
+                                             std::move(defresult)));
+  return true;
+}
+
+CaseExprTreeGenerator::CaseExprTreeGenerator(
+    const ExprState* expr_state,
+    std::vector<
+        std::pair<std::unique_ptr<ExprTreeGenerator>,
+                  std::unique_ptr<ExprTreeGenerator>>>&&
+        when_clauses,  // NOLINT(build/c++11)
+    std::unique_ptr<ExprTreeGenerator>&& defresult) :  // NOLINT(build/c++11)
+    ExprTreeGenerator(expr_state, ExprTreeNodeType::kCase),
+    when_clauses_(std::move(when_clauses)),
+    defresult_(std::move(defresult)) {
+}
+
+bool CaseExprTreeGenerator::GenerateCode(GpCodegenUtils* codegen_utils,
+                                         const ExprTreeGeneratorInfo& gen_info,
+                                         llvm::Value** llvm_out_value,
+                                         llvm::Value* const llvm_isnull_ptr) {
+  assert(nullptr != llvm_out_value);
+  assert(nullptr != llvm_isnull_ptr);
+  *llvm_out_value = nullptr;
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::BasicBlock* end_block = codegen_utils->CreateBasicBlock(
+      "case_end_block", gen_info.llvm_main_func);
+  llvm::Value* llvm_result_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<Datum>(), nullptr, "case_result");
+
+  // Evaluate the WHEN clauses in turn; the result of the first one that is
+  // true is returned. A NULL condition is not considered true.
+  for (size_t i = 0; i < when_clauses_.size(); ++i) {
+    llvm::BasicBlock* then_block = codegen_utils->CreateBasicBlock(
+        "case_then_" + std::to_string(i), gen_info.llvm_main_func);
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "case_next_when_" + std::to_string(i), gen_info.llvm_main_func);
+
+    llvm::Value* llvm_cond_isnull_ptr = irb->CreateAlloca(
+        codegen_utils->GetType<bool>(), nullptr, "isNull");
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                     llvm_cond_isnull_ptr);
+    llvm::Value* llvm_cond = nullptr;
+    if (!when_clauses_[i].first->GenerateCode(codegen_utils,
+                                              gen_info,
+                                              &llvm_cond,
+                                              llvm_cond_isnull_ptr)) {
+      return false;
+    }
+    irb->CreateCondBr(
+        irb->CreateAnd(
+            codegen_utils->CreateDatumToCppTypeCast<bool>(llvm_cond),
+            irb->CreateNot(irb->CreateLoad(llvm_cond_isnull_ptr))),
+        then_block /* true */,
+        next_block /* false */);
+
+    irb->SetInsertPoint(then_block);
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isnull_ptr);
+    llvm::Value* llvm_result = nullptr;
+    if (!when_clauses_[i].second->GenerateCode(codegen_utils,
+                                               gen_info,
+                                               &llvm_result,
+                                               llvm_isnull_ptr)) {
+      return false;
+    }
+    irb->CreateStore(llvm_result, llvm_result_ptr);
+    irb->CreateBr(end_block);
+
+    irb->SetInsertPoint(next_block);
+  }
+
+  if (nullptr != defresult_) {
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isnull_ptr);
+    llvm::Value* llvm_defresult = nullptr;
+    if (!defresult_->GenerateCode(codegen_utils,
+                                  gen_info,
+                                  &llvm_defresult,
+                                  llvm_isnull_ptr)) {
+      return false;
+    }
+    irb->CreateStore(llvm_defresult, llvm_result_ptr);
+  } else {
+    irb->CreateStore(codegen_utils->GetConstant<bool>(true), llvm_isnull_ptr);
+    irb->CreateStore(codegen_utils->GetConstant<Datum>(0), llvm_result_ptr);
+  }
+  irb->CreateBr(end_block);
+
+  irb->SetInsertPoint(end_block);
+  *llvm_out_value = irb->CreateLoad(llvm_result_ptr);
+  return true;
+}
@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    coalesce_expr_tree_generator.cc
+//
+//  @doc:
+//    Object that generate code for COALESCE expression.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "codegen/coalesce_expr_tree_generator.h"
+#include "codegen/expr_tree_generator.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+#include "llvm/IR/IRBuilder.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "nodes/execnodes.h"
+#include "nodes/nodes.h"
+#include "nodes/pg_list.h"
+#include "nodes/primnodes.h"
+}
+
+namespace llvm {
+class Value;
+}  // namespace llvm
+
+using gpcodegen::CoalesceExprTreeGenerator;
+using gpcodegen::ExprTreeGenerator;
+using gpcodegen::GpCodegenUtils;
+
+bool CoalesceExprTreeGenerator::VerifyAndCreateExprTree(
+    const ExprState* expr_state,
+    ExprTreeGeneratorInfo* gen_info,
+    std::unique_ptr<ExprTreeGenerator>* expr_tree) {
+  assert(nullptr != expr_state &&
+         nullptr != expr_state->expr &&
+         T_CoalesceExpr == nodeTag(expr_state->expr) &&
+         nullptr != expr_tree);
+
+  expr_tree->reset(nullptr);
+  List *arguments =
+      reinterpret_cast<const CoalesceExprState*>(expr_state)->args;
+
+  ListCell *arg = nullptr;
+  std::vector<std::unique_ptr<ExprTreeGenerator>> expr_tree_arguments;
+  foreach(arg, arguments) {
+    ExprState *argstate = reinterpret_cast<ExprState*>(lfirst(arg));
+    assert(nullptr != argstate);
+    std::unique_ptr<ExprTreeGenerator> arg_tree(nullptr);
+    if (!ExprTreeGenerator::VerifyAndCreateExprTree(argstate,
+                                                    gen_info,
+                                                    &arg_tree)) {
+      return false;
+    }
+    assert(nullptr != arg_tree);
+    expr_tree_arguments.push_back(std::move(arg_tree));
+  }
+
+  expr_tree->reset(new CoalesceExprTreeGenerator(
+      expr_state, std::move(expr_tree_arguments)));
+  return true;
+}
+
+CoalesceExprTreeGenerator::CoalesceExprTreeGenerator(
+    const ExprState* expr_state,
+    std::vector<
+        std::unique_ptr<
+            ExprTreeGenerator>>&& arguments) :  // NOLINT(build/c++11)
+    ExprTreeGenerator(expr_state, ExprTreeNodeType::kCoalesce),
+    arguments_(std::move(arguments)) {
+}
+
+bool CoalesceExprTreeGenerator::GenerateCode(
+    GpCodegenUtils* codegen_utils,
+    const ExprTreeGeneratorInfo& gen_info,
+    llvm::Value** llvm_out_value,
+    llvm::Value* const llvm_isnull_ptr) {
+  assert(nullptr != llvm_out_value);
+  assert(nullptr != llvm_isnull_ptr);
+  *llvm_out_value = nullptr;
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::BasicBlock* end_block = codegen_utils->CreateBasicBlock(
+      "coalesce_end_block", gen_info.llvm_main_func);
+  llvm::Value* llvm_result_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<Datum>(), nullptr, "coalesce_result");
+
+  // Return the first argument that is not NULL.
+  for (size_t i = 0; i < arguments_.size(); ++i) {
+    llvm::BasicBlock* not_null_block = codegen_utils->CreateBasicBlock(
+        "coalesce_not_null_arg_" + std::to_string(i), gen_info.llvm_main_func);
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "coalesce_next_arg_" + std::to_string(i), gen_info.llvm_main_func);
+
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isnull_ptr);
+    llvm::Value* llvm_arg = nullptr;
+    if (!arguments_[i]->GenerateCode(codegen_utils,
+                                     gen_info,
+                                     &llvm_arg,
+                                     llvm_isnull_ptr)) {
+      return false;
+    }
+    irb->CreateCondBr(irb->CreateLoad(llvm_isnull_ptr),
+                      next_block /* true */,
+                      not_null_block /* false */);
+
+    irb->SetInsertPoint(not_null_block);
+    irb->CreateStore(llvm_arg, llvm_result_ptr);
+    irb->CreateBr(end_block);
+
+    irb->SetInsertPoint(next_block);
+  }
+
+  // Else return NULL
+  irb->CreateStore(codegen_utils->GetConstant<bool>(true), llvm_isnull_ptr);
+  irb->CreateStore(codegen_utils->GetConstant<Datum>(0), llvm_result_ptr);
+  irb->CreateBr(end_block);
+
+  irb->SetInsertPoint(end_block);
+  *llvm_out_value = irb->CreateLoad(llvm_result_ptr);
+  return true;
+}
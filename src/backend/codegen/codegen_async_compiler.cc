@@ -0,0 +1,214 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    codegen_async_compiler.cc
+//
+//  @doc:
+//    Implementation of the background compiler of generated modules
+//
+//---------------------------------------------------------------------------
+#include "codegen/codegen_async_compiler.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <signal.h>
+#include <algorithm>
+#include <string>
+#include <system_error>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "codegen/codegen_manager.h"
+#include "codegen/codegen_wrapper.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "storage/ipc.h"
+#include "utils/elog.h"
+}
+
+using gpcodegen::CodegenAsyncCompiler;
+using gpcodegen::CodegenCache;
+using gpcodegen::CodegenManager;
+using gpcodegen::GpCodegenUtils;
+
+struct CodegenAsyncCompiler::Job {
+  // nullptr once the manager cancelled the job
+  CodegenManager* manager;
+  GpCodegenUtils* codegen_utils;
+  // Owns codegen_utils if the manager was destroyed during compilation
+  std::unique_ptr<GpCodegenUtils> orphaned_codegen_utils;
+  CodegenCache::Settings settings;
+  // Transaction nesting level of the query that submitted the job
+  int nest_level;
+  // Messages to log once the backend gets the job back
+  std::vector<std::string> messages;
+  bool is_compiled;
+};
+
+namespace {
+
+void ShutdownAsyncCompiler(int code, Datum arg) {
+  CodegenAsyncCompiler::GetInstance()->Shutdown();
+}
+
+}  // namespace
+
+CodegenAsyncCompiler* CodegenAsyncCompiler::GetInstance() {
+  // Lives as long as the backend, as the thread may outlive any owner
+  static CodegenAsyncCompiler* instance = new CodegenAsyncCompiler();
+  return instance;
+}
+
+bool CodegenAsyncCompiler::Start() {
+  if (is_shutting_down_) {
+    return false;
+  }
+  if (is_started_) {
+    return true;
+  }
+
+  // The thread inherits the signal mask, so that signals are only ever
+  // handled by the backend.
+  sigset_t all_signals;
+  sigset_t old_signals;
+  sigfillset(&all_signals);
+  pthread_sigmask(SIG_SETMASK, &all_signals, &old_signals);
+  try {
+    std::thread(&CodegenAsyncCompiler::Run, this).detach();
+    is_started_ = true;
+  } catch (const std::system_error& e) {
+    elog(DEBUG1, "could not start the codegen compiler thread: %s", e.what());
+  }
+  pthread_sigmask(SIG_SETMASK, &old_signals, nullptr);
+
+  if (is_started_) {
+    on_proc_exit(ShutdownAsyncCompiler, 0);
+  }
+  return is_started_;
+}
+
+void CodegenAsyncCompiler::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cond_.wait(lock, [this] {
+      return is_shutting_down_ || !queued_jobs_.empty();
+    });
+    if (is_shutting_down_) {
+      return;
+    }
+
+    Job* job = queued_jobs_.front();
+    queued_jobs_.pop_front();
+    compiling_job_ = job;
+    lock.unlock();
+
+    job->settings.messages = &job->messages;
+    job->is_compiled = CodegenManager::CompileModule(job->codegen_utils,
+                                                     job->settings);
+
+    lock.lock();
+    compiling_job_ = nullptr;
+    if (nullptr == job->manager) {
+      lock.unlock();
+      delete job;
+      lock.lock();
+    } else {
+      compiled_jobs_.push_back(job);
+      CodegenAsyncCompileDone = true;
+    }
+    cond_.notify_all();
+  }
+}
+
+CodegenAsyncCompiler::Job* CodegenAsyncCompiler::Submit(
+    CodegenManager* manager,
+    GpCodegenUtils* codegen_utils,
+    const CodegenCache::Settings& settings,
+    int nest_level) {
+  assert(nullptr != manager);
+  assert(nullptr != codegen_utils);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!Start()) {
+    return nullptr;
+  }
+
+  Job* job = new Job{manager, codegen_utils, nullptr, settings, nest_level,
+                     {}, false};
+  queued_jobs_.push_back(job);
+  cond_.notify_all();
+  return job;
+}
+
+void CodegenAsyncCompiler::Cancel(
+    Job* job, std::unique_ptr<GpCodegenUtils>* codegen_utils) {
+  assert(nullptr != job);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (job == compiling_job_) {
+    job->manager = nullptr;
+    job->orphaned_codegen_utils = std::move(*codegen_utils);
+    return;
+  }
+
+  auto queued = std::find(queued_jobs_.begin(), queued_jobs_.end(), job);
+  if (queued != queued_jobs_.end()) {
+    queued_jobs_.erase(queued);
+  } else {
+    auto compiled = std::find(compiled_jobs_.begin(), compiled_jobs_.end(),
+                              job);
+    assert(compiled != compiled_jobs_.end());
+    compiled_jobs_.erase(compiled);
+  }
+  delete job;
+}
+
+void CodegenAsyncCompiler::AbortJobs(int nest_level) {
+  std::vector<CodegenManager*> managers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto collect = [&managers, nest_level](Job* job) {
+      if (nullptr != job && nullptr != job->manager &&
+          job->nest_level >= nest_level) {
+        managers.push_back(job->manager);
+      }
+    };
+    std::for_each(queued_jobs_.begin(), queued_jobs_.end(), collect);
+    collect(compiling_job_);
+    std::for_each(compiled_jobs_.begin(), compiled_jobs_.end(), collect);
+  }
+
+  // Cancel() takes the lock again, and copes with a job that moved on to
+  // another state in the meantime.
+  for (CodegenManager* manager : managers) {
+    manager->AbandonAsyncCompile();
+  }
+}
+
+void CodegenAsyncCompiler::InstallCompiledFunctions() {
+  std::vector<Job*> jobs;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs.swap(compiled_jobs_);
+    CodegenAsyncCompileDone = false;
+  }
+
+  for (Job* job : jobs) {
+    for (const std::string& message : job->messages) {
+      elog(DEBUG1, "%s", message.c_str());
+    }
+    assert(nullptr != job->manager);
+    job->manager->FinishAsyncCompile(job->is_compiled);
+    delete job;
+  }
+}
+
+void CodegenAsyncCompiler::Shutdown() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  is_shutting_down_ = true;
+  cond_.notify_all();
+  cond_.wait(lock, [this] { return nullptr == compiling_job_; });
+}
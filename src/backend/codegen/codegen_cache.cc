@@ -0,0 +1,266 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    codegen_cache.cc
+//
+//  @doc:
+//    Implementation of the cache of compiled generated modules
+//
+//---------------------------------------------------------------------------
+#include "codegen/codegen_cache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "codegen/codegen_config.h"
+
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/raw_ostream.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "utils/elog.h"
+#include "utils/guc.h"
+}
+
+using gpcodegen::CodegenCache;
+
+namespace {
+
+// Prefix of the keys given to modules as their names, and of the files
+// in codegen_cache_directory.
+constexpr char kKeyPrefix[] = "gpcodegen_";
+
+// First line of the files in codegen_cache_directory, followed by the size
+// of the IR that precedes the object.
+constexpr char kFileMagic[] = "GPCODEGEN_CACHE";
+
+}  // namespace
+
+CodegenCache* CodegenCache::GetInstance() {
+  // Lives as long as the backend
+  static CodegenCache* instance = new CodegenCache();
+  return instance;
+}
+
+CodegenCache::Settings CodegenCache::Settings::FromGUCs() {
+  return {codegen_optimization_level,
+          codegen_cache_size,
+          nullptr == codegen_cache_directory ?
+              std::string() : std::string(codegen_cache_directory),
+          nullptr};
+}
+
+bool CodegenCache::PrepareModule(llvm::Module* module,
+                                 const Settings& settings) {
+  pending_key_.clear();
+  pending_ir_.clear();
+  pending_settings_ = settings;
+
+  bool use_disk = !settings.directory.empty();
+  if (nullptr == module || (settings.size <= 0 && !use_disk)) {
+    return false;
+  }
+
+  // The module's name is made up from the plan node, and is left out of the
+  // key, so that the same code generated for another plan node is shared.
+  module->setModuleIdentifier("");
+  llvm::raw_string_ostream out(pending_ir_);
+  module->print(out, nullptr);
+
+  // Machine code also depends on the target and the optimization level
+  out << "; target " << llvm::sys::getProcessTriple()
+      << " " << llvm::sys::getHostCPUName()
+      << " opt " << settings.opt_level << "\n";
+  out.flush();
+
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx",
+                static_cast<unsigned long long>(  // NOLINT(runtime/int)
+                    std::hash<std::string>()(pending_ir_)));
+  pending_key_ = std::string(kKeyPrefix) + hash;
+  module->setModuleIdentifier(pending_key_);
+  return true;
+}
+
+std::unique_ptr<llvm::MemoryBuffer> CodegenCache::getObject(
+    const llvm::Module* module) {
+  // Auxiliary modules, or a module that wasn't prepared
+  if (pending_key_.empty() ||
+      module->getModuleIdentifier() != pending_key_) {
+    return nullptr;
+  }
+
+  auto it = index_.find(pending_key_);
+  // Keys are hashes; the IR tells hash collisions apart.
+  if (it != index_.end() && it->second->ir == pending_ir_) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    hits_++;
+    return llvm::MemoryBuffer::getMemBufferCopy(
+        it->second->object->getBuffer());
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> object = ReadFromDisk();
+  if (nullptr != object) {
+    Insert(pending_key_, pending_ir_, object->getBuffer());
+    hits_++;
+    return object;
+  }
+
+  misses_++;
+  return nullptr;
+}
+
+void CodegenCache::notifyObjectCompiled(const llvm::Module* module,
+                                        llvm::MemoryBufferRef object) {
+  if (pending_key_.empty() ||
+      module->getModuleIdentifier() != pending_key_) {
+    return;
+  }
+  Insert(pending_key_, pending_ir_, object.getBuffer());
+  WriteToDisk(object.getBuffer());
+}
+
+void CodegenCache::Clear() {
+  index_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+
+void CodegenCache::Insert(const std::string& key,
+                          const std::string& ir,
+                          llvm::StringRef object) {
+  std::size_t limit = pending_settings_.size <= 0 ? 0 :
+      static_cast<std::size_t>(pending_settings_.size) * 1024;
+  std::size_t size = ir.size() + object.size();
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    bytes_ -= it->second->ir.size() + it->second->object->getBufferSize();
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  if (size > limit) {
+    return;
+  }
+
+  while (bytes_ + size > limit) {
+    Entry& victim = entries_.back();
+    bytes_ -= victim.ir.size() + victim.object->getBufferSize();
+    index_.erase(victim.key);
+    entries_.pop_back();
+  }
+
+  entries_.emplace_front();
+  Entry& entry = entries_.front();
+  entry.key = key;
+  entry.ir = ir;
+  entry.object = llvm::MemoryBuffer::getMemBufferCopy(object);
+  index_[key] = entries_.begin();
+  bytes_ += size;
+}
+
+std::string CodegenCache::DiskPath() const {
+  if (pending_settings_.directory.empty()) {
+    return std::string();
+  }
+  return pending_settings_.directory + "/" + pending_key_ + ".o";
+}
+
+void CodegenCache::Log(const std::string& message) {
+  if (nullptr != pending_settings_.messages) {
+    pending_settings_.messages->push_back(message);
+  } else {
+    elog(DEBUG1, "%s", message.c_str());
+  }
+}
+
+bool CodegenCache::DirectoryIsPrivate() {
+  const std::string& directory = pending_settings_.directory;
+  struct stat st;
+
+  if (stat(directory.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+    Log("codegen cache directory \"" + directory + "\" does not exist");
+    return false;
+  }
+  // The files hold machine code that we link into the backend
+  if (st.st_uid != geteuid() || (st.st_mode & 0777) != 0700) {
+    Log("ignoring codegen cache directory \"" + directory +
+        "\": it must be owned by the server user and have mode 0700");
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<llvm::MemoryBuffer> CodegenCache::ReadFromDisk() {
+  std::string path = DiskPath();
+  if (path.empty() || !DirectoryIsPrivate()) {
+    return nullptr;
+  }
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> file =
+      llvm::MemoryBuffer::getFile(path);
+  if (!file) {
+    return nullptr;
+  }
+
+  llvm::StringRef contents = file.get()->getBuffer();
+  std::size_t newline = contents.find('\n');
+  unsigned long long ir_size = 0;  // NOLINT(runtime/int)
+  if (newline == llvm::StringRef::npos ||
+      !contents.startswith(kFileMagic) ||
+      contents.substr(sizeof(kFileMagic), newline - sizeof(kFileMagic))
+          .getAsInteger(10, ir_size) ||
+      contents.size() - newline - 1 < ir_size ||
+      contents.substr(newline + 1, ir_size) != pending_ir_) {
+    Log("ignoring invalid codegen cache file \"" + path + "\"");
+    return nullptr;
+  }
+
+  return llvm::MemoryBuffer::getMemBufferCopy(
+      contents.substr(newline + 1 + ir_size));
+}
+
+void CodegenCache::WriteToDisk(llvm::StringRef object) {
+  std::string path = DiskPath();
+  if (path.empty() || !DirectoryIsPrivate()) {
+    return;
+  }
+
+  // Write to a file of our own and rename it, so that other backends never
+  // see a partially written file.
+  std::string tmp_path = path + "." + std::to_string(getpid());
+  std::error_code error;
+  {
+    llvm::raw_fd_ostream out(tmp_path, error, llvm::sys::fs::F_None);
+    if (!error) {
+      out << kFileMagic << " " << pending_ir_.size() << "\n"
+          << pending_ir_ << object;
+      out.close();
+      if (out.has_error()) {
+        out.clear_error();
+        error = std::make_error_code(std::errc::io_error);
+      }
+    }
+  }
+
+  if (!error) {
+    error = llvm::sys::fs::rename(tmp_path, path);
+  }
+  if (error) {
+    Log("could not write codegen cache file \"" + path + "\": " +
+        error.message());
+    llvm::sys::fs::remove(tmp_path);
+  }
+}
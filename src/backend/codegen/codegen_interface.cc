@@ -13,12 +13,19 @@
 
 #include <string>
 
+#include "codegen/codegen_manager.h"
+
 using gpcodegen::CodegenInterface;
+using gpcodegen::CodegenManager;
 
 // Initalization of unique counter
 unsigned CodegenInterface::unique_counter_ = 0;
 
 std::string CodegenInterface::GenerateUniqueName(
+    CodegenManager* manager,
     const std::string& orig_func_name) {
+  if (nullptr != manager) {
+    return manager->GenerateUniqueFuncName(orig_func_name);
+  }
   return orig_func_name + std::to_string(unique_counter_++);
 }
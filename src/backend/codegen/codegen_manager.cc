@@ -12,11 +12,14 @@
 #include <assert.h>
 #include <iosfwd>
 #include <memory>
+#include <mutex>  // NOLINT(build/c++11)
 #include <string>
 #include <vector>
 
 #include "llvm/Support/raw_ostream.h"
 
+#include "codegen/codegen_async_compiler.h"
+#include "codegen/codegen_cache.h"
 #include "codegen/codegen_interface.h"
 #include "codegen/codegen_manager.h"
 #include "codegen/codegen_wrapper.h"
@@ -25,16 +28,31 @@
 
 extern "C" {
 #include "postgres.h"  // NOLINT(build/include)
+#include "access/xact.h"
 #include "utils/guc.h"
 }
 
 using gpcodegen::CodegenManager;
 
-CodegenManager::CodegenManager(const std::string& module_name) {
+CodegenManager::CodegenManager(const std::string& module_name)
+    : unique_counter_(0),
+      async_job_(nullptr) {
   module_name_ = module_name;
   codegen_utils_.reset(new gpcodegen::GpCodegenUtils(module_name));
 }
 
+CodegenManager::~CodegenManager() {
+  AbandonAsyncCompile();
+}
+
+void CodegenManager::AbandonAsyncCompile() {
+  if (nullptr != async_job_) {
+    gpcodegen::CodegenAsyncCompiler::GetInstance()->Cancel(async_job_,
+                                                           &codegen_utils_);
+    async_job_ = nullptr;
+  }
+}
+
 bool CodegenManager::EnrollCodeGenerator(
     CodegenFuncLifespan funcLifespan, CodegenInterface* generator) {
   // Only CodegenFuncLifespan_Parameter_Invariant is supported as of now
@@ -60,14 +78,8 @@ unsigned int CodegenManager::GenerateCode() {
   return success_count;
 }
 
-unsigned int CodegenManager::PrepareGeneratedFunctions() {
-  unsigned int success_count = 0;
-
-  // If no generator registered, just return with success count as 0
-  if (enrolled_code_generators_.empty()) {
-    return success_count;
-  }
-
+bool CodegenManager::CompileModule(GpCodegenUtils* codegen_utils,
+                                   const CodegenCache::Settings& settings) {
   STATIC_ASSERT_OPTIMIZATION_LEVEL(kNone,
                                    CODEGEN_OPTIMIZATION_LEVEL_NONE);
   STATIC_ASSERT_OPTIMIZATION_LEVEL(kLess,
@@ -77,15 +89,65 @@ unsigned int CodegenManager::PrepareGeneratedFunctions() {
   STATIC_ASSERT_OPTIMIZATION_LEVEL(kAggressive,
                                    CODEGEN_OPTIMIZATION_LEVEL_AGGRESSIVE);
 
+  // The cache keeps track of one module being compiled at a time
+  static std::mutex compile_mutex;
+  std::lock_guard<std::mutex> lock(compile_mutex);
+
+  // Let the cache supply the machine code if the same module was compiled
+  // before, e.g. by a previous execution of the query
+  gpcodegen::CodegenCache* cache = gpcodegen::CodegenCache::GetInstance();
+  bool use_cache = cache->PrepareModule(codegen_utils->module(), settings);
+
   // Call GpCodegenUtils to compile entire module
-  bool compilation_status = codegen_utils_->PrepareForExecution(
-      gpcodegen::GpCodegenUtils::OptimizationLevel(codegen_optimization_level),
-      true);
+  return codegen_utils->PrepareForExecution(
+      gpcodegen::GpCodegenUtils::OptimizationLevel(settings.opt_level),
+      true,
+      use_cache ? cache : nullptr) &&
+      codegen_utils->FinalizeForExecution();
+}
 
-  if (!compilation_status) {
-    return success_count;
+unsigned int CodegenManager::PrepareGeneratedFunctions() {
+  // If no generator registered, just return with success count as 0
+  if (enrolled_code_generators_.empty()) {
+    return 0;
+  }
+
+  if (!CompileModule(codegen_utils_.get(),
+                     gpcodegen::CodegenCache::Settings::FromGUCs())) {
+    return 0;
+  }
+  return InstallGeneratedFunctions();
+}
+
+unsigned int CodegenManager::PrepareGeneratedFunctionsAsync() {
+  // If no generator registered, just return with success count as 0
+  if (enrolled_code_generators_.empty()) {
+    return 0;
   }
 
+  assert(nullptr == async_job_);
+  async_job_ = gpcodegen::CodegenAsyncCompiler::GetInstance()->Submit(
+      this, codegen_utils_.get(),
+      gpcodegen::CodegenCache::Settings::FromGUCs(),
+      GetCurrentTransactionNestLevel());
+  if (nullptr == async_job_) {
+    return PrepareGeneratedFunctions();
+  }
+  return 0;
+}
+
+unsigned int CodegenManager::FinishAsyncCompile(bool is_compiled) {
+  assert(nullptr != async_job_);
+  async_job_ = nullptr;
+  if (!is_compiled) {
+    return 0;
+  }
+  return InstallGeneratedFunctions();
+}
+
+unsigned int CodegenManager::InstallGeneratedFunctions() {
+  unsigned int success_count = 0;
+
   // On successful compilation, go through all generator and swap
   // the pointer so compiled function get called
   gpcodegen::GpCodegenUtils* codegen_utils = codegen_utils_.get();
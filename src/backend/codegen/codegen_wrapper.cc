@@ -18,12 +18,20 @@
 
 #include "codegen/codegen_config.h"
 #include "codegen/base_codegen.h"
+#include "codegen/codegen_async_compiler.h"
 #include "codegen/codegen_manager.h"
 #include "codegen/exec_eval_expr_codegen.h"
 #include "codegen/exec_variable_list_codegen.h"
 #include "codegen/expr_tree_generator.h"
 #include "codegen/utils/gp_codegen_utils.h"
 #include "codegen/advance_aggregates_codegen.h"
+#include "codegen/agg_scan_pipeline_codegen.h"
+#include "codegen/agg_hash_entry_match_codegen.h"
+#include "codegen/calc_hash_value_codegen.h"
+#include "codegen/copy_input_attributes_codegen.h"
+#include "codegen/exec_hash_get_hash_value_codegen.h"
+#include "codegen/memtuple_deform_codegen.h"
+#include "codegen/mk_compare_datum_codegen.h"
 
 extern "C" {
 #include "lib/stringinfo.h"
@@ -34,10 +42,19 @@ using gpcodegen::BaseCodegen;
 using gpcodegen::ExecVariableListCodegen;
 using gpcodegen::ExecEvalExprCodegen;
 using gpcodegen::AdvanceAggregatesCodegen;
+using gpcodegen::ExecHashGetHashValueCodegen;
+using gpcodegen::CalcHashValueCodegen;
+using gpcodegen::AggHashEntryMatchCodegen;
+using gpcodegen::MemTupleDeformCodegen;
+using gpcodegen::MKCompareDatumCodegen;
+using gpcodegen::AggScanPipelineCodegen;
+using gpcodegen::CopyInputAttributesCodegen;
 
 // Current code generator manager that oversees all code generators
 static void* ActiveCodeGeneratorManager = nullptr;
 
+volatile bool CodegenAsyncCompileDone = false;
+
 // Perform global set-up tasks for code generation. Returns 0 on
 // success, nonzero on error.
 unsigned int InitCodegen() {
@@ -62,9 +79,21 @@ unsigned int CodeGeneratorManagerPrepareGeneratedFunctions(void* manager) {
   if (!codegen) {
     return 0;
   }
+  if (codegen_async_compile) {
+    return static_cast<CodegenManager*>(manager)
+        ->PrepareGeneratedFunctionsAsync();
+  }
   return static_cast<CodegenManager*>(manager)->PrepareGeneratedFunctions();
 }
 
+void CodeGeneratorManagerInstallCompiledFunctions() {
+  gpcodegen::CodegenAsyncCompiler::GetInstance()->InstallCompiledFunctions();
+}
+
+void CodeGeneratorManagerAbortAsyncCompile(int nestLevel) {
+  gpcodegen::CodegenAsyncCompiler::GetInstance()->AbortJobs(nestLevel);
+}
+
 unsigned int CodeGeneratorManagerNotifyParameterChange(void* manager) {
   // parameter change notification is not supported yet
   assert(false);
@@ -163,3 +192,119 @@ void* AdvanceAggregatesCodegenEnroll(
   return generator;
 }
 
+void* ExecHashGetHashValueCodegenEnroll(
+    ExecHashGetHashValueFn regular_func_ptr,
+    ExecHashGetHashValueFn* ptr_to_chosen_func_ptr,
+    List *hashkeys,
+    List *hashoperators,
+    bool outer_tuple) {
+  CodegenManager* manager = static_cast<CodegenManager*>(
+      GetActiveCodeGeneratorManager());
+  ExecHashGetHashValueCodegen* generator =
+      CodegenManager::CreateAndEnrollGenerator<ExecHashGetHashValueCodegen>(
+          manager,
+          regular_func_ptr,
+          ptr_to_chosen_func_ptr,
+          hashkeys,
+          hashoperators,
+          outer_tuple);
+  return generator;
+}
+
+void* CalcHashValueCodegenEnroll(
+    CalcHashValueFn regular_func_ptr,
+    CalcHashValueFn* ptr_to_chosen_func_ptr,
+    AggState *aggstate) {
+  CodegenManager* manager = static_cast<CodegenManager*>(
+      GetActiveCodeGeneratorManager());
+  CalcHashValueCodegen* generator =
+      CodegenManager::CreateAndEnrollGenerator<CalcHashValueCodegen>(
+          manager,
+          regular_func_ptr,
+          ptr_to_chosen_func_ptr,
+          aggstate);
+  return generator;
+}
+
+void* AggHashEntryMatchCodegenEnroll(
+    AggHashEntryMatchFn regular_func_ptr,
+    AggHashEntryMatchFn* ptr_to_chosen_func_ptr,
+    AggState *aggstate) {
+  CodegenManager* manager = static_cast<CodegenManager*>(
+      GetActiveCodeGeneratorManager());
+  AggHashEntryMatchCodegen* generator =
+      CodegenManager::CreateAndEnrollGenerator<AggHashEntryMatchCodegen>(
+          manager,
+          regular_func_ptr,
+          ptr_to_chosen_func_ptr,
+          aggstate);
+  return generator;
+}
+
+void* MemTupleDeformCodegenEnroll(
+    MemTupleDeformFn regular_func_ptr,
+    MemTupleDeformFn* ptr_to_chosen_func_ptr,
+    TupleDesc tupdesc,
+    int natts) {
+  CodegenManager* manager = static_cast<CodegenManager*>(
+      GetActiveCodeGeneratorManager());
+  MemTupleDeformCodegen* generator =
+      CodegenManager::CreateAndEnrollGenerator<MemTupleDeformCodegen>(
+          manager,
+          regular_func_ptr,
+          ptr_to_chosen_func_ptr,
+          tupdesc,
+          natts);
+  return generator;
+}
+
+void* MKCompareDatumCodegenEnroll(
+    MKCompareDatumFn regular_func_ptr,
+    MKCompareDatumFn* ptr_to_chosen_func_ptr,
+    int nkeys,
+    Oid* sortFunctions,
+    bool* reverse) {
+  CodegenManager* manager = static_cast<CodegenManager*>(
+      GetActiveCodeGeneratorManager());
+  MKCompareDatumCodegen* generator =
+      CodegenManager::CreateAndEnrollGenerator<MKCompareDatumCodegen>(
+          manager,
+          regular_func_ptr,
+          ptr_to_chosen_func_ptr,
+          nkeys,
+          sortFunctions,
+          reverse);
+  return generator;
+}
+
+void* AggScanPipelineCodegenEnroll(
+    AggScanPipelineFn regular_func_ptr,
+    AggScanPipelineFn* ptr_to_chosen_func_ptr,
+    AggState *aggstate) {
+  CodegenManager* manager = static_cast<CodegenManager*>(
+      GetActiveCodeGeneratorManager());
+  AggScanPipelineCodegen* generator =
+      CodegenManager::CreateAndEnrollGenerator<AggScanPipelineCodegen>(
+          manager,
+          regular_func_ptr,
+          ptr_to_chosen_func_ptr,
+          aggstate);
+  return generator;
+}
+
+void* CopyInputAttributesCodegenEnroll(
+    CopyInputAttributesFn regular_func_ptr,
+    CopyInputAttributesFn* ptr_to_chosen_func_ptr,
+    CopyStateData *cstate,
+    TupleDesc tupdesc) {
+  CodegenManager* manager = static_cast<CodegenManager*>(
+      GetActiveCodeGeneratorManager());
+  CopyInputAttributesCodegen* generator =
+      CodegenManager::CreateAndEnrollGenerator<CopyInputAttributesCodegen>(
+          manager,
+          regular_func_ptr,
+          ptr_to_chosen_func_ptr,
+          cstate,
+          tupdesc);
+  return generator;
+}
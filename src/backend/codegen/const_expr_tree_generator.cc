@@ -18,6 +18,7 @@
 #include "codegen/utils/gp_codegen_utils.h"
 
 #include "llvm/IR/Constant.h"
+#include "llvm/IR/Constants.h"
 
 
 extern "C" {
@@ -58,8 +59,19 @@ bool ConstExprTreeGenerator::GenerateCode(GpCodegenUtils* codegen_utils,
   assert(nullptr != llvm_isnull_ptr);
   auto irb = codegen_utils->ir_builder();
   Const* const_expr = reinterpret_cast<Const*>(expr_state()->expr);
-  // const_expr->constvalue is a datum
-  *llvm_out_value = codegen_utils->GetConstant(const_expr->constvalue);
+  if (const_expr->constbyval || const_expr->constisnull) {
+    // const_expr->constvalue is a datum
+    *llvm_out_value = codegen_utils->GetConstant(const_expr->constvalue);
+  } else {
+    // Refer to a pass-by-reference value through an external global
+    // variable, so that its address stays out of the IR, and the compiled
+    // code can be cached and linked against the Const of another execution.
+    *llvm_out_value = llvm::ConstantExpr::getPtrToInt(
+        codegen_utils->GetConstant(
+            reinterpret_cast<const char*>(
+                DatumGetPointer(const_expr->constvalue))),
+        codegen_utils->GetType<Datum>());
+  }
   // *isNull = con->constisnull;
   irb->CreateStore(
       codegen_utils->GetConstant<bool>(const_expr->constisnull),
@@ -0,0 +1,453 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    copy_input_attributes_codegen.cc
+//
+//  @doc:
+//    Generates code for CopyInputAttributes function.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <string>
+
+#include "codegen/copy_input_attributes_codegen.h"
+#include "codegen/utils/gp_codegen_utils.h"
+#include "codegen/utils/utility.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "access/tupdesc.h"
+#include "catalog/pg_attribute.h"
+#include "commands/copy.h"
+#include "fmgr.h"
+#include "lib/stringinfo.h"
+#include "nodes/pg_list.h"
+#include "utils/elog.h"
+#include "utils/fmgroids.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+using gpcodegen::CopyInputAttributesCodegen;
+
+constexpr char CopyInputAttributesCodegen::kCopyInputAttributesPrefix[];
+
+CopyInputAttributesCodegen::CopyInputAttributesCodegen(
+    CodegenManager* manager,
+    CopyInputAttributesFn regular_func_ptr,
+    CopyInputAttributesFn* ptr_to_regular_func_ptr,
+    CopyStateData* cstate,
+    TupleDesc tupdesc)
+: BaseCodegen(manager,
+              kCopyInputAttributesPrefix,
+              regular_func_ptr,
+              ptr_to_regular_func_ptr),
+              cstate_(cstate),
+              tupdesc_(tupdesc) {
+}
+
+llvm::Function* CopyInputAttributesCodegen::GenerateParseInt(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+  auto irb = codegen_utils->ir_builder();
+
+  // Internal, so that LLVM may inline it and drop it.
+  llvm::Function* parse_int_func =
+      codegen_utils->CreateFunction<bool (*)(const char*, int64*)>(
+          GetUniqueFuncName() + "_parse_int",
+          false,
+          llvm::GlobalValue::InternalLinkage);
+  llvm::Value* llvm_str_arg = ArgumentByPosition(parse_int_func, 0);
+  llvm::Value* llvm_result_arg = ArgumentByPosition(parse_int_func, 1);
+
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry", parse_int_func);
+  llvm::BasicBlock* leading_space_block = codegen_utils->CreateBasicBlock(
+      "leading_space", parse_int_func);
+  llvm::BasicBlock* sign_block = codegen_utils->CreateBasicBlock(
+      "sign", parse_int_func);
+  llvm::BasicBlock* digit_block = codegen_utils->CreateBasicBlock(
+      "digit", parse_int_func);
+  llvm::BasicBlock* accumulate_block = codegen_utils->CreateBasicBlock(
+      "accumulate", parse_int_func);
+  llvm::BasicBlock* digits_done_block = codegen_utils->CreateBasicBlock(
+      "digits_done", parse_int_func);
+  llvm::BasicBlock* trailing_space_block = codegen_utils->CreateBasicBlock(
+      "trailing_space", parse_int_func);
+  llvm::BasicBlock* end_block = codegen_utils->CreateBasicBlock(
+      "end", parse_int_func);
+  llvm::BasicBlock* success_block = codegen_utils->CreateBasicBlock(
+      "success", parse_int_func);
+  llvm::BasicBlock* fail_block = codegen_utils->CreateBasicBlock(
+      "fail", parse_int_func);
+
+  // isspace() of the C locale, for ASCII only: ' ', '\t', '\n', '\v', '\f'
+  // and '\r'.
+  auto create_is_space = [codegen_utils, irb](llvm::Value* llvm_c) {
+    return irb->CreateOr(
+        irb->CreateICmpEQ(llvm_c, codegen_utils->GetConstant<char>(' ')),
+        irb->CreateICmpULE(
+            irb->CreateSub(llvm_c, codegen_utils->GetConstant<char>('\t')),
+            codegen_utils->GetConstant<char>('\r' - '\t')));
+  };
+
+  // entry block
+  // ----------
+  irb->SetInsertPoint(entry_block);
+  irb->CreateBr(leading_space_block);
+
+  // leading_space block
+  // ----------
+  // while (isspace(*ptr)) ptr++;
+  irb->SetInsertPoint(leading_space_block);
+  llvm::PHINode* llvm_leading_ptr = irb->CreatePHI(
+      codegen_utils->GetType<const char*>(), 2);
+  llvm_leading_ptr->addIncoming(llvm_str_arg, entry_block);
+  llvm::Value* llvm_leading_c = irb->CreateLoad(llvm_leading_ptr);
+  llvm_leading_ptr->addIncoming(
+      irb->CreateInBoundsGEP(codegen_utils->GetType<char>(), llvm_leading_ptr,
+                             codegen_utils->GetConstant<int64>(1)),
+      leading_space_block);
+  irb->CreateCondBr(create_is_space(llvm_leading_c),
+                    leading_space_block /* true */,
+                    sign_block /* false */);
+
+  // sign block
+  // ----------
+  // if (*ptr == '-' || *ptr == '+') ptr++;
+  irb->SetInsertPoint(sign_block);
+  llvm::Value* llvm_is_negative = irb->CreateICmpEQ(
+      llvm_leading_c, codegen_utils->GetConstant<char>('-'));
+  llvm::Value* llvm_has_sign = irb->CreateOr(
+      llvm_is_negative,
+      irb->CreateICmpEQ(llvm_leading_c, codegen_utils->GetConstant<char>('+')));
+  llvm::Value* llvm_digits_ptr = irb->CreateSelect(
+      llvm_has_sign,
+      irb->CreateInBoundsGEP(codegen_utils->GetType<char>(), llvm_leading_ptr,
+                             codegen_utils->GetConstant<int64>(1)),
+      llvm_leading_ptr);
+  irb->CreateBr(digit_block);
+
+  // digit block
+  // ----------
+  // while (isdigit(*ptr)) ...
+  irb->SetInsertPoint(digit_block);
+  llvm::PHINode* llvm_digit_ptr = irb->CreatePHI(
+      codegen_utils->GetType<const char*>(), 2);
+  llvm::PHINode* llvm_value = irb->CreatePHI(
+      codegen_utils->GetType<int64>(), 2);
+  llvm::PHINode* llvm_ndigits = irb->CreatePHI(
+      codegen_utils->GetType<int32>(), 2);
+  llvm_digit_ptr->addIncoming(llvm_digits_ptr, sign_block);
+  llvm_value->addIncoming(codegen_utils->GetConstant<int64>(0), sign_block);
+  llvm_ndigits->addIncoming(codegen_utils->GetConstant<int32>(0), sign_block);
+  llvm::Value* llvm_digit_c = irb->CreateLoad(llvm_digit_ptr);
+  llvm::Value* llvm_digit = irb->CreateSub(
+      llvm_digit_c, codegen_utils->GetConstant<char>('0'));
+  irb->CreateCondBr(
+      irb->CreateICmpULE(llvm_digit, codegen_utils->GetConstant<char>(9)),
+      accumulate_block /* true */,
+      digits_done_block /* false */);
+
+  // accumulate block
+  // ----------
+  // value = value * 10 + digit; ptr++;
+  // 18 digits always fit in an int64; longer values are left to the input
+  // function, which reports them as out of range.
+  irb->SetInsertPoint(accumulate_block);
+  llvm::Value* llvm_next_value = irb->CreateAdd(
+      irb->CreateMul(llvm_value, codegen_utils->GetConstant<int64>(10)),
+      irb->CreateZExt(llvm_digit, codegen_utils->GetType<int64>()));
+  llvm::Value* llvm_next_ndigits = irb->CreateAdd(
+      llvm_ndigits, codegen_utils->GetConstant<int32>(1));
+  llvm_digit_ptr->addIncoming(
+      irb->CreateInBoundsGEP(codegen_utils->GetType<char>(), llvm_digit_ptr,
+                             codegen_utils->GetConstant<int64>(1)),
+      accumulate_block);
+  llvm_value->addIncoming(llvm_next_value, accumulate_block);
+  llvm_ndigits->addIncoming(llvm_next_ndigits, accumulate_block);
+  irb->CreateCondBr(
+      irb->CreateICmpSLE(llvm_next_ndigits,
+                         codegen_utils->GetConstant<int32>(18)),
+      digit_block /* true */,
+      fail_block /* false */);
+
+  // digits_done block
+  // ----------
+  // At least one digit is required.
+  irb->SetInsertPoint(digits_done_block);
+  irb->CreateCondBr(
+      irb->CreateICmpEQ(llvm_ndigits, codegen_utils->GetConstant<int32>(0)),
+      fail_block /* true */,
+      trailing_space_block /* false */);
+
+  // trailing_space block
+  // ----------
+  // while (isspace(*ptr)) ptr++;
+  irb->SetInsertPoint(trailing_space_block);
+  llvm::PHINode* llvm_trailing_ptr = irb->CreatePHI(
+      codegen_utils->GetType<const char*>(), 2);
+  llvm_trailing_ptr->addIncoming(llvm_digit_ptr, digits_done_block);
+  llvm::Value* llvm_trailing_c = irb->CreateLoad(llvm_trailing_ptr);
+  llvm_trailing_ptr->addIncoming(
+      irb->CreateInBoundsGEP(codegen_utils->GetType<char>(), llvm_trailing_ptr,
+                             codegen_utils->GetConstant<int64>(1)),
+      trailing_space_block);
+  irb->CreateCondBr(create_is_space(llvm_trailing_c),
+                    trailing_space_block /* true */,
+                    end_block /* false */);
+
+  // end block
+  // ----------
+  // Nothing but white space may follow the digits.
+  irb->SetInsertPoint(end_block);
+  irb->CreateCondBr(
+      irb->CreateICmpEQ(llvm_trailing_c, codegen_utils->GetConstant<char>(0)),
+      success_block /* true */,
+      fail_block /* false */);
+
+  // success block
+  // ----------
+  // *result = negative ? -value : value; return true;
+  irb->SetInsertPoint(success_block);
+  irb->CreateStore(
+      irb->CreateSelect(llvm_is_negative,
+                        irb->CreateNeg(llvm_value),
+                        llvm_value),
+      llvm_result_arg);
+  irb->CreateRet(codegen_utils->GetConstant<bool>(true));
+
+  // fail block
+  // ----------
+  irb->SetInsertPoint(fail_block);
+  irb->CreateRet(codegen_utils->GetConstant<bool>(false));
+
+  return parse_int_func;
+}
+
+bool CopyInputAttributesCodegen::GenerateCopyInputAttributes(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+  assert(NULL != codegen_utils);
+  assert(NULL != cstate_);
+  assert(NULL != tupdesc_);
+
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Function* parse_int_func = GenerateParseInt(codegen_utils);
+
+  llvm::Function* copy_input_attributes_func =
+      CreateFunction<CopyInputAttributesFn>(
+          codegen_utils, GetUniqueFuncName());
+
+  llvm::Value* llvm_cstate_arg =
+      ArgumentByPosition(copy_input_attributes_func, 0);
+  llvm::Value* llvm_attr_offsets_arg =
+      ArgumentByPosition(copy_input_attributes_func, 1);
+  llvm::Value* llvm_values_arg =
+      ArgumentByPosition(copy_input_attributes_func, 2);
+  llvm::Value* llvm_nulls_arg =
+      ArgumentByPosition(copy_input_attributes_func, 3);
+
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry_block", copy_input_attributes_func);
+
+  // External functions
+  llvm::Function* llvm_InputFunctionCall =
+      codegen_utils->GetOrRegisterExternalFunction(InputFunctionCall,
+                                                   "InputFunctionCall");
+
+  // entry block
+  // ----------
+  irb->SetInsertPoint(entry_block);
+
+#ifdef CODEGEN_DEBUG
+  codegen_utils->CreateElog(DEBUG1, "Codegen'ed CopyInputAttributes called!");
+#endif
+
+  llvm::Value* llvm_attribute_buf_data = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_cstate_arg,
+                                        &CopyStateData::attribute_buf,
+                                        &StringInfoData::data));
+  llvm::Value* llvm_cur_attname_ptr = codegen_utils->GetPointerToMember(
+      llvm_cstate_arg, &CopyStateData::cur_attname);
+  // The parsed value of the integer attributes
+  llvm::Value* llvm_int_value_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<int64>(), nullptr, "int_value");
+
+  ListCell* cur;
+  foreach(cur, cstate_->attnumlist) {
+    int attnum = lfirst_int(cur);
+    int m = attnum - 1;
+    Form_pg_attribute attr = tupdesc_->attrs[m];
+    Oid in_func_oid = cstate_->in_functions[m].fn_oid;
+    std::string suffix = "_" + std::to_string(attnum);
+
+    llvm::BasicBlock* input_function_block = codegen_utils->CreateBasicBlock(
+        "input_function" + suffix, copy_input_attributes_func);
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "next" + suffix, copy_input_attributes_func);
+
+    // string = cstate->attribute_buf.data + attr_offsets[m];
+    llvm::Value* llvm_string = irb->CreateInBoundsGEP(
+        codegen_utils->GetType<char>(),
+        llvm_attribute_buf_data,
+        irb->CreateLoad(irb->CreateInBoundsGEP(
+            codegen_utils->GetType<int>(),
+            llvm_attr_offsets_arg,
+            codegen_utils->GetConstant(m))));
+    llvm::Value* llvm_value_ptr = irb->CreateInBoundsGEP(
+        codegen_utils->GetType<Datum>(),
+        llvm_values_arg,
+        codegen_utils->GetConstant(m));
+    llvm::Value* llvm_null_ptr = irb->CreateInBoundsGEP(
+        codegen_utils->GetType<bool>(),
+        llvm_nulls_arg,
+        codegen_utils->GetConstant(m));
+    llvm::Value* llvm_isnull = irb->CreateLoad(llvm_null_ptr);
+
+    // The NULL string of a FORCE NOT NULL attribute is passed to the input
+    // function as is.
+    if (cstate_->csv_mode && cstate_->force_notnull_flags[m]) {
+      llvm_string = irb->CreateSelect(
+          llvm_isnull,
+          irb->CreateLoad(codegen_utils->GetPointerToMember(
+              llvm_cstate_arg, &CopyStateData::null_print)),
+          llvm_string);
+      llvm_isnull = codegen_utils->GetConstant<bool>(false);
+    }
+
+    int64 min_value = 0;
+    int64 max_value = 0;
+    bool is_int = true;
+    switch (in_func_oid) {
+      case F_INT2IN:
+        min_value = PG_INT16_MIN;
+        max_value = PG_INT16_MAX;
+        break;
+      case F_INT4IN:
+        min_value = PG_INT32_MIN;
+        max_value = PG_INT32_MAX;
+        break;
+      case F_INT8IN:
+        // Any 18 digit value is in range.
+        min_value = PG_INT64_MIN;
+        max_value = PG_INT64_MAX;
+        break;
+      default:
+        is_int = false;
+    }
+
+    if (is_int) {
+      llvm::BasicBlock* null_block = codegen_utils->CreateBasicBlock(
+          "null" + suffix, copy_input_attributes_func);
+      llvm::BasicBlock* parse_block = codegen_utils->CreateBasicBlock(
+          "parse" + suffix, copy_input_attributes_func);
+      llvm::BasicBlock* parsed_block = codegen_utils->CreateBasicBlock(
+          "parsed" + suffix, copy_input_attributes_func);
+
+      irb->CreateCondBr(llvm_isnull,
+                        null_block /* true */,
+                        parse_block /* false */);
+
+      // null block
+      // ----------
+      // The input functions of the integer types are strict.
+      irb->SetInsertPoint(null_block);
+      irb->CreateStore(codegen_utils->GetConstant<Datum>(0), llvm_value_ptr);
+      irb->CreateStore(codegen_utils->GetConstant<bool>(true), llvm_null_ptr);
+      irb->CreateBr(next_block);
+
+      // parse block
+      // ----------
+      irb->SetInsertPoint(parse_block);
+      llvm::Value* llvm_parsed = irb->CreateCall(
+          parse_int_func, {llvm_string, llvm_int_value_ptr});
+      irb->CreateCondBr(llvm_parsed,
+                        parsed_block /* true */,
+                        input_function_block /* false */);
+
+      // parsed block
+      // ----------
+      // Values out of the range of the type are left to the input function,
+      // which reports them.
+      irb->SetInsertPoint(parsed_block);
+      llvm::Value* llvm_int_value = irb->CreateLoad(llvm_int_value_ptr);
+      llvm::BasicBlock* store_block = codegen_utils->CreateBasicBlock(
+          "store" + suffix, copy_input_attributes_func);
+      irb->CreateCondBr(
+          irb->CreateAnd(
+              irb->CreateICmpSGE(llvm_int_value,
+                                 codegen_utils->GetConstant<int64>(min_value)),
+              irb->CreateICmpSLE(llvm_int_value,
+                                 codegen_utils->GetConstant<int64>(max_value))),
+          store_block /* true */,
+          input_function_block /* false */);
+
+      // store block
+      // ----------
+      // The datums of smaller integers are sign extended, as the parsed value.
+      irb->SetInsertPoint(store_block);
+      irb->CreateStore(
+          codegen_utils->CreateCppTypeToDatumCast(llvm_int_value),
+          llvm_value_ptr);
+      irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_null_ptr);
+      irb->CreateBr(next_block);
+    } else {
+      irb->CreateBr(input_function_block);
+    }
+
+    // input_function block
+    // ----------
+    // cstate->cur_attname = NameStr(attr[m]->attname);
+    // values[m] = InputFunctionCall(&in_functions[m],
+    //                               isnull ? NULL : string,
+    //                               typioparams[m], attr[m]->atttypmod);
+    // nulls[m] = isnull;
+    // cstate->cur_attname = NULL;
+    irb->SetInsertPoint(input_function_block);
+    irb->CreateStore(
+        codegen_utils->GetConstant<const char*>(NameStr(attr->attname)),
+        llvm_cur_attname_ptr);
+    irb->CreateStore(
+        irb->CreateCall(llvm_InputFunctionCall, {
+            codegen_utils->GetConstant<FmgrInfo*>(&cstate_->in_functions[m]),
+            irb->CreateSelect(llvm_isnull,
+                              codegen_utils->GetConstant<char*>(nullptr),
+                              llvm_string),
+            codegen_utils->GetConstant<Oid>(cstate_->typioparams[m]),
+            codegen_utils->GetConstant<int32>(attr->atttypmod)}),
+        llvm_value_ptr);
+    irb->CreateStore(llvm_isnull, llvm_null_ptr);
+    irb->CreateStore(codegen_utils->GetConstant<const char*>(nullptr),
+                     llvm_cur_attname_ptr);
+    irb->CreateBr(next_block);
+
+    irb->SetInsertPoint(next_block);
+  }
+
+  irb->CreateRetVoid();
+
+  return true;
+}
+
+bool CopyInputAttributesCodegen::GenerateCodeInternal(
+    GpCodegenUtils* codegen_utils) {
+  bool isGenerated = GenerateCopyInputAttributes(codegen_utils);
+
+  if (isGenerated) {
+    elog(DEBUG1, "CopyInputAttributes was generated successfully!");
+    return true;
+  } else {
+    elog(DEBUG1, "CopyInputAttributes generation failed!");
+    return false;
+  }
+}
@@ -93,6 +93,11 @@ void ExecEvalExprCodegen::PrepareSlotGetAttr() {
       // generated slot_getattr(). This may not be true always, but calling the
       // regular slot_getattr() will still preserve correctness.
       break;
+    case T_HashJoinState:
+      // The hash bucket matching clauses refer to both the inner and the
+      // outer tuple, so there is no single slot to specialize slot_getattr()
+      // for. Use the regular slot_getattr().
+      break;
     default:
       elog(DEBUG1,
           "Attempting to generate ExecEvalExpr for an unsupported operator!");
@@ -0,0 +1,264 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    exec_hash_get_hash_value_codegen.cc
+//
+//  @doc:
+//    Generates code for ExecHashGetHashValue function.
+//
+//---------------------------------------------------------------------------
+#include "codegen/exec_hash_get_hash_value_codegen.h"
+#include "codegen/op_expr_tree_generator.h"
+#include "codegen/pg_func_generator_interface.h"
+
+#include "codegen/utils/gp_codegen_utils.h"
+#include "codegen/utils/utility.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "nodes/execnodes.h"
+#include "nodes/pg_list.h"
+#include "nodes/primnodes.h"
+#include "utils/elog.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+using gpcodegen::ExecHashGetHashValueCodegen;
+
+constexpr char ExecHashGetHashValueCodegen::kExecHashGetHashValuePrefix[];
+
+ExecHashGetHashValueCodegen::ExecHashGetHashValueCodegen(
+    CodegenManager* manager,
+    ExecHashGetHashValueFn regular_func_ptr,
+    ExecHashGetHashValueFn* ptr_to_regular_func_ptr,
+    List *hashkeys,
+    List *hashoperators,
+    bool outer_tuple)
+: BaseCodegen(manager,
+              kExecHashGetHashValuePrefix,
+              regular_func_ptr,
+              ptr_to_regular_func_ptr),
+              hashkeys_(hashkeys),
+              hashoperators_(hashoperators),
+              outer_tuple_(outer_tuple) {
+}
+
+bool ExecHashGetHashValueCodegen::GenerateExecHashGetHashValue(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+
+  assert(NULL != codegen_utils);
+  if (NIL == hashkeys_ ||
+      list_length(hashkeys_) != list_length(hashoperators_)) {
+    return false;
+  }
+
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Function* exec_hash_get_hash_value_func =
+      CreateFunction<ExecHashGetHashValueFn>(
+          codegen_utils, GetUniqueFuncName());
+
+  // BasicBlock of function entry.
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry_block", exec_hash_get_hash_value_func);
+  llvm::BasicBlock* error_block = codegen_utils->CreateBasicBlock(
+      "error_block", exec_hash_get_hash_value_func);
+
+  // External functions
+  llvm::Function* llvm_slot_getattr =
+      codegen_utils->GetOrRegisterExternalFunction(slot_getattr_regular,
+                                                   "slot_getattr_regular");
+  llvm::Function* llvm_MemoryContextReset =
+      codegen_utils->GetOrRegisterExternalFunction(MemoryContextReset,
+                                                   "MemoryContextReset");
+
+  // Function arguments to ExecHashGetHashValue
+  llvm::Value* llvm_econtext_arg = ArgumentByPosition(
+      exec_hash_get_hash_value_func, 2);
+  llvm::Value* llvm_keep_nulls_arg = ArgumentByPosition(
+      exec_hash_get_hash_value_func, 5);
+  llvm::Value* llvm_hashvalue_arg = ArgumentByPosition(
+      exec_hash_get_hash_value_func, 6);
+  llvm::Value* llvm_hashkeys_null_arg = ArgumentByPosition(
+      exec_hash_get_hash_value_func, 7);
+
+  // entry block
+  // ----------
+  irb->SetInsertPoint(entry_block);
+
+#ifdef CODEGEN_DEBUG
+  codegen_utils->CreateElog(DEBUG1, "Codegen'ed ExecHashGetHashValue called!");
+#endif
+
+  llvm::Value* llvm_hashkey_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<uint32_t>(), nullptr, "hashkey");
+  llvm::Value* llvm_result_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "result");
+  llvm::Value* llvm_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "isNull");
+
+  irb->CreateStore(codegen_utils->GetConstant<uint32_t>(0), llvm_hashkey_ptr);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(true), llvm_result_ptr);
+  // (*hashkeys_null) = true;
+  irb->CreateStore(codegen_utils->GetConstant<bool>(true),
+                   llvm_hashkeys_null_arg);
+
+  // ResetExprContext(econtext);
+  // Plain Vars don't leak memory, but the caller may count on the reset.
+  irb->CreateCall(llvm_MemoryContextReset, {
+      irb->CreateLoad(codegen_utils->GetPointerToMember(
+          llvm_econtext_arg, &ExprContext::ecxt_per_tuple_memory))});
+
+  ListCell *hk;
+  ListCell *ho;
+  int i = 0;
+  forboth(hk, hashkeys_, ho, hashoperators_) {
+    ExprState *keyexpr = reinterpret_cast<ExprState *>(lfirst(hk));
+    Oid hashop = lfirst_oid(ho);
+
+    if (nullptr == keyexpr->expr ||
+        T_Var != nodeTag(keyexpr->expr) ||
+        reinterpret_cast<Var *>(keyexpr->expr)->varattno <= 0) {
+      elog(DEBUG1, "We only codegen hash keys that are user attributes");
+      return false;
+    }
+    Var *var = reinterpret_cast<Var *>(keyexpr->expr);
+
+    Oid left_hashfn;
+    Oid right_hashfn;
+    if (!get_op_hash_functions(hashop, &left_hashfn, &right_hashfn)) {
+      return false;
+    }
+    Oid hashfn = outer_tuple_ ? left_hashfn : right_hashfn;
+    gpcodegen::PGFuncGeneratorInterface* pg_func_gen =
+        gpcodegen::OpExprTreeGenerator::GetPGFuncGenerator(hashfn);
+    if (nullptr == pg_func_gen) {
+      elog(DEBUG1, "We do not support hash function with oid = %d", hashfn);
+      return false;
+    }
+
+    llvm::BasicBlock* null_block = codegen_utils->CreateBasicBlock(
+        "null_block_key" + std::to_string(i), exec_hash_get_hash_value_func);
+    llvm::BasicBlock* not_null_block = codegen_utils->CreateBasicBlock(
+        "not_null_block_key" + std::to_string(i),
+        exec_hash_get_hash_value_func);
+    llvm::BasicBlock* hash_block = codegen_utils->CreateBasicBlock(
+        "hash_block_key" + std::to_string(i), exec_hash_get_hash_value_func);
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "next_block_key" + std::to_string(i), exec_hash_get_hash_value_func);
+
+    // rotate hashkey left 1 bit at each step
+    llvm::Value* llvm_hashkey = irb->CreateLoad(llvm_hashkey_ptr);
+    irb->CreateStore(
+        irb->CreateOr(
+            irb->CreateShl(llvm_hashkey,
+                           codegen_utils->GetConstant<uint32_t>(1)),
+            irb->CreateLShr(llvm_hashkey,
+                            codegen_utils->GetConstant<uint32_t>(31))),
+        llvm_hashkey_ptr);
+
+    // Get the join attribute value of the tuple, as in ExecEvalScalarVar()
+    llvm::Value* llvm_slot_ptr = nullptr;
+    switch (var->varno) {
+      case INNER:
+        llvm_slot_ptr = codegen_utils->GetPointerToMember(
+            llvm_econtext_arg, &ExprContext::ecxt_innertuple);
+        break;
+      case OUTER:
+        llvm_slot_ptr = codegen_utils->GetPointerToMember(
+            llvm_econtext_arg, &ExprContext::ecxt_outertuple);
+        break;
+      default:
+        llvm_slot_ptr = codegen_utils->GetPointerToMember(
+            llvm_econtext_arg, &ExprContext::ecxt_scantuple);
+        break;
+    }
+    llvm::Value* llvm_keyval = irb->CreateCall(llvm_slot_getattr, {
+        irb->CreateLoad(llvm_slot_ptr),
+        codegen_utils->GetConstant<int32_t>(var->varattno),
+        llvm_isnull_ptr});
+    irb->CreateCondBr(irb->CreateLoad(llvm_isnull_ptr),
+                      null_block /* true */,
+                      not_null_block /* false */);
+
+    // null block
+    // ----------
+    // If the join operator is strict, the tuple is rejected unless
+    // keep_nulls. Otherwise hashkey is left unmodified.
+    irb->SetInsertPoint(null_block);
+    if (op_strict(hashop)) {
+      irb->CreateStore(
+          irb->CreateAnd(irb->CreateLoad(llvm_result_ptr),
+                         llvm_keep_nulls_arg),
+          llvm_result_ptr);
+    }
+    irb->CreateBr(next_block);
+
+    // not null block
+    // ----------
+    irb->SetInsertPoint(not_null_block);
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                     llvm_hashkeys_null_arg);
+    irb->CreateCondBr(irb->CreateLoad(llvm_result_ptr),
+                      hash_block /* true */,
+                      next_block /* false */);
+
+    // hash block
+    // ----------
+    // hashkey ^= hash function(keyval)
+    irb->SetInsertPoint(hash_block);
+    gpcodegen::PGFuncGeneratorInfo pg_func_info(
+        exec_hash_get_hash_value_func,
+        error_block,
+        {llvm_keyval},
+        {codegen_utils->GetConstant<bool>(false)});
+    llvm::Value* llvm_hkey = nullptr;
+    if (!pg_func_gen->GenerateCode(codegen_utils, pg_func_info, &llvm_hkey,
+                                   llvm_isnull_ptr)) {
+      elog(DEBUG1, "Hash function with oid = %d was not generated "
+           "successfully!", hashfn);
+      return false;
+    }
+    irb->CreateStore(
+        irb->CreateXor(irb->CreateLoad(llvm_hashkey_ptr), llvm_hkey),
+        llvm_hashkey_ptr);
+    irb->CreateBr(next_block);
+
+    irb->SetInsertPoint(next_block);
+    i++;
+  }
+
+  // *hashvalue = hashkey;
+  irb->CreateStore(irb->CreateLoad(llvm_hashkey_ptr), llvm_hashvalue_arg);
+  irb->CreateRet(irb->CreateLoad(llvm_result_ptr));
+
+  // Error block
+  // ---------------
+  // The hash functions don't report errors, so this is never reached.
+  irb->SetInsertPoint(error_block);
+  irb->CreateRet(codegen_utils->GetConstant<bool>(false));
+
+  return true;
+}
+
+bool ExecHashGetHashValueCodegen::GenerateCodeInternal(
+    GpCodegenUtils* codegen_utils) {
+  bool isGenerated = GenerateExecHashGetHashValue(codegen_utils);
+
+  if (isGenerated) {
+    elog(DEBUG1, "ExecHashGetHashValue was generated successfully!");
+    return true;
+  } else {
+    elog(DEBUG1, "ExecHashGetHashValue generation failed!");
+    return false;
+  }
+}
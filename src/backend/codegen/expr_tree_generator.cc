@@ -12,9 +12,14 @@
 #include <cassert>
 #include <memory>
 
+#include "codegen/bool_expr_tree_generator.h"
+#include "codegen/case_expr_tree_generator.h"
+#include "codegen/coalesce_expr_tree_generator.h"
 #include "codegen/const_expr_tree_generator.h"
 #include "codegen/expr_tree_generator.h"
+#include "codegen/null_test_expr_tree_generator.h"
 #include "codegen/op_expr_tree_generator.h"
+#include "codegen/scalar_array_op_expr_tree_generator.h"
 #include "codegen/var_expr_tree_generator.h"
 
 extern "C" {
@@ -51,6 +56,32 @@ bool ExprTreeGenerator::VerifyAndCreateExprTree(
           expr_state, gen_info, expr_tree);
       break;
     }
+    case T_BoolExpr: {
+      supported_expr_tree = BoolExprTreeGenerator::VerifyAndCreateExprTree(
+          expr_state, gen_info, expr_tree);
+      break;
+    }
+    case T_NullTest: {
+      supported_expr_tree = NullTestExprTreeGenerator::VerifyAndCreateExprTree(
+          expr_state, gen_info, expr_tree);
+      break;
+    }
+    case T_CaseExpr: {
+      supported_expr_tree = CaseExprTreeGenerator::VerifyAndCreateExprTree(
+          expr_state, gen_info, expr_tree);
+      break;
+    }
+    case T_CoalesceExpr: {
+      supported_expr_tree = CoalesceExprTreeGenerator::VerifyAndCreateExprTree(
+          expr_state, gen_info, expr_tree);
+      break;
+    }
+    case T_ScalarArrayOpExpr: {
+      supported_expr_tree =
+          ScalarArrayOpExprTreeGenerator::VerifyAndCreateExprTree(
+              expr_state, gen_info, expr_tree);
+      break;
+    }
     default : {
       supported_expr_tree = false;
       elog(DEBUG1, "Unsupported expression tree %d found",
@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    agg_hash_entry_match_codegen.h
+//
+//  @doc:
+//    Headers for agg_hash_entry_match codegen.
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPCODEGEN_AGGHASHENTRYMATCH_CODEGEN_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_AGGHASHENTRYMATCH_CODEGEN_H_
+
+#include "codegen/base_codegen.h"
+#include "codegen/codegen_wrapper.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class AggHashEntryMatchCodegen: public BaseCodegen<AggHashEntryMatchFn> {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param regular_func_ptr        Regular version of the target function.
+   * @param ptr_to_chosen_func_ptr  Reference to the function pointer that the
+   *                                caller will call.
+   * @param aggstate                The AggState to use for generating code.
+   *
+   * @note 	The ptr_to_chosen_func_ptr can refer to either the generated
+   *        function or the corresponding regular version.
+   *
+   **/
+  explicit AggHashEntryMatchCodegen(
+      CodegenManager* manager,
+      AggHashEntryMatchFn regular_func_ptr,
+      AggHashEntryMatchFn* ptr_to_regular_func_ptr,
+      AggState *aggstate);
+
+  virtual ~AggHashEntryMatchCodegen() = default;
+
+ protected:
+  /**
+   * @brief Generate code for agg_hash_entry_match.
+   *
+   * @param codegen_utils
+   *
+   * @return true on successful generation; false otherwise.
+   *
+   * This implementation only supports grouping columns whose equality
+   * function OpExprTreeGenerator has a generator for. Otherwise, we fall
+   * back to the regular function.
+   *
+   */
+  bool GenerateCodeInternal(gpcodegen::GpCodegenUtils* codegen_utils) final;
+
+ private:
+  AggState *aggstate_;
+
+  static constexpr char kAggHashEntryMatchPrefix[] = "AggHashEntryMatch";
+
+  /**
+   * @brief Generates runtime code that implements agg_hash_entry_match.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @return true on successful generation.
+   **/
+  bool GenerateAggHashEntryMatch(gpcodegen::GpCodegenUtils* codegen_utils);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+#endif  // GPCODEGEN_AGGHASHENTRYMATCH_CODEGEN_H_
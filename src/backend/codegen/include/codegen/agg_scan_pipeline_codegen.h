@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    agg_scan_pipeline_codegen.h
+//
+//  @doc:
+//    Headers for agg_scan_pipeline codegen.
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPCODEGEN_AGG_SCAN_PIPELINE_CODEGEN_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_AGG_SCAN_PIPELINE_CODEGEN_H_
+
+#include <memory>
+#include <vector>
+
+#include "codegen/base_codegen.h"
+#include "codegen/codegen_wrapper.h"
+#include "codegen/expr_tree_generator.h"
+
+struct ScanState;
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class SlotGetAttrCodegen;
+
+class AggScanPipelineCodegen: public BaseCodegen<AggScanPipelineFn> {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param regular_func_ptr        Regular version of the target function.
+   * @param ptr_to_chosen_func_ptr  Reference to the function pointer that the
+   *                                caller will call.
+   * @param aggstate                The plain AggState to use for generating
+   *                                code.
+   *
+   * @note 	The ptr_to_chosen_func_ptr can refer to either the generated
+   *        function or the corresponding regular version.
+   *
+   **/
+  explicit AggScanPipelineCodegen(
+      CodegenManager* manager,
+      AggScanPipelineFn regular_func_ptr,
+      AggScanPipelineFn* ptr_to_regular_func_ptr,
+      AggState *aggstate);
+
+  virtual ~AggScanPipelineCodegen() = default;
+
+  bool InitDependencies() override;
+
+ protected:
+  /**
+   * @brief Generate code for agg_scan_pipeline.
+   *
+   * @param codegen_utils
+   *
+   * @return true on successful generation; false otherwise.
+   *
+   * The generated function runs the whole input of the Agg in one loop: it
+   * fetches the tuples of the outer table scan, checks its quals, projects
+   * them and advances the aggregates, without going through ExecProcNode,
+   * ExecScan and the function pointers of the two nodes for each tuple. The
+   * quals are generated inline when the expression trees are supported, and
+   * the generated advance_aggregates of this manager is called directly, so
+   * that LLVM may inline it into the loop.
+   *
+   * Only Aggs whose outer plan is a TableScan without instrumentation are
+   * fused, so that EXPLAIN ANALYZE and gpperfmon still count the rows.
+   *
+   */
+  bool GenerateCodeInternal(gpcodegen::GpCodegenUtils* codegen_utils) final;
+
+ private:
+  AggState* aggstate_;
+  // The outer table scan, or nullptr if the plan shape is not supported
+  ScanState* scan_state_;
+
+  // Trees of the quals of the scan, if all of them are supported
+  std::vector<std::unique_ptr<ExprTreeGenerator>> qual_trees_;
+  ExprTreeGeneratorInfo gen_info_;
+  SlotGetAttrCodegen* slot_getattr_codegen_;
+
+  static constexpr char kAggScanPipelinePrefix[] = "AggScanPipeline";
+
+  /**
+   * @brief Generates runtime code that implements agg_scan_pipeline.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @return true on successful generation.
+   **/
+  bool GenerateAggScanPipeline(gpcodegen::GpCodegenUtils* codegen_utils);
+
+  /**
+   * @brief Generates the check of the quals of the scan for the current scan
+   *        tuple, branching to qual_pass_block or qual_fail_block.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @param qual_pass_block Block to jump to if the tuple satisfies the quals.
+   * @param qual_fail_block Block to jump to otherwise.
+   * @return true on successful generation.
+   **/
+  bool GenerateQuals(gpcodegen::GpCodegenUtils* codegen_utils,
+                     llvm::BasicBlock* qual_pass_block,
+                     llvm::BasicBlock* qual_fail_block);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+#endif  // GPCODEGEN_AGG_SCAN_PIPELINE_CODEGEN_H_
@@ -0,0 +1,73 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    case_expr_tree_generator.h
+//
+//  @doc:
+//    Object that generate code for CASE expression.
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_CASE_EXPR_TREE_GENERATOR_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_CASE_EXPR_TREE_GENERATOR_H_
+
+#include <utility>
+#include <vector>
+
+#include "codegen/expr_tree_generator.h"
+#include "codegen/codegen_wrapper.h"
+
+#include "llvm/IR/Value.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+/**
+ * @brief Object that generate code for CASE expression.
+ *
+ * Only the searched form (CASE WHEN cond THEN ...) is supported; the simple
+ * form (CASE arg WHEN ...) passes its argument through econtext to
+ * CaseTestExpr nodes, which is left to ExecEvalCase().
+ **/
+class CaseExprTreeGenerator : public ExprTreeGenerator {
+ public:
+  static bool VerifyAndCreateExprTree(
+        const ExprState* expr_state,
+        ExprTreeGeneratorInfo* gen_info,
+        std::unique_ptr<ExprTreeGenerator>* expr_tree);
+
+  bool GenerateCode(gpcodegen::GpCodegenUtils* codegen_utils,
+                    const ExprTreeGeneratorInfo& gen_info,
+                    llvm::Value** llvm_out_value,
+                    llvm::Value* const llvm_isnull_ptr) final;
+
+ protected:
+  /**
+   * @brief Constructor.
+   *
+   * @param expr_state   Expression state
+   * @param when_clauses Pairs of condition and result of the WHEN clauses
+   * @param defresult    Default result (ELSE clause); nullptr if none
+   **/
+  CaseExprTreeGenerator(
+      const ExprState* expr_state,
+      std::vector<
+          std::pair<std::unique_ptr<ExprTreeGenerator>,
+                    std::unique_ptr<ExprTreeGenerator>>>&&
+          when_clauses,  // NOLINT(build/c++11)
+      std::unique_ptr<ExprTreeGenerator>&& defresult);  // NOLINT(build/c++11)
+
+ private:
+  std::vector<std::pair<std::unique_ptr<ExprTreeGenerator>,
+                        std::unique_ptr<ExprTreeGenerator>>> when_clauses_;
+  std::unique_ptr<ExprTreeGenerator> defresult_;
+};
+
+/** @} */
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_CASE_EXPR_TREE_GENERATOR_H_
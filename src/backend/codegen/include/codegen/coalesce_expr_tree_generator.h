@@ -0,0 +1,63 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    coalesce_expr_tree_generator.h
+//
+//  @doc:
+//    Object that generate code for COALESCE expression.
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_COALESCE_EXPR_TREE_GENERATOR_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_COALESCE_EXPR_TREE_GENERATOR_H_
+
+#include <vector>
+
+#include "codegen/expr_tree_generator.h"
+#include "codegen/codegen_wrapper.h"
+
+#include "llvm/IR/Value.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+/**
+ * @brief Object that generate code for COALESCE expression.
+ **/
+class CoalesceExprTreeGenerator : public ExprTreeGenerator {
+ public:
+  static bool VerifyAndCreateExprTree(
+        const ExprState* expr_state,
+        ExprTreeGeneratorInfo* gen_info,
+        std::unique_ptr<ExprTreeGenerator>* expr_tree);
+
+  bool GenerateCode(gpcodegen::GpCodegenUtils* codegen_utils,
+                    const ExprTreeGeneratorInfo& gen_info,
+                    llvm::Value** llvm_out_value,
+                    llvm::Value* const llvm_isnull_ptr) final;
+
+ protected:
+  /**
+   * @brief Constructor.
+   *
+   * @param expr_state Expression state
+   * @param arguments  Arguments of COALESCE as list of ExprTreeGenerator
+   **/
+  CoalesceExprTreeGenerator(
+      const ExprState* expr_state,
+      std::vector<
+          std::unique_ptr<
+              ExprTreeGenerator>>&& arguments);  // NOLINT(build/c++11)
+
+ private:
+  std::vector<std::unique_ptr<ExprTreeGenerator>> arguments_;
+};
+
+/** @} */
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_COALESCE_EXPR_TREE_GENERATOR_H_
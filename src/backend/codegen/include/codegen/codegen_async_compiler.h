@@ -0,0 +1,155 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    codegen_async_compiler.h
+//
+//  @doc:
+//    Compiles the modules of code generator managers in a background thread
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_CODEGEN_ASYNC_COMPILER_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_CODEGEN_ASYNC_COMPILER_H_
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <vector>
+
+#include "codegen/codegen_cache.h"
+#include "codegen/utils/macros.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class CodegenManager;
+class GpCodegenUtils;
+
+/**
+ * @brief Per-backend compiler thread, so that the executor doesn't wait for
+ *        LLVM to optimize and compile the generated code.
+ *
+ * Code is still generated by the backend, as generators look at the executor
+ * state. Only the compilation of the module of a CodegenManager, which is
+ * LLVM alone, runs in the background thread. Meanwhile the executor runs the
+ * regular functions, and the backend swaps in the compiled ones in
+ * InstallCompiledFunctions(), which the executor calls between tuples once
+ * CodegenAsyncCompileDone is set. The function pointers are thus only ever
+ * written by the backend, at a point where no tuple is half processed.
+ *
+ * The thread compiles one module at a time, in the order they were
+ * submitted. It never calls into the backend: it doesn't log, allocate
+ * memory with palloc, or look at GUCs, and it blocks all signals.
+ **/
+class CodegenAsyncCompiler {
+ public:
+  /**
+   * @brief A module handed to the compiler thread.
+   **/
+  struct Job;
+
+  /**
+   * @return The compiler of this backend.
+   **/
+  static CodegenAsyncCompiler* GetInstance();
+
+  /**
+   * @brief Queue the module of a manager for compilation.
+   *
+   * @param manager The manager that generated the module. It is notified
+   *        with CodegenManager::FinishAsyncCompile() from
+   *        InstallCompiledFunctions().
+   * @param codegen_utils Utility that holds the module. The backend must not
+   *        use it until the manager is notified.
+   * @param settings Settings to compile the module with.
+   * @param nest_level Transaction nesting level of the query of the manager,
+   *        to cancel the job with AbortJobs() if that (sub)transaction
+   *        aborts.
+   * @return The job, or nullptr if the compiler thread couldn't be started,
+   *         in which case the caller should compile synchronously.
+   **/
+  Job* Submit(CodegenManager* manager,
+              GpCodegenUtils* codegen_utils,
+              const CodegenCache::Settings& settings,
+              int nest_level);
+
+  /**
+   * @brief Cancel a job whose manager is being destroyed.
+   *
+   * @param job The job.
+   * @param codegen_utils The manager's utility. If the job is being compiled,
+   *        the compiler thread takes it over and frees it when done.
+   **/
+  void Cancel(Job* job, std::unique_ptr<GpCodegenUtils>* codegen_utils);
+
+  /**
+   * @brief Cancel the jobs of the queries of an aborted (sub)transaction.
+   *
+   * An ERROR leaks the managers of the aborted queries, as ExecEndNode
+   * doesn't run, while the executor state that their generators point to is
+   * freed. Their jobs are dropped, so that the managers are never notified
+   * with FinishAsyncCompile().
+   *
+   * @param nest_level Transaction nesting level that aborts; the jobs
+   *        submitted at this level or deeper are cancelled.
+   *
+   * @note Must be called by the backend, not by the compiler thread.
+   **/
+  void AbortJobs(int nest_level);
+
+  /**
+   * @brief Notify the managers of the jobs that were compiled since the
+   *        last call, so that they swap in the compiled functions.
+   *
+   * @note Must be called by the backend, not by the compiler thread.
+   **/
+  void InstallCompiledFunctions();
+
+  /**
+   * @brief Wait for the module being compiled, if any, and stop the
+   *        compiler thread. Queued jobs are abandoned.
+   **/
+  void Shutdown();
+
+ private:
+  CodegenAsyncCompiler()
+      : is_started_(false),
+        is_shutting_down_(false),
+        compiling_job_(nullptr) {
+  }
+
+  // Start the compiler thread, if it isn't yet.
+  bool Start();
+
+  // Body of the compiler thread.
+  void Run();
+
+  // Protects all the members below, and the jobs.
+  std::mutex mutex_;
+  // Signaled when a job is queued, a job is compiled, or on shutdown.
+  std::condition_variable cond_;
+
+  bool is_started_;
+  bool is_shutting_down_;
+
+  // Jobs waiting to be compiled, oldest first.
+  std::deque<Job*> queued_jobs_;
+  // Job being compiled, if any.
+  Job* compiling_job_;
+  // Compiled jobs whose manager hasn't been notified yet.
+  std::vector<Job*> compiled_jobs_;
+
+  DISALLOW_COPY_AND_ASSIGN(CodegenAsyncCompiler);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_CODEGEN_ASYNC_COMPILER_H_
@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    codegen_cache.h
+//
+//  @doc:
+//    Cache of the compiled machine code of generated modules
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_CODEGEN_CACHE_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_CODEGEN_CACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "codegen/utils/macros.h"
+
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+/**
+ * @brief Per-backend cache of the machine code that MCJIT compiled for
+ *        generated modules, so that repeated executions of a query skip the
+ *        expensive compilation.
+ *
+ * A module is looked up by its LLVM IR, which captures everything the
+ * generated code depends on: the structure of the expression trees, the
+ * tuple descriptors and any pass-by-value constants. Pointers, such as those
+ * to executor state or to the values of pass-by-reference constants, don't
+ * appear in the IR. CodegenUtils turns them into external global variables,
+ * and calls to backend functions go to external functions, all of them
+ * resolved by name when the compiled object is linked. A cached object can therefore be linked again against the
+ * state of another execution.
+ *
+ * Compiled objects are kept in memory up to codegen_cache_size kilobytes,
+ * and optionally written to codegen_cache_directory so that other backends
+ * can load them. The directory is only used if it is private to the server
+ * user.
+ **/
+class CodegenCache : public llvm::ObjectCache {
+ public:
+  /**
+   * @return The cache of this backend.
+   **/
+  static CodegenCache* GetInstance();
+
+  ~CodegenCache() override = default;
+
+  /**
+   * @brief Settings for compiling one module, taken from the GUCs when the
+   *        module is handed to the compiler, as it may be compiled in the
+   *        background while the GUCs change.
+   **/
+  struct Settings {
+    // codegen_optimization_level
+    int opt_level;
+    // codegen_cache_size, in kilobytes
+    int size;
+    // codegen_cache_directory, or empty
+    std::string directory;
+    // If not nullptr, messages are appended to it instead of being logged,
+    // which is not allowed off the main thread of the backend.
+    std::vector<std::string>* messages;
+
+    /**
+     * @return The settings of the current GUCs, with no message collector.
+     **/
+    static Settings FromGUCs();
+  };
+
+  /**
+   * @brief Compute the key of a module that is about to be compiled.
+   *
+   * @note This renames the module to its key, which is how getObject() and
+   *       notifyObjectCompiled() recognize it.
+   *
+   * @param module The module to compile.
+   * @param settings Settings the module is compiled with.
+   * @return true if the cache is enabled and should be used to compile the
+   *         module.
+   **/
+  bool PrepareModule(llvm::Module* module, const Settings& settings);
+
+  /**
+   * @brief Return a copy of the compiled object of a module prepared with
+   *        PrepareModule(), or nullptr if it isn't cached.
+   **/
+  std::unique_ptr<llvm::MemoryBuffer> getObject(
+      const llvm::Module* module) override;
+
+  /**
+   * @brief Cache the object compiled for a module prepared with
+   *        PrepareModule().
+   **/
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef object) override;
+
+  /**
+   * @brief Drop all the objects cached in memory.
+   **/
+  void Clear();
+
+  /**
+   * @return Number of modules whose compiled object was found in the cache.
+   **/
+  std::size_t hits() const {
+    return hits_;
+  }
+
+  /**
+   * @return Number of modules that had to be compiled.
+   **/
+  std::size_t misses() const {
+    return misses_;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::string ir;
+    std::unique_ptr<llvm::MemoryBuffer> object;
+  };
+
+  CodegenCache()
+      : bytes_(0),
+        pending_settings_({0, 0, std::string(), nullptr}),
+        hits_(0),
+        misses_(0) {
+  }
+
+  // Cache the object in memory, evicting the least recently used ones to
+  // stay within codegen_cache_size.
+  void Insert(const std::string& key,
+              const std::string& ir,
+              llvm::StringRef object);
+
+  // Read and write the object of the pending module in
+  // codegen_cache_directory.
+  std::unique_ptr<llvm::MemoryBuffer> ReadFromDisk();
+  void WriteToDisk(llvm::StringRef object);
+
+  std::string DiskPath() const;
+
+  // Whether codegen_cache_directory exists, is owned by the server user and
+  // has mode 0700. Other users must not be able to plant code in it.
+  bool DirectoryIsPrivate();
+
+  // Log a DEBUG1 message, or collect it in the messages of the settings of
+  // the pending module.
+  void Log(const std::string& message);
+
+  // Cached objects, most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+
+  // Total size of the IR and objects in 'entries_'.
+  std::size_t bytes_;
+
+  // Key, IR and settings of the module prepared last by PrepareModule().
+  std::string pending_key_;
+  std::string pending_ir_;
+  Settings pending_settings_;
+
+  std::size_t hits_;
+  std::size_t misses_;
+
+  DISALLOW_COPY_AND_ASSIGN(CodegenCache);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_CODEGEN_CACHE_H_
@@ -21,11 +21,22 @@ extern bool codegen_exec_variable_list;
 extern bool codegen_slot_getattr;
 extern bool codegen_exec_eval_expr;
 extern bool codegen_advance_aggregate;
+extern bool codegen_exec_hash_get_hash_value;
+extern bool codegen_calc_hash_value;
+extern bool codegen_agg_hash_entry_match;
+extern bool codegen_memtuple_deform;
+extern bool codegen_mk_compare_datum;
+extern bool codegen_agg_scan_pipeline;
+extern bool codegen_copy_input_attributes;
+extern bool codegen_inline_builtins;
+extern bool codegen_async_compile;
 // TODO(shardikar): Retire this GUC after performing experiments to find the
 // tradeoff of codegen-ing slot_getattr() (potentially by measuring the
 // difference in the number of instructions) when one of the first few
 // attributes is varlen.
 extern int codegen_varlen_tolerance;
+extern int codegen_cache_size;
+extern char* codegen_cache_directory;
 }
 
 namespace gpcodegen {
@@ -39,6 +50,13 @@ class ExecVariableListCodegen;
 class SlotGetAttrCodegen;
 class ExecEvalExprCodegen;
 class AdvanceAggregatesCodegen;
+class ExecHashGetHashValueCodegen;
+class CalcHashValueCodegen;
+class AggHashEntryMatchCodegen;
+class MemTupleDeformCodegen;
+class MKCompareDatumCodegen;
+class AggScanPipelineCodegen;
+class CopyInputAttributesCodegen;
 
 class CodegenConfig {
  public:
@@ -73,6 +91,41 @@ inline bool CodegenConfig::IsGeneratorEnabled<AdvanceAggregatesCodegen>() {
   return codegen_advance_aggregate;
 }
 
+template<>
+inline bool CodegenConfig::IsGeneratorEnabled<ExecHashGetHashValueCodegen>() {
+  return codegen_exec_hash_get_hash_value;
+}
+
+template<>
+inline bool CodegenConfig::IsGeneratorEnabled<CalcHashValueCodegen>() {
+  return codegen_calc_hash_value;
+}
+
+template<>
+inline bool CodegenConfig::IsGeneratorEnabled<AggHashEntryMatchCodegen>() {
+  return codegen_agg_hash_entry_match;
+}
+
+template<>
+inline bool CodegenConfig::IsGeneratorEnabled<MemTupleDeformCodegen>() {
+  return codegen_memtuple_deform;
+}
+
+template<>
+inline bool CodegenConfig::IsGeneratorEnabled<MKCompareDatumCodegen>() {
+  return codegen_mk_compare_datum;
+}
+
+template<>
+inline bool CodegenConfig::IsGeneratorEnabled<AggScanPipelineCodegen>() {
+  return codegen_agg_scan_pipeline;
+}
+
+template<>
+inline bool CodegenConfig::IsGeneratorEnabled<CopyInputAttributesCodegen>() {
+  return codegen_copy_input_attributes;
+}
+
 
 /** @} */
 
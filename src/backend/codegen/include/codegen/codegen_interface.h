@@ -23,6 +23,7 @@ namespace gpcodegen {
 
 // Forward declaration
 class GpCodegenUtils;
+class CodegenManager;
 
 /**
  * @brief Interface for all code generators.
@@ -97,14 +98,18 @@ class CodegenInterface {
    * @brief	Utility function to construct a unique function name from the
    * 			original function name by appending a numeric suffix.
    *
+   * @param manager	The manager whose module the function is generated in.
+   * 			Names are unique within that module, or within the
+   * 			backend if there is no manager.
    * @param orig_func_name	Function name that needs to be made unique.
    * @return 	Unique string for given input string.
    *
    **/
-  static std::string GenerateUniqueName(const std::string& orig_func_name);
+  static std::string GenerateUniqueName(CodegenManager* manager,
+                                        const std::string& orig_func_name);
 
  private:
-  // Unique counter for all instances of Codegen Interface.
+  // Unique counter for instances of Codegen Interface without a manager.
   static unsigned unique_counter_;
 };
 
@@ -18,6 +18,8 @@
 #include <string>
 
 #include "codegen/utils/macros.h"
+#include "codegen/codegen_async_compiler.h"
+#include "codegen/codegen_cache.h"
 #include "codegen/codegen_config.h"
 #include "codegen/codegen_interface.h"
 #include "codegen/base_codegen.h"
@@ -46,7 +48,11 @@ class CodegenManager {
    **/
   explicit CodegenManager(const std::string& module_name);
 
-  ~CodegenManager() = default;
+  /**
+   * @brief Destructor. Cancels the background compilation of the module, if
+   *        it is still pending.
+   **/
+  ~CodegenManager();
 
   /**
    * @brief Template function to facilitate enroll for any type of
@@ -137,6 +143,55 @@ class CodegenManager {
    **/
   unsigned int PrepareGeneratedFunctions();
 
+  /**
+   * @brief Compile all the generated functions in the background. Until
+   *        they are compiled, callers keep using the regular functions, and
+   *        then the pointers are swapped by FinishAsyncCompile().
+   *
+   * @note The module must not be used anymore by the backend, until the
+   *       compilation finishes.
+   *
+   * @return The number of enrolled codegen that successully generated code
+   *         and whose compiled function is used right away, i.e. 0 unless
+   *         the background compiler is unavailable and the functions were
+   *         compiled synchronously.
+   **/
+  unsigned int PrepareGeneratedFunctionsAsync();
+
+  /**
+   * @brief Called by CodegenAsyncCompiler, in the backend, when the
+   *        compilation started by PrepareGeneratedFunctionsAsync() is done.
+   *
+   * @param is_compiled true if the module was compiled successfully.
+   * @return The number of enrolled codegen whose compiled function is now
+   *         used.
+   **/
+  unsigned int FinishAsyncCompile(bool is_compiled);
+
+  /**
+   * @brief Cancel the background compilation, if any, because the query of
+   *        the manager aborted. The regular functions stay in use.
+   *
+   * @note If the module is being compiled, the compiler thread takes it
+   *       over, so the manager is left without one.
+   **/
+  void AbandonAsyncCompile();
+
+  /**
+   * @brief Compile the module of a GpCodegenUtils, with the compiled code
+   *        cache if it is enabled.
+   *
+   * @note This runs in the background compiler thread as well: it doesn't
+   *       use any backend state but for the cache, and compilations are
+   *       serialized.
+   *
+   * @param codegen_utils Utility that holds the module.
+   * @param settings Settings to compile the module with.
+   * @return true on success.
+   **/
+  static bool CompileModule(GpCodegenUtils* codegen_utils,
+                            const CodegenCache::Settings& settings);
+
   /**
    * @brief 	Notifies the manager of a parameter change.
    *
@@ -172,6 +227,21 @@ class CodegenManager {
    */
   const std::string& GetExplainString();
 
+  /**
+   * @brief Generate a name for a generated function that is unique in the
+   *        module of this manager.
+   *
+   * @note Names are numbered per manager rather than per backend, so that
+   *       repeated executions of a query generate identical modules that
+   *       CodegenCache can share the compiled code of.
+   *
+   * @param orig_func_name Function name that needs to be made unique.
+   * @return Unique string for given input string.
+   **/
+  std::string GenerateUniqueFuncName(const std::string& orig_func_name) {
+    return orig_func_name + std::to_string(unique_counter_++);
+  }
+
  private:
   // GpCodegenUtils provides a facade to LLVM subsystem.
   std::unique_ptr<gpcodegen::GpCodegenUtils> codegen_utils_;
@@ -184,6 +254,16 @@ class CodegenManager {
   // Holds the dumped IR of all underlying modules for EXPLAIN CODEGEN queries
   std::string explain_string_;
 
+  // Counter for the names of generated functions in this manager's module
+  unsigned unique_counter_;
+
+  // Pending background compilation of the module, if any
+  CodegenAsyncCompiler::Job* async_job_;
+
+  // Swap in the compiled functions of all the generators that successfully
+  // generated code. Returns the number of swapped functions.
+  unsigned int InstallGeneratedFunctions();
+
   DISALLOW_COPY_AND_ASSIGN(CodegenManager);
 };
 
@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    copy_input_attributes_codegen.h
+//
+//  @doc:
+//    Headers for CopyInputAttributes codegen.
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPCODEGEN_COPY_INPUT_ATTRIBUTES_CODEGEN_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_COPY_INPUT_ATTRIBUTES_CODEGEN_H_
+
+#include "codegen/base_codegen.h"
+#include "codegen/codegen_wrapper.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "access/tupdesc.h"
+}
+
+struct CopyStateData;
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class CopyInputAttributesCodegen: public BaseCodegen<CopyInputAttributesFn> {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param regular_func_ptr        Regular version of the target function.
+   * @param ptr_to_chosen_func_ptr  Reference to the function pointer that the
+   *                                caller will call.
+   * @param cstate                  State of the COPY FROM, with its input
+   *                                functions and options set.
+   * @param tupdesc                 Descriptor of the target relation.
+   *
+   * @note 	The ptr_to_chosen_func_ptr can refer to either the generated
+   *        function or the corresponding regular version.
+   *
+   **/
+  explicit CopyInputAttributesCodegen(
+      CodegenManager* manager,
+      CopyInputAttributesFn regular_func_ptr,
+      CopyInputAttributesFn* ptr_to_regular_func_ptr,
+      CopyStateData* cstate,
+      TupleDesc tupdesc);
+
+  virtual ~CopyInputAttributesCodegen() = default;
+
+ protected:
+  /**
+   * @brief Generate code for CopyInputAttributes.
+   *
+   * @param codegen_utils
+   *
+   * @return true on successful generation; false otherwise.
+   *
+   * The generated function is unrolled over the attributes of the COPY, with
+   * the input function, typioparam, typmod and FORCE NOT NULL flag of each
+   * attribute as constants. smallint, integer and bigint attributes are
+   * parsed inline; any value that the inline parser doesn't accept, such as
+   * an out of range one, is passed to the input function, so that the errors
+   * are the same as without codegen.
+   *
+   */
+  bool GenerateCodeInternal(gpcodegen::GpCodegenUtils* codegen_utils) final;
+
+ private:
+  CopyStateData* cstate_;
+  TupleDesc tupdesc_;
+
+  static constexpr char kCopyInputAttributesPrefix[] = "CopyInputAttributes";
+
+  /**
+   * @brief Generates runtime code that implements CopyInputAttributes.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @return true on successful generation.
+   **/
+  bool GenerateCopyInputAttributes(gpcodegen::GpCodegenUtils* codegen_utils);
+
+  /**
+   * @brief Generates a function that parses a decimal integer the way the
+   *        input functions of the integer types do.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @return The function, of type bool (*)(const char* str, int64* result).
+   *
+   * The function accepts leading and trailing ASCII white space, an optional
+   * sign and up to 18 digits, and returns false for anything else, in which
+   * case the caller falls back to the input function.
+   **/
+  llvm::Function* GenerateParseInt(gpcodegen::GpCodegenUtils* codegen_utils);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+#endif  // GPCODEGEN_COPY_INPUT_ATTRIBUTES_CODEGEN_H_
@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    exec_hash_get_hash_value_codegen.h
+//
+//  @doc:
+//    Headers for ExecHashGetHashValue codegen.
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPCODEGEN_EXECHASHGETHASHVALUE_CODEGEN_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_EXECHASHGETHASHVALUE_CODEGEN_H_
+
+#include "codegen/base_codegen.h"
+#include "codegen/codegen_wrapper.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class ExecHashGetHashValueCodegen
+    : public BaseCodegen<ExecHashGetHashValueFn> {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param regular_func_ptr        Regular version of the target function.
+   * @param ptr_to_chosen_func_ptr  Reference to the function pointer that the
+   *                                caller will call.
+   * @param hashkeys                List of ExprStates of the hash keys.
+   * @param hashoperators           List of the OIDs of the hash operators.
+   * @param outer_tuple             true if the hash keys are those of the
+   *                                outer side of the hash join.
+   *
+   * @note 	The ptr_to_chosen_func_ptr can refer to either the generated
+   *        function or the corresponding regular version.
+   *
+   **/
+  explicit ExecHashGetHashValueCodegen(
+      CodegenManager* manager,
+      ExecHashGetHashValueFn regular_func_ptr,
+      ExecHashGetHashValueFn* ptr_to_regular_func_ptr,
+      List *hashkeys,
+      List *hashoperators,
+      bool outer_tuple);
+
+  virtual ~ExecHashGetHashValueCodegen() = default;
+
+ protected:
+  /**
+   * @brief Generate code for ExecHashGetHashValue.
+   *
+   * @param codegen_utils
+   *
+   * @return true on successful generation; false otherwise.
+   *
+   * The generated function is specialized for the hash keys and hash
+   * functions of one side of the hash join, and ignores the hashkeys and
+   * outer_tuple arguments it is called with.
+   *
+   * This implementation only supports hash keys that are plain Vars, and
+   * hash functions for which OpExprTreeGenerator has a generator. Otherwise,
+   * we fall back to the regular function.
+   *
+   */
+  bool GenerateCodeInternal(gpcodegen::GpCodegenUtils* codegen_utils) final;
+
+ private:
+  List *hashkeys_;
+  List *hashoperators_;
+  bool outer_tuple_;
+
+  static constexpr char kExecHashGetHashValuePrefix[] = "ExecHashGetHashValue";
+
+  /**
+   * @brief Generates runtime code that implements ExecHashGetHashValue.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @return true on successful generation.
+   **/
+  bool GenerateExecHashGetHashValue(gpcodegen::GpCodegenUtils* codegen_utils);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+#endif  // GPCODEGEN_EXECHASHGETHASHVALUE_CODEGEN_H_
@@ -39,7 +39,12 @@ namespace gpcodegen {
 enum class ExprTreeNodeType {
   kConst = 0,
   kVar = 1,
-  kOperator = 2
+  kOperator = 2,
+  kBoolExpr = 3,
+  kNullTest = 4,
+  kCase = 5,
+  kCoalesce = 6,
+  kScalarArrayOp = 7
 };
 
 /**
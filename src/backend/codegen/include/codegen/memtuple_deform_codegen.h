@@ -0,0 +1,122 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    memtuple_deform_codegen.h
+//
+//  @doc:
+//    Headers for memtuple_getsomeattrs codegen.
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPCODEGEN_MEMTUPLE_DEFORM_CODEGEN_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_MEMTUPLE_DEFORM_CODEGEN_H_
+
+#include "codegen/base_codegen.h"
+#include "codegen/codegen_wrapper.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "access/memtup.h"
+#include "access/tupdesc.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class MemTupleDeformCodegen: public BaseCodegen<MemTupleDeformFn> {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param regular_func_ptr        Regular version of the target function.
+   * @param ptr_to_chosen_func_ptr  Reference to the function pointer that the
+   *                                caller will call.
+   * @param tupdesc                 Descriptor of the memtuples to deform.
+   * @param natts                   Number of leading attributes to deform.
+   *
+   * @note 	The ptr_to_chosen_func_ptr can refer to either the generated
+   *        function or the corresponding regular version.
+   *
+   **/
+  explicit MemTupleDeformCodegen(
+      CodegenManager* manager,
+      MemTupleDeformFn regular_func_ptr,
+      MemTupleDeformFn* ptr_to_regular_func_ptr,
+      TupleDesc tupdesc,
+      int natts);
+
+  virtual ~MemTupleDeformCodegen() = default;
+
+ protected:
+  /**
+   * @brief Generate code for memtuple_getsomeattrs.
+   *
+   * @param codegen_utils
+   *
+   * @return true on successful generation; false otherwise.
+   *
+   * The generated function is specialized for the MemTupleBinding of tupdesc:
+   * the offsets of the attributes are constants and the null bitmap is
+   * walked one bit at a time with the space saved by each null attribute as
+   * a constant. Calls that ask for more than natts attributes fall back to
+   * the regular function.
+   *
+   */
+  bool GenerateCodeInternal(gpcodegen::GpCodegenUtils* codegen_utils) final;
+
+ private:
+  TupleDesc tupdesc_;
+  int natts_;
+
+  static constexpr char kMemTupleDeformPrefix[] = "MemTupleDeform";
+
+  /**
+   * @brief Generates runtime code that implements memtuple_getsomeattrs.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @return true on successful generation.
+   **/
+  bool GenerateMemTupleDeform(gpcodegen::GpCodegenUtils* codegen_utils);
+
+  /**
+   * @brief Generates the deforming of a memtuple for one layout.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @param pbind The binding of tupdesc_.
+   * @param colbind pbind->bind for small memtuples, pbind->large_bind for
+   *        large ones.
+   * @param hasnull true if the memtuple has a null bitmap.
+   * @param llvm_mtup The memtuple.
+   * @param llvm_values The array of values to fill in.
+   * @param llvm_isnull The array of null flags to fill in.
+   * @param deform_func The generated function.
+   * @return true on successful generation.
+   *
+   * The code is emitted at the current insertion point and returns from the
+   * function.
+   **/
+  bool GenerateDeformForLayout(gpcodegen::GpCodegenUtils* codegen_utils,
+                               const MemTupleBinding* pbind,
+                               const MemTupleBindingCols* colbind,
+                               bool hasnull,
+                               llvm::Value* llvm_mtup,
+                               llvm::Value* llvm_values,
+                               llvm::Value* llvm_isnull,
+                               llvm::Function* deform_func);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+#endif  // GPCODEGEN_MEMTUPLE_DEFORM_CODEGEN_H_
@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    mk_compare_datum_codegen.h
+//
+//  @doc:
+//    Headers for tupsort_compare_datum codegen.
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPCODEGEN_MK_COMPARE_DATUM_CODEGEN_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_MK_COMPARE_DATUM_CODEGEN_H_
+
+#include <vector>
+
+#include "codegen/base_codegen.h"
+#include "codegen/codegen_wrapper.h"
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class MKCompareDatumCodegen: public BaseCodegen<MKCompareDatumFn> {
+ public:
+  /**
+   * @brief Constructor
+   *
+   * @param regular_func_ptr        Regular version of the target function.
+   * @param ptr_to_chosen_func_ptr  Reference to the function pointer that the
+   *                                caller will call.
+   * @param nkeys                   Number of sort keys, i.e. levels.
+   * @param sort_functions          Oids of the btree comparison functions of
+   *                                the sort keys.
+   * @param reverse                 true for the keys that are sorted in
+   *                                descending order.
+   *
+   * @note 	The ptr_to_chosen_func_ptr can refer to either the generated
+   *        function or the corresponding regular version.
+   *
+   **/
+  explicit MKCompareDatumCodegen(
+      CodegenManager* manager,
+      MKCompareDatumFn regular_func_ptr,
+      MKCompareDatumFn* ptr_to_regular_func_ptr,
+      int nkeys,
+      const Oid* sort_functions,
+      const bool* reverse);
+
+  virtual ~MKCompareDatumCodegen() = default;
+
+ protected:
+  /**
+   * @brief Generate code for tupsort_compare_datum.
+   *
+   * @param codegen_utils
+   *
+   * @return true on successful generation; false otherwise.
+   *
+   * The generated function dispatches on the level being compared to code
+   * that is specialized for the comparison function and direction of that
+   * level. Null entries never reach the comparator, as their ordering is
+   * already encoded in the compflags of the entries. Levels whose datums are
+   * prepared with strxfrm are compared by the regular function.
+   *
+   */
+  bool GenerateCodeInternal(gpcodegen::GpCodegenUtils* codegen_utils) final;
+
+ private:
+  std::vector<Oid> sort_functions_;
+  std::vector<bool> reverse_;
+
+  static constexpr char kMKCompareDatumPrefix[] = "MKCompareDatum";
+
+  /**
+   * @brief Generates runtime code that implements tupsort_compare_datum.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @return true on successful generation.
+   **/
+  bool GenerateMKCompareDatum(gpcodegen::GpCodegenUtils* codegen_utils);
+
+  /**
+   * @brief Generates the comparison of the datums of one level.
+   *
+   * @param codegen_utils Utility to ease the code generation process.
+   * @param lv The level.
+   * @param llvm_d1 The datum of the first entry.
+   * @param llvm_d2 The datum of the second entry.
+   * @param compare_func The generated function.
+   * @param error_block Block to jump to if the comparison function reports
+   *        an error.
+   * @param llvm_out_result Set to the result of the comparison, before it is
+   *        reversed; nullptr if the comparison function is not supported.
+   * @return true on successful generation.
+   **/
+  bool GenerateCompareLevel(gpcodegen::GpCodegenUtils* codegen_utils,
+                            int lv,
+                            llvm::Value* llvm_d1,
+                            llvm::Value* llvm_d2,
+                            llvm::Function* compare_func,
+                            llvm::BasicBlock* error_block,
+                            llvm::Value** llvm_out_result);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+#endif  // GPCODEGEN_MK_COMPARE_DATUM_CODEGEN_H_
@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    null_test_expr_tree_generator.h
+//
+//  @doc:
+//    Object that generate code for IS [NOT] NULL expression.
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_NULL_TEST_EXPR_TREE_GENERATOR_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_NULL_TEST_EXPR_TREE_GENERATOR_H_
+
+#include "codegen/expr_tree_generator.h"
+#include "codegen/codegen_wrapper.h"
+
+#include "llvm/IR/Value.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+/**
+ * @brief Object that generate code for IS [NOT] NULL expression.
+ *
+ * Only scalar arguments are supported; a row-typed argument needs to check
+ * its fields, which is left to ExecEvalNullTest().
+ **/
+class NullTestExprTreeGenerator : public ExprTreeGenerator {
+ public:
+  static bool VerifyAndCreateExprTree(
+        const ExprState* expr_state,
+        ExprTreeGeneratorInfo* gen_info,
+        std::unique_ptr<ExprTreeGenerator>* expr_tree);
+
+  bool GenerateCode(gpcodegen::GpCodegenUtils* codegen_utils,
+                    const ExprTreeGeneratorInfo& gen_info,
+                    llvm::Value** llvm_out_value,
+                    llvm::Value* const llvm_isnull_ptr) final;
+
+ protected:
+  /**
+   * @brief Constructor.
+   *
+   * @param expr_state Expression state
+   * @param arg        Argument of the null test
+   **/
+  NullTestExprTreeGenerator(
+      const ExprState* expr_state,
+      std::unique_ptr<ExprTreeGenerator>&& arg);  // NOLINT(build/c++11)
+
+ private:
+  std::unique_ptr<ExprTreeGenerator> arg_;
+};
+
+/** @} */
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_NULL_TEST_EXPR_TREE_GENERATOR_H_
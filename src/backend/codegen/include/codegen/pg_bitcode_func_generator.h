@@ -0,0 +1,111 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    pg_bitcode_func_generator.h
+//
+//  @doc:
+//    Object that generate code for built-in functions by inlining their
+//    LLVM bitcode
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_PG_BITCODE_FUNC_GENERATOR_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_PG_BITCODE_FUNC_GENERATOR_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "codegen/pg_func_generator_interface.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "fmgr.h"
+}
+
+namespace llvm {
+class MemoryBuffer;
+class Value;
+}  // namespace llvm
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class GpCodegenUtils;
+struct PGFuncGeneratorInfo;
+
+/**
+ * @brief Object that generates code for a built-in function that has no
+ *        hand-written generator, by calling its fmgr entry point and inlining
+ *        the body of the entry point from the bitcode library of built-ins.
+ *
+ * The bitcode library, gpcodegen_builtins.bc, is built from a selection of
+ * the sources under utils/adt and installed in $libdir.
+ **/
+class PGBitcodeFuncGenerator : public PGFuncGeneratorInterface {
+ public:
+  /**
+   * @brief Look up the generator of a built-in function.
+   *
+   * @param oid The oid of the function.
+   * @return The generator, or nullptr if the function is not a built-in
+   *         function with a fixed number of arguments, or the bitcode library
+   *         does not define it.
+   **/
+  static PGFuncGeneratorInterface* GetPGFuncGenerator(unsigned int oid);
+
+  std::string GetName() final {
+    return pg_func_name_;
+  }
+
+  size_t GetTotalArgCount() final {
+    return total_arg_count_;
+  }
+
+  bool IsStrict() final {
+    return is_strict_;
+  }
+
+  bool GenerateCode(gpcodegen::GpCodegenUtils* codegen_utils,
+                    const PGFuncGeneratorInfo& pg_func_info,
+                    llvm::Value** llvm_out_value,
+                    llvm::Value* const llvm_isnull_ptr) final;
+
+ private:
+  PGBitcodeFuncGenerator(unsigned int pg_func_oid,
+                         const std::string& pg_func_name,
+                         size_t total_arg_count,
+                         bool is_strict);
+
+  /**
+   * @return The bitcode library of built-ins, or nullptr if it could not be
+   *         loaded. It is loaded once per backend.
+   **/
+  static const llvm::MemoryBuffer* GetBitcodeLibrary();
+
+  /**
+   * @return true if the bitcode library defines a function named name.
+   **/
+  static bool IsDefinedInBitcodeLibrary(const std::string& name);
+
+  unsigned int pg_func_oid_;
+  std::string pg_func_name_;
+  size_t total_arg_count_;
+  bool is_strict_;
+  // Passed as fcinfo->flinfo, for the functions that look at it. It lives as
+  // long as the generator, i.e. until the backend exits.
+  FmgrInfo flinfo_;
+
+  static std::unordered_map<unsigned int,
+                            std::unique_ptr<PGBitcodeFuncGenerator>>
+      bitcode_functions_;
+};
+
+/** @} */
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_PG_BITCODE_FUNC_GENERATOR_H_
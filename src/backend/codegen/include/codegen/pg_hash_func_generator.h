@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    pg_hash_func_generator.h
+//
+//  @doc:
+//    Object that generate code for hash support functions
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_PG_HASH_FUNC_GENERATOR_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_PG_HASH_FUNC_GENERATOR_H_
+
+#include "codegen/pg_func_generator_interface.h"
+
+namespace llvm {
+class Value;
+}  // namespace llvm
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+class GpCodegenUtils;
+struct PGFuncGeneratorInfo;
+
+/**
+ * @brief Class with static member functions to generate code for the hash
+ *        support functions of the integer hash opclasses.
+ *
+ * The generated code must compute the same hash values as the regular
+ * functions in hashfunc.c, since generated and regular code may hash into
+ * the same hash tables and spill files.
+ **/
+class PGHashFuncGenerator {
+ public:
+  /**
+   * @brief Create instructions for hashchar function
+   *
+   * @param codegen_utils     Utility to easy code generation.
+   * @param pg_func_info      Details for pgfunc generation
+   * @param llvm_out_value    Store the 32-bit hash value
+   *
+   * @return true if generation was successful otherwise return false
+   **/
+  static bool HashChar(gpcodegen::GpCodegenUtils* codegen_utils,
+                       const PGFuncGeneratorInfo& pg_func_info,
+                       llvm::Value** llvm_out_value);
+
+  /**
+   * @brief Create instructions for hashint2 function
+   *
+   * @param codegen_utils     Utility to easy code generation.
+   * @param pg_func_info      Details for pgfunc generation
+   * @param llvm_out_value    Store the 32-bit hash value
+   *
+   * @return true if generation was successful otherwise return false
+   **/
+  static bool HashInt2(gpcodegen::GpCodegenUtils* codegen_utils,
+                       const PGFuncGeneratorInfo& pg_func_info,
+                       llvm::Value** llvm_out_value);
+
+  /**
+   * @brief Create instructions for hashint4, hashoid and hashenum functions
+   *
+   * @param codegen_utils     Utility to easy code generation.
+   * @param pg_func_info      Details for pgfunc generation
+   * @param llvm_out_value    Store the 32-bit hash value
+   *
+   * @return true if generation was successful otherwise return false
+   **/
+  static bool HashInt4(gpcodegen::GpCodegenUtils* codegen_utils,
+                       const PGFuncGeneratorInfo& pg_func_info,
+                       llvm::Value** llvm_out_value);
+
+  /**
+   * @brief Create instructions for hashint8 function
+   *
+   * @param codegen_utils     Utility to easy code generation.
+   * @param pg_func_info      Details for pgfunc generation
+   * @param llvm_out_value    Store the 32-bit hash value
+   *
+   * @return true if generation was successful otherwise return false
+   **/
+  static bool HashInt8(gpcodegen::GpCodegenUtils* codegen_utils,
+                       const PGFuncGeneratorInfo& pg_func_info,
+                       llvm::Value** llvm_out_value);
+
+ private:
+  /**
+   * @brief Create instructions for hash_uint32.
+   *
+   * @param codegen_utils     Utility to easy code generation.
+   * @param llvm_key          32-bit integer to hash.
+   *
+   * @return 32-bit hash value of llvm_key.
+   **/
+  static llvm::Value* GenerateHashUInt32(
+      gpcodegen::GpCodegenUtils* codegen_utils,
+      llvm::Value* llvm_key);
+};
+
+/** @} */
+
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_PG_HASH_FUNC_GENERATOR_H_
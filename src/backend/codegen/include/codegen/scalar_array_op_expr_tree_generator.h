@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    scalar_array_op_expr_tree_generator.h
+//
+//  @doc:
+//    Object that generate code for scalar op ANY/ALL (array) expression.
+//
+//---------------------------------------------------------------------------
+#ifndef GPCODEGEN_SCALAR_ARRAY_OP_EXPR_TREE_GENERATOR_H_  // NOLINT(build/header_guard)
+#define GPCODEGEN_SCALAR_ARRAY_OP_EXPR_TREE_GENERATOR_H_
+
+#include <vector>
+
+#include "codegen/expr_tree_generator.h"
+#include "codegen/codegen_wrapper.h"
+
+#include "llvm/IR/Value.h"
+
+namespace gpcodegen {
+
+/** \addtogroup gpcodegen
+ *  @{
+ */
+
+/**
+ * @brief Object that generate code for scalar op ANY/ALL (array) expression.
+ *
+ * Only constant arrays of pass-by-value elements, and operators for which
+ * OpExprTreeGenerator has a generator, are supported. The elements are
+ * unrolled at generation time; x = ANY (array) over integer-like types is
+ * compiled to a switch, which LLVM lowers to a jump table or a binary search.
+ **/
+class ScalarArrayOpExprTreeGenerator : public ExprTreeGenerator {
+ public:
+  static bool VerifyAndCreateExprTree(
+        const ExprState* expr_state,
+        ExprTreeGeneratorInfo* gen_info,
+        std::unique_ptr<ExprTreeGenerator>* expr_tree);
+
+  bool GenerateCode(gpcodegen::GpCodegenUtils* codegen_utils,
+                    const ExprTreeGeneratorInfo& gen_info,
+                    llvm::Value** llvm_out_value,
+                    llvm::Value* const llvm_isnull_ptr) final;
+
+ protected:
+  /**
+   * @brief Constructor.
+   *
+   * @param expr_state    Expression state
+   * @param scalar_arg    Scalar argument of the expression
+   * @param elements      Non-NULL elements of the constant array
+   * @param typlen        Length of the array element type
+   * @param has_nulls     true if the constant array has NULL elements
+   **/
+  ScalarArrayOpExprTreeGenerator(
+      const ExprState* expr_state,
+      std::unique_ptr<ExprTreeGenerator>&& scalar_arg,  // NOLINT(build/c++11)
+      std::vector<Datum>&& elements,  // NOLINT(build/c++11)
+      int16_t typlen,
+      bool has_nulls);
+
+ private:
+  std::unique_ptr<ExprTreeGenerator> scalar_arg_;
+  std::vector<Datum> elements_;
+  int16_t typlen_;
+  bool has_nulls_;
+
+  /**
+   * @brief Generate x = ANY (array) as a switch over the array elements.
+   **/
+  bool GenerateSwitch(gpcodegen::GpCodegenUtils* codegen_utils,
+                      llvm::Value* llvm_scalar,
+                      llvm::Value* llvm_result_ptr,
+                      llvm::Value* const llvm_isnull_ptr,
+                      llvm::BasicBlock* end_block);
+
+  /**
+   * @brief Generate one call of the operator per array element, combined
+   * with OR (ANY) or AND (ALL) and short-circuited.
+   **/
+  bool GenerateUnrolledLoop(gpcodegen::GpCodegenUtils* codegen_utils,
+                            const ExprTreeGeneratorInfo& gen_info,
+                            llvm::Value* llvm_scalar,
+                            llvm::Value* llvm_result_ptr,
+                            llvm::Value* const llvm_isnull_ptr,
+                            llvm::BasicBlock* end_block);
+};
+
+/** @} */
+}  // namespace gpcodegen
+
+#endif  // GPCODEGEN_SCALAR_ARRAY_OP_EXPR_TREE_GENERATOR_H_
@@ -32,6 +32,7 @@
 #include "llvm/ADT/Twine.h"
 #include "llvm/Analysis/CallGraph.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -44,6 +45,7 @@
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 
 namespace gpcodegen {
@@ -450,11 +452,23 @@ class CodegenUtils {
    *        code at the expense of increased compilation time.
    * @param optimize_for_host_cpu If true, LLVM will optimize generated machine
    *        code for the specific CPU model we are running on.
+   * @param object_cache If not NULL, MCJIT looks up the compiled objects of
+   *        modules in this cache before compiling them, and stores the objects
+   *        it compiles in it.
    * @return true if an ExecutionEngine was set up successfully, false if some
    *         error occured.
    **/
   bool PrepareForExecution(const OptimizationLevel cpu_opt_level,
-                           const bool optimize_for_host_cpu);
+                           const bool optimize_for_host_cpu,
+                           llvm::ObjectCache* object_cache = nullptr);
+
+  /**
+   * @brief Compile all the functions prepared by PrepareForExecution() now,
+   *        instead of on the first call to GetFunctionPointer().
+   *
+   * @return true if an ExecutionEngine was set up by PrepareForExecution().
+   **/
+  bool FinalizeForExecution();
 
   /**
    * @brief Get a pointer to the compiled machine-code version of a function
@@ -504,6 +518,28 @@ class CodegenUtils {
     return llvm::InlineFunction(llvm::CallSite(call_inst), info);
   }
 
+  /**
+   * @brief Link the body of a function that is defined in an LLVM bitcode
+   *        library into the module managed by this CodegenUtils, so that calls
+   *        to it can be inlined with InlineFunction().
+   *
+   * @note Only the requested function and the file-local functions and
+   *       variables it refers to are linked. The function itself gets internal
+   *       linkage. Any other function it calls, and any global variable with
+   *       external linkage, is left as a declaration and resolved to the
+   *       symbol of the running executable. This way the linked code shares
+   *       state with the executable instead of using its own copies.
+   *
+   * @param bitcode The LLVM bitcode library. It must outlive this CodegenUtils.
+   * @param function_name The name of the function to link.
+   * @return The linked function, or NULL if the library could not be parsed,
+   *         does not define function_name, or this module already declares a
+   *         function named function_name. If the function was already linked
+   *         by a previous call, it is returned again.
+   **/
+  llvm::Function* LinkFunctionFromBitcode(const llvm::MemoryBufferRef& bitcode,
+                                          const std::string& function_name);
+
   /*
    * @brief Dump the IR of all underlying LLVM modules.
    *
@@ -0,0 +1,370 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    memtuple_deform_codegen.cc
+//
+//  @doc:
+//    Generates code for memtuple_getsomeattrs function.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <stddef.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "codegen/memtuple_deform_codegen.h"
+#include "codegen/utils/gp_codegen_utils.h"
+#include "codegen/utils/utility.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "access/memtup.h"
+#include "access/tupdesc.h"
+#include "catalog/pg_attribute.h"
+#include "utils/elog.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+using gpcodegen::MemTupleDeformCodegen;
+
+constexpr char MemTupleDeformCodegen::kMemTupleDeformPrefix[];
+
+MemTupleDeformCodegen::MemTupleDeformCodegen(
+    CodegenManager* manager,
+    MemTupleDeformFn regular_func_ptr,
+    MemTupleDeformFn* ptr_to_regular_func_ptr,
+    TupleDesc tupdesc,
+    int natts)
+: BaseCodegen(manager,
+              kMemTupleDeformPrefix,
+              regular_func_ptr,
+              ptr_to_regular_func_ptr),
+              tupdesc_(tupdesc),
+              natts_(natts) {
+}
+
+bool MemTupleDeformCodegen::GenerateDeformForLayout(
+    gpcodegen::GpCodegenUtils* codegen_utils,
+    const MemTupleBinding* pbind,
+    const MemTupleBindingCols* colbind,
+    bool hasnull,
+    llvm::Value* llvm_mtup,
+    llvm::Value* llvm_values,
+    llvm::Value* llvm_isnull,
+    llvm::Function* deform_func) {
+  auto irb = codegen_utils->ir_builder();
+  const std::string layout_name =
+      std::string(colbind == &pbind->large_bind ? "large" : "small") +
+      (hasnull ? "_hasnull" : "");
+
+  // char *start = (char *) mtup + (hasnull ? null_bitmap_extra_size : 0);
+  llvm::Value* llvm_mtup_bytes = irb->CreateBitCast(
+      llvm_mtup, codegen_utils->GetType<char*>());
+  llvm::Value* llvm_start = irb->CreateInBoundsGEP(
+      llvm_mtup_bytes,
+      codegen_utils->GetConstant<int32>(
+          hasnull ? pbind->null_bitmap_extra_size : 0));
+
+  // The space saved by the null attributes that physically precede each
+  // attribute, i.e. compute_null_save() with the null bitmap walked one bit
+  // at a time. null_saves_aligned has an entry for each combination of 4
+  // bits; the entry with only bit p set is the space saved when physical
+  // column p is null.
+  std::vector<llvm::Value*> llvm_null_bytes;
+  std::vector<llvm::Value*> llvm_null_saves_before;
+  if (hasnull) {
+    int max_physical_col = -1;
+    for (int i = 0; i < natts_; ++i) {
+      const MemTupleAttrBinding& attrbind = colbind->bindings[i];
+      int physical_col = (attrbind.null_byte << 3) +
+          __builtin_ctz(attrbind.null_mask);
+      max_physical_col = std::max(max_physical_col, physical_col);
+    }
+
+    // unsigned char *nullp = memtuple_get_nullp(mtup, pbind);
+    llvm::Value* llvm_nullp = irb->CreateInBoundsGEP(
+        llvm_mtup_bytes,
+        codegen_utils->GetConstant<int32>(
+            offsetof(MemTupleData, PRIVATE_mt_bits) +
+            (pbind->tupdesc->tdhasoid ? sizeof(Oid) : 0)));
+    for (int b = 0; b <= (max_physical_col >> 3); ++b) {
+      llvm_null_bytes.push_back(irb->CreateLoad(irb->CreateInBoundsGEP(
+          llvm_nullp, codegen_utils->GetConstant<int32>(b))));
+    }
+
+    llvm::Value* llvm_null_save = codegen_utils->GetConstant<int32>(0);
+    for (int p = 0; p <= max_physical_col; ++p) {
+      llvm_null_saves_before.push_back(llvm_null_save);
+      short save = colbind->null_saves_aligned[  // NOLINT(runtime/int)
+          ((p >> 2) << 4) + (1 << (p & 3))];
+      if (0 == save) {
+        continue;
+      }
+      llvm::Value* llvm_bit_is_set = irb->CreateICmpNE(
+          irb->CreateAnd(llvm_null_bytes[p >> 3],
+                         codegen_utils->GetConstant<unsigned char>(
+                             1 << (p & 7))),
+          codegen_utils->GetConstant<unsigned char>(0));
+      llvm_null_save = irb->CreateAdd(
+          llvm_null_save,
+          irb->CreateSelect(llvm_bit_is_set,
+                            codegen_utils->GetConstant<int32>(save),
+                            codegen_utils->GetConstant<int32>(0)));
+    }
+  }
+
+  for (int i = 0; i < natts_; ++i) {
+    Form_pg_attribute attr = tupdesc_->attrs[i];
+    const MemTupleAttrBinding& attrbind = colbind->bindings[i];
+
+    llvm::Value* llvm_values_ptr = irb->CreateInBoundsGEP(
+        llvm_values, codegen_utils->GetConstant(i));
+    llvm::Value* llvm_isnull_ptr = irb->CreateInBoundsGEP(
+        llvm_isnull, codegen_utils->GetConstant(i));
+
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        layout_name + "_next_att_" + std::to_string(i), deform_func);
+
+    // The null attribute offsets are subtracted from the binding offset.
+    llvm::Value* llvm_attr_offset = codegen_utils->GetConstant<int32>(
+        attrbind.offset);
+    if (hasnull) {
+      llvm::BasicBlock* null_block = codegen_utils->CreateBasicBlock(
+          layout_name + "_null_att_" + std::to_string(i), deform_func);
+      llvm::BasicBlock* not_null_block = codegen_utils->CreateBasicBlock(
+          layout_name + "_not_null_att_" + std::to_string(i), deform_func);
+
+      // if (nullp[attrbind->null_byte] & attrbind->null_mask)
+      llvm::Value* llvm_is_null = irb->CreateICmpNE(
+          irb->CreateAnd(llvm_null_bytes[attrbind.null_byte],
+                         codegen_utils->GetConstant<unsigned char>(
+                             attrbind.null_mask)),
+          codegen_utils->GetConstant<unsigned char>(0));
+      irb->CreateCondBr(llvm_is_null, null_block, not_null_block);
+
+      irb->SetInsertPoint(null_block);
+      irb->CreateStore(codegen_utils->GetConstant<Datum>(0), llvm_values_ptr);
+      irb->CreateStore(codegen_utils->GetConstant<bool>(true),
+                       llvm_isnull_ptr);
+      irb->CreateBr(next_block);
+
+      irb->SetInsertPoint(not_null_block);
+      int physical_col = (attrbind.null_byte << 3) +
+          __builtin_ctz(attrbind.null_mask);
+      llvm_attr_offset = irb->CreateSub(
+          llvm_attr_offset, llvm_null_saves_before[physical_col]);
+    }
+
+    // memtuple_get_attr_data_ptr(start, attrbind, null_saves, nullp)
+    llvm::Value* llvm_attr_ptr = irb->CreateInBoundsGEP(llvm_start,
+                                                        llvm_attr_offset);
+    llvm::Value* llvm_data_ptr = llvm_attr_ptr;
+    if (MTB_ByRef == attrbind.flag || MTB_ByRef_CStr == attrbind.flag) {
+      // The fixed length area holds the offset of the data from start.
+      llvm::Value* llvm_data_offset = nullptr;
+      switch (attrbind.len) {
+        case sizeof(uint16):
+          llvm_data_offset = irb->CreateLoad(irb->CreateBitCast(
+              llvm_attr_ptr, codegen_utils->GetType<int16*>()));
+          break;
+        case sizeof(uint32):
+          llvm_data_offset = irb->CreateLoad(irb->CreateBitCast(
+              llvm_attr_ptr, codegen_utils->GetType<int32*>()));
+          break;
+        default:
+          elog(DEBUG1, "Unexpected binding length %d of attribute %d",
+               attrbind.len, i + 1);
+          return false;
+      }
+      llvm_data_ptr = irb->CreateInBoundsGEP(
+          llvm_start,
+          irb->CreateZExt(llvm_data_offset, codegen_utils->GetType<int64>()));
+    }
+
+    // values[i] = fetchatt(attr, data_ptr);
+    llvm::Value* llvm_value = nullptr;
+    if (attr->attbyval) {
+      switch (attr->attlen) {
+        case sizeof(char):
+          llvm_value = irb->CreateLoad(llvm_data_ptr);
+          break;
+        case sizeof(int16):
+          llvm_value = irb->CreateLoad(irb->CreateBitCast(
+              llvm_data_ptr, codegen_utils->GetType<int16*>()));
+          break;
+        case sizeof(int32):
+          llvm_value = irb->CreateLoad(irb->CreateBitCast(
+              llvm_data_ptr, codegen_utils->GetType<int32*>()));
+          break;
+        case sizeof(Datum):
+          llvm_value = irb->CreateLoad(irb->CreateBitCast(
+              llvm_data_ptr, codegen_utils->GetType<int64*>()));
+          break;
+        default:
+          elog(DEBUG1, "We do not support data type length %d, passed by "
+               "value", attr->attlen);
+          return false;
+      }
+      llvm_value = irb->CreateZExt(llvm_value,
+                                   codegen_utils->GetType<Datum>());
+    } else {
+      llvm_value = irb->CreatePtrToInt(llvm_data_ptr,
+                                       codegen_utils->GetType<Datum>());
+    }
+    irb->CreateStore(llvm_value, llvm_values_ptr);
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                     llvm_isnull_ptr);
+    irb->CreateBr(next_block);
+
+    irb->SetInsertPoint(next_block);
+  }
+  irb->CreateRetVoid();
+  return true;
+}
+
+bool MemTupleDeformCodegen::GenerateMemTupleDeform(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+
+  assert(NULL != codegen_utils);
+  if (nullptr == tupdesc_ ||
+      natts_ <= 0 ||
+      natts_ > tupdesc_->natts) {
+    return false;
+  }
+
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Function* deform_func = CreateFunction<MemTupleDeformFn>(
+      codegen_utils, GetUniqueFuncName());
+
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry_block", deform_func);
+  llvm::BasicBlock* deform_block = codegen_utils->CreateBasicBlock(
+      "deform_block", deform_func);
+  llvm::BasicBlock* fallback_block = codegen_utils->CreateBasicBlock(
+      "fallback_block", deform_func);
+  llvm::BasicBlock* small_block = codegen_utils->CreateBasicBlock(
+      "small_block", deform_func);
+  llvm::BasicBlock* large_block = codegen_utils->CreateBasicBlock(
+      "large_block", deform_func);
+  llvm::BasicBlock* small_hasnull_block = codegen_utils->CreateBasicBlock(
+      "small_hasnull_block", deform_func);
+  llvm::BasicBlock* small_nonull_block = codegen_utils->CreateBasicBlock(
+      "small_nonull_block", deform_func);
+  llvm::BasicBlock* large_hasnull_block = codegen_utils->CreateBasicBlock(
+      "large_hasnull_block", deform_func);
+  llvm::BasicBlock* large_nonull_block = codegen_utils->CreateBasicBlock(
+      "large_nonull_block", deform_func);
+
+  // External functions
+  llvm::Function* llvm_memtuple_getsomeattrs =
+      codegen_utils->GetOrRegisterExternalFunction(memtuple_getsomeattrs,
+                                                   "memtuple_getsomeattrs");
+
+  // Function arguments to memtuple_getsomeattrs
+  llvm::Value* llvm_mtup_arg = ArgumentByPosition(deform_func, 0);
+  llvm::Value* llvm_pbind_arg = ArgumentByPosition(deform_func, 1);
+  llvm::Value* llvm_natts_arg = ArgumentByPosition(deform_func, 2);
+  llvm::Value* llvm_values_arg = ArgumentByPosition(deform_func, 3);
+  llvm::Value* llvm_isnull_arg = ArgumentByPosition(deform_func, 4);
+
+  // entry block
+  // ----------
+  irb->SetInsertPoint(entry_block);
+
+#ifdef CODEGEN_DEBUG
+  codegen_utils->CreateElog(DEBUG1, "Codegen'ed memtuple_getsomeattrs called!");
+#endif
+
+  // Only the first natts_ attributes are generated for.
+  irb->CreateCondBr(
+      irb->CreateICmpSLE(llvm_natts_arg,
+                         codegen_utils->GetConstant<int32>(natts_)),
+      deform_block /* true */,
+      fallback_block /* false */);
+
+  // fallback block
+  // ----------
+  irb->SetInsertPoint(fallback_block);
+  irb->CreateCall(llvm_memtuple_getsomeattrs, {llvm_mtup_arg,
+                                               llvm_pbind_arg,
+                                               llvm_natts_arg,
+                                               llvm_values_arg,
+                                               llvm_isnull_arg});
+  irb->CreateRetVoid();
+
+  // deform block
+  // ----------
+  // Pick the layout from the flags of the memtuple.
+  irb->SetInsertPoint(deform_block);
+  llvm::Value* llvm_mt_len = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_mtup_arg,
+                                        &MemTupleData::PRIVATE_mt_len));
+  llvm::Value* llvm_hasnull = irb->CreateICmpNE(
+      irb->CreateAnd(llvm_mt_len,
+                     codegen_utils->GetConstant<uint32>(MEMTUP_HASNULL)),
+      codegen_utils->GetConstant<uint32>(0));
+  irb->CreateCondBr(
+      irb->CreateICmpNE(
+          irb->CreateAnd(llvm_mt_len,
+                         codegen_utils->GetConstant<uint32>(MEMTUP_LARGETUP)),
+          codegen_utils->GetConstant<uint32>(0)),
+      large_block /* true */,
+      small_block /* false */);
+
+  irb->SetInsertPoint(small_block);
+  irb->CreateCondBr(llvm_hasnull, small_hasnull_block, small_nonull_block);
+  irb->SetInsertPoint(large_block);
+  irb->CreateCondBr(llvm_hasnull, large_hasnull_block, large_nonull_block);
+
+  // The binding is only needed while generating: the generated code depends
+  // on its offsets, which are the same for any binding of tupdesc_.
+  MemTupleBinding* pbind = create_memtuple_binding(tupdesc_);
+  bool is_generated = true;
+  struct {
+    llvm::BasicBlock* block;
+    const MemTupleBindingCols* colbind;
+    bool hasnull;
+  } layouts[] = {
+      {small_nonull_block, &pbind->bind, false},
+      {small_hasnull_block, &pbind->bind, true},
+      {large_nonull_block, &pbind->large_bind, false},
+      {large_hasnull_block, &pbind->large_bind, true},
+  };
+  for (const auto& layout : layouts) {
+    irb->SetInsertPoint(layout.block);
+    is_generated = is_generated &&
+        GenerateDeformForLayout(codegen_utils, pbind, layout.colbind,
+                                layout.hasnull, llvm_mtup_arg,
+                                llvm_values_arg, llvm_isnull_arg,
+                                deform_func);
+  }
+  destroy_memtuple_binding(pbind);
+
+  return is_generated;
+}
+
+bool MemTupleDeformCodegen::GenerateCodeInternal(
+    GpCodegenUtils* codegen_utils) {
+  bool isGenerated = GenerateMemTupleDeform(codegen_utils);
+
+  if (isGenerated) {
+    elog(DEBUG1, "memtuple_getsomeattrs was generated successfully!");
+    return true;
+  } else {
+    elog(DEBUG1, "memtuple_getsomeattrs generation failed!");
+    return false;
+  }
+}
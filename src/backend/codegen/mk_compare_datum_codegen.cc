@@ -0,0 +1,240 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    mk_compare_datum_codegen.cc
+//
+//  @doc:
+//    Generates code for tupsort_compare_datum function.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <string>
+#include <vector>
+
+#include "codegen/mk_compare_datum_codegen.h"
+#include "codegen/op_expr_tree_generator.h"
+#include "codegen/pg_func_generator_interface.h"
+#include "codegen/utils/gp_codegen_utils.h"
+#include "codegen/utils/utility.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "access/memtup.h"
+#include "access/skey.h"
+#include "access/tupdesc.h"
+#include "utils/elog.h"
+#include "utils/fmgroids.h"
+#include "utils/rel.h"
+#include "utils/tuplesort_mk.h"
+}
+
+namespace llvm {
+class BasicBlock;
+class Function;
+class Value;
+}  // namespace llvm
+
+using gpcodegen::MKCompareDatumCodegen;
+
+constexpr char MKCompareDatumCodegen::kMKCompareDatumPrefix[];
+
+MKCompareDatumCodegen::MKCompareDatumCodegen(
+    CodegenManager* manager,
+    MKCompareDatumFn regular_func_ptr,
+    MKCompareDatumFn* ptr_to_regular_func_ptr,
+    int nkeys,
+    const Oid* sort_functions,
+    const bool* reverse)
+: BaseCodegen(manager,
+              kMKCompareDatumPrefix,
+              regular_func_ptr,
+              ptr_to_regular_func_ptr),
+              sort_functions_(sort_functions, sort_functions + nkeys),
+              reverse_(reverse, reverse + nkeys) {
+}
+
+bool MKCompareDatumCodegen::GenerateCompareLevel(
+    gpcodegen::GpCodegenUtils* codegen_utils,
+    int lv,
+    llvm::Value* llvm_d1,
+    llvm::Value* llvm_d2,
+    llvm::Function* compare_func,
+    llvm::BasicBlock* error_block,
+    llvm::Value** llvm_out_result) {
+  auto irb = codegen_utils->ir_builder();
+  *llvm_out_result = nullptr;
+
+  if (F_BTINT4CMP == sort_functions_[lv]) {
+    // As for MKLV_TYPE_INT32 levels:
+    // result = (i1 < i2) ? -1 : ((i1 == i2) ? 0 : 1);
+    llvm::Value* llvm_i1 =
+        codegen_utils->CreateDatumToCppTypeCast<int32>(llvm_d1);
+    llvm::Value* llvm_i2 =
+        codegen_utils->CreateDatumToCppTypeCast<int32>(llvm_d2);
+    *llvm_out_result = irb->CreateSelect(
+        irb->CreateICmpSLT(llvm_i1, llvm_i2),
+        codegen_utils->GetConstant<int32>(-1),
+        irb->CreateSelect(irb->CreateICmpEQ(llvm_i1, llvm_i2),
+                          codegen_utils->GetConstant<int32>(0),
+                          codegen_utils->GetConstant<int32>(1)));
+    return true;
+  }
+
+  gpcodegen::PGFuncGeneratorInterface* pg_func_gen =
+      gpcodegen::OpExprTreeGenerator::GetPGFuncGenerator(sort_functions_[lv]);
+  if (nullptr == pg_func_gen) {
+    elog(DEBUG1, "Comparison function with oid = %d is compared by "
+         "tupsort_compare_datum", sort_functions_[lv]);
+    return true;
+  }
+
+  // The datums of the entries are never null.
+  llvm::Value* llvm_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "isNull");
+  gpcodegen::PGFuncGeneratorInfo pg_func_info(
+      compare_func,
+      error_block,
+      {llvm_d1, llvm_d2},
+      {codegen_utils->GetConstant<bool>(false),
+       codegen_utils->GetConstant<bool>(false)});
+  llvm::Value* llvm_result = nullptr;
+  if (!pg_func_gen->GenerateCode(codegen_utils, pg_func_info, &llvm_result,
+                                 llvm_isnull_ptr)) {
+    elog(DEBUG1, "Comparison function with oid = %d was not generated "
+         "successfully!", sort_functions_[lv]);
+    return false;
+  }
+  *llvm_out_result = codegen_utils->CreateDatumToCppTypeCast<int32>(
+      codegen_utils->CreateCppTypeToDatumCast(llvm_result));
+  return true;
+}
+
+bool MKCompareDatumCodegen::GenerateMKCompareDatum(
+    gpcodegen::GpCodegenUtils* codegen_utils) {
+  assert(NULL != codegen_utils);
+  if (sort_functions_.empty()) {
+    return false;
+  }
+
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Function* compare_func = CreateFunction<MKCompareDatumFn>(
+      codegen_utils, GetUniqueFuncName());
+
+  llvm::Value* llvm_v1_arg = ArgumentByPosition(compare_func, 0);
+  llvm::Value* llvm_v2_arg = ArgumentByPosition(compare_func, 1);
+  llvm::Value* llvm_lvctxt_arg = ArgumentByPosition(compare_func, 2);
+  llvm::Value* llvm_mkctxt_arg = ArgumentByPosition(compare_func, 3);
+
+  llvm::BasicBlock* entry_block = codegen_utils->CreateBasicBlock(
+      "entry_block", compare_func);
+  llvm::BasicBlock* dispatch_block = codegen_utils->CreateBasicBlock(
+      "dispatch_block", compare_func);
+  llvm::BasicBlock* fallback_block = codegen_utils->CreateBasicBlock(
+      "fallback_block", compare_func);
+
+  // External functions
+  llvm::Function* llvm_tupsort_compare_datum =
+      codegen_utils->GetOrRegisterExternalFunction(tupsort_compare_datum,
+                                                   "tupsort_compare_datum");
+
+  // entry block
+  // ----------
+  // The datums of MKLV_TYPE_CHAR and MKLV_TYPE_TEXT levels are prepared with
+  // strxfrm, which only the regular function knows how to compare.
+  irb->SetInsertPoint(entry_block);
+
+#ifdef CODEGEN_DEBUG
+  codegen_utils->CreateElog(DEBUG1, "Codegen'ed tupsort_compare_datum called!");
+#endif
+
+  llvm::Value* llvm_lvtype = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_lvctxt_arg,
+                                        &MKLvContext::lvtype));
+  irb->CreateCondBr(
+      irb->CreateOr(
+          irb->CreateICmpEQ(llvm_lvtype,
+                            codegen_utils->GetConstant(MKLV_TYPE_CHAR)),
+          irb->CreateICmpEQ(llvm_lvtype,
+                            codegen_utils->GetConstant(MKLV_TYPE_TEXT))),
+      fallback_block /* true */,
+      dispatch_block /* false */);
+
+  // dispatch block
+  // ----------
+  // lv = lvctxt - mkctxt->lvctxt;
+  irb->SetInsertPoint(dispatch_block);
+  llvm::Value* llvm_first_lvctxt = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_mkctxt_arg,
+                                        &MKContext::lvctxt));
+  llvm::Value* llvm_lv = irb->CreateExactSDiv(
+      irb->CreateSub(
+          irb->CreatePtrToInt(llvm_lvctxt_arg, codegen_utils->GetType<int64>()),
+          irb->CreatePtrToInt(llvm_first_lvctxt,
+                              codegen_utils->GetType<int64>())),
+      codegen_utils->GetConstant<int64>(sizeof(MKLvContext)));
+  llvm::Value* llvm_d1 = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_v1_arg, &MKEntry::d));
+  llvm::Value* llvm_d2 = irb->CreateLoad(
+      codegen_utils->GetPointerToMember(llvm_v2_arg, &MKEntry::d));
+  llvm::SwitchInst* llvm_switch = irb->CreateSwitch(
+      llvm_lv, fallback_block, sort_functions_.size());
+
+  for (int lv = 0; lv < static_cast<int>(sort_functions_.size()); ++lv) {
+    llvm::BasicBlock* level_block = codegen_utils->CreateBasicBlock(
+        "level_" + std::to_string(lv), compare_func);
+    llvm_switch->addCase(
+        llvm::ConstantInt::get(
+            llvm::cast<llvm::IntegerType>(codegen_utils->GetType<int64>()),
+            lv),
+        level_block);
+
+    // level block
+    // ----------
+    irb->SetInsertPoint(level_block);
+    llvm::Value* llvm_result = nullptr;
+    // Errors are reported by calling the regular function.
+    if (!GenerateCompareLevel(codegen_utils, lv, llvm_d1, llvm_d2,
+                              compare_func, fallback_block, &llvm_result)) {
+      return false;
+    }
+    if (nullptr == llvm_result) {
+      irb->CreateBr(fallback_block);
+      continue;
+    }
+    // The planner's reverse flag is the SK_BT_DESC flag of the scan key.
+    if (reverse_[lv]) {
+      llvm_result = irb->CreateNeg(llvm_result);
+    }
+    irb->CreateRet(llvm_result);
+  }
+
+  // fallback block
+  // ----------
+  // return tupsort_compare_datum(v1, v2, lvctxt, mkctxt);
+  irb->SetInsertPoint(fallback_block);
+  irb->CreateRet(irb->CreateCall(llvm_tupsort_compare_datum, {
+      llvm_v1_arg, llvm_v2_arg, llvm_lvctxt_arg, llvm_mkctxt_arg}));
+
+  return true;
+}
+
+bool MKCompareDatumCodegen::GenerateCodeInternal(
+    GpCodegenUtils* codegen_utils) {
+  bool isGenerated = GenerateMKCompareDatum(codegen_utils);
+
+  if (isGenerated) {
+    elog(DEBUG1, "tupsort_compare_datum was generated successfully!");
+    return true;
+  } else {
+    elog(DEBUG1, "tupsort_compare_datum generation failed!");
+    return false;
+  }
+}
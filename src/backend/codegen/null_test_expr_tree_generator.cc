@@ -0,0 +1,116 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    null_test_expr_tree_generator.cc
+//
+//  @doc:
+//    Object that generate code for IS [NOT] NULL expression.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <memory>
+#include <utility>
+
+#include "codegen/expr_tree_generator.h"
+#include "codegen/null_test_expr_tree_generator.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+#include "llvm/IR/IRBuilder.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "nodes/execnodes.h"
+#include "nodes/nodes.h"
+#include "nodes/primnodes.h"
+#include "utils/elog.h"
+}
+
+namespace llvm {
+class Value;
+}  // namespace llvm
+
+using gpcodegen::NullTestExprTreeGenerator;
+using gpcodegen::ExprTreeGenerator;
+using gpcodegen::GpCodegenUtils;
+
+bool NullTestExprTreeGenerator::VerifyAndCreateExprTree(
+    const ExprState* expr_state,
+    ExprTreeGeneratorInfo* gen_info,
+    std::unique_ptr<ExprTreeGenerator>* expr_tree) {
+  assert(nullptr != expr_state &&
+         nullptr != expr_state->expr &&
+         T_NullTest == nodeTag(expr_state->expr) &&
+         nullptr != expr_tree);
+
+  expr_tree->reset(nullptr);
+  const NullTestState* nstate =
+      reinterpret_cast<const NullTestState*>(expr_state);
+  if (nstate->argisrow) {
+    elog(DEBUG1, "Unsupported null test on a row-typed argument");
+    return false;
+  }
+
+  assert(nullptr != nstate->arg);
+  std::unique_ptr<ExprTreeGenerator> arg(nullptr);
+  if (!ExprTreeGenerator::VerifyAndCreateExprTree(nstate->arg,
+                                                  gen_info,
+                                                  &arg)) {
+    return false;
+  }
+  assert(nullptr != arg);
+
+  expr_tree->reset(new NullTestExprTreeGenerator(expr_state, std::move(arg)));
+  return true;
+}
+
+NullTestExprTreeGenerator::NullTestExprTreeGenerator(
+    const ExprState* expr_state,
+    std::unique_ptr<ExprTreeGenerator>&& arg) :  // NOLINT(build/c++11)
+    ExprTreeGenerator(expr_state, ExprTreeNodeType::kNullTest),
+    arg_(std::move(arg)) {
+}
+
+bool NullTestExprTreeGenerator::GenerateCode(
+    GpCodegenUtils* codegen_utils,
+    const ExprTreeGeneratorInfo& gen_info,
+    llvm::Value** llvm_out_value,
+    llvm::Value* const llvm_isnull_ptr) {
+  assert(nullptr != llvm_out_value);
+  assert(nullptr != llvm_isnull_ptr);
+  *llvm_out_value = nullptr;
+  NullTest* null_test = reinterpret_cast<NullTest*>(expr_state()->expr);
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::Value* llvm_arg_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "isNull");
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                   llvm_arg_isnull_ptr);
+  llvm::Value* llvm_arg = nullptr;
+  if (!arg_->GenerateCode(codegen_utils,
+                          gen_info,
+                          &llvm_arg,
+                          llvm_arg_isnull_ptr)) {
+    return false;
+  }
+  llvm::Value* llvm_arg_isnull = irb->CreateLoad(llvm_arg_isnull_ptr);
+
+  llvm::Value* llvm_result = nullptr;
+  switch (null_test->nulltesttype) {
+    case IS_NULL:
+      llvm_result = llvm_arg_isnull;
+      break;
+    case IS_NOT_NULL:
+      llvm_result = irb->CreateNot(llvm_arg_isnull);
+      break;
+    default:
+      elog(DEBUG1, "Unrecognized nulltesttype: %d", null_test->nulltesttype);
+      return false;
+  }
+
+  // The result of a null test is never NULL.
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isnull_ptr);
+  *llvm_out_value = codegen_utils->CreateCppTypeToDatumCast(llvm_result);
+  return true;
+}
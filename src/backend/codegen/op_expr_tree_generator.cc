@@ -24,7 +24,9 @@
 #include "codegen/pg_func_generator_interface.h"
 #include "codegen/utils/gp_codegen_utils.h"
 #include "codegen/pg_arith_func_generator.h"
+#include "codegen/pg_bitcode_func_generator.h"
 #include "codegen/pg_date_func_generator.h"
+#include "codegen/pg_hash_func_generator.h"
 
 #include "llvm/IR/IRBuilder.h"
 
@@ -45,6 +47,7 @@ class Value;
 using gpcodegen::OpExprTreeGenerator;
 using gpcodegen::ExprTreeGenerator;
 using gpcodegen::GpCodegenUtils;
+using gpcodegen::PGBitcodeFuncGenerator;
 using gpcodegen::PGFuncGeneratorInterface;
 using gpcodegen::PGFuncGeneratorFn;
 using gpcodegen::CodeGenFuncMap;
@@ -148,6 +151,88 @@ void OpExprTreeGenerator::InitializeSupportedFunction() {
           nullptr,
           true));
 
+  // Equality operators of the hash opclasses, used by the hash clauses of
+  // hash joins and the grouping columns of hash aggregates.
+  supported_function_[61] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGIRBuilderFuncGenerator<bool, char, char>(
+          61, "chareq", &IRBuilder<>::CreateICmpEQ,
+          true));
+
+  supported_function_[63] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGIRBuilderFuncGenerator<bool, int16_t, int16_t>(
+          63, "int2eq", &IRBuilder<>::CreateICmpEQ,
+          true));
+
+  supported_function_[65] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGIRBuilderFuncGenerator<bool, int32_t, int32_t>(
+          65, "int4eq", &IRBuilder<>::CreateICmpEQ,
+          true));
+
+  supported_function_[184] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGIRBuilderFuncGenerator<bool, uint32_t, uint32_t>(
+          184, "oideq", &IRBuilder<>::CreateICmpEQ,
+          true));
+
+  supported_function_[467] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGIRBuilderFuncGenerator<bool, int64_t, int64_t>(
+          467, "int8eq", &IRBuilder<>::CreateICmpEQ,
+          true));
+
+  supported_function_[1086] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGIRBuilderFuncGenerator<bool, int32_t, int32_t>(
+          1086, "date_eq", &IRBuilder<>::CreateICmpEQ,
+          true));
+
+  // Hash support functions of the above. They are not called by operators,
+  // but the hash join and hash aggregate generators look them up here.
+  supported_function_[449] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGGenericFuncGenerator<uint32_t, int16_t>(
+          449,
+          "hashint2",
+          &PGHashFuncGenerator::HashInt2,
+          nullptr,
+          true));
+
+  supported_function_[450] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGGenericFuncGenerator<uint32_t, int32_t>(
+          450,
+          "hashint4",
+          &PGHashFuncGenerator::HashInt4,
+          nullptr,
+          true));
+
+  supported_function_[453] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGGenericFuncGenerator<uint32_t, uint32_t>(
+          453,
+          "hashoid",
+          &PGHashFuncGenerator::HashInt4,
+          nullptr,
+          true));
+
+  supported_function_[454] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGGenericFuncGenerator<uint32_t, char>(
+          454,
+          "hashchar",
+          &PGHashFuncGenerator::HashChar,
+          nullptr,
+          true));
+
+  supported_function_[949] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGGenericFuncGenerator<uint32_t, int64_t>(
+          949,
+          "hashint8",
+          &PGHashFuncGenerator::HashInt8,
+          nullptr,
+          true));
+
+  supported_function_[3515] = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGGenericFuncGenerator<uint32_t, uint32_t>(
+          3515,
+          "hashenum",
+          &PGHashFuncGenerator::HashInt4,
+          nullptr,
+          true));
+
   supported_function_[1088] = std::unique_ptr<PGFuncGeneratorInterface>(
       new PGIRBuilderFuncGenerator<bool, int32_t, int32_t>(
           1088, "date_le", &IRBuilder<>::CreateICmpSLE,
@@ -167,7 +252,8 @@ PGFuncGeneratorInterface* OpExprTreeGenerator::GetPGFuncGenerator(
   InitializeSupportedFunction();
   auto itr = supported_function_.find(oid);
   if (itr == supported_function_.end()) {
-    return nullptr;
+    // Fall back to inlining the function from the bitcode library.
+    return PGBitcodeFuncGenerator::GetPGFuncGenerator(oid);
   }
   return itr->second.get();
 }
@@ -235,20 +321,18 @@ bool OpExprTreeGenerator::GenerateCode(GpCodegenUtils* codegen_utils,
   assert(nullptr != llvm_out_value);
   *llvm_out_value = nullptr;
   OpExpr* op_expr = reinterpret_cast<OpExpr*>(expr_state()->expr);
-  CodeGenFuncMap::iterator itr =  supported_function_.find(op_expr->opfuncid);
   auto irb = codegen_utils->ir_builder();
 
-  if (itr == supported_function_.end()) {
+  // Get the interface to generate code for operator function
+  PGFuncGeneratorInterface* pg_func_interface =
+      GetPGFuncGenerator(op_expr->opfuncid);
+  if (nullptr == pg_func_interface) {
     // Operators are stored in pg_proc table.
     // See postgres.bki for more details.
     elog(WARNING, "Unsupported operator %d.", op_expr->opfuncid);
     return false;
   }
 
-  // Get the interface to generate code for operator function
-  PGFuncGeneratorInterface* pg_func_interface = itr->second.get();
-  assert(nullptr != pg_func_interface);
-
   if (arguments_.size() != pg_func_interface->GetTotalArgCount()) {
     elog(WARNING, "Expected argument size to be %lu\n",
          pg_func_interface->GetTotalArgCount());
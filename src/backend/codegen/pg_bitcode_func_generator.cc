@@ -0,0 +1,273 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    pg_bitcode_func_generator.cc
+//
+//  @doc:
+//    Object that generate code for built-in functions by inlining their
+//    LLVM bitcode
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "codegen/codegen_config.h"
+#include "codegen/pg_bitcode_func_generator.h"
+#include "codegen/pg_func_generator.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+#include "llvm/Bitcode/ReaderWriter.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "fmgr.h"
+#include "miscadmin.h"
+#include "utils/elog.h"
+#include "utils/fmgrtab.h"
+#include "utils/memutils.h"
+}
+
+using gpcodegen::GpCodegenUtils;
+using gpcodegen::PGBitcodeFuncGenerator;
+using gpcodegen::PGFuncGeneratorInterface;
+
+namespace {
+
+// Name of the bitcode library of built-ins, in $libdir.
+constexpr char kBitcodeLibraryName[] = "gpcodegen_builtins.bc";
+
+}  // namespace
+
+std::unordered_map<unsigned int, std::unique_ptr<PGBitcodeFuncGenerator>>
+PGBitcodeFuncGenerator::bitcode_functions_;
+
+PGFuncGeneratorInterface* PGBitcodeFuncGenerator::GetPGFuncGenerator(
+    unsigned int oid) {
+  if (!codegen_inline_builtins) {
+    return nullptr;
+  }
+
+  auto itr = bitcode_functions_.find(oid);
+  if (itr != bitcode_functions_.end()) {
+    return itr->second.get();
+  }
+
+  // fmgr_builtins is sorted by oid.
+  const FmgrBuiltin* builtins_end = fmgr_builtins + fmgr_nbuiltins;
+  const FmgrBuiltin* builtin = std::lower_bound(
+      fmgr_builtins, builtins_end, oid,
+      [](const FmgrBuiltin& entry, unsigned int oid) {
+        return entry.foid < oid;
+      });
+
+  std::unique_ptr<PGBitcodeFuncGenerator> generator(nullptr);
+  if (builtin != builtins_end &&
+      builtin->foid == oid &&
+      !builtin->retset &&
+      builtin->nargs >= 0 &&
+      IsDefinedInBitcodeLibrary(builtin->funcName)) {
+    generator.reset(new PGBitcodeFuncGenerator(oid,
+                                               builtin->funcName,
+                                               builtin->nargs,
+                                               builtin->strict));
+  }
+
+  // Unsupported functions are remembered too, so that they are looked up
+  // only once.
+  PGBitcodeFuncGenerator* result = generator.get();
+  bitcode_functions_[oid] = std::move(generator);
+  return result;
+}
+
+PGBitcodeFuncGenerator::PGBitcodeFuncGenerator(unsigned int pg_func_oid,
+                                               const std::string& pg_func_name,
+                                               size_t total_arg_count,
+                                               bool is_strict)
+    : pg_func_oid_(pg_func_oid),
+      pg_func_name_(pg_func_name),
+      total_arg_count_(total_arg_count),
+      is_strict_(is_strict) {
+  fmgr_info_cxt(pg_func_oid_, &flinfo_, TopMemoryContext);
+}
+
+const llvm::MemoryBuffer* PGBitcodeFuncGenerator::GetBitcodeLibrary() {
+  static std::unique_ptr<llvm::MemoryBuffer> library(nullptr);
+  static bool is_loaded = false;
+  if (!is_loaded) {
+    is_loaded = true;
+    std::string path = std::string(pkglib_path) + "/" + kBitcodeLibraryName;
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path);
+    if (!buffer) {
+      elog(DEBUG1, "Could not load the bitcode library of built-in functions "
+           "\"%s\": %s", path.c_str(), buffer.getError().message().c_str());
+    } else {
+      library = std::move(buffer.get());
+    }
+  }
+  return library.get();
+}
+
+bool PGBitcodeFuncGenerator::IsDefinedInBitcodeLibrary(
+    const std::string& name) {
+  static std::unique_ptr<std::unordered_set<std::string>> defined_names(
+      nullptr);
+  if (nullptr == defined_names) {
+    defined_names.reset(new std::unordered_set<std::string>());
+    const llvm::MemoryBuffer* library = GetBitcodeLibrary();
+    if (nullptr != library) {
+      // Only the symbol table is needed, so no function body is read.
+      llvm::LLVMContext context;
+      llvm::ErrorOr<std::unique_ptr<llvm::Module>> module =
+          llvm::getLazyBitcodeModule(
+              llvm::MemoryBuffer::getMemBuffer(library->getMemBufferRef(),
+                                               false),
+              context);
+      if (module) {
+        for (const llvm::Function& function : *module.get()) {
+          if (!function.isDeclaration() && !function.hasLocalLinkage()) {
+            defined_names->insert(function.getName().str());
+          }
+        }
+      }
+    }
+  }
+  return defined_names->find(name) != defined_names->end();
+}
+
+bool PGBitcodeFuncGenerator::GenerateCode(
+    gpcodegen::GpCodegenUtils* codegen_utils,
+    const PGFuncGeneratorInfo& pg_func_info,
+    llvm::Value** llvm_out_value,
+    llvm::Value* const llvm_isnull_ptr) {
+  assert(nullptr != codegen_utils);
+  assert(nullptr != llvm_out_value);
+  assert(nullptr != llvm_isnull_ptr);
+  auto irb = codegen_utils->ir_builder();
+
+  if (pg_func_info.llvm_args.size() != total_arg_count_) {
+    elog(DEBUG1, "Expected %lu arguments for %s", total_arg_count_,
+         pg_func_name_.c_str());
+    return false;
+  }
+
+  const llvm::MemoryBuffer* library = GetBitcodeLibrary();
+  llvm::Function* llvm_builtin_func = nullptr == library ? nullptr :
+      codegen_utils->LinkFunctionFromBitcode(library->getMemBufferRef(),
+                                             pg_func_name_);
+  if (nullptr == llvm_builtin_func ||
+      llvm_builtin_func->getReturnType() != codegen_utils->GetType<Datum>() ||
+      llvm_builtin_func->arg_size() != 1) {
+    elog(DEBUG1, "Could not link %s from the bitcode library",
+         pg_func_name_.c_str());
+    return false;
+  }
+
+  llvm::Value* llvm_result_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<Datum>(), nullptr, "result");
+  llvm::BasicBlock* call_block = codegen_utils->CreateBasicBlock(
+      "PGBitcodeFuncGenerator_call_block", pg_func_info.llvm_main_func);
+  llvm::BasicBlock* end_block = codegen_utils->CreateBasicBlock(
+      "PGBitcodeFuncGenerator_end_block", pg_func_info.llvm_main_func);
+
+  if (is_strict_) {
+    // As in ExecMakeFunctionResult, a strict function is not called at all
+    // if any of its arguments is NULL.
+    llvm::BasicBlock* strict_logic_entry_block = codegen_utils->
+        CreateBasicBlock("strict_logic_entry_block",
+                         pg_func_info.llvm_main_func);
+    llvm::BasicBlock* null_argument_block = codegen_utils->CreateBasicBlock(
+        "null_argument_block", pg_func_info.llvm_main_func);
+    irb->CreateBr(strict_logic_entry_block);
+    if (!GenerateStrictLogic(codegen_utils, pg_func_info,
+                             strict_logic_entry_block,
+                             null_argument_block,
+                             call_block)) {
+      return false;
+    }
+
+    irb->SetInsertPoint(null_argument_block);
+    irb->CreateStore(codegen_utils->GetConstant<bool>(true), llvm_isnull_ptr);
+    irb->CreateStore(codegen_utils->GetConstant<Datum>(0), llvm_result_ptr);
+    irb->CreateBr(end_block);
+  } else {
+    irb->CreateBr(call_block);
+  }
+
+  // call_block
+  // ----------
+  // Fill in a FunctionCallInfoData on the stack, as InitFunctionCallInfoData
+  // does, and call the function's fmgr entry point with it.
+  irb->SetInsertPoint(call_block);
+  llvm::AllocaInst* llvm_fcinfo = irb->CreateAlloca(
+      codegen_utils->GetType<char>(),
+      codegen_utils->GetConstant(sizeof(FunctionCallInfoData)),
+      "fcinfo");
+  llvm_fcinfo->setAlignment(alignof(FunctionCallInfoData));
+
+  irb->CreateStore(codegen_utils->GetConstant<FmgrInfo*>(&flinfo_),
+                   codegen_utils->GetPointerToMember(
+                       llvm_fcinfo, &FunctionCallInfoData::flinfo));
+  irb->CreateStore(codegen_utils->GetConstant<fmNodePtr>(nullptr),
+                   codegen_utils->GetPointerToMember(
+                       llvm_fcinfo, &FunctionCallInfoData::context));
+  irb->CreateStore(codegen_utils->GetConstant<fmNodePtr>(nullptr),
+                   codegen_utils->GetPointerToMember(
+                       llvm_fcinfo, &FunctionCallInfoData::resultinfo));
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                   codegen_utils->GetPointerToMember(
+                       llvm_fcinfo, &FunctionCallInfoData::isnull));
+  irb->CreateStore(codegen_utils->GetConstant<int16>(total_arg_count_),
+                   codegen_utils->GetPointerToMember(
+                       llvm_fcinfo, &FunctionCallInfoData::nargs));
+  llvm::Value* llvm_fcinfo_arg = codegen_utils->GetPointerToMember(
+      llvm_fcinfo, &FunctionCallInfoData::arg);
+  llvm::Value* llvm_fcinfo_argnull = codegen_utils->GetPointerToMember(
+      llvm_fcinfo, &FunctionCallInfoData::argnull);
+  for (size_t i = 0; i < total_arg_count_; ++i) {
+    irb->CreateStore(
+        codegen_utils->CreateCppTypeToDatumCast(pg_func_info.llvm_args[i]),
+        irb->CreateConstInBoundsGEP2_64(llvm_fcinfo_arg, 0, i));
+    irb->CreateStore(pg_func_info.llvm_args_isNull[i],
+                     irb->CreateConstInBoundsGEP2_64(llvm_fcinfo_argnull,
+                                                     0, i));
+  }
+
+  llvm::CallInst* llvm_call = irb->CreateCall(
+      llvm_builtin_func,
+      {irb->CreatePointerCast(
+          llvm_fcinfo,
+          llvm_builtin_func->getFunctionType()->getParamType(0))});
+  irb->CreateStore(llvm_call, llvm_result_ptr);
+  irb->CreateStore(
+      irb->CreateLoad(codegen_utils->GetPointerToMember(
+          llvm_fcinfo, &FunctionCallInfoData::isnull)),
+      llvm_isnull_ptr);
+  irb->CreateBr(end_block);
+
+  // The body of the entry point is inlined, so that it can be optimized
+  // together with the rest of the expression. Inlining splits call_block,
+  // hence the result goes through llvm_result_ptr rather than a phi node.
+  if (!codegen_utils->InlineFunction(llvm_call)) {
+    elog(DEBUG1, "Could not inline %s", pg_func_name_.c_str());
+  }
+
+  // end_block
+  // ---------
+  irb->SetInsertPoint(end_block);
+  *llvm_out_value = irb->CreateLoad(llvm_result_ptr);
+  return true;
+}
@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    pg_hash_func_generator.cc
+//
+//  @doc:
+//    Object that generate code for hash support functions
+//
+//---------------------------------------------------------------------------
+
+#include <assert.h>
+#include <cstdint>
+
+#include "codegen/pg_hash_func_generator.h"
+#include "codegen/pg_func_generator_interface.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Value.h"
+
+using gpcodegen::GpCodegenUtils;
+using gpcodegen::PGHashFuncGenerator;
+using gpcodegen::PGFuncGeneratorInfo;
+
+namespace {
+
+// rot(x, k) of hashfunc.c
+llvm::Value* GenerateRot(GpCodegenUtils* codegen_utils,
+                         llvm::Value* llvm_x,
+                         uint32_t k) {
+  llvm::IRBuilder<>* irb = codegen_utils->ir_builder();
+  return irb->CreateOr(
+      irb->CreateShl(llvm_x, codegen_utils->GetConstant<uint32_t>(k)),
+      irb->CreateLShr(llvm_x, codegen_utils->GetConstant<uint32_t>(32 - k)));
+}
+
+// One step of mix(a, b, c) of hashfunc.c:
+//   x -= y;  x ^= rot(y, k);  y += z;
+void GenerateMixStep(GpCodegenUtils* codegen_utils,
+                     llvm::Value** llvm_x,
+                     llvm::Value** llvm_y,
+                     llvm::Value* llvm_z,
+                     uint32_t k) {
+  llvm::IRBuilder<>* irb = codegen_utils->ir_builder();
+  *llvm_x = irb->CreateSub(*llvm_x, *llvm_y);
+  *llvm_x = irb->CreateXor(*llvm_x, GenerateRot(codegen_utils, *llvm_y, k));
+  *llvm_y = irb->CreateAdd(*llvm_y, llvm_z);
+}
+
+}  // namespace
+
+llvm::Value* PGHashFuncGenerator::GenerateHashUInt32(
+    GpCodegenUtils* codegen_utils,
+    llvm::Value* llvm_key) {
+  assert(nullptr != llvm_key);
+  assert(codegen_utils->GetType<uint32_t>() == llvm_key->getType());
+  llvm::IRBuilder<>* irb = codegen_utils->ir_builder();
+
+  // a = 0xdeadbeef + k; b = 0xdeadbeef; c = 3923095 + sizeof(uint32);
+  llvm::Value* a = irb->CreateAdd(
+      codegen_utils->GetConstant<uint32_t>(0xdeadbeef), llvm_key);
+  llvm::Value* b = codegen_utils->GetConstant<uint32_t>(0xdeadbeef);
+  llvm::Value* c = codegen_utils->GetConstant<uint32_t>(
+      static_cast<uint32_t>(3923095 + sizeof(uint32_t)));
+
+  // mix(a, b, c)
+  GenerateMixStep(codegen_utils, &a, &c, b, 4);
+  GenerateMixStep(codegen_utils, &b, &a, c, 6);
+  GenerateMixStep(codegen_utils, &c, &b, a, 8);
+  GenerateMixStep(codegen_utils, &a, &c, b, 16);
+  GenerateMixStep(codegen_utils, &b, &a, c, 19);
+  GenerateMixStep(codegen_utils, &c, &b, a, 4);
+
+  return c;
+}
+
+bool PGHashFuncGenerator::HashChar(
+    GpCodegenUtils* codegen_utils,
+    const PGFuncGeneratorInfo& pg_func_info,
+    llvm::Value** llvm_out_value) {
+  assert(1 == pg_func_info.llvm_args.size());
+  // hash_uint32((int32) PG_GETARG_CHAR(0))
+  *llvm_out_value = GenerateHashUInt32(
+      codegen_utils,
+      codegen_utils->ir_builder()->CreateSExt(
+          pg_func_info.llvm_args[0], codegen_utils->GetType<uint32_t>()));
+  return true;
+}
+
+bool PGHashFuncGenerator::HashInt2(
+    GpCodegenUtils* codegen_utils,
+    const PGFuncGeneratorInfo& pg_func_info,
+    llvm::Value** llvm_out_value) {
+  assert(1 == pg_func_info.llvm_args.size());
+  // hash_uint32((int32) PG_GETARG_INT16(0))
+  *llvm_out_value = GenerateHashUInt32(
+      codegen_utils,
+      codegen_utils->ir_builder()->CreateSExt(
+          pg_func_info.llvm_args[0], codegen_utils->GetType<uint32_t>()));
+  return true;
+}
+
+bool PGHashFuncGenerator::HashInt4(
+    GpCodegenUtils* codegen_utils,
+    const PGFuncGeneratorInfo& pg_func_info,
+    llvm::Value** llvm_out_value) {
+  assert(1 == pg_func_info.llvm_args.size());
+  // hash_uint32(PG_GETARG_INT32(0))
+  *llvm_out_value = GenerateHashUInt32(codegen_utils,
+                                       pg_func_info.llvm_args[0]);
+  return true;
+}
+
+bool PGHashFuncGenerator::HashInt8(
+    GpCodegenUtils* codegen_utils,
+    const PGFuncGeneratorInfo& pg_func_info,
+    llvm::Value** llvm_out_value) {
+  assert(1 == pg_func_info.llvm_args.size());
+  llvm::IRBuilder<>* irb = codegen_utils->ir_builder();
+  llvm::Value* llvm_val = pg_func_info.llvm_args[0];
+
+  // uint32 lohalf = (uint32) val;
+  // uint32 hihalf = (uint32) (val >> 32);
+  llvm::Value* llvm_lohalf = irb->CreateTrunc(
+      llvm_val, codegen_utils->GetType<uint32_t>());
+  llvm::Value* llvm_hihalf = irb->CreateTrunc(
+      irb->CreateAShr(llvm_val, codegen_utils->GetConstant<int64_t>(32)),
+      codegen_utils->GetType<uint32_t>());
+
+  // lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+  llvm_lohalf = irb->CreateXor(
+      llvm_lohalf,
+      irb->CreateSelect(
+          irb->CreateICmpSGE(llvm_val, codegen_utils->GetConstant<int64_t>(0)),
+          llvm_hihalf,
+          irb->CreateNot(llvm_hihalf)));
+
+  *llvm_out_value = GenerateHashUInt32(codegen_utils, llvm_lohalf);
+  return true;
+}
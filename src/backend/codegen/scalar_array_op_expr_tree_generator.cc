@@ -0,0 +1,366 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright (C) 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    scalar_array_op_expr_tree_generator.cc
+//
+//  @doc:
+//    Object that generate code for scalar op ANY/ALL (array) expression.
+//
+//---------------------------------------------------------------------------
+#include <assert.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "codegen/expr_tree_generator.h"
+#include "codegen/op_expr_tree_generator.h"
+#include "codegen/pg_func_generator_interface.h"
+#include "codegen/scalar_array_op_expr_tree_generator.h"
+#include "codegen/utils/gp_codegen_utils.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#include "nodes/execnodes.h"
+#include "nodes/nodes.h"
+#include "nodes/pg_list.h"
+#include "nodes/primnodes.h"
+#include "utils/array.h"
+#include "utils/elog.h"
+#include "utils/lsyscache.h"
+}
+
+namespace llvm {
+class Value;
+}  // namespace llvm
+
+using gpcodegen::ScalarArrayOpExprTreeGenerator;
+using gpcodegen::ExprTreeGenerator;
+using gpcodegen::GpCodegenUtils;
+using gpcodegen::OpExprTreeGenerator;
+using gpcodegen::PGFuncGeneratorInfo;
+using gpcodegen::PGFuncGeneratorInterface;
+
+namespace {
+
+// Equality functions of pass-by-value types that are true iff both
+// arguments have the same bits, so that x = ANY (array) can be a switch.
+const std::unordered_set<Oid> kBitwiseEqualityFunctions = {
+    61,    // chareq
+    63,    // int2eq
+    65,    // int4eq
+    184,   // oideq
+    467,   // int8eq
+    1086,  // date_eq
+};
+
+}  // namespace
+
+bool ScalarArrayOpExprTreeGenerator::VerifyAndCreateExprTree(
+    const ExprState* expr_state,
+    ExprTreeGeneratorInfo* gen_info,
+    std::unique_ptr<ExprTreeGenerator>* expr_tree) {
+  assert(nullptr != expr_state &&
+         nullptr != expr_state->expr &&
+         T_ScalarArrayOpExpr == nodeTag(expr_state->expr) &&
+         nullptr != expr_tree);
+
+  expr_tree->reset(nullptr);
+  ScalarArrayOpExpr* opexpr =
+      reinterpret_cast<ScalarArrayOpExpr*>(expr_state->expr);
+  PGFuncGeneratorInterface* pg_func_gen =
+      OpExprTreeGenerator::GetPGFuncGenerator(opexpr->opfuncid);
+  if (nullptr == pg_func_gen ||
+      !pg_func_gen->IsStrict() ||
+      2 != pg_func_gen->GetTotalArgCount()) {
+    elog(DEBUG1, "Unsupported operator %d in ScalarArrayOpExpr.",
+         opexpr->opfuncid);
+    return false;
+  }
+
+  List *arguments = reinterpret_cast<const ScalarArrayOpExprState*>(
+      expr_state)->fxprstate.args;
+  assert(2 == list_length(arguments));
+  ExprState *scalar_state = reinterpret_cast<ExprState*>(linitial(arguments));
+  ExprState *array_state = reinterpret_cast<ExprState*>(lsecond(arguments));
+
+  // The array must be a non-NULL constant, so that its elements can be
+  // unrolled at generation time.
+  if (nullptr == array_state->expr ||
+      T_Const != nodeTag(array_state->expr) ||
+      reinterpret_cast<Const*>(array_state->expr)->constisnull) {
+    elog(DEBUG1, "Unsupported non-constant array in ScalarArrayOpExpr.");
+    return false;
+  }
+
+  ArrayType *arr = DatumGetArrayTypeP(
+      reinterpret_cast<Const*>(array_state->expr)->constvalue);
+  int16 typlen;
+  bool typbyval;
+  char typalign;
+  get_typlenbyvalalign(ARR_ELEMTYPE(arr), &typlen, &typbyval, &typalign);
+  if (!typbyval) {
+    elog(DEBUG1, "Unsupported array of pass-by-reference elements in "
+         "ScalarArrayOpExpr.");
+    return false;
+  }
+
+  Datum *elem_values = nullptr;
+  bool *elem_nulls = nullptr;
+  int num_elems = 0;
+  deconstruct_array(arr, ARR_ELEMTYPE(arr), typlen, typbyval, typalign,
+                    &elem_values, &elem_nulls, &num_elems);
+
+  std::vector<Datum> elements;
+  bool has_nulls = false;
+  for (int i = 0; i < num_elems; ++i) {
+    if (elem_nulls[i]) {
+      has_nulls = true;
+    } else {
+      elements.push_back(elem_values[i]);
+    }
+  }
+  pfree(elem_values);
+  pfree(elem_nulls);
+
+  std::unique_ptr<ExprTreeGenerator> scalar_arg(nullptr);
+  if (!ExprTreeGenerator::VerifyAndCreateExprTree(scalar_state,
+                                                  gen_info,
+                                                  &scalar_arg)) {
+    return false;
+  }
+  assert(nullptr != scalar_arg);
+
+  expr_tree->reset(new ScalarArrayOpExprTreeGenerator(expr_state,
+                                                      std::move(scalar_arg),
+                                                      std::move(elements),
+                                                      typlen,
+                                                      has_nulls));
+  return true;
+}
+
+ScalarArrayOpExprTreeGenerator::ScalarArrayOpExprTreeGenerator(
+    const ExprState* expr_state,
+    std::unique_ptr<ExprTreeGenerator>&& scalar_arg,  // NOLINT(build/c++11)
+    std::vector<Datum>&& elements,  // NOLINT(build/c++11)
+    int16_t typlen,
+    bool has_nulls) :
+    ExprTreeGenerator(expr_state, ExprTreeNodeType::kScalarArrayOp),
+    scalar_arg_(std::move(scalar_arg)),
+    elements_(std::move(elements)),
+    typlen_(typlen),
+    has_nulls_(has_nulls) {
+}
+
+bool ScalarArrayOpExprTreeGenerator::GenerateCode(
+    GpCodegenUtils* codegen_utils,
+    const ExprTreeGeneratorInfo& gen_info,
+    llvm::Value** llvm_out_value,
+    llvm::Value* const llvm_isnull_ptr) {
+  assert(nullptr != llvm_out_value);
+  assert(nullptr != llvm_isnull_ptr);
+  *llvm_out_value = nullptr;
+  ScalarArrayOpExpr* opexpr =
+      reinterpret_cast<ScalarArrayOpExpr*>(expr_state()->expr);
+  auto irb = codegen_utils->ir_builder();
+
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isnull_ptr);
+
+  // If the array is empty, the result is FALSE for ANY and TRUE for ALL,
+  // even if the scalar is NULL.
+  if (elements_.empty() && !has_nulls_) {
+    *llvm_out_value = codegen_utils->GetConstant<Datum>(!opexpr->useOr);
+    return true;
+  }
+
+  llvm::BasicBlock* scalar_not_null_block = codegen_utils->CreateBasicBlock(
+      "scalar_array_op_not_null_block", gen_info.llvm_main_func);
+  llvm::BasicBlock* scalar_null_block = codegen_utils->CreateBasicBlock(
+      "scalar_array_op_null_block", gen_info.llvm_main_func);
+  llvm::BasicBlock* end_block = codegen_utils->CreateBasicBlock(
+      "scalar_array_op_end_block", gen_info.llvm_main_func);
+
+  llvm::Value* llvm_result_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "scalar_array_op_result");
+  llvm::Value* llvm_scalar_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "isNull");
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                   llvm_scalar_isnull_ptr);
+  llvm::Value* llvm_scalar = nullptr;
+  if (!scalar_arg_->GenerateCode(codegen_utils,
+                                 gen_info,
+                                 &llvm_scalar,
+                                 llvm_scalar_isnull_ptr)) {
+    return false;
+  }
+  irb->CreateCondBr(irb->CreateLoad(llvm_scalar_isnull_ptr),
+                    scalar_null_block /* true */,
+                    scalar_not_null_block /* false */);
+
+  // scalar null block
+  // -----------------
+  // The operator is strict, so a NULL scalar gives NULL.
+  irb->SetInsertPoint(scalar_null_block);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(true), llvm_isnull_ptr);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_result_ptr);
+  irb->CreateBr(end_block);
+
+  // scalar not null block
+  // ---------------------
+  irb->SetInsertPoint(scalar_not_null_block);
+  bool is_generated = false;
+  if (opexpr->useOr &&
+      kBitwiseEqualityFunctions.count(opexpr->opfuncid) > 0) {
+    is_generated = GenerateSwitch(codegen_utils, llvm_scalar,
+                                  llvm_result_ptr, llvm_isnull_ptr,
+                                  end_block);
+  } else {
+    is_generated = GenerateUnrolledLoop(codegen_utils, gen_info, llvm_scalar,
+                                        llvm_result_ptr, llvm_isnull_ptr,
+                                        end_block);
+  }
+  if (!is_generated) {
+    return false;
+  }
+
+  irb->SetInsertPoint(end_block);
+  *llvm_out_value = codegen_utils->CreateCppTypeToDatumCast(
+      irb->CreateLoad(llvm_result_ptr));
+  return true;
+}
+
+bool ScalarArrayOpExprTreeGenerator::GenerateSwitch(
+    GpCodegenUtils* codegen_utils,
+    llvm::Value* llvm_scalar,
+    llvm::Value* llvm_result_ptr,
+    llvm::Value* const llvm_isnull_ptr,
+    llvm::BasicBlock* end_block) {
+  assert(typlen_ > 0 && typlen_ <= static_cast<int16_t>(sizeof(Datum)));
+  auto irb = codegen_utils->ir_builder();
+  llvm::Function* llvm_main_func = irb->GetInsertBlock()->getParent();
+
+  llvm::BasicBlock* found_block = codegen_utils->CreateBasicBlock(
+      "scalar_array_op_found_block", llvm_main_func);
+  llvm::BasicBlock* not_found_block = codegen_utils->CreateBasicBlock(
+      "scalar_array_op_not_found_block", llvm_main_func);
+
+  // Compare only the bytes of the element type, since that is all that
+  // the equality function looks at.
+  llvm::IntegerType* llvm_elem_type = llvm::IntegerType::get(
+      llvm_scalar->getContext(), typlen_ * 8);
+  llvm::Value* llvm_key = llvm_scalar;
+  if (llvm_elem_type != llvm_scalar->getType()) {
+    llvm_key = irb->CreateTrunc(llvm_scalar, llvm_elem_type);
+  }
+
+  // Switch case values must be distinct.
+  uint64_t mask = ~static_cast<uint64_t>(0);
+  if (typlen_ < static_cast<int16_t>(sizeof(Datum))) {
+    mask = (static_cast<uint64_t>(1) << (typlen_ * 8)) - 1;
+  }
+  std::vector<uint64_t> case_values;
+  for (Datum element : elements_) {
+    case_values.push_back(static_cast<uint64_t>(element) & mask);
+  }
+  std::sort(case_values.begin(), case_values.end());
+  case_values.erase(std::unique(case_values.begin(), case_values.end()),
+                    case_values.end());
+
+  llvm::SwitchInst* llvm_switch = irb->CreateSwitch(
+      llvm_key, not_found_block, case_values.size());
+  for (uint64_t case_value : case_values) {
+    llvm_switch->addCase(llvm::ConstantInt::get(llvm_elem_type, case_value),
+                         found_block);
+  }
+
+  // found block
+  // -----------
+  irb->SetInsertPoint(found_block);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(true), llvm_result_ptr);
+  irb->CreateBr(end_block);
+
+  // not found block
+  // ---------------
+  // A NULL element might have matched, so the result is NULL if there
+  // are any.
+  irb->SetInsertPoint(not_found_block);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(has_nulls_),
+                   llvm_isnull_ptr);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_result_ptr);
+  irb->CreateBr(end_block);
+  return true;
+}
+
+bool ScalarArrayOpExprTreeGenerator::GenerateUnrolledLoop(
+    GpCodegenUtils* codegen_utils,
+    const ExprTreeGeneratorInfo& gen_info,
+    llvm::Value* llvm_scalar,
+    llvm::Value* llvm_result_ptr,
+    llvm::Value* const llvm_isnull_ptr,
+    llvm::BasicBlock* end_block) {
+  ScalarArrayOpExpr* opexpr =
+      reinterpret_cast<ScalarArrayOpExpr*>(expr_state()->expr);
+  bool use_or = opexpr->useOr;
+  PGFuncGeneratorInterface* pg_func_gen =
+      OpExprTreeGenerator::GetPGFuncGenerator(opexpr->opfuncid);
+  assert(nullptr != pg_func_gen);
+  auto irb = codegen_utils->ir_builder();
+
+  llvm::BasicBlock* short_circuit_block = codegen_utils->CreateBasicBlock(
+      "scalar_array_op_short_circuit_block", gen_info.llvm_main_func);
+  llvm::Value* llvm_op_isnull_ptr = irb->CreateAlloca(
+      codegen_utils->GetType<bool>(), nullptr, "isNull");
+
+  for (size_t i = 0; i < elements_.size(); ++i) {
+    llvm::BasicBlock* next_block = codegen_utils->CreateBasicBlock(
+        "scalar_array_op_next_elem_" + std::to_string(i),
+        gen_info.llvm_main_func);
+
+    irb->CreateStore(codegen_utils->GetConstant<bool>(false),
+                     llvm_op_isnull_ptr);
+    PGFuncGeneratorInfo pg_func_info(
+        gen_info.llvm_main_func,
+        gen_info.llvm_error_block,
+        {llvm_scalar, codegen_utils->GetConstant<Datum>(elements_[i])},
+        {codegen_utils->GetConstant<bool>(false),
+         codegen_utils->GetConstant<bool>(false)});
+    llvm::Value* llvm_op_value = nullptr;
+    if (!pg_func_gen->GenerateCode(codegen_utils, pg_func_info,
+                                   &llvm_op_value, llvm_op_isnull_ptr)) {
+      return false;
+    }
+    llvm::Value* llvm_decides = use_or ?
+        llvm_op_value : irb->CreateNot(llvm_op_value);
+    irb->CreateCondBr(llvm_decides,
+                      short_circuit_block /* true */,
+                      next_block /* false */);
+
+    irb->SetInsertPoint(next_block);
+  }
+
+  // None of the elements decided the result. The operator is strict, so
+  // the NULL elements would have given NULL.
+  irb->CreateStore(codegen_utils->GetConstant<bool>(has_nulls_),
+                   llvm_isnull_ptr);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(!use_or),
+                   llvm_result_ptr);
+  irb->CreateBr(end_block);
+
+  // short circuit block
+  // -------------------
+  irb->SetInsertPoint(short_circuit_block);
+  irb->CreateStore(codegen_utils->GetConstant<bool>(use_or),
+                   llvm_result_ptr);
+  irb->CreateBr(end_block);
+  return true;
+}
@@ -124,9 +124,10 @@ bool SlotGetAttrCodegen::GenerateCodeInternal(
     return true;
   }
 
-  // Give the function a human readable name
+  // Give the function a human readable name. Leave the address of the slot
+  // out of it, so that the module is the same in every execution and its
+  // compiled code can be cached.
   std::string function_name = GetUniqueFuncName() + "_" +
-      std::to_string(reinterpret_cast<uint64_t>(slot_)) + "_" +
       std::to_string(max_attr_);
   llvm::Function* function = CreateFunction<SlotGetAttrFn>(codegen_utils,
                                                            function_name);
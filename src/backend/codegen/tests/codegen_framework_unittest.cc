@@ -12,11 +12,15 @@
 //
 //---------------------------------------------------------------------------
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <ctime>
 #include <initializer_list>
 #include <limits>
@@ -57,6 +61,7 @@ extern "C" {
 #include "codegen/utils/codegen_utils.h"
 #include "codegen/utils/gp_codegen_utils.h"
 #include "codegen/utils/utility.h"
+#include "codegen/codegen_cache.h"
 #include "codegen/codegen_manager.h"
 #include "codegen/codegen_wrapper.h"
 #include "codegen/codegen_interface.h"
@@ -403,7 +408,7 @@ TEST_F(CodegenManagerTest, TestGetters) {
 
   EXPECT_EQ(SumCodeGenerator::kAddFuncNamePrefix,
             code_gen->GetOrigFuncName());
-  // Static unique_counter will be zero to begin with.
+  // Function names are numbered per manager, starting from zero.
   // So uniqueFuncName return with suffix zero.
   EXPECT_EQ(SumCodeGenerator::kAddFuncNamePrefix + std::to_string(0),
             code_gen->GetUniqueFuncName());
@@ -625,6 +630,89 @@ TEST_F(CodegenManagerTest, ResetTest) {
   ASSERT_TRUE(SumFuncRegular == sum_func_ptr);
 }
 
+TEST_F(CodegenManagerTest, CompiledCodeCacheTest) {
+  codegen_cache_size = 1024;
+  CodegenCache* cache = CodegenCache::GetInstance();
+  cache->Clear();
+  std::size_t hits = cache->hits();
+  std::size_t misses = cache->misses();
+
+  sum_func_ptr = nullptr;
+  EnrollCodegen<SumCodeGenerator, SumFunc>(SumFuncRegular, &sum_func_ptr);
+  EXPECT_EQ(1, manager_->GenerateCode());
+  ASSERT_TRUE(manager_->PrepareGeneratedFunctions());
+  ASSERT_TRUE(SumFuncRegular != sum_func_ptr);
+  EXPECT_EQ(hits, cache->hits());
+  EXPECT_EQ(misses + 1, cache->misses());
+
+  // A new manager generating the same code gets the compiled code from the
+  // cache
+  manager_.reset(new CodegenManager("CodegenManagerTest"));
+  sum_func_ptr = nullptr;
+  EnrollCodegen<SumCodeGenerator, SumFunc>(SumFuncRegular, &sum_func_ptr);
+  EXPECT_EQ(1, manager_->GenerateCode());
+  ASSERT_TRUE(manager_->PrepareGeneratedFunctions());
+  ASSERT_TRUE(SumFuncRegular != sum_func_ptr);
+  EXPECT_EQ(hits + 1, cache->hits());
+  EXPECT_EQ(misses + 1, cache->misses());
+  EXPECT_EQ(5, sum_func_ptr(2, 3));
+
+  // Different code doesn't
+  manager_.reset(new CodegenManager("CodegenManagerTest"));
+  mul_func_ptr = nullptr;
+  EnrollCodegen<MulOverflowCodeGenerator, MulFunc>(MulFuncRegular,
+                                                   &mul_func_ptr);
+  EXPECT_EQ(1, manager_->GenerateCode());
+  ASSERT_TRUE(manager_->PrepareGeneratedFunctions());
+  EXPECT_EQ(hits + 1, cache->hits());
+  EXPECT_EQ(misses + 2, cache->misses());
+  EXPECT_EQ(6, mul_func_ptr(2, 3));
+
+  codegen_cache_size = 0;
+  cache->Clear();
+}
+
+TEST_F(CodegenManagerTest, CompiledCodeDiskCacheTest) {
+  char directory[] = "/tmp/codegen_cache_test_XXXXXX";
+  ASSERT_TRUE(nullptr != mkdtemp(directory));
+  codegen_cache_directory = directory;
+  CodegenCache* cache = CodegenCache::GetInstance();
+  cache->Clear();
+  std::size_t hits = cache->hits();
+  std::size_t misses = cache->misses();
+
+  // The first compilation writes the object to the directory
+  sum_func_ptr = nullptr;
+  EnrollCodegen<SumCodeGenerator, SumFunc>(SumFuncRegular, &sum_func_ptr);
+  EXPECT_EQ(1, manager_->GenerateCode());
+  ASSERT_TRUE(manager_->PrepareGeneratedFunctions());
+  EXPECT_EQ(misses + 1, cache->misses());
+
+  // With no in-memory cache, a new manager loads it from there
+  manager_.reset(new CodegenManager("CodegenManagerTest"));
+  sum_func_ptr = nullptr;
+  EnrollCodegen<SumCodeGenerator, SumFunc>(SumFuncRegular, &sum_func_ptr);
+  EXPECT_EQ(1, manager_->GenerateCode());
+  ASSERT_TRUE(manager_->PrepareGeneratedFunctions());
+  EXPECT_EQ(hits + 1, cache->hits());
+  EXPECT_EQ(5, sum_func_ptr(2, 3));
+
+  // A directory that others can write to is not used
+  ASSERT_EQ(0, chmod(directory, 0777));
+  manager_.reset(new CodegenManager("CodegenManagerTest"));
+  sum_func_ptr = nullptr;
+  EnrollCodegen<SumCodeGenerator, SumFunc>(SumFuncRegular, &sum_func_ptr);
+  EXPECT_EQ(1, manager_->GenerateCode());
+  ASSERT_TRUE(manager_->PrepareGeneratedFunctions());
+  EXPECT_EQ(hits + 1, cache->hits());
+  EXPECT_EQ(misses + 2, cache->misses());
+  EXPECT_EQ(5, sum_func_ptr(2, 3));
+
+  codegen_cache_directory = nullptr;
+  cache->Clear();
+  std::system((std::string("rm -rf ") + directory).c_str());
+}
+
 TEST_F(CodegenManagerTest, TestDatumBoolCast) {
   CheckDatumCast<bool>(BoolGetDatum,
                        DatumGetBool,
@@ -63,6 +63,7 @@ extern "C" {
 #include "codegen/base_codegen.h"
 #include "codegen/pg_func_generator.h"
 #include "codegen/pg_arith_func_generator.h"
+#include "codegen/pg_hash_func_generator.h"
 
 
 namespace gpcodegen {
@@ -377,6 +378,114 @@ TEST_F(CodegenPGFuncGeneratorTest, PGGenericFuncGeneratorOneArgTest) {
   EXPECT_EQ(3, fn(2));
 }
 
+// Reference implementation of hash_uint32() of hashfunc.c
+uint32_t ReferenceHashUInt32(uint32_t k) {
+#define rot(x, k) (((x) << (k)) | ((x) >> (32 - (k))))
+  uint32_t a = 0xdeadbeef + k;
+  uint32_t b = 0xdeadbeef;
+  uint32_t c = 3923095 + static_cast<uint32_t>(sizeof(uint32_t));
+
+  a -= c;  a ^= rot(c, 4);  c += b;
+  b -= a;  b ^= rot(a, 6);  a += c;
+  c -= b;  c ^= rot(b, 8);  b += a;
+  a -= c;  a ^= rot(c, 16);  c += b;
+  b -= a;  b ^= rot(a, 19);  a += c;
+  c -= b;  c ^= rot(b, 4);  b += a;
+#undef rot
+  return c;
+}
+
+// Reference implementation of hashint4() of hashfunc.c
+uint32_t ReferenceHashInt4(int32_t val) {
+  return ReferenceHashUInt32(static_cast<uint32_t>(val));
+}
+
+// Reference implementation of hashint8() of hashfunc.c
+uint32_t ReferenceHashInt8(int64_t val) {
+  uint32_t lohalf = static_cast<uint32_t>(val);
+  uint32_t hihalf = static_cast<uint32_t>(val >> 32);
+  lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+  return ReferenceHashUInt32(lohalf);
+}
+
+// Generates a function that calls the given hash generator on its Datum
+// argument, and checks its results against the reference implementation.
+template <typename CppType>
+void CheckHashFuncGenerator(gpcodegen::GpCodegenUtils* codegen_utils,
+                            PGFuncGeneratorFn hash_generator,
+                            const std::vector<CppType>& values,
+                            uint32_t (*reference)(CppType)) {
+  using HashFn = uint32_t (*) (Datum);
+
+  llvm::Function* hash_fn =
+      codegen_utils->CreateFunction<HashFn>("hash_fn");
+  llvm::BasicBlock* main_block =
+      codegen_utils->CreateBasicBlock("main", hash_fn);
+  llvm::BasicBlock* error_block =
+      codegen_utils->CreateBasicBlock("error", hash_fn);
+
+  auto irb = codegen_utils->ir_builder();
+  irb->SetInsertPoint(main_block);
+
+  auto generator = std::unique_ptr<PGFuncGeneratorInterface>(
+      new PGGenericFuncGenerator<uint32_t, CppType>(
+          0,
+          "",
+          hash_generator,
+          nullptr,
+          true));
+
+  llvm::Value* result = nullptr;
+  llvm::Value* llvm_isNull = irb->CreateAlloca(
+        codegen_utils->GetType<bool>(), nullptr, "isNull");
+  irb->CreateStore(codegen_utils->GetConstant<bool>(false), llvm_isNull);
+  PGFuncGeneratorInfo pg_gen_info(hash_fn, error_block,
+                                  {ArgumentByPosition(hash_fn, 0)},
+                                  {codegen_utils->GetConstant<bool>(false)});
+
+  EXPECT_TRUE(generator->GenerateCode(codegen_utils, pg_gen_info,
+                                      &result, llvm_isNull));
+  irb->CreateRet(result);
+
+  irb->SetInsertPoint(error_block);
+  irb->CreateRet(codegen_utils->GetConstant<uint32_t>(0));
+
+  EXPECT_FALSE(llvm::verifyFunction(*hash_fn));
+  EXPECT_FALSE(llvm::verifyModule(*codegen_utils->module()));
+
+  EXPECT_TRUE(codegen_utils->PrepareForExecution(
+      CodegenUtils::OptimizationLevel::kNone,
+      true));
+
+  HashFn fn = codegen_utils->GetFunctionPointer<HashFn>("hash_fn");
+  for (CppType value : values) {
+    Datum datum = 0;
+    *reinterpret_cast<CppType*>(&datum) = value;
+    EXPECT_EQ(reference(value), fn(datum));
+  }
+}
+
+// Test the generated hashint4 against hash_uint32()
+TEST_F(CodegenPGFuncGeneratorTest, PGHashFuncGeneratorHashInt4Test) {
+  CheckHashFuncGenerator<int32_t>(
+      codegen_utils_.get(),
+      &PGHashFuncGenerator::HashInt4,
+      {0, 1, -1, 42, std::numeric_limits<int32_t>::max(),
+       std::numeric_limits<int32_t>::min()},
+      &ReferenceHashInt4);
+}
+
+// Test the generated hashint8 against hashint8() of hashfunc.c
+TEST_F(CodegenPGFuncGeneratorTest, PGHashFuncGeneratorHashInt8Test) {
+  CheckHashFuncGenerator<int64_t>(
+      codegen_utils_.get(),
+      &PGHashFuncGenerator::HashInt8,
+      {0, 1, -1, 42, 1LL << 40, -(1LL << 40),
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()},
+      &ReferenceHashInt8);
+}
+
 }  // namespace gpcodegen
 
 
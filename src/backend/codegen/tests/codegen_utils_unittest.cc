@@ -33,6 +33,7 @@
 #include "gtest/gtest.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/APInt.h"
+#include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/IR/Argument.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Constant.h"
@@ -47,6 +48,8 @@
 #include "llvm/IR/Value.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace gpcodegen {
 
@@ -2930,6 +2933,75 @@ TEST_F(CodegenUtilsTest, InlineFunctionTest) {
   EXPECT_EQ(compiled_add_two_fn(-5), -3);
 }
 
+TEST_F(CodegenUtilsTest, LinkFunctionFromBitcodeTest) {
+  typedef int (*AddConstToIntFn) (int);
+
+  // Build a bitcode library with an external function add_two, which calls a
+  // file-local function add_one, and an unrelated external function.
+  std::string bitcode;
+  {
+    CodegenUtils library_utils("library_module");
+    auto irb = library_utils.ir_builder();
+    llvm::Function* add_one_fn =
+        library_utils.CreateFunction<AddConstToIntFn>(
+            "add_one", false, llvm::GlobalValue::InternalLinkage);
+    irb->SetInsertPoint(library_utils.CreateBasicBlock("main", add_one_fn));
+    irb->CreateRet(irb->CreateAdd(ArgumentByPosition(add_one_fn, 0),
+                                  library_utils.GetConstant(1)));
+
+    llvm::Function* add_two_fn =
+        library_utils.CreateFunction<AddConstToIntFn>("add_two");
+    irb->SetInsertPoint(library_utils.CreateBasicBlock("main", add_two_fn));
+    irb->CreateRet(irb->CreateCall(
+        add_one_fn,
+        {irb->CreateCall(add_one_fn, {ArgumentByPosition(add_two_fn, 0)})}));
+
+    llvm::Function* unrelated_fn =
+        library_utils.CreateFunction<AddConstToIntFn>("unrelated");
+    irb->SetInsertPoint(library_utils.CreateBasicBlock("main", unrelated_fn));
+    irb->CreateRet(ArgumentByPosition(unrelated_fn, 0));
+
+    llvm::raw_string_ostream out(bitcode);
+    llvm::WriteBitcodeToFile(library_utils.module(), out);
+  }
+  llvm::MemoryBufferRef library(bitcode, "library_module");
+
+  EXPECT_EQ(nullptr, codegen_utils_->LinkFunctionFromBitcode(library,
+                                                             "missing"));
+
+  llvm::Function* add_two_fn =
+      codegen_utils_->LinkFunctionFromBitcode(library, "add_two");
+  ASSERT_NE(nullptr, add_two_fn);
+  EXPECT_FALSE(add_two_fn->isDeclaration());
+  EXPECT_TRUE(add_two_fn->hasLocalLinkage());
+  // Only what add_two needs is linked.
+  EXPECT_EQ(nullptr, codegen_utils_->module()->getFunction("unrelated"));
+  // Linking again returns the same function.
+  EXPECT_EQ(add_two_fn,
+            codegen_utils_->LinkFunctionFromBitcode(library, "add_two"));
+
+  // Call add_two from a generated function and inline it.
+  auto irb = codegen_utils_->ir_builder();
+  llvm::Function* add_four_fn =
+      codegen_utils_->CreateFunction<AddConstToIntFn>("add_four");
+  irb->SetInsertPoint(codegen_utils_->CreateBasicBlock("main", add_four_fn));
+  llvm::CallInst* first_call =
+      irb->CreateCall(add_two_fn, {ArgumentByPosition(add_four_fn, 0)});
+  llvm::CallInst* second_call = irb->CreateCall(add_two_fn, {first_call});
+  irb->CreateRet(second_call);
+  EXPECT_TRUE(codegen_utils_->InlineFunction(first_call));
+  EXPECT_TRUE(codegen_utils_->InlineFunction(second_call));
+  EXPECT_FALSE(llvm::verifyModule(*codegen_utils_->module()));
+
+  EXPECT_TRUE(codegen_utils_->PrepareForExecution(
+      CodegenUtils::OptimizationLevel::kNone, false));
+  AddConstToIntFn compiled_add_four_fn =
+      codegen_utils_->GetFunctionPointer<AddConstToIntFn>("add_four");
+  ASSERT_NE(nullptr, compiled_add_four_fn);
+  EXPECT_EQ(9, compiled_add_four_fn(5));
+  EXPECT_EQ(-1, compiled_add_four_fn(-5));
+}
+
 
 #ifdef CODEGEN_DEBUG
 
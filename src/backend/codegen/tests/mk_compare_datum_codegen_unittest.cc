@@ -0,0 +1,162 @@
+//---------------------------------------------------------------------------
+//  Greenplum Database
+//  Copyright 2016 Pivotal Software, Inc.
+//
+//  @filename:
+//    mk_compare_datum_codegen_unittest.cc
+//
+//  @doc:
+//    Unit tests for MKCompareDatumCodegen
+//
+//  @test:
+//
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "postgres.h"  // NOLINT(build/include)
+#undef newNode  // undef newNode so it doesn't have name collision with llvm
+#include "fmgr.h"
+#include "access/memtup.h"
+#include "access/nbtree.h"
+#include "access/tupdesc.h"
+#include "utils/fmgroids.h"
+#include "utils/rel.h"
+#include "utils/tuplesort_mk.h"
+#include "utils/elog.h"
+#undef elog
+#define elog(...)
+}
+
+#include "codegen/codegen_config.h"
+#include "codegen/codegen_manager.h"
+#include "codegen/codegen_wrapper.h"
+#include "codegen/mk_compare_datum_codegen.h"
+
+namespace gpcodegen {
+
+class MKCompareDatumCodegenTestEnvironment : public ::testing::Environment {
+ public:
+  virtual void SetUp() {
+    ASSERT_EQ(InitCodegen(), 1);
+  }
+};
+
+class MKCompareDatumCodegenTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    manager_.reset(new CodegenManager("MKCompareDatumCodegenTest"));
+    codegen_validate_functions = true;
+    // Keep the levels that have no hand-written generator on the regular
+    // path, so that the test does not depend on the bitcode library.
+    codegen_inline_builtins = false;
+  }
+
+  // Set up the levels of mkctxt_ as create_mksort_context would for the
+  // given comparison functions and directions.
+  void InitMKContext(const std::vector<Oid>& sort_functions,
+                     const std::vector<bool>& reverse) {
+    lvctxt_.assign(sort_functions.size(), MKLvContext());
+    mkctxt_ = MKContext();
+    mkctxt_.total_lv = sort_functions.size();
+    mkctxt_.lvctxt = lvctxt_.data();
+    mkctxt_.compare = tupsort_compare_datum;
+    for (size_t i = 0; i < sort_functions.size(); ++i) {
+      MKLvContext* lvctxt = &lvctxt_[i];
+      fmgr_info(sort_functions[i], &lvctxt->scanKey.sk_func);
+      if (reverse[i]) {
+        lvctxt->scanKey.sk_flags |= SK_BT_DESC;
+      }
+      lvctxt->attno = i + 1;
+      lvctxt->typByVal = true;
+      lvctxt->lvtype = F_BTINT4CMP == sort_functions[i] ?
+          MKLV_TYPE_INT32 : MKLV_TYPE_NONE;
+      lvctxt->mkctxt = &mkctxt_;
+    }
+  }
+
+  // Enroll the generator for the levels of mkctxt_ and generate it.
+  void GenerateCompare(const std::vector<Oid>& sort_functions,
+                       const std::vector<bool>& reverse) {
+    std::unique_ptr<bool[]> reverse_array(new bool[reverse.size()]);
+    for (size_t i = 0; i < reverse.size(); ++i) {
+      reverse_array[i] = reverse[i];
+    }
+    compare_fn_ = tupsort_compare_datum;
+    MKCompareDatumCodegen* code_gen = new MKCompareDatumCodegen(
+        manager_.get(), tupsort_compare_datum, &compare_fn_,
+        sort_functions.size(), sort_functions.data(), reverse_array.get());
+    ASSERT_TRUE(manager_->EnrollCodeGenerator(
+        CodegenFuncLifespan_Parameter_Invariant, code_gen));
+    EXPECT_EQ(1, manager_->GenerateCode());
+    ASSERT_TRUE(manager_->PrepareGeneratedFunctions());
+    ASSERT_TRUE(tupsort_compare_datum != compare_fn_);
+  }
+
+  // Compare every pair of values at level lv with both the regular and the
+  // generated function.
+  void CheckLevel(int lv, const std::vector<Datum>& values) {
+    for (Datum d1 : values) {
+      for (Datum d2 : values) {
+        MKEntry v1 = MKEntry();
+        MKEntry v2 = MKEntry();
+        v1.d = d1;
+        v2.d = d2;
+        EXPECT_EQ(tupsort_compare_datum(&v1, &v2, &lvctxt_[lv], &mkctxt_),
+                  compare_fn_(&v1, &v2, &lvctxt_[lv], &mkctxt_));
+      }
+    }
+  }
+
+  std::unique_ptr<CodegenManager> manager_;
+  std::vector<MKLvContext> lvctxt_;
+  MKContext mkctxt_;
+  MKCompareDatumFn compare_fn_;
+};
+
+TEST_F(MKCompareDatumCodegenTest, Int4AscDescTest) {
+  std::vector<Oid> sort_functions = {F_BTINT4CMP, F_BTINT4CMP};
+  std::vector<bool> reverse = {false, true};
+  InitMKContext(sort_functions, reverse);
+  GenerateCompare(sort_functions, reverse);
+
+  std::vector<Datum> values = {
+      Int32GetDatum(std::numeric_limits<int32>::min()),
+      Int32GetDatum(-1),
+      Int32GetDatum(0),
+      Int32GetDatum(1),
+      Int32GetDatum(std::numeric_limits<int32>::max())};
+  CheckLevel(0, values);
+  CheckLevel(1, values);
+}
+
+TEST_F(MKCompareDatumCodegenTest, FallbackTest) {
+  std::vector<Oid> sort_functions = {F_BTINT8CMP, F_BTINT4CMP, F_BTINT8CMP};
+  std::vector<bool> reverse = {true, false, false};
+  InitMKContext(sort_functions, reverse);
+  GenerateCompare(sort_functions, reverse);
+
+  std::vector<Datum> int8_values = {
+      Int64GetDatum(std::numeric_limits<int64>::min()),
+      Int64GetDatum(-1),
+      Int64GetDatum(0),
+      Int64GetDatum(std::numeric_limits<int64>::max())};
+  CheckLevel(0, int8_values);
+  CheckLevel(1, {Int32GetDatum(-7), Int32GetDatum(7)});
+  CheckLevel(2, int8_values);
+}
+
+}  // namespace gpcodegen
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  AddGlobalTestEnvironment(
+      new gpcodegen::MKCompareDatumCodegenTestEnvironment);
+  return RUN_ALL_TESTS();
+}
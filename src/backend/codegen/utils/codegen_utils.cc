@@ -21,12 +21,15 @@
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "codegen/utils/codegen_utils.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 // DO NOT REMOVE: including the MCJIT.h header forces the MCJIT engine to be
 // linked in when using static libraries.
@@ -36,11 +39,14 @@
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Linker/Linker.h"
 #include "llvm/Support/CodeGen.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
@@ -201,7 +207,8 @@ bool CodegenUtils::Optimize(const OptimizationLevel generic_opt_level,
 }
 
 bool CodegenUtils::PrepareForExecution(const OptimizationLevel cpu_opt_level,
-                                        const bool optimize_for_host_cpu) {
+                                        const bool optimize_for_host_cpu,
+                                        llvm::ObjectCache* object_cache) {
   if (engine_.get() != nullptr) {
     // This method was already called successfully.
     return false;
@@ -224,6 +231,10 @@ bool CodegenUtils::PrepareForExecution(const OptimizationLevel cpu_opt_level,
     return false;
   }
 
+  if (object_cache != nullptr) {
+    engine_->setObjectCache(object_cache);
+  }
+
   // Add auxiliary modules generated by companion tools to the ExecutionEngine.
   for (std::unique_ptr<llvm::Module>& auxiliary_module : auxiliary_modules_) {
     engine_->addModule(std::move(auxiliary_module));
@@ -263,6 +274,14 @@ bool CodegenUtils::PrepareForExecution(const OptimizationLevel cpu_opt_level,
   return true;
 }
 
+bool CodegenUtils::FinalizeForExecution() {
+  if (engine_.get() == nullptr) {
+    return false;
+  }
+  engine_->finalizeObject();
+  return true;
+}
+
 void CodegenUtils::PrintUnderlyingModules(llvm::raw_ostream& out) {
   // Print the main module
   out << "==== MAIN MODULE ====" << "\n";
@@ -279,6 +298,120 @@ void CodegenUtils::PrintUnderlyingModules(llvm::raw_ostream& out) {
   out.flush();
 }
 
+llvm::Function* CodegenUtils::LinkFunctionFromBitcode(
+    const llvm::MemoryBufferRef& bitcode,
+    const std::string& function_name) {
+  if (module_.get() == nullptr) {
+    // PrepareForExecution() was already called.
+    return nullptr;
+  }
+
+  llvm::Function* function = module_->getFunction(function_name);
+  if (function != nullptr) {
+    // Either linked by a previous call, or declared as something else.
+    return function->isDeclaration() ? nullptr : function;
+  }
+
+  // Parse the library lazily, so that only the function bodies that we need
+  // are actually read.
+  llvm::ErrorOr<std::unique_ptr<llvm::Module>> library
+      = llvm::getLazyBitcodeModule(
+          llvm::MemoryBuffer::getMemBuffer(bitcode, false), context_);
+  if (!library) {
+    return nullptr;
+  }
+  llvm::Module* library_module = library.get().get();
+  llvm::Function* library_function
+      = library_module->getFunction(function_name);
+  if (library_function == nullptr || library_function->isDeclaration()) {
+    return nullptr;
+  }
+
+  // Collect the requested function along with the file-local functions and
+  // variables that it refers to, directly or through the initializers of
+  // file-local variables.
+  std::unordered_set<const llvm::Value*> visited;
+  std::unordered_set<llvm::Function*> needed_functions;
+  std::vector<const llvm::Value*> worklist = {library_function};
+  while (!worklist.empty()) {
+    const llvm::Value* value = worklist.back();
+    worklist.pop_back();
+    if (!visited.insert(value).second) {
+      continue;
+    }
+    if (const llvm::Function* f = llvm::dyn_cast<llvm::Function>(value)) {
+      if (f != library_function && !f->hasLocalLinkage()) {
+        continue;
+      }
+      llvm::Function* needed_function = const_cast<llvm::Function*>(f);
+      if (needed_function->materialize()) {
+        return nullptr;
+      }
+      needed_functions.insert(needed_function);
+      for (const llvm::BasicBlock& block : *needed_function) {
+        for (const llvm::Instruction& instruction : block) {
+          worklist.insert(worklist.end(),
+                          instruction.op_begin(),
+                          instruction.op_end());
+        }
+      }
+    } else if (const llvm::GlobalVariable* variable
+                   = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+      if (variable->hasLocalLinkage() && variable->hasInitializer()) {
+        worklist.push_back(variable->getInitializer());
+      }
+    } else if (const llvm::Constant* constant
+                   = llvm::dyn_cast<llvm::Constant>(value)) {
+      worklist.insert(worklist.end(), constant->op_begin(), constant->op_end());
+    }
+  }
+
+  // Drop everything else. Functions that are not needed become declarations,
+  // and so do variables with external linkage, so that they are resolved to
+  // the running executable.
+  for (llvm::Function& f : *library_module) {
+    if (needed_functions.find(&f) == needed_functions.end()) {
+      f.deleteBody();
+    }
+  }
+  for (llvm::GlobalVariable& variable : library_module->globals()) {
+    if (!variable.hasLocalLinkage() && !variable.isDeclaration()) {
+      variable.setInitializer(nullptr);
+      variable.setLinkage(llvm::GlobalValue::ExternalLinkage);
+    }
+  }
+  bool erased = true;
+  while (erased) {
+    erased = false;
+    for (llvm::Module::global_iterator it = library_module->global_begin();
+         it != library_module->global_end(); ) {
+      llvm::GlobalVariable* variable = &*it++;
+      variable->removeDeadConstantUsers();
+      if (variable->use_empty()) {
+        variable->eraseFromParent();
+        erased = true;
+      }
+    }
+    for (llvm::Module::iterator it = library_module->begin();
+         it != library_module->end(); ) {
+      llvm::Function* f = &*it++;
+      f->removeDeadConstantUsers();
+      if (f != library_function && f->use_empty()) {
+        f->eraseFromParent();
+        erased = true;
+      }
+    }
+  }
+
+  // Keep the linked copy private to this module, so that it never clashes
+  // with the symbol of the executable.
+  library_function->setLinkage(llvm::GlobalValue::InternalLinkage);
+  if (llvm::Linker::LinkModules(module_.get(), library_module)) {
+    return nullptr;
+  }
+  return module_->getFunction(function_name);
+}
+
 llvm::GlobalVariable* CodegenUtils::AddExternalGlobalVariable(
     llvm::Type* type,
     const void* address) {
@@ -1604,6 +1604,12 @@ DoCopy(const CopyStmt *stmt, const char *queryString)
 			/* should shutdown the mpp stuff such as interconnect and dispatch thread */
 			mppExecutorCleanup(cstate->queryDesc);
 		}
+		if (cstate->CodegenManager)
+		{
+			/* drop the generated code and any pending compilation */
+			CodeGeneratorManagerDestroy(cstate->CodegenManager);
+			cstate->CodegenManager = NULL;
+		}
 		PG_RE_THROW();
 	}
 	PG_END_TRY();
@@ -3685,7 +3691,6 @@ CopyFrom(CopyState cstate)
 	bool		use_fsm = true;		/* by default, use FSM for free space */
 	int		   *attr_offsets;
 	bool		no_more_data = false;
-	ListCell   *cur;
 	bool		cur_row_rejected = false;
 	int			original_lineno_for_qe = 0; /* keep compiler happy (var referenced by macro) */
 	CdbCopy    *cdbCopy = NULL; /* never used... for compiling COPY_HANDLE_ERROR */
@@ -3823,6 +3828,30 @@ CopyFrom(CopyState cstate)
 	partValues = (Datum *) palloc(attr_count * sizeof(Datum));
 	partNulls = (bool *) palloc(attr_count * sizeof(bool));
 
+	/*
+	 * Generate the conversion of the attributes of a line, now that the input
+	 * functions and the COPY options are known. The QD only parses the lines
+	 * of master-only tables, which are not worth compiling for.
+	 */
+	cstate->in_functions = in_functions;
+	cstate->typioparams = typioparams;
+#ifdef USE_CODEGEN
+	cstate->CopyInputAttributes_gen_info.CopyInputAttributes_fn = CopyInputAttributes;
+#endif
+	if (Gp_role != GP_ROLE_DISPATCH)
+	{
+		cstate->CodegenManager = CodeGeneratorManagerCreate("CopyFrom");
+		START_CODE_GENERATOR_MANAGER(cstate->CodegenManager);
+		{
+			enroll_CopyInputAttributes_codegen(CopyInputAttributes,
+					&cstate->CopyInputAttributes_gen_info.CopyInputAttributes_fn,
+					cstate, tupDesc);
+			CodeGeneratorManagerGenerateCode(cstate->CodegenManager);
+			(void) CodeGeneratorManagerPrepareGeneratedFunctions(cstate->CodegenManager);
+		}
+		END_CODE_GENERATOR_MANAGER();
+	}
+
 	/* Set up callback to identify error line number */
 	errcontext.callback = copy_in_error_callback;
 	errcontext.arg = (void *) cstate;
@@ -3874,6 +3903,7 @@ CopyFrom(CopyState cstate)
 				char		relstorage;
 				
 				CHECK_FOR_INTERRUPTS();
+				CHECK_FOR_COMPILED_FUNCTIONS();
 
 				/* Reset the per-tuple exprcontext */
 				ResetPerTupleExprContext(estate);
@@ -4003,36 +4033,10 @@ CopyFrom(CopyState cstate)
 						CopyReadAttributesText(cstate, baseNulls, attr_offsets, num_phys_attrs, attr);
 
 					/*
-					 * Loop to read the user attributes on the line.
+					 * Convert the user attributes on the line.
 					 */
-					foreach(cur, cstate->attnumlist)
-					{
-						int			attnum = lfirst_int(cur);
-						int			m = attnum - 1;
-						char	   *string;
-
-						string = cstate->attribute_buf.data + attr_offsets[m];
-
-						if (baseNulls[m])
-							isnull = true;
-						else
-							isnull = false;
-
-						if (cstate->csv_mode && isnull && cstate->force_notnull_flags[m])
-						{
-							string = cstate->null_print;		/* set to NULL string */
-							isnull = false;
-						}
-
-						cstate->cur_attname = NameStr(attr[m]->attname);
-
-						baseValues[m] = InputFunctionCall(&in_functions[m],
-													  isnull ? NULL : string,
-													  typioparams[m],
-													  attr[m]->atttypmod);
-						baseNulls[m] = isnull;
-						cstate->cur_attname = NULL;
-					}
+					call_CopyInputAttributes(cstate, attr_offsets,
+											 baseValues, baseNulls);
 
 					/*
 					 * Now compute and insert any defaults available for the columns
@@ -4357,6 +4361,12 @@ CopyFrom(CopyState cstate)
 	
 	cstate->rel = NULL; /* closed above */
 
+	if (NULL != cstate->CodegenManager)
+	{
+		CodeGeneratorManagerDestroy(cstate->CodegenManager);
+		cstate->CodegenManager = NULL;
+	}
+
 	MemoryContextSwitchTo(oldcontext);
 	FreeExecutorState(estate);
 }
@@ -5653,6 +5663,55 @@ CopyReadAttributesCSV(CopyState cstate, bool *nulls, int *attr_offsets,
 
 }
 
+/*
+ * Convert the attributes of the current line, which CopyReadAttributesText or
+ * CopyReadAttributesCSV split into attribute_buf, to datums with the input
+ * functions of their types.
+ *
+ * attr_offsets and nulls are the outputs of the CopyReadAttributes functions.
+ * Only the attributes in attnumlist are set in values and nulls.
+ *
+ * With codegen, this is replaced by a version that is specialized for the
+ * types of the relation and the COPY options, see CopyInputAttributesCodegen.
+ */
+void
+CopyInputAttributes(CopyState cstate, int *attr_offsets, Datum *values,
+					bool *nulls)
+{
+	Form_pg_attribute *attr = RelationGetDescr(cstate->rel)->attrs;
+	ListCell   *cur;
+
+	foreach(cur, cstate->attnumlist)
+	{
+		int			attnum = lfirst_int(cur);
+		int			m = attnum - 1;
+		char	   *string;
+		bool		isnull;
+
+		string = cstate->attribute_buf.data + attr_offsets[m];
+
+		if (nulls[m])
+			isnull = true;
+		else
+			isnull = false;
+
+		if (cstate->csv_mode && isnull && cstate->force_notnull_flags[m])
+		{
+			string = cstate->null_print;		/* set to NULL string */
+			isnull = false;
+		}
+
+		cstate->cur_attname = NameStr(attr[m]->attname);
+
+		values[m] = InputFunctionCall(&cstate->in_functions[m],
+									  isnull ? NULL : string,
+									  cstate->typioparams[m],
+									  attr[m]->atttypmod);
+		nulls[m] = isnull;
+		cstate->cur_attname = NULL;
+	}
+}
+
 /*
  * Read a single attribute line when delimiter is 'off'. This is a fast track -
  * we copy the entire line buf into the attribute buf, check for null value,
@@ -9,6 +9,7 @@
 #include "executor/executor.h"
 #include "nodes/execnodes.h"
 #include "cdb/cdbappendonlyam.h"
+#include "codegen/codegen_wrapper.h"
 
 TupleTableSlot *
 AppendOnlyScanNext(ScanState *scanState)
@@ -36,6 +37,27 @@ AppendOnlyScanNext(ScanState *scanState)
 	 */
 	appendonly_getnext(scandesc, direction, slot);
 
+#ifdef USE_CODEGEN
+	/*
+	 * If a deformer was generated for this table, deform the columns the
+	 * scan needs right away, instead of one memtuple_getattr() per
+	 * column reference.
+	 */
+	if (IsA(scanState, TableScanState) &&
+		NULL != ((TableScanState *) scanState)->MemTupleDeform_gen_info.code_generator &&
+		!TupIsNull(slot) &&
+		TupHasMemTuple(slot))
+	{
+		TableScanState *tsstate = (TableScanState *) scanState;
+		int			natts = tsstate->MemTupleDeform_gen_info.natts;
+
+		call_MemTupleDeform(tsstate, slot->PRIVATE_tts_memtuple, slot->tts_mt_bind,
+							natts, slot_get_values(slot), slot_get_isnull(slot));
+		TupSetVirtualTuple(slot);
+		slot->PRIVATE_tts_nvalid = natts;
+	}
+#endif
+
 	return slot;
 }
 
@@ -103,7 +103,6 @@ static void *readHashEntry(AggState *aggstate,
 						   int32 *p_input_size);
 
 /* Methods for hash table */
-static uint32 calc_hash_value(AggState* aggstate, TupleTableSlot *inputslot);
 static void spill_hash_table(AggState *aggstate);
 static void init_agg_hash_iter(HashAggTable* ht);
 static HashAggEntry *lookup_agg_hash_entry(AggState *aggstate, void *input_record,
@@ -125,6 +124,9 @@ static inline void *mpool_cxt_alloc(void *manager, Size len)
  *
  * This based on but different from get_hash_value from the dynahash
  * API.  Use a different name to underline that we don't use dynahash.
+ *
+ * Called through call_CalcHashValue, which may call a generated version
+ * specialized for the grouping columns instead.
  */
 uint32
 calc_hash_value(AggState* aggstate, TupleTableSlot *inputslot)
@@ -363,6 +365,42 @@ setGroupAggs(HashAggTable *hashtable, MemTupleBinding *mt_bind, HashAggEntry *en
 	}
 }
 
+/* Function: agg_hash_entry_match
+ *
+ * Check whether the grouping key of the input tuple matches that of the
+ * given hash table entry.
+ *
+ * Called through call_AggHashEntryMatch, which may call a generated version
+ * specialized for the grouping columns instead.
+ */
+bool
+agg_hash_entry_match(AggState *aggstate, TupleTableSlot *inputslot,
+					 MemTuple entry_tuple)
+{
+	MemTupleBinding *mt_bind = aggstate->hashslot->tts_mt_bind;
+	Agg *agg = (Agg*)aggstate->ss.ps.plan;
+	int i;
+
+	for (i = 0; i < agg->numCols; i++)
+	{
+		AttrNumber	att = agg->grpColIdx[i];
+		bool input_isNull = false;
+		bool entry_isNull = false;
+		Datum input_datum = slot_getattr(inputslot, att, &input_isNull);
+		Datum entry_datum = memtuple_getattr(entry_tuple, mt_bind, att, &entry_isNull);
+
+		if ( !input_isNull && !entry_isNull &&
+			 (DatumGetBool(FunctionCall2(&aggstate->eqfunctions[i],
+										 input_datum,
+										 entry_datum)) ) )
+			continue; /* Both non-NULL and equal. */
+		if (!(input_isNull && entry_isNull))
+			return false; /* Unequal, or only one of them is NULL. */
+	}
+
+	return true;
+}
+
 /*
  * Function: lookup_agg_hash_entry
  *
@@ -420,6 +458,17 @@ lookup_agg_hash_entry(AggState *aggstate,
 
 		if (hashkey != entry->hashvalue)
 		{
+			if (aggstate->ss.ps.profile)
+				aggstate->ss.ps.profile->hashCollisions++;
+			entry = entry->next;
+			continue;
+		}
+
+		if (input_type == INPUT_RECORD_TUPLE)
+		{
+			if (call_AggHashEntryMatch(aggstate, (TupleTableSlot *)input_record, mtup))
+				break;
+
 			entry = entry->next;
 			continue;
 		}
@@ -434,9 +483,6 @@ lookup_agg_hash_entry(AggState *aggstate,
 				
 			switch(input_type)
 			{
-				case INPUT_RECORD_TUPLE:
-					input_datum = slot_getattr((TupleTableSlot *)input_record, att, &input_isNull);
-					break;
 				case INPUT_RECORD_GROUP_AND_AGGS:
 					input_datum = memtuple_getattr((MemTuple)input_record, mt_bind, att, &input_isNull);
 					break;
@@ -821,7 +867,7 @@ agg_hash_initial_pass(AggState *aggstate)
 
 		/* Find or (if there's room) build a hash table entry for the
 		 * input tuple's group. */
-		hashkey = calc_hash_value(aggstate, outerslot);
+		hashkey = call_CalcHashValue(aggstate, outerslot);
 		entry = lookup_agg_hash_entry(aggstate, (void *)outerslot,
 									  INPUT_RECORD_TUPLE, 0, hashkey, 0, &isNew);
 		
@@ -574,6 +574,8 @@ ExecutorStart(QueryDesc *queryDesc, int eflags)
 		 * Initialize the plan state tree
 		 */
 		Assert(CurrentMemoryContext == estate->es_query_cxt);
+		if (!(eflags & EXEC_FLAG_EXPLAIN_ONLY))
+			InstrProfileQueryStart(estate);
 		InitPlan(queryDesc, eflags);
 
 		Assert(queryDesc->planstate);
@@ -1130,6 +1132,8 @@ ExecutorEnd(QueryDesc *queryDesc)
 	queryDesc->es_processed = estate->es_processed;
 	queryDesc->es_lastoid = estate->es_lastoid;
 
+	InstrProfileQueryEnd(estate);
+
 	/*
 	 * Release EState and per-query memory context
 	 */
@@ -82,6 +82,7 @@
 
 #include "executor/executor.h"
 #include "executor/instrument.h"
+#include "executor/execHHashagg.h"
 #include "executor/nodeAgg.h"
 #include "executor/nodeAppend.h"
 #include "executor/nodeAssertOp.h"
@@ -131,6 +132,8 @@
 #include "pg_trace.h"
 
 #include "codegen/codegen_wrapper.h"
+#include "utils/lsyscache.h"
+#include "utils/tuplesort_mk.h"
 
 #ifdef CDB_TRACE_EXECUTOR
 #include "nodes/print.h"
@@ -168,6 +171,15 @@ static void ExecCdbTraceNode(PlanState *node, bool entry, TupleTableSlot *result
  static void
  EnrollProjInfoTargetList(PlanState* result, ProjectionInfo* ProjInfo);
 
+ static void
+ EnrollHashJoin(PlanState* result);
+
+ static void
+ EnrollAppendOnlyScan(PlanState* result);
+
+ static void
+ EnrollSort(PlanState* result);
+
 /*
  * setSubplanSliceId
  *   Set the slice id info for the given subplan.
@@ -369,6 +381,7 @@ ExecInitNode(Plan *node, EState *estate, int eflags)
 			{
 			  EnrollProjInfoTargetList(result, result->ps_ProjInfo);
 			}
+			EnrollAppendOnlyScan(result);
 			}
 			END_MEMORY_ACCOUNT();
 			break;
@@ -545,6 +558,11 @@ ExecInitNode(Plan *node, EState *estate, int eflags)
 			{
 			result = (PlanState *) ExecInitHashJoin((HashJoin *) node,
 													estate, eflags);
+			/*
+			 * Enroll the hash value computation of both sides and the
+			 * bucket matching clauses in codegen_manager
+			 */
+			EnrollHashJoin(result);
 			}
 			END_MEMORY_ACCOUNT();
 			break;
@@ -583,6 +601,7 @@ ExecInitNode(Plan *node, EState *estate, int eflags)
 			{
 			result = (PlanState *) ExecInitSort((Sort *) node,
 												estate, eflags);
+			EnrollSort(result);
 			}
 			END_MEMORY_ACCOUNT();
 			break;
@@ -609,7 +628,39 @@ ExecInitNode(Plan *node, EState *estate, int eflags)
 			  }
 			  enroll_AdvanceAggregates_codegen(advance_aggregates,
 			        &aggstate->AdvanceAggregates_gen_info.AdvanceAggregates_fn,
-			        aggstate);			}
+			        aggstate);
+			  /*
+			   * Enrolled after advance_aggregates, whose generated version
+			   * the pipeline calls.
+			   */
+			  if (((Agg *) node)->aggstrategy == AGG_PLAIN)
+			  {
+			    enroll_AggScanPipeline_codegen(agg_scan_pipeline,
+			          &aggstate->AggScanPipeline_gen_info.AggScanPipeline_fn,
+			          aggstate);
+			  }
+			  if (((Agg *) node)->aggstrategy == AGG_HASHED)
+			  {
+			    enroll_CalcHashValue_codegen(calc_hash_value,
+			          &aggstate->CalcHashValue_gen_info.CalcHashValue_fn,
+			          aggstate);
+			    enroll_AggHashEntryMatch_codegen(agg_hash_entry_match,
+			          &aggstate->AggHashEntryMatch_gen_info.AggHashEntryMatch_fn,
+			          aggstate);
+			    /*
+			     * The first integer in hash_needed is the largest Var number
+			     * of the grouping columns kept in the entries.
+			     */
+			    if (NIL != aggstate->hash_needed)
+			    {
+			      enroll_MemTupleDeform_codegen(memtuple_getsomeattrs,
+			            &aggstate->MemTupleDeform_gen_info.MemTupleDeform_fn,
+			            aggstate,
+			            aggstate->ss.ss_ScanTupleSlot->tts_tupleDescriptor,
+			            linitial_int(aggstate->hash_needed));
+			    }
+			  }
+			}
 			}
 			END_MEMORY_ACCOUNT();
 			break;
@@ -776,6 +827,10 @@ ExecInitNode(Plan *node, EState *estate, int eflags)
 	if (estate->es_instrument && result != NULL)
 		result->instrument = InstrAlloc(1);
 
+	/* Set up the always-on profile, for the nodes of the current slice */
+	if (result != NULL && !isAlienPlanNode)
+		result->profile = InstrProfileAlloc(estate, node);
+
 	if (result != NULL)
 	{
 		SAVE_EXECUTOR_MEMORY_ACCOUNT(result, curMemoryAccountId);
@@ -886,6 +941,133 @@ EnrollProjInfoTargetList(PlanState* result, ProjectionInfo* ProjInfo)
 #endif
 }
 
+/* ----------------------------------------------------------------
+ *    EnrollHashJoin
+ *
+ *    Enroll the hash value computation of the outer and inner side
+ *    of a HashJoin, and its bucket matching clauses, for codegen.
+ * ----------------------------------------------------------------
+ */
+void
+EnrollHashJoin(PlanState* result)
+{
+#ifdef USE_CODEGEN
+	if (NULL == result)
+	{
+		return;
+	}
+
+	HashJoinState *hjstate = (HashJoinState *) result;
+	HashState *hashState = (HashState *) innerPlanState(hjstate);
+
+	enroll_ExecHashGetHashValue_codegen(ExecHashGetHashValue,
+	      &hjstate->ExecHashGetHashValue_gen_info.ExecHashGetHashValue_fn,
+	      hjstate, hjstate->hj_OuterHashKeys, hjstate->hj_HashOperators,
+	      true /* outer_tuple */);
+	enroll_ExecHashGetHashValue_codegen(ExecHashGetHashValue,
+	      &hashState->ExecHashGetHashValue_gen_info.ExecHashGetHashValue_fn,
+	      hashState, hjstate->hj_InnerHashKeys, hjstate->hj_HashOperators,
+	      false /* outer_tuple */);
+
+	ListCell *l;
+	foreach(l, hjstate->hashqualclauses)
+	{
+	  ExprState *exprstate = (ExprState*) lfirst(l);
+	  enroll_ExecEvalExpr_codegen(exprstate->evalfunc,
+	                              &exprstate->evalfunc,
+	                              exprstate,
+	                              result->ps_ExprContext,
+	                              result);
+	}
+#endif
+}
+
+/* ----------------------------------------------------------------
+ *    EnrollAppendOnlyScan
+ *
+ *    Enroll the deforming of the memtuples of an append-only row
+ *    table, up to the last column that the scan needs, for codegen.
+ * ----------------------------------------------------------------
+ */
+void
+EnrollAppendOnlyScan(PlanState* result)
+{
+#ifdef USE_CODEGEN
+	if (NULL == result)
+	{
+		return;
+	}
+
+	TableScanState *tsstate = (TableScanState *) result;
+	Relation rel = tsstate->ss.ss_currentRelation;
+	if (NULL == rel ||
+	    !RelationIsAoRows(rel))
+	{
+		return;
+	}
+
+	TupleDesc tupdesc = tsstate->ss.ss_ScanTupleSlot->tts_tupleDescriptor;
+	bool *proj = (bool *) palloc0(tupdesc->natts * sizeof(bool));
+	GetNeededColumnsForScan((Node *) result->plan->targetlist, proj, tupdesc->natts);
+	GetNeededColumnsForScan((Node *) result->plan->qual, proj, tupdesc->natts);
+
+	int natts = tupdesc->natts;
+	while (natts > 0 && !proj[natts - 1])
+	{
+		natts--;
+	}
+	pfree(proj);
+
+	if (natts > 0)
+	{
+	  enroll_MemTupleDeform_codegen(memtuple_getsomeattrs,
+	        &tsstate->MemTupleDeform_gen_info.MemTupleDeform_fn,
+	        tsstate, tupdesc, natts);
+	}
+#endif
+}
+
+/* ----------------------------------------------------------------
+ *    EnrollSort
+ *
+ *    Enroll the comparator of a multi-key sort, specialized for the
+ *    sort keys of the Sort node, for codegen.
+ * ----------------------------------------------------------------
+ */
+void
+EnrollSort(PlanState* result)
+{
+#ifdef USE_CODEGEN
+	if (NULL == result ||
+	    !gp_enable_mk_sort)
+	{
+		return;
+	}
+
+	SortState *sortstate = (SortState *) result;
+	Sort *plannode = (Sort *) result->plan;
+	Oid *sortFunctions = (Oid *) palloc(plannode->numCols * sizeof(Oid));
+	bool *reverse = (bool *) palloc(plannode->numCols * sizeof(bool));
+
+	for (int i = 0; i < plannode->numCols; i++)
+	{
+		if (!get_compare_function_for_ordering_op(plannode->sortOperators[i],
+												  &sortFunctions[i], &reverse[i]))
+		{
+			elog(ERROR, "operator %u is not a valid ordering operator",
+				 plannode->sortOperators[i]);
+		}
+	}
+
+	enroll_MKCompareDatum_codegen(tupsort_compare_datum,
+	      &sortstate->MKCompareDatum_gen_info.MKCompareDatum_fn,
+	      sortstate, plannode->numCols, sortFunctions, reverse);
+
+	pfree(sortFunctions);
+	pfree(reverse);
+#endif
+}
+
 
 /* ----------------------------------------------------------------
  *		ExecSliceDependencyNode
@@ -939,6 +1121,8 @@ TupleTableSlot *
 ExecProcNode(PlanState *node)
 {
 	TupleTableSlot *result = NULL;
+	InstrProfile *saveProfile = CurrentInstrProfile;
+	uint64		startCycles = 0;
 
 	START_CODE_GENERATOR_MANAGER(node->CodegenManager);
 	{
@@ -946,6 +1130,7 @@ ExecProcNode(PlanState *node)
 	{
 
 	CHECK_FOR_INTERRUPTS();
+	CHECK_FOR_COMPILED_FUNCTIONS();
 
 	/*
 	 * Even if we are requested to finish query, Motion has to do its work
@@ -969,6 +1154,18 @@ ExecProcNode(PlanState *node)
 	if (node->instrument)
 		InstrStartNode(node->instrument);
 
+	/* Count the call, and time one in every gp_instrument_profile_interval */
+	if (node->profile)
+	{
+		node->profile->ncalls++;
+		if (--node->profileCountdown <= 0)
+		{
+			node->profileCountdown = gp_instrument_profile_interval;
+			startCycles = INSTR_CYCLES_GET_CURRENT();
+		}
+		CurrentInstrProfile = node->profile;
+	}
+
 	if(!node->fHadSentGpmon)
 		CheckSendPlanStateGpmonPkt(node);
 
@@ -1138,6 +1335,13 @@ ExecProcNode(PlanState *node)
 			break;
 	}
 
+	if (startCycles != 0)
+	{
+		node->profile->sampleCycles += INSTR_CYCLES_GET_CURRENT() - startCycles;
+		node->profile->nsamples++;
+	}
+	CurrentInstrProfile = saveProfile;
+
 	if (node->instrument)
 		InstrStopNode(node->instrument, TupIsNull(result) ? 0.0 : 1.0);
 
@@ -1197,6 +1401,8 @@ Node *
 MultiExecProcNode(PlanState *node)
 {
 	Node	   *result;
+	InstrProfile *saveProfile = CurrentInstrProfile;
+	uint64		startCycles = 0;
 
 	CHECK_FOR_INTERRUPTS();
 
@@ -1209,6 +1415,14 @@ MultiExecProcNode(PlanState *node)
 		if (node->chgParam != NULL) /* something changed */
 			ExecReScan(node, NULL); /* let ReScan handle this */
 
+		/* These nodes are called once per scan; time every call */
+		if (node->profile)
+		{
+			node->profile->ncalls++;
+			startCycles = INSTR_CYCLES_GET_CURRENT();
+			CurrentInstrProfile = node->profile;
+		}
+
 		switch (nodeTag(node))
 		{
 				/*
@@ -1237,6 +1451,13 @@ MultiExecProcNode(PlanState *node)
 				break;
 		}
 
+		if (startCycles != 0)
+		{
+			node->profile->sampleCycles += INSTR_CYCLES_GET_CURRENT() - startCycles;
+			node->profile->nsamples++;
+		}
+		CurrentInstrProfile = saveProfile;
+
 		PG_TRACE5(execprocnode__exit, Gp_segment, currentSliceId, nodeTag(node), node->plan->plan_node_id, node->plan->plan_parent_node_id);
 	}
 	END_MEMORY_ACCOUNT();
@@ -430,6 +430,17 @@ ExecTableScanRelation(ScanState *scanState)
 	return ExecScan(scanState, getScanMethod(scanState->tableType)->accessMethod);
 }
 
+/*
+ * FetchTableScanRelation
+ *   Return the next tuple from the access method of the relation, without
+ *   checking the quals or projecting.
+ */
+TupleTableSlot *
+FetchTableScanRelation(ScanState *scanState)
+{
+	return getScanMethod(scanState->tableType)->accessMethod(scanState);
+}
+
 /*
  * BeginScanRelation
  *   Begin the relation scan.
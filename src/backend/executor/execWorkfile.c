@@ -15,6 +15,7 @@
 #include "storage/buffile.h"
 #include "storage/bfz.h"
 #include "executor/execWorkfile.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 #include "cdb/cdbvars.h"
 #include "utils/workfile_mgr.h"
@@ -219,6 +220,7 @@ ExecWorkFile_Write(ExecWorkFile *workfile,
 {
 	Assert(workfile != NULL);
 	uint64 bytes;
+	uint64 waitStart;
 
 	SIMPLE_FAULT_INJECTOR(WorkfileWriteFail);
 
@@ -235,6 +237,8 @@ ExecWorkFile_Write(ExecWorkFile *workfile,
 		workfile_mgr_report_error();
 	}
 
+	waitStart = InstrWaitStart();
+
 	switch(workfile->fileType)
 	{
 		case BUFFILE:
@@ -298,6 +302,11 @@ ExecWorkFile_Write(ExecWorkFile *workfile,
 			insist_log(false, "invalid work file type: %d", workfile->fileType);
 	}
 
+	InstrWaitEnd(INSTR_WAIT_WORKFILE_WRITE, waitStart);
+
+	if (CurrentInstrProfile)
+		CurrentInstrProfile->spillBytes += size;
+
 	return true;
 }
 
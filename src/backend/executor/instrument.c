@@ -17,6 +17,51 @@
 #include <unistd.h>
 
 #include "executor/instrument.h"
+#include "cdb/cdbvars.h"
+#include "miscadmin.h"
+#include "nodes/execnodes.h"
+#include "storage/backendid.h"
+#include "storage/shmem.h"
+
+/*
+ * Shared memory of the always-on profile: one slot for each backend, and
+ * the reading of the cycle counter and the clock when the postmaster
+ * started, to convert cycles to seconds.
+ */
+typedef struct InstrProfileShmem
+{
+	uint64		startCycles;
+	instr_time	startTime;
+	InstrProfileSlot slots[1];	/* VARIABLE LENGTH ARRAY, MaxBackends */
+} InstrProfileShmem;
+
+static InstrProfileShmem *InstrProfileData = NULL;
+
+/*
+ * The top-level query, and its slot if its nodes are profiled.  The slot is
+ * NULL if gp_instrument_profile_interval is 0.
+ */
+static struct EState *InstrProfileOwner = NULL;
+static InstrProfileSlot *MyInstrProfileSlot = NULL;
+
+/* The profile of the node that ExecProcNode is running, if any */
+InstrProfile *CurrentInstrProfile = NULL;
+
+/*
+ * The wait times of the top-level query: the waitCycles of its slot, or
+ * LocalWaitCycles if it has none.  They are kept in LocalWaitCycles after
+ * the query ends, until the next one starts.
+ */
+static uint64 LocalWaitCycles[INSTR_NUM_WAIT_CLASSES];
+uint64	   *InstrWaitCycles = LocalWaitCycles;
+
+const char *const InstrWaitClassNames[INSTR_NUM_WAIT_CLASSES] = {
+	"motion recv",
+	"motion send",
+	"read I/O",
+	"workfile write",
+	"lock"
+};
 
 
 /* Allocate new instrumentation structure(s) */
@@ -102,3 +147,210 @@ InstrEndLoop(Instrumentation *instr)
 	instr->firsttuple = 0;
 	instr->tuplecount = 0;
 }
+
+
+/*
+ * Report shared-memory space needed by InstrProfileShmemInit.
+ */
+Size
+InstrProfileShmemSize(void)
+{
+	return add_size(offsetof(InstrProfileShmem, slots),
+					mul_size(sizeof(InstrProfileSlot), MaxBackends));
+}
+
+/*
+ * Initialize the slots of the always-on profile during postmaster startup.
+ */
+void
+InstrProfileShmemInit(void)
+{
+	bool		found;
+
+	InstrProfileData = (InstrProfileShmem *)
+		ShmemInitStruct("Instrumentation Profile", InstrProfileShmemSize(),
+						&found);
+
+	if (!found)
+	{
+		MemSet(InstrProfileData, 0, InstrProfileShmemSize());
+		InstrProfileData->startCycles = INSTR_CYCLES_GET_CURRENT();
+		INSTR_TIME_SET_CURRENT(InstrProfileData->startTime);
+	}
+}
+
+/*
+ * Make the query of estate the top-level one, unless there is one already,
+ * and claim the slot of this backend for it.  Queries that run inside
+ * another one, for functions or SPI, are not profiled: their nodes have the
+ * same plan_node_ids.  Their waits are accounted to the top-level query.
+ */
+void
+InstrProfileQueryStart(struct EState *estate)
+{
+	volatile InstrProfileSlot *slot;
+
+	if (InstrProfileOwner != NULL)
+		return;
+
+	InstrProfileOwner = estate;
+	MemSet(LocalWaitCycles, 0, sizeof(LocalWaitCycles));
+	InstrWaitCycles = LocalWaitCycles;
+
+	if (gp_instrument_profile_interval <= 0 ||
+		InstrProfileData == NULL ||
+		MyBackendId < 1 || MyBackendId > MaxBackends)
+		return;
+
+	slot = &InstrProfileData->slots[MyBackendId - 1];
+
+	slot->changecount++;
+	slot->pid = MyProcPid;
+	slot->sessionId = gp_session_id;
+	slot->commandCount = gp_command_count;
+	slot->sliceId = currentSliceId;
+	slot->nnodes = 0;
+	MemSet((uint64 *) slot->waitCycles, 0, sizeof(slot->waitCycles));
+	MemSet((InstrProfile *) slot->nodes, 0, sizeof(slot->nodes));
+	slot->changecount++;
+	Assert((slot->changecount & 1) == 0);
+
+	MyInstrProfileSlot = (InstrProfileSlot *) slot;
+	InstrWaitCycles = MyInstrProfileSlot->waitCycles;
+}
+
+/*
+ * End the top-level query, and release the slot of this backend, if estate
+ * is the top-level query.
+ *
+ * The counters stay in the slot, and the wait times in LocalWaitCycles, so
+ * that they are still there if the statistics of EXPLAIN ANALYZE are
+ * collected after this.
+ */
+void
+InstrProfileQueryEnd(struct EState *estate)
+{
+	volatile InstrProfileSlot *slot = MyInstrProfileSlot;
+
+	if (estate != InstrProfileOwner)
+		return;
+
+	if (slot != NULL)
+	{
+		memcpy(LocalWaitCycles, (uint64 *) slot->waitCycles,
+			   sizeof(LocalWaitCycles));
+
+		slot->changecount++;
+		slot->sessionId = 0;
+		slot->changecount++;
+		Assert((slot->changecount & 1) == 0);
+	}
+
+	InstrProfileOwner = NULL;
+	MyInstrProfileSlot = NULL;
+	CurrentInstrProfile = NULL;
+	InstrWaitCycles = LocalWaitCycles;
+}
+
+/*
+ * Return the profile of a plan node of estate, or NULL if it isn't
+ * profiled.
+ */
+InstrProfile *
+InstrProfileAlloc(struct EState *estate, struct Plan *plan)
+{
+	volatile InstrProfileSlot *slot = MyInstrProfileSlot;
+	InstrProfile *profile;
+
+	if (estate != InstrProfileOwner || slot == NULL ||
+		plan->plan_node_id < 0 ||
+		plan->plan_node_id >= INSTR_PROFILE_MAX_NODES)
+		return NULL;
+
+	profile = (InstrProfile *) &slot->nodes[plan->plan_node_id];
+	profile->nodeTag = nodeTag(plan);
+	if (slot->nnodes <= plan->plan_node_id)
+		slot->nnodes = plan->plan_node_id + 1;
+
+	return profile;
+}
+
+/*
+ * Release the slot at the end of the transaction, in case the query that
+ * claimed it was aborted before ExecutorEnd.
+ */
+void
+AtEOXact_InstrProfile(void)
+{
+	if (InstrProfileOwner != NULL)
+		InstrProfileQueryEnd(InstrProfileOwner);
+	CurrentInstrProfile = NULL;
+}
+
+/*
+ * Number of slots, for InstrProfileSlotCopy.
+ */
+int
+InstrProfileSlotCount(void)
+{
+	return InstrProfileData != NULL ? MaxBackends : 0;
+}
+
+/*
+ * Copy a slot of any backend, following the protocol of retrying if its
+ * changecount changes while we copy it.
+ *
+ * Returns false if the slot is not profiling a query.
+ */
+bool
+InstrProfileSlotCopy(int slotno, InstrProfileSlot *dst)
+{
+	volatile InstrProfileSlot *slot;
+
+	Assert(slotno >= 0 && slotno < InstrProfileSlotCount());
+	slot = &InstrProfileData->slots[slotno];
+
+	for (;;)
+	{
+		int			save_changecount = slot->changecount;
+
+		memcpy(dst, (InstrProfileSlot *) slot, sizeof(InstrProfileSlot));
+
+		if (save_changecount == slot->changecount &&
+			(save_changecount & 1) == 0)
+			break;
+
+		/* Make sure we can break out of loop if stuck... */
+		CHECK_FOR_INTERRUPTS();
+	}
+
+	return dst->sessionId != 0;
+}
+
+/*
+ * Convert a difference of INSTR_CYCLES_GET_CURRENT() to seconds.
+ *
+ * The rate of the counter is measured since the postmaster started, so that
+ * any backend can convert the counters of the others.
+ */
+double
+InstrProfileCyclesToSeconds(uint64 cycles)
+{
+	uint64		nowCycles;
+	instr_time	nowTime;
+	double		elapsed;
+
+	if (InstrProfileData == NULL)
+		return 0.0;
+
+	nowCycles = INSTR_CYCLES_GET_CURRENT();
+	INSTR_TIME_SET_CURRENT(nowTime);
+	INSTR_TIME_SUBTRACT(nowTime, InstrProfileData->startTime);
+	elapsed = INSTR_TIME_GET_DOUBLE(nowTime);
+
+	if (nowCycles <= InstrProfileData->startCycles || elapsed <= 0.0)
+		return 0.0;
+
+	return (double) cycles * elapsed /
+		(double) (nowCycles - InstrProfileData->startCycles);
+}
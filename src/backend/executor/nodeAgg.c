@@ -133,11 +133,36 @@ typedef struct AggHashEntryData
 	AggStatePerGroupData pergroup[1];	/* VARIABLE LENGTH ARRAY */
 } AggHashEntryData;				/* VARIABLE LENGTH STRUCT */
 
+/*
+ * An entry of the distinct set of a hashed DISTINCT aggregate.  The set is
+ * kept from group to group; a value belongs to the current group's set only
+ * if it was last seen in that group.
+ */
+typedef struct DistinctHashEntryData *DistinctHashEntry;
+
+typedef struct DistinctHashEntryData
+{
+	TupleHashEntryData shared;	/* common header for hash table entries */
+	int64		groupno;		/* last group the value was seen in */
+} DistinctHashEntryData;
+
 static void advance_transition_function(AggState *aggstate,
 										AggStatePerAgg peraggstate,
 										AggStatePerGroup pergroupstate,
 										FunctionCallInfoData *fcinfo,
 										MemoryManagerContainer *mem_manager);
+static void begin_ordered_aggregate_sort(AggState *aggstate,
+										 AggStatePerAgg peraggstate,
+										 int workMemKB);
+static void reset_distinct_hash_table(AggState *aggstate,
+									  AggStatePerAgg peraggstate);
+static void advance_distinct_hash(AggState *aggstate,
+								  AggStatePerAgg peraggstate,
+								  AggStatePerGroup pergroupstate,
+								  TupleTableSlot *slot,
+								  MemoryManagerContainer *mem_manager);
+static Size distinct_hash_space(AggStatePerAgg peraggstate);
+static bool distinct_hash_contains(AggStatePerAgg peraggstate, Datum value);
 static void process_ordered_aggregate_single(AggState *aggstate,
 											 AggStatePerAgg peraggstate,
 											 AggStatePerGroup pergroupstate);
@@ -203,6 +228,160 @@ datumCopyWithMemManager(Datum oldvalue, Datum value, bool typByVal, int typLen,
 	return res;
 }
 
+/*
+ * Start a fresh sort operation for a DISTINCT/ORDER BY aggregate, which may
+ * use workMemKB of memory before spilling.
+ *
+ * When called, CurrentMemoryContext should be the per-query context.
+ */
+static void
+begin_ordered_aggregate_sort(AggState *aggstate, AggStatePerAgg peraggstate,
+							 int workMemKB)
+{
+	/*
+	 * In case of rescan, maybe there could be an uncompleted sort
+	 * operation?  Clean it up if so.
+	 */
+	if(gp_enable_mk_sort)
+	{
+		if (peraggstate->sortstate)
+			tuplesort_end_mk((Tuplesortstate_mk *) peraggstate->sortstate);
+
+		/*
+		 * We use a plain Datum sorter when there's a single input column;
+		 * otherwise sort the full tuple.  (See comments for
+		 * process_ordered_aggregate_single.)
+		 */
+		if (peraggstate->numInputs == 1)
+		{
+			peraggstate->sortstate =
+				tuplesort_begin_datum_mk(&aggstate->ss,
+										 peraggstate->evaldesc->attrs[0]->atttypid,
+										 peraggstate->sortOperators[0], false,
+										 workMemKB, false);
+		}
+		else
+		{
+			bool	   *nullsFirstFlags = palloc0(peraggstate->numSortCols * sizeof(bool));
+
+			peraggstate->sortstate =
+				tuplesort_begin_heap_mk(&aggstate->ss,
+										peraggstate->evaldesc,
+										peraggstate->numSortCols, peraggstate->sortColIdx,
+										peraggstate->sortOperators, nullsFirstFlags,
+										workMemKB, false);
+			pfree(nullsFirstFlags);
+		}
+
+		/* 
+		 * CDB: If EXPLAIN ANALYZE, let all of our tuplesort operations
+		 * share our Instrumentation object and message buffer.
+		 */
+		if (aggstate->ss.ps.instrument)
+			tuplesort_set_instrument_mk((Tuplesortstate_mk *) peraggstate->sortstate,
+					aggstate->ss.ps.instrument,
+					aggstate->ss.ps.cdbexplainbuf);
+	}
+	else /* gp_enable_mk_sort is off */
+	{
+		if (peraggstate->sortstate)
+			tuplesort_end((Tuplesortstate *) peraggstate->sortstate);
+
+		/*
+		 * We use a plain Datum sorter when there's a single input column;
+		 * otherwise sort the full tuple.  (See comments for
+		 * process_ordered_aggregate_single.)
+		 */
+		if (peraggstate->numInputs == 1)
+		{
+			peraggstate->sortstate =
+				tuplesort_begin_datum(peraggstate->evaldesc->attrs[0]->atttypid,
+									  peraggstate->sortOperators[0], false,
+									  workMemKB, false);
+		}
+		else
+		{
+			bool	   *nullsFirstFlags = palloc0(peraggstate->numSortCols * sizeof(bool));
+
+			peraggstate->sortstate =
+				tuplesort_begin_heap(peraggstate->evaldesc,
+									 peraggstate->numSortCols, peraggstate->sortColIdx,
+									 peraggstate->sortOperators, nullsFirstFlags,
+									 workMemKB, false);
+		}
+
+		/* 
+		 * CDB: If EXPLAIN ANALYZE, let all of our tuplesort operations
+		 * share our Instrumentation object and message buffer.
+		 */
+		if (aggstate->ss.ps.instrument)
+			tuplesort_set_instrument((Tuplesortstate *) peraggstate->sortstate,
+					aggstate->ss.ps.instrument,
+					aggstate->ss.ps.cdbexplainbuf);
+	}
+
+	/* CDB: Set enhanced sort options. */
+	{
+		int64 		limit = 0;
+		int64 		offset = 0;
+		int 		unique = peraggstate->aggref->aggdistinct &&
+							 ( gp_enable_sort_distinct ? 1 : 0) ;
+		int 		sort_flags = gp_sort_flags; /* get the guc */
+		int         maxdistinct = gp_sort_max_distinct; /* get guc */
+
+		if(gp_enable_mk_sort)
+			cdb_tuplesort_init_mk((Tuplesortstate_mk *) peraggstate->sortstate, 
+					offset, limit, unique, 
+					sort_flags, maxdistinct);
+		else
+			cdb_tuplesort_init((Tuplesortstate *) peraggstate->sortstate, 
+					offset, limit, unique, 
+					sort_flags, maxdistinct);
+	}
+}
+
+/*
+ * Start an empty distinct set for a hashed DISTINCT aggregate.  A sort left
+ * over from a previous group that spilled is discarded too.
+ *
+ * The hash table is reused: bumping the group number empties the set
+ * without touching its entries.  The values of earlier groups still take
+ * space, so the table is only rebuilt once they fill half of the budget,
+ * which leaves each group at least the other half before it spills.
+ */
+static void
+reset_distinct_hash_table(AggState *aggstate, AggStatePerAgg peraggstate)
+{
+	if (peraggstate->sortstate)
+	{
+		if (gp_enable_mk_sort)
+			tuplesort_end_mk((Tuplesortstate_mk *) peraggstate->sortstate);
+		else
+			tuplesort_end((Tuplesortstate *) peraggstate->sortstate);
+		peraggstate->sortstate = NULL;
+	}
+
+	if (peraggstate->distinctTable != NULL &&
+		distinct_hash_space(peraggstate) > peraggstate->distinctMemLimit / 2)
+	{
+		/* The dynahash lives in a child context, so delete that as well. */
+		MemoryContextResetAndDeleteChildren(peraggstate->distinctcxt);
+		peraggstate->distinctTable = NULL;
+	}
+
+	if (peraggstate->distinctTable == NULL)
+		peraggstate->distinctTable =
+			BuildTupleHashTable(1, &peraggstate->distinctColIdx,
+								peraggstate->distinctEqfns,
+								peraggstate->distinctHashfns,
+								256, sizeof(DistinctHashEntryData),
+								peraggstate->distinctcxt,
+								aggstate->tmpcontext->ecxt_per_tuple_memory);
+
+	peraggstate->distinctGroupNo++;
+	peraggstate->distinctSpilled = false;
+}
+
 /*
  * Initialize all aggregates for a new group of input values.
  *
@@ -224,111 +403,14 @@ initialize_aggregates(AggState *aggstate,
 		AggStatePerGroup pergroupstate = &pergroup[aggno];
 
 		/*
-		 * Start a fresh sort operation for each DISTINCT/ORDER BY aggregate.
+		 * Start a fresh sort operation for each DISTINCT/ORDER BY aggregate,
+		 * or an empty distinct set for a hashed DISTINCT aggregate.
 		 */
-		if (peraggstate->numSortCols > 0)
-		{
-			/*
-			 * In case of rescan, maybe there could be an uncompleted sort
-			 * operation?  Clean it up if so.
-			 */
-			if(gp_enable_mk_sort)
-			{
-				if (peraggstate->sortstate)
-					tuplesort_end_mk((Tuplesortstate_mk *) peraggstate->sortstate);
-
-				/*
-				 * We use a plain Datum sorter when there's a single input column;
-				 * otherwise sort the full tuple.  (See comments for
-				 * process_ordered_aggregate_single.)
-				 */
-				if (peraggstate->numInputs == 1)
-				{
-					peraggstate->sortstate =
-						tuplesort_begin_datum_mk(&aggstate->ss,
-												 peraggstate->evaldesc->attrs[0]->atttypid,
-												 peraggstate->sortOperators[0], false,
-												 PlanStateOperatorMemKB((PlanState *) aggstate), false);
-				}
-				else
-				{
-					bool	   *nullsFirstFlags = palloc0(peraggstate->numSortCols * sizeof(bool));
-
-					peraggstate->sortstate =
-						tuplesort_begin_heap_mk(&aggstate->ss,
-												peraggstate->evaldesc,
-												peraggstate->numSortCols, peraggstate->sortColIdx,
-												peraggstate->sortOperators, nullsFirstFlags,
-												PlanStateOperatorMemKB((PlanState *) aggstate), false);
-					pfree(nullsFirstFlags);
-				}
-
-				/* 
-				 * CDB: If EXPLAIN ANALYZE, let all of our tuplesort operations
-				 * share our Instrumentation object and message buffer.
-				 */
-				if (aggstate->ss.ps.instrument)
-					tuplesort_set_instrument_mk((Tuplesortstate_mk *) peraggstate->sortstate,
-							aggstate->ss.ps.instrument,
-							aggstate->ss.ps.cdbexplainbuf);
-			}
-			else /* gp_enable_mk_sort is off */
-			{
-				if (peraggstate->sortstate)
-					tuplesort_end((Tuplesortstate *) peraggstate->sortstate);
-
-				/*
-				 * We use a plain Datum sorter when there's a single input column;
-				 * otherwise sort the full tuple.  (See comments for
-				 * process_ordered_aggregate_single.)
-				 */
-				if (peraggstate->numInputs == 1)
-				{
-					peraggstate->sortstate =
-						tuplesort_begin_datum(peraggstate->evaldesc->attrs[0]->atttypid,
-											  peraggstate->sortOperators[0], false,
-											  PlanStateOperatorMemKB((PlanState *) aggstate), false);
-				}
-				else
-				{
-					bool	   *nullsFirstFlags = palloc0(peraggstate->numSortCols * sizeof(bool));
-
-					peraggstate->sortstate =
-						tuplesort_begin_heap(peraggstate->evaldesc,
-											 peraggstate->numSortCols, peraggstate->sortColIdx,
-											 peraggstate->sortOperators, nullsFirstFlags,
-											 PlanStateOperatorMemKB((PlanState *) aggstate), false);
-				}
-
-				/* 
-				 * CDB: If EXPLAIN ANALYZE, let all of our tuplesort operations
-				 * share our Instrumentation object and message buffer.
-				 */
-				if (aggstate->ss.ps.instrument)
-					tuplesort_set_instrument((Tuplesortstate *) peraggstate->sortstate,
-							aggstate->ss.ps.instrument,
-							aggstate->ss.ps.cdbexplainbuf);
-			}
-
-			/* CDB: Set enhanced sort options. */
-			{
-				int64 		limit = 0;
-				int64 		offset = 0;
-				int 		unique = peragg->aggref->aggdistinct &&
-									 ( gp_enable_sort_distinct ? 1 : 0) ;
-				int 		sort_flags = gp_sort_flags; /* get the guc */
-				int         maxdistinct = gp_sort_max_distinct; /* get guc */
-
-				if(gp_enable_mk_sort)
-					cdb_tuplesort_init_mk((Tuplesortstate_mk *) peraggstate->sortstate, 
-							offset, limit, unique, 
-							sort_flags, maxdistinct);
-				else
-					cdb_tuplesort_init((Tuplesortstate *) peraggstate->sortstate, 
-							offset, limit, unique, 
-							sort_flags, maxdistinct);
-			}
-		}
+		if (peraggstate->useDistinctHash)
+			reset_distinct_hash_table(aggstate, peraggstate);
+		else if (peraggstate->numSortCols > 0)
+			begin_ordered_aggregate_sort(aggstate, peraggstate,
+										 PlanStateOperatorMemKB((PlanState *) aggstate));
 
 		/*
 		 * (Re)set transValue to the initial value.
@@ -562,6 +644,13 @@ advance_aggregates(AggState *aggstate, AggStatePerGroup pergroup,
 				if (i < nargs)
 					continue; /* aggno loop */
 			}
+
+			if (peraggstate->useDistinctHash)
+			{
+				advance_distinct_hash(aggstate, peraggstate, pergroupstate,
+									  slot, mem_manager);
+				continue; /* aggno loop */
+			}
 			
 			/* OK, put the tuple into the tuplesort object */
 			if (peraggstate->numInputs == 1)
@@ -627,6 +716,123 @@ advance_aggregates(AggState *aggstate, AggStatePerGroup pergroup,
 	} /* aggno loop */
 }
 
+/*
+ * Advance all the aggregates for the rest of the input of a plain Agg, and
+ * return true, or return false if the caller has to fetch and aggregate the
+ * input tuples one by one.
+ *
+ * Called through call_AggScanPipeline, which may call a generated version
+ * that fuses the outer table scan, its quals and projection, and
+ * advance_aggregates into one loop. The regular version never consumes the
+ * input.
+ */
+bool
+agg_scan_pipeline(AggState *aggstate, AggStatePerGroup pergroup,
+				  MemoryManagerContainer *mem_manager)
+{
+	return false;
+}
+
+/*
+ * Advance a hashed DISTINCT aggregate for one input value, which has been
+ * projected into slot.
+ *
+ * A value not yet in the group's distinct set is added to it and passed to
+ * the transition function right away.  Once the set has used up its memory
+ * share it is frozen: values it already holds are still skipped, and the
+ * others go into a sort, which is deduplicated (and checked against the set)
+ * by process_ordered_aggregate_single when the group is finalized.
+ */
+static void
+advance_distinct_hash(AggState *aggstate,
+					  AggStatePerAgg peraggstate,
+					  AggStatePerGroup pergroupstate,
+					  TupleTableSlot *slot,
+					  MemoryManagerContainer *mem_manager)
+{
+	TupleHashTable hashtable = peraggstate->distinctTable;
+	DistinctHashEntry entry;
+	FunctionCallInfoData fcinfo;
+	Datum		value;
+	bool		isnull;
+	bool		isnew;
+
+	value = slot_getattr(slot, 1, &isnull);
+
+	/* per SQL, DISTINCT doesn't use nulls */
+	if (isnull)
+		return;
+
+	if (peraggstate->distinctSpilled)
+	{
+		entry = (DistinctHashEntry) LookupTupleHashEntry(hashtable, slot, NULL);
+		if (entry != NULL && entry->groupno == peraggstate->distinctGroupNo)
+			return;
+
+		if (gp_enable_mk_sort)
+			tuplesort_putdatum_mk((Tuplesortstate_mk *) peraggstate->sortstate,
+								  value, false);
+		else
+			tuplesort_putdatum((Tuplesortstate *) peraggstate->sortstate,
+							   value, false);
+		return;
+	}
+
+	/* An entry left by an earlier group is taken over by this one. */
+	entry = (DistinctHashEntry) LookupTupleHashEntry(hashtable, slot, &isnew);
+	if (!isnew && entry->groupno == peraggstate->distinctGroupNo)
+		return;
+	entry->groupno = peraggstate->distinctGroupNo;
+
+	fcinfo.arg[1] = value;
+	fcinfo.argnull[1] = false;
+	advance_transition_function(aggstate, peraggstate, pergroupstate,
+								&fcinfo, mem_manager);
+
+	if (isnew &&
+		distinct_hash_space(peraggstate) > peraggstate->distinctMemLimit)
+	{
+		/* The overflow sort gets the other half of the aggregate's share. */
+		begin_ordered_aggregate_sort(aggstate, peraggstate,
+									 Max((int) (peraggstate->distinctMemLimit / 1024L), 64));
+		peraggstate->distinctSpilled = true;
+	}
+}
+
+/*
+ * Memory used by the distinct set of a hashed DISTINCT aggregate.
+ *
+ * The entries themselves live in the dynahash's own context; charge them by
+ * count, and the copied values by the space of distinctcxt.
+ */
+static Size
+distinct_hash_space(AggStatePerAgg peraggstate)
+{
+	return MemoryContextGetCurrentSpace(peraggstate->distinctcxt) +
+		hash_get_num_entries(peraggstate->distinctTable->hashtab) *
+		MAXALIGN(sizeof(DistinctHashEntryData) + 2 * sizeof(void *));
+}
+
+/*
+ * Is value (of the aggregate's input type) in the distinct set?
+ */
+static bool
+distinct_hash_contains(AggStatePerAgg peraggstate, Datum value)
+{
+	TupleTableSlot *slot = peraggstate->evalslot;
+	DistinctHashEntry entry;
+
+	ExecClearTuple(slot);
+	slot_get_values(slot)[0] = value;
+	slot_get_isnull(slot)[0] = false;
+	ExecStoreVirtualTuple(slot);
+
+	entry = (DistinctHashEntry)
+		LookupTupleHashEntry(peraggstate->distinctTable, slot, NULL);
+
+	return entry != NULL && entry->groupno == peraggstate->distinctGroupNo;
+}
+
 /*
  * Run the transition function for a DISTINCT or ORDER BY aggregate
  * with only one input.  This is called after we have completed
@@ -700,6 +906,13 @@ process_ordered_aggregate_single(AggState *aggstate,
 		{ 
 			/* per SQL, DISTINCT doesn't use nulls */
 		}
+		else if (peraggstate->useDistinctHash &&
+				 distinct_hash_contains(peraggstate, *newVal))
+		{
+			/* already passed to the transfn before the distinct set filled up */
+			if (!peraggstate->inputtypeByVal)
+				pfree(DatumGetPointer(*newVal));
+		}
 		else if (isDistinct &&
 				 haveOldVal &&
 				 ((oldIsNull && *isNull) ||
@@ -1337,6 +1550,18 @@ agg_retrieve_direct(AggState *aggstate)
 						aggstate->has_partial_agg = has_partial_agg;
 						break;
 					}
+
+					/*
+					 * A plain Agg may aggregate the rest of its input at
+					 * once, without going through ExecProcNode per tuple.
+					 */
+					if (node->aggstrategy == AGG_PLAIN &&
+						!is_middle_rollup_agg &&
+						call_AggScanPipeline(aggstate, pergroup, &(aggstate->mem_manager)))
+					{
+						aggstate->agg_done = true;
+						break;
+					}
 					
 					outerslot = ExecProcNode(outerPlan);
 					if (TupIsNull(outerslot))
@@ -1457,7 +1682,13 @@ agg_retrieve_direct(AggState *aggstate)
 			else
 				pergroupstate = &perpassthru[aggno];
 
-			if ( peraggstate->numSortCols > 0 )
+			if ( peraggstate->useDistinctHash )
+			{
+				/* Only the values that overflowed the distinct set are left. */
+				if ( peraggstate->distinctSpilled )
+					process_ordered_aggregate_single(aggstate, peraggstate, pergroupstate);
+			}
+			else if ( peraggstate->numSortCols > 0 )
 			{
 				if ( peraggstate->numInputs == 1 )
 					process_ordered_aggregate_single(aggstate, peraggstate, pergroupstate);
@@ -1629,6 +1860,24 @@ agg_retrieve_hash_table(AggState *aggstate)
 		 * for it, so that it can be used in ExecProject.
 		 */
 		ExecStoreMinimalTuple((MemTuple)entry->tuple_and_aggs, firstSlot, false);
+#ifdef USE_CODEGEN
+		/*
+		 * If a deformer was generated for the entries, deform the grouping
+		 * columns right away, instead of one memtuple_getattr() per column
+		 * reference.
+		 */
+		if (NULL != aggstate->MemTupleDeform_gen_info.code_generator)
+		{
+			int			natts = aggstate->MemTupleDeform_gen_info.natts;
+
+			call_MemTupleDeform(aggstate, (MemTuple)entry->tuple_and_aggs,
+								aggstate->hashslot->tts_mt_bind, natts,
+								slot_get_values(firstSlot),
+								slot_get_isnull(firstSlot));
+			TupSetVirtualTuple(firstSlot);
+			firstSlot->PRIVATE_tts_nvalid = natts;
+		}
+#endif
 		pergroup = (AggStatePerGroup)((char *)entry->tuple_and_aggs + 
 					      MAXALIGN(memtuple_get_size((MemTuple)entry->tuple_and_aggs,
 									 aggstate->hashslot->tts_mt_bind)));
@@ -1705,6 +1954,7 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	ExprContext *econtext;
 	int			numaggs,
 				aggno;
+	int			numDistinctHash = 0;
 	ListCell   *l;
 
 	/* check for unsupported flags */
@@ -2240,11 +2490,58 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 			 */
 			eqfunc = equality_oper_funcid(inputTypes[0]);
 			fmgr_info(eqfunc, &peraggstate->equalfn);
+
+			/*
+			 * Eliminate duplicates with a hash table instead of the sort if
+			 * the type can be hashed and the aggregate does not care about
+			 * the order of its input.  Having a preliminary function is
+			 * what the planner already takes as license to feed an
+			 * aggregate its input in arbitrary partial orders.
+			 */
+			if (gp_enable_agg_distinct_hash &&
+				OidIsValid(peraggstate->prelimfn_oid))
+			{
+				Oid			eqop = equality_oper_opid(inputTypes[0]);
+
+				if (op_hashjoinable(eqop))
+				{
+					peraggstate->useDistinctHash = true;
+					peraggstate->distinctColIdx = 1;
+					execTuplesHashPrepare(1, &eqop,
+										  &peraggstate->distinctEqfns,
+										  &peraggstate->distinctHashfns);
+					peraggstate->distinctcxt =
+						AllocSetContextCreate(CurrentMemoryContext,
+											  "AggDistinctHash",
+											  ALLOCSET_DEFAULT_MINSIZE,
+											  ALLOCSET_DEFAULT_INITSIZE,
+											  ALLOCSET_DEFAULT_MAXSIZE);
+					numDistinctHash++;
+				}
+			}
 		}
 		
 		ReleaseSysCache(aggTuple);
 	}
 
+	/*
+	 * Hashed DISTINCT aggregates share the operator memory.  Each one gets an
+	 * equal share, half for its distinct set and half for the sort its
+	 * overflow goes to.
+	 */
+	if (numDistinctHash > 0)
+	{
+		Size		limit = (Size) (PlanStateOperatorMemKB((PlanState *) aggstate) * 1024L /
+									numDistinctHash / 2);
+		int			i;
+
+		for (i = 0; i <= aggno; i++)
+		{
+			if (peragg[i].useDistinctHash)
+				peragg[i].distinctMemLimit = limit;
+		}
+	}
+
 	/*
 	 * Process percentile expressions.  These are treated separately from
 	 * Aggref expressions at the moment as we cannot change the catalog, but
@@ -2911,8 +3208,10 @@ count_extra_agg_slots_walker(Node *node, int *count)
 void
 ExecEagerFreeAgg(AggState *node)
 {
+	int			aggno;
+
 	/* Close any open tuplesorts */
-	for (int aggno = 0; aggno < node->numaggs; aggno++)
+	for (aggno = 0; aggno < node->numaggs; aggno++)
 	{
 		AggStatePerAgg peraggstate = &node->peragg[aggno];
 
@@ -2933,6 +3232,18 @@ ExecEagerFreeAgg(AggState *node)
 
 		peraggstate->sortstate = NULL;
 	}
+
+	/* Release the distinct sets; initialize_aggregates rebuilds them */
+	for (aggno = 0; aggno < node->numaggs; aggno++)
+	{
+		AggStatePerAgg peraggstate = &node->peragg[aggno];
+
+		if (peraggstate->useDistinctHash && peraggstate->distinctTable)
+		{
+			MemoryContextResetAndDeleteChildren(peraggstate->distinctcxt);
+			peraggstate->distinctTable = NULL;
+		}
+	}
 	
 	if (IS_HASHAGG(node))
 	{
@@ -52,10 +52,20 @@ ExecHashTableExplainBatches(HashJoinTable   hashtable,
                             int             ibatch_end,
                             const char     *title);
 static void ExecHashTableReallocBatchData(HashJoinTable hashtable, int new_nbatch);
-
-void ExecChooseHashTableSize(double ntuples, int tupwidth,
+static void ExecHashTableCheckSpace(HashState *hashState, HashJoinTable hashtable,
+						HashJoinBatchData *batch);
+static void ExecHashBuildSkewHash(HashJoinTable hashtable, Hash *node,
+					  int mcvsToUse);
+static void ExecHashSkewTableInsert(HashState *hashState, HashJoinTable hashtable,
+						TupleTableSlot *slot,
+						uint32 hashvalue,
+						int bucketNumber);
+static void ExecHashRemoveNextSkewBucket(HashJoinTable hashtable);
+
+void ExecChooseHashTableSize(double ntuples, int tupwidth, bool useskew,
 						int *numbuckets,
 						int *numbatches,
+						int *num_skew_mcvs,
 						uint64 operatorMemKB
 						);
 
@@ -130,10 +140,24 @@ MultiExecHash(HashState *node)
 		econtext->ecxt_innertuple = slot;
 		bool hashkeys_null = false;
 
-		if (ExecHashGetHashValue(node, hashtable, econtext, hashkeys, false,
-								 node->hs_keepnull, &hashvalue, &hashkeys_null))
+		if (call_ExecHashGetHashValue(node, node, hashtable, econtext, hashkeys,
+									  false, node->hs_keepnull, &hashvalue,
+									  &hashkeys_null))
 		{
-			ExecHashTableInsert(node, hashtable, slot, hashvalue);
+			int			bucketNumber;
+
+			bucketNumber = ExecHashGetSkewBucket(hashtable, hashvalue);
+			if (bucketNumber != INVALID_SKEW_BUCKET_NO)
+			{
+				/* It's a skew tuple, so put it into that hash table */
+				ExecHashSkewTableInsert(node, hashtable, slot, hashvalue,
+										bucketNumber);
+			}
+			else
+			{
+				/* Not subject to skew optimization, so insert normally */
+				ExecHashTableInsert(node, hashtable, slot, hashvalue);
+			}
 		}
 
 		if (hashkeys_null)
@@ -274,6 +298,7 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 	Plan	   *outerNode;
 	int			nbuckets;
 	int			nbatch;
+	int			num_skew_mcvs;
 	int			log2_nbuckets;
 	int			nkeys;
 	int			i;
@@ -293,7 +318,8 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 	outerNode = outerPlan(node);
 
 	ExecChooseHashTableSize(outerNode->plan_rows, outerNode->plan_width,
-			&nbuckets, &nbatch, operatorMemKB);
+			node->skewMCVs != NIL,
+			&nbuckets, &nbatch, &num_skew_mcvs, operatorMemKB);
 
 #ifdef HJDEBUG
     elog(LOG, "HJ: nbatch = %d, nbuckets = %d\n", nbatch, nbuckets);
@@ -314,6 +340,11 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 	hashtable->log2_nbuckets = log2_nbuckets;
 	hashtable->buckets = NULL;
 	hashtable->bloom = NULL;
+	hashtable->skewEnabled = false;
+	hashtable->skewBucket = NULL;
+	hashtable->skewBucketLen = 0;
+	hashtable->nSkewBuckets = 0;
+	hashtable->skewBucketNums = NULL;
 	hashtable->nbatch = nbatch;
 	hashtable->curbatch = 0;
 	hashtable->nbatch_original = nbatch;
@@ -324,6 +355,9 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 	hashtable->work_set = NULL;
 	hashtable->state_file = NULL;
 	hashtable->spaceAllowed = operatorMemKB * 1024L;
+	hashtable->spaceUsedSkew = 0;
+	hashtable->spaceAllowedSkew =
+		hashtable->spaceAllowed * SKEW_WORK_MEM_PERCENT / 100;
 	hashtable->stats = NULL;
 	hashtable->eagerlyReleased = false;
 	hashtable->hjstate = hjstate;
@@ -428,6 +462,13 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 		hashtable->bloom = (uint64*) palloc0(nbuckets * sizeof(uint64));
 
 	MemoryContextSwitchTo(oldcxt);
+
+	/*
+	 * Set up for skew optimization, if possible and there's a need for more
+	 * than one batch.  (In a one-batch join, there's no point in it.)
+	 */
+	if (nbatch > 1)
+		ExecHashBuildSkewHash(hashtable, node, num_skew_mcvs);
 	}
 	END_MEMORY_ACCOUNT();
 	return hashtable;
@@ -448,14 +489,16 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
  */
 
 void
-ExecChooseHashTableSize(double ntuples, int tupwidth,
+ExecChooseHashTableSize(double ntuples, int tupwidth, bool useskew,
 						int *numbuckets,
 						int *numbatches,
+						int *num_skew_mcvs,
 						uint64 operatorMemKB)
 {
 	int			tupsize;
 	double		inner_rel_bytes;
 	long		hash_table_bytes;
+	long		skew_table_bytes;
 	long		max_pointers;
 	int			nbatch;
 	int			nbuckets;
@@ -484,6 +527,42 @@ ExecChooseHashTableSize(double ntuples, int tupwidth,
 	 */
 	hash_table_bytes = operatorMemKB * 1024L;
 
+	/*
+	 * If skew optimization is possible, estimate the number of skew buckets
+	 * that will fit in the memory allowed, and decrement the assumed space
+	 * available for the main hash table accordingly.
+	 *
+	 * We make the optimistic assumption that each skew bucket will contain
+	 * one inner-relation tuple.  If that turns out to be low, we will recover
+	 * at runtime by reducing the number of skew buckets.
+	 *
+	 * hashtable->skewBucket will have up to 8 times as many HashSkewBucket
+	 * pointers as the number of MCVs we allow, since ExecHashBuildSkewHash
+	 * will round up to the next power of 2 and then multiply by 4 to reduce
+	 * collisions.
+	 */
+	if (useskew)
+	{
+		skew_table_bytes = hash_table_bytes * SKEW_WORK_MEM_PERCENT / 100;
+
+		/*----------
+		 * Divisor is:
+		 * size of a hash tuple +
+		 * worst-case size of skewBucket[] per MCV +
+		 * size of skewBucketNums[] entry +
+		 * size of skew bucket struct itself
+		 *----------
+		 */
+		*num_skew_mcvs = skew_table_bytes / (tupsize +
+											 (8 * sizeof(HashSkewBucket *)) +
+											 sizeof(int) +
+											 SKEW_BUCKET_OVERHEAD);
+		if (*num_skew_mcvs > 0)
+			hash_table_bytes -= skew_table_bytes;
+	}
+	else
+		*num_skew_mcvs = 0;
+
 	/*
 	 * Set nbuckets to achieve an average bucket load of gp_hashjoin_tuples_per_bucket when
 	 * memory is filled.  Set nbatch to the smallest power of 2 that appears
@@ -713,6 +792,8 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 	long		ninmemory;
 	long		nfreed;
 	Size        spaceFreed = 0;
+	Size		hotspace = 0;
+	uint32		hotvalue = 0;
 	HashJoinTableStats *stats = hashtable->stats;
 
 	/* do nothing if we've decided to shut off growth */
@@ -761,6 +842,8 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 		HashJoinTuple prevtuple;
 		HashJoinTuple tuple;
 		uint64 bloom = 0;
+		uint32		candidate = 0;
+		long		votes = 0;
 
 		prevtuple = NULL;
 		tuple = hashtable->buckets[i];
@@ -781,6 +864,11 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 				/* keep tuple */
 				prevtuple = tuple;
 				bloom |= BLOOMVAL(tuple->hashvalue);
+
+				/* majority vote for the most common hash value in the chain */
+				if (votes == 0)
+					candidate = tuple->hashvalue;
+				votes += (tuple->hashvalue == candidate) ? 1 : -1;
 			}
 			else
 			{
@@ -806,6 +894,8 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 				spaceFreed += spaceTuple;
 				if (stats)
 					stats->batchstats[batchno].spillspace_in += spaceTuple;
+				if (fullbatch->unsplittable && tuple->hashvalue == fullbatch->hotvalue)
+					fullbatch->hotspace -= spaceTuple;
 
 				pfree(tuple);
 				nfreed++;
@@ -816,6 +906,29 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 
 		if(gp_hashjoin_bloomfilter!=0)
 			hashtable->bloom[i] = bloom;
+
+		/*
+		 * Tuples sharing a hash value always share a bucket.  Measure the
+		 * space taken by the winner of the vote, so that we can tell whether
+		 * some single hash value is too big to ever fit in memory.
+		 */
+		if (votes > 0)
+		{
+			Size		candspace = 0;
+
+			for (tuple = hashtable->buckets[i]; tuple != NULL; tuple = tuple->next)
+			{
+				if (tuple->hashvalue == candidate)
+					candspace += HJTUPLE_OVERHEAD +
+						memtuple_get_size(HJTUPLE_MINTUPLE(tuple), NULL);
+			}
+
+			if (candspace > hotspace)
+			{
+				hotspace = candspace;
+				hotvalue = candidate;
+			}
+		}
 	}
 
 #ifdef HJDEBUG
@@ -854,6 +967,29 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 		elog(LOG, "HJ: Disabling further increase of nbatch");
 	}
 
+	/*
+	 * If the tuples of a single hash value exceed spaceAllowed by themselves,
+	 * this batch cannot be split any further: every doubling would spill only
+	 * the few other tuples that arrived since the last one.  Stop counting
+	 * the hot value's tuples against the batch, so that we only double again
+	 * when the splittable remainder overflows.
+	 */
+	if (hotspace > hashtable->spaceAllowed)
+	{
+		if (!fullbatch->unsplittable || fullbatch->hotvalue != hotvalue)
+		{
+			if (stats && !fullbatch->unsplittable)
+				stats->nunsplittable++;
+			elog(LOG, "HJ batch %d: hash value %u takes " UINT64_FORMAT
+				 " bytes, more than work_mem; batch cannot be split further",
+				 curbatch, hotvalue, (uint64) hotspace);
+		}
+		fullbatch->unsplittable = true;
+		fullbatch->hotvalue = hotvalue;
+		fullbatch->hotspace = hotspace;
+	}
+	else if (fullbatch->unsplittable && fullbatch->hotspace == 0)
+		fullbatch->unsplittable = false;
 }
 
 /*
@@ -937,6 +1073,8 @@ ExecHashTableInsert(HashState *hashState, HashJoinTable hashtable,
 	/* Update batch size. */
 	batch->innertuples++;
 	batch->innerspace += hashTupleSize;
+	if (batch->unsplittable && hashvalue == batch->hotvalue)
+		batch->hotspace += hashTupleSize;
 
 	/*
 	 * decide whether to put the tuple in the hash table or a temp file
@@ -960,23 +1098,7 @@ ExecHashTableInsert(HashState *hashState, HashJoinTable hashtable,
 			hashtable->bloom[bucketno] |= BLOOMVAL(hashvalue);
 
 		/* Double the number of batches when too much data in hash table. */
-		if (batch->innerspace > hashtable->spaceAllowed ||
-			batch->innertuples > UINT_MAX/2)
-		{
-			ExecHashIncreaseNumBatches(hashtable);
-
-			if (ps && ps->instrument)
-			{
-				ps->instrument->workfileCreated = true;
-			}
-
-			/* Gpmon stuff */
-			if(ps)
-			{
-				Gpmon_M_Set(&ps->gpmon_pkt, GPMON_HASH_SPILLBATCH, hashtable->nbatch);
-				CheckSendPlanStateGpmonPkt(ps);
-			}
-		}
+		ExecHashTableCheckSpace(hashState, hashtable, batch);
 	}
 	else
 	{
@@ -988,6 +1110,33 @@ ExecHashTableInsert(HashState *hashState, HashJoinTable hashtable,
 	END_MEMORY_ACCOUNT();
 }
 
+/*
+ * ExecHashTableCheckSpace
+ *		double the number of batches if the current batch uses more than
+ *		spaceAllowed, not counting an unsplittable hash value
+ */
+static void
+ExecHashTableCheckSpace(HashState *hashState, HashJoinTable hashtable,
+						HashJoinBatchData *batch)
+{
+	PlanState  *ps = &hashState->ps;
+
+	if (batch->innerspace - batch->hotspace > hashtable->spaceAllowed ||
+		batch->innertuples > UINT_MAX/2)
+	{
+		ExecHashIncreaseNumBatches(hashtable);
+
+		if (ps->instrument)
+		{
+			ps->instrument->workfileCreated = true;
+		}
+
+		/* Gpmon stuff */
+		Gpmon_M_Set(&ps->gpmon_pkt, GPMON_HASH_SPILLBATCH, hashtable->nbatch);
+		CheckSendPlanStateGpmonPkt(ps);
+	}
+}
+
 /*
  * ExecHashGetHashValue
  *		Compute the hash value for a tuple
@@ -1161,14 +1310,16 @@ ExecScanHashBucket(HashState *hashState, HashJoinState *hjstate,
 	 * hj_CurTuple is NULL to start scanning a new bucket, or the address of
 	 * the last tuple returned from the current bucket.
 	 */
-	if (hashTuple == NULL)
+	if (hashTuple != NULL)
+		hashTuple = hashTuple->next;
+	else if (hjstate->hj_CurSkewBucketNo != INVALID_SKEW_BUCKET_NO)
+		hashTuple = hashtable->skewBucket[hjstate->hj_CurSkewBucketNo]->tuples;
+	else
 	{
 		/* if bloom filter fails, then no match - don't even bother to scan */
 		if (gp_hashjoin_bloomfilter == 0 || 0 != (hashtable->bloom[hjstate->hj_CurBucketNo] & BLOOMVAL(hashvalue)))
 			hashTuple = hashtable->buckets[hjstate->hj_CurBucketNo];
 	}
-	else
-		hashTuple = hashTuple->next;
 
 	while (hashTuple != NULL)
 	{
@@ -1191,6 +1342,8 @@ ExecScanHashBucket(HashState *hashState, HashJoinState *hjstate,
 				return hashTuple;
 			}
 		}
+		else if (hjstate->js.ps.profile)
+			hjstate->js.ps.profile->hashCollisions++;
 
 		hashTuple = hashTuple->next;
 	}
@@ -1236,6 +1389,7 @@ ExecHashTableReset(HashState *hashState, HashJoinTable hashtable)
 
 	hashtable->batches[hashtable->curbatch]->innerspace = 0;
 	hashtable->batches[hashtable->curbatch]->innertuples = 0;
+	hashtable->batches[hashtable->curbatch]->hotspace = 0;
 	hashtable->totalTuples = 0;
 
 	MemoryContextSwitchTo(oldcxt);
@@ -1254,6 +1408,348 @@ ExecReScanHash(HashState *node, ExprContext *exprCtxt)
 		ExecReScan(((PlanState *) node)->lefttree, exprCtxt);
 }
 
+/*
+ * ExecHashBuildSkewHash
+ *
+ *		Set up for skew optimization if we can identify the most common values
+ *		(MCVs) of the outer relation's join key.  We make a skew hash bucket
+ *		for the hash value of each MCV, up to the number of slots allowed
+ *		based on available memory.
+ *
+ *		The MCVs are looked up by the planner and shipped in the Hash node,
+ *		because statistics are only kept on the QD.
+ */
+static void
+ExecHashBuildSkewHash(HashJoinTable hashtable, Hash *node, int mcvsToUse)
+{
+	HashJoinBatchData *batch = hashtable->batches[0];
+	FmgrInfo   *hashfunctions;
+	ListCell   *lc;
+	Size		arraySpace;
+	int			nbuckets;
+	int			i;
+
+	/* Do nothing if planner didn't identify the outer relation's MCVs */
+	if (node->skewMCVs == NIL)
+		return;
+	/* Also, do nothing if we don't have room for at least one skew bucket */
+	if (mcvsToUse <= 0)
+		return;
+
+	if (mcvsToUse > list_length(node->skewMCVs))
+		mcvsToUse = list_length(node->skewMCVs);
+
+	/*
+	 * The MCVs we can afford must cover at least SKEW_MIN_OUTER_FRACTION of
+	 * the outer relation, or it isn't worth the trouble.
+	 */
+	if (mcvsToUse < node->skewMinMCVs)
+		return;
+
+	/*
+	 * Okay, set up the skew hashtable.
+	 *
+	 * skewBucket[] is an open addressing hashtable with a power of 2 size
+	 * that is greater than the number of MCV values.  (This ensures there
+	 * will be at least one null entry, so searches will always terminate.)
+	 */
+	nbuckets = 2;
+	while (nbuckets <= mcvsToUse)
+		nbuckets <<= 1;
+	/* use two more bits just to help avoid collisions */
+	nbuckets <<= 2;
+
+	hashtable->skewEnabled = true;
+	hashtable->skewBucketLen = nbuckets;
+
+	/*
+	 * We allocate the bucket memory in the hashtable's batch context. It is
+	 * only needed during the first batch, and this ensures it will be
+	 * automatically removed once the first batch is done.
+	 */
+	hashtable->skewBucket = (HashSkewBucket **)
+		MemoryContextAllocZero(hashtable->batchCxt,
+							   nbuckets * sizeof(HashSkewBucket *));
+	hashtable->skewBucketNums = (int *)
+		MemoryContextAllocZero(hashtable->batchCxt,
+							   mcvsToUse * sizeof(int));
+
+	arraySpace = nbuckets * sizeof(HashSkewBucket *) + mcvsToUse * sizeof(int);
+	batch->innerspace += arraySpace;
+	hashtable->spaceUsedSkew += arraySpace;
+
+	/*
+	 * Create a skew bucket for each MCV hash value.
+	 *
+	 * Note: it is very important that we create the buckets in order of
+	 * decreasing MCV frequency.  If we have to remove some buckets, they must
+	 * be removed in reverse order of creation (see notes in
+	 * ExecHashRemoveNextSkewBucket) and we want the least common MCVs to be
+	 * removed first.
+	 */
+	hashfunctions = hashtable->outer_hashfunctions;
+
+	i = 0;
+	foreach(lc, node->skewMCVs)
+	{
+		Const	   *mcv = (Const *) lfirst(lc);
+		uint32		hashvalue;
+		int			bucket;
+
+		if (i++ >= mcvsToUse)
+			break;
+
+		Assert(IsA(mcv, Const) && !mcv->constisnull);
+		hashvalue = DatumGetUInt32(FunctionCall1(&hashfunctions[0],
+												 mcv->constvalue));
+
+		/*
+		 * While we have not hit a hole in the hashtable and have not hit the
+		 * desired bucket, we have collided with some previous hash value, so
+		 * try the next bucket location.  NB: this code must match
+		 * ExecHashGetSkewBucket.
+		 */
+		bucket = hashvalue & (nbuckets - 1);
+		while (hashtable->skewBucket[bucket] != NULL &&
+			   hashtable->skewBucket[bucket]->hashvalue != hashvalue)
+			bucket = (bucket + 1) & (nbuckets - 1);
+
+		/*
+		 * If we found an existing bucket with the same hashvalue, leave it
+		 * alone.  It's okay for two MCVs to share a hashvalue.
+		 */
+		if (hashtable->skewBucket[bucket] != NULL)
+			continue;
+
+		/* Okay, create a new skew bucket for this hashvalue. */
+		hashtable->skewBucket[bucket] = (HashSkewBucket *)
+			MemoryContextAlloc(hashtable->batchCxt,
+							   sizeof(HashSkewBucket));
+		hashtable->skewBucket[bucket]->hashvalue = hashvalue;
+		hashtable->skewBucket[bucket]->tuples = NULL;
+		hashtable->skewBucketNums[hashtable->nSkewBuckets] = bucket;
+		hashtable->nSkewBuckets++;
+		batch->innerspace += SKEW_BUCKET_OVERHEAD;
+		hashtable->spaceUsedSkew += SKEW_BUCKET_OVERHEAD;
+	}
+}
+
+/*
+ * ExecHashGetSkewBucket
+ *
+ *		Returns the index of the skew bucket for this hashvalue,
+ *		or INVALID_SKEW_BUCKET_NO if the hashvalue is not
+ *		associated with any active skew bucket.
+ */
+int
+ExecHashGetSkewBucket(HashJoinTable hashtable, uint32 hashvalue)
+{
+	int			bucket;
+
+	/*
+	 * Always return INVALID_SKEW_BUCKET_NO if not doing skew optimization (in
+	 * particular, this happens after the initial batch is done).
+	 */
+	if (!hashtable->skewEnabled)
+		return INVALID_SKEW_BUCKET_NO;
+
+	/*
+	 * Since skewBucketLen is a power of 2, we can do a modulo by ANDing.
+	 */
+	bucket = hashvalue & (hashtable->skewBucketLen - 1);
+
+	/*
+	 * While we have not hit a hole in the hashtable and have not hit the
+	 * desired bucket, we have collided with some other hash value, so try the
+	 * next bucket location.
+	 */
+	while (hashtable->skewBucket[bucket] != NULL &&
+		   hashtable->skewBucket[bucket]->hashvalue != hashvalue)
+		bucket = (bucket + 1) & (hashtable->skewBucketLen - 1);
+
+	/*
+	 * Found the desired bucket?
+	 */
+	if (hashtable->skewBucket[bucket] != NULL)
+		return bucket;
+
+	/*
+	 * There must not be any hashtable entry for this hash value.
+	 */
+	return INVALID_SKEW_BUCKET_NO;
+}
+
+/*
+ * ExecHashSkewTableInsert
+ *
+ *		Insert a tuple into the skew hashtable.
+ *
+ * This should generally match up with the current-batch case in
+ * ExecHashTableInsert.
+ */
+static void
+ExecHashSkewTableInsert(HashState *hashState, HashJoinTable hashtable,
+						TupleTableSlot *slot,
+						uint32 hashvalue,
+						int bucketNumber)
+{
+	MemTuple	tuple = ExecFetchSlotMemTuple(slot, false);
+	HashJoinBatchData *batch = hashtable->batches[hashtable->curbatch];
+	HashJoinTuple hashTuple;
+	int			hashTupleSize;
+
+	START_MEMORY_ACCOUNT(hashState->ps.plan->memoryAccountId);
+	{
+	Assert(hashtable->curbatch == 0);
+
+	/* Create the HashJoinTuple */
+	hashTupleSize = HJTUPLE_OVERHEAD + memtuple_get_size(tuple, NULL);
+	hashTuple = (HashJoinTuple) MemoryContextAlloc(hashtable->batchCxt,
+												   hashTupleSize);
+	hashTuple->hashvalue = hashvalue;
+	memcpy(HJTUPLE_MINTUPLE(hashTuple), tuple, memtuple_get_size(tuple, NULL));
+
+	/* Push it onto the front of the skew bucket's list */
+	hashTuple->next = hashtable->skewBucket[bucketNumber]->tuples;
+	hashtable->skewBucket[bucketNumber]->tuples = hashTuple;
+	hashtable->totalTuples += 1;
+
+	if (hashtable->stats)
+		hashtable->stats->skewinner++;
+
+	/* Account for space used, and back off if we've used too much */
+	batch->innertuples++;
+	batch->innerspace += hashTupleSize;
+	hashtable->spaceUsedSkew += hashTupleSize;
+	while (hashtable->spaceUsedSkew > hashtable->spaceAllowedSkew)
+		ExecHashRemoveNextSkewBucket(hashtable);
+
+	/* Check we are not over the total spaceAllowed, either */
+	ExecHashTableCheckSpace(hashState, hashtable, batch);
+	}
+	END_MEMORY_ACCOUNT();
+}
+
+/*
+ *		ExecHashRemoveNextSkewBucket
+ *
+ *		Remove the least valuable skew bucket by pushing its tuples into
+ *		the main hash table.
+ */
+static void
+ExecHashRemoveNextSkewBucket(HashJoinTable hashtable)
+{
+	HashJoinBatchData *curbatch = hashtable->batches[hashtable->curbatch];
+	HashJoinTableStats *stats = hashtable->stats;
+	int			bucketToRemove;
+	HashSkewBucket *bucket;
+	uint32		hashvalue;
+	int			bucketno;
+	int			batchno;
+	HashJoinTuple hashTuple;
+
+	/* Locate the bucket to remove */
+	bucketToRemove = hashtable->skewBucketNums[hashtable->nSkewBuckets - 1];
+	bucket = hashtable->skewBucket[bucketToRemove];
+
+	/*
+	 * Calculate which bucket and batch the tuples belong to in the main
+	 * hashtable.  They all have the same hash value, so it's the same for all
+	 * of them.  Also note that it's not possible for nbatch to increase while
+	 * we are processing the tuples.
+	 */
+	hashvalue = bucket->hashvalue;
+	ExecHashGetBucketAndBatch(hashtable, hashvalue, &bucketno, &batchno);
+
+	/* Process all tuples in the bucket */
+	hashTuple = bucket->tuples;
+	while (hashTuple != NULL)
+	{
+		HashJoinTuple nextHashTuple = hashTuple->next;
+		MemTuple	tuple;
+		Size		tupleSize;
+
+		/*
+		 * This code must agree with ExecHashTableInsert.  We do not use
+		 * ExecHashTableInsert directly as ExecHashTableInsert expects a
+		 * TupleTableSlot while we already have HashJoinTuples.
+		 */
+		tuple = HJTUPLE_MINTUPLE(hashTuple);
+		tupleSize = HJTUPLE_OVERHEAD + memtuple_get_size(tuple, NULL);
+
+		if (stats)
+			stats->skewinner--;
+
+		/* Decide whether to put the tuple in the hash table or a temp file */
+		if (batchno == hashtable->curbatch)
+		{
+			/* Move the tuple to the main hash table */
+			hashTuple->next = hashtable->buckets[bucketno];
+			hashtable->buckets[bucketno] = hashTuple;
+			if (gp_hashjoin_bloomfilter != 0)
+				hashtable->bloom[bucketno] |= BLOOMVAL(hashvalue);
+			/* We have reduced skew space, but overall space doesn't change */
+			hashtable->spaceUsedSkew -= tupleSize;
+		}
+		else
+		{
+			HashJoinBatchData *batch = hashtable->batches[batchno];
+
+			/* Put the tuple into a temp file for later batches */
+			Assert(batchno > hashtable->curbatch);
+			ExecHashJoinSaveTuple(NULL, tuple, hashvalue, hashtable,
+								  &batch->innerside, hashtable->bfCxt);
+
+			/* Charge the tuple to the batch it now belongs to */
+			curbatch->innertuples--;
+			curbatch->innerspace -= tupleSize;
+			batch->innertuples++;
+			batch->innerspace += tupleSize;
+			if (stats)
+				stats->batchstats[batchno].spillspace_in += tupleSize;
+
+			pfree(hashTuple);
+			hashtable->totalTuples--;
+			hashtable->spaceUsedSkew -= tupleSize;
+		}
+
+		hashTuple = nextHashTuple;
+	}
+
+	/*
+	 * Free the bucket struct itself and reset the hashtable entry to NULL.
+	 *
+	 * NOTE: this is not nearly as simple as it looks on the surface, because
+	 * of the possibility of collisions in the hashtable.  Suppose that hash
+	 * values A and B collide at a particular hashtable entry, and that A was
+	 * entered first so B gets shifted to a different table entry.  If we were
+	 * to remove A first then ExecHashGetSkewBucket would mistakenly start
+	 * reporting that B is not in the hashtable, because it would hit the NULL
+	 * before finding B.  However, we always remove entries in the reverse
+	 * order of creation, so this failure cannot happen.
+	 */
+	hashtable->skewBucket[bucketToRemove] = NULL;
+	hashtable->nSkewBuckets--;
+	pfree(bucket);
+	curbatch->innerspace -= SKEW_BUCKET_OVERHEAD;
+	hashtable->spaceUsedSkew -= SKEW_BUCKET_OVERHEAD;
+
+	/*
+	 * If we have removed all skew buckets then give up on skew optimization.
+	 * Release the arrays since they aren't useful any more.
+	 */
+	if (hashtable->nSkewBuckets == 0)
+	{
+		hashtable->skewEnabled = false;
+		pfree(hashtable->skewBucket);
+		pfree(hashtable->skewBucketNums);
+		hashtable->skewBucket = NULL;
+		hashtable->skewBucketNums = NULL;
+		curbatch->innerspace -= hashtable->spaceUsedSkew;
+		hashtable->spaceUsedSkew = 0;
+	}
+}
+
 
 /*
  * ExecHashTableExplainInit
@@ -1283,6 +1779,9 @@ ExecHashTableExplainInit(HashState *hashState, HashJoinState *hjstate,
         (HashJoinBatchStats *)palloc0(nbatch * sizeof(hashtable->stats->batchstats[0]));
     hashtable->stats->nbatchstats = nbatch;
 
+    /* Skew buckets were set up by ExecHashTableCreate, if any. */
+    hashtable->stats->nskewbuckets = hashtable->nSkewBuckets;
+
     /* Restore caller's memory context. */
     MemoryContextSwitchTo(oldcxt);
     }
@@ -1415,6 +1914,21 @@ ExecHashTableExplainEnd(PlanState *planstate, struct StringInfoData *buf)
                              hashtable->nbatch - stats->nonemptybatches);
         appendStringInfoChar(buf, '\n');
     }
+
+    /* Report skew optimization statistics. */
+    if (stats->nskewbuckets > 0)
+        appendStringInfo(buf,
+                         "Skew optimization used %d MCV buckets"
+                         " holding " UINT64_FORMAT " inner rows,"
+                         " probed by " UINT64_FORMAT " outer rows.\n",
+                         stats->nskewbuckets,
+                         stats->skewinner,
+                         stats->skewouter);
+    if (stats->nunsplittable > 0)
+        appendStringInfo(buf,
+                         "%d batches could not be split further"
+                         " due to a single hash value exceeding work_mem.\n",
+                         stats->nunsplittable);
 }                               /* ExecHashTableExplainEnd */
 
 
@@ -36,6 +36,9 @@ static TupleTableSlot *ExecHashJoinGetSavedTuple(HashJoinBatchSide *side,
 						  uint32 *hashvalue,
 						  TupleTableSlot *tupleSlot);
 static int	ExecHashJoinNewBatch(HashJoinState *hjstate);
+static bool ExecHashJoinFillProbeBatch(PlanState *outerNode,
+						   HashJoinState *hjstate);
+static void ExecHashJoinResetProbeBatch(HashJoinState *hjstate);
 static bool isNotDistinctJoin(List *qualList);
 
 static void ReleaseHashTable(HashJoinState *node);
@@ -65,6 +68,7 @@ ExecHashJoin(HashJoinState *node)
 	TupleTableSlot *outerTupleSlot;
 	uint32		hashvalue;
 	int			batchno;
+	uint64		operatorMemKB;
 
 	/*
 	 * get information from HashJoin node
@@ -167,12 +171,21 @@ ExecHashJoin(HashJoinState *node)
 		}
 
 		/*
-		 * create the hash table
+		 * create the hash table; the outer tuples read ahead for batched
+		 * probing get their share of the memory first
 		 */
+		operatorMemKB = PlanStateOperatorMemKB((PlanState *) hashNode);
+		if (node->hj_ProbeBatch != NULL)
+		{
+			uint64		probeBatchMemKB = operatorMemKB * PROBE_BATCH_MEM_PERCENT / 100;
+
+			node->hj_ProbeBatch->spaceAllowed = probeBatchMemKB * 1024L;
+			operatorMemKB -= probeBatchMemKB;
+		}
 		hashtable = ExecHashTableCreate(hashNode,
 										node,
 										node->hj_HashOperators,
-										PlanStateOperatorMemKB((PlanState *) hashNode));
+										operatorMemKB);
 		node->hj_HashTable = hashtable;
 
         /*
@@ -301,13 +314,21 @@ ExecHashJoin(HashJoinState *node)
 			node->hj_CurHashValue = hashvalue;
 			ExecHashGetBucketAndBatch(hashtable, hashvalue,
 									  &node->hj_CurBucketNo, &batchno);
+			node->hj_CurSkewBucketNo = ExecHashGetSkewBucket(hashtable,
+															 hashvalue);
 			node->hj_CurTuple = NULL;
 
+			if (node->hj_CurSkewBucketNo != INVALID_SKEW_BUCKET_NO &&
+				hashtable->stats)
+				hashtable->stats->skewouter++;
+
 			/*
 			 * Now we've got an outer tuple and the corresponding hash bucket,
-			 * but this tuple may not belong to the current batch.
+			 * but it might not belong to the current batch, or it might match
+			 * a skew bucket.
 			 */
-			if (batchno != hashtable->curbatch)
+			if (batchno != hashtable->curbatch &&
+				node->hj_CurSkewBucketNo == INVALID_SKEW_BUCKET_NO)
 			{
 				/*
 				 * Need to postpone this outer tuple to a later batch. Save it
@@ -579,6 +600,7 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 
 	hjstate->hj_CurHashValue = 0;
 	hjstate->hj_CurBucketNo = 0;
+	hjstate->hj_CurSkewBucketNo = INVALID_SKEW_BUCKET_NO;
 	hjstate->hj_CurTuple = NULL;
 
 	/*
@@ -613,6 +635,25 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 	hjstate->hj_MatchedOuter = false;
 	hjstate->hj_OuterNotEmpty = false;
 
+	/*
+	 * Set up the read-ahead buffer for batched probing, if requested.
+	 */
+	hjstate->hj_ProbeBatch = NULL;
+	if (gp_hashjoin_probe_batch_size > 0)
+	{
+		HashJoinProbeBatch *pb = (HashJoinProbeBatch *) palloc0(sizeof(HashJoinProbeBatch));
+
+		pb->size = gp_hashjoin_probe_batch_size;
+		pb->tuples = (MemTuple *) palloc0(pb->size * sizeof(MemTuple));
+		pb->hashvalues = (uint32 *) palloc0(pb->size * sizeof(uint32));
+		pb->cxt = AllocSetContextCreate(CurrentMemoryContext,
+										"HashJoinProbeBatch",
+										ALLOCSET_DEFAULT_MINSIZE,
+										ALLOCSET_DEFAULT_INITSIZE,
+										ALLOCSET_DEFAULT_MAXSIZE);
+		hjstate->hj_ProbeBatch = pb;
+	}
+
 	initGpmonPktForHashJoin((Plan *)node, &hjstate->js.ps.gpmon_pkt, estate);
 	
 	return hjstate;
@@ -661,6 +702,12 @@ ExecEndHashJoin(HashJoinState *node)
 	ExecClearTuple(node->hj_OuterTupleSlot);
 	ExecClearTuple(node->hj_HashTupleSlot);
 
+	if (node->hj_ProbeBatch)
+	{
+		MemoryContextDelete(node->hj_ProbeBatch->cxt);
+		node->hj_ProbeBatch = NULL;
+	}
+
 	/*
 	 * clean up subtrees
 	 */
@@ -693,7 +740,36 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 	HashState *hashState = (HashState *) innerPlanState(hjstate);
 
 	/* Read tuples from outer relation only if it's the first batch */
-	if (curbatch == 0)
+	if (curbatch == 0 && hjstate->hj_ProbeBatch != NULL)
+	{
+		HashJoinProbeBatch *pb = hjstate->hj_ProbeBatch;
+
+		/* Hand out the next read-ahead tuple, refilling the vector as needed */
+		if (pb->next < pb->ntuples ||
+			ExecHashJoinFillProbeBatch(outerNode, hjstate))
+		{
+			*hashvalue = pb->hashvalues[pb->next];
+			slot = ExecStoreMinimalTuple(pb->tuples[pb->next],
+										 hjstate->hj_OuterTupleSlot,
+										 false);	/* owned by pb->cxt */
+			pb->next++;
+
+			/* remember outer relation is not empty for possible rescan */
+			hjstate->hj_OuterNotEmpty = true;
+
+			return slot;
+		}
+
+		/*
+		 * We have just reached the end of the first pass. Try to switch to a
+		 * saved batch.
+		 */
+		curbatch = ExecHashJoinNewBatch(hjstate);
+
+		Gpmon_M_Incr_Rows_Out(GpmonPktFromHashJoinState(hjstate)); 
+		CheckSendPlanStateGpmonPkt(&hjstate->js.ps);
+	}
+	else if (curbatch == 0)
 	{
 		for (;;)
 		{
@@ -723,12 +799,12 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 					(hjstate->js.jointype == JOIN_LASJ) ||
 					(hjstate->js.jointype == JOIN_LASJ_NOTIN) ||
 					hjstate->hj_nonequijoin;
-			if (ExecHashGetHashValue(hashState, hashtable, econtext,
-									 hjstate->hj_OuterHashKeys,
-									 true,		/* outer tuple */
-									 keep_nulls,
-									 hashvalue,
-									 &hashkeys_null))
+			if (call_ExecHashGetHashValue(hjstate, hashState, hashtable, econtext,
+										  hjstate->hj_OuterHashKeys,
+										  true,		/* outer tuple */
+										  keep_nulls,
+										  hashvalue,
+										  &hashkeys_null))
 			{
 				/* remember outer relation is not empty for possible rescan */
 				hjstate->hj_OuterNotEmpty = true;
@@ -795,6 +871,122 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 	return NULL;
 }
 
+/*
+ * ExecHashJoinFillProbeBatch
+ *		read the next vector of outer tuples for batched probing
+ *
+ * Reads up to gp_hashjoin_probe_batch_size tuples from the outer plan during
+ * the first pass, keeping a copy of each one that can possibly match together
+ * with its hash value, until the copies fill the batch's share of the join's
+ * memory.  Once the whole vector is hashed, the bucket heads the
+ * tuples will probe are prefetched in two rounds: first the bucket array
+ * slots, then the first tuple of each chain.  Returns false when the outer
+ * relation is exhausted.
+ */
+static bool
+ExecHashJoinFillProbeBatch(PlanState *outerNode, HashJoinState *hjstate)
+{
+	HashJoinProbeBatch *pb = hjstate->hj_ProbeBatch;
+	HashJoinTable hashtable = hjstate->hj_HashTable;
+	HashState  *hashState = (HashState *) innerPlanState(hjstate);
+	ExprContext *econtext = hjstate->js.ps.ps_ExprContext;
+	bool		keep_nulls;
+	uint32		nbuckets = (uint32) hashtable->nbuckets;
+	int			i;
+
+	keep_nulls = (hjstate->js.jointype == JOIN_LEFT) ||
+		(hjstate->js.jointype == JOIN_LASJ) ||
+		(hjstate->js.jointype == JOIN_LASJ_NOTIN) ||
+		hjstate->hj_nonequijoin;
+
+	/* The previous vector's tuples are about to go away */
+	ExecClearTuple(hjstate->hj_OuterTupleSlot);
+	ExecHashJoinResetProbeBatch(hjstate);
+
+	while (pb->ntuples < pb->size)
+	{
+		TupleTableSlot *slot;
+		MemoryContext oldcxt;
+		uint32		hashvalue;
+		bool		hashkeys_null = false;
+
+		/*
+		 * Check to see if first outer tuple was already fetched by
+		 * ExecHashJoin() and not used yet.
+		 */
+		slot = hjstate->hj_FirstOuterTupleSlot;
+		if (!TupIsNull(slot))
+			hjstate->hj_FirstOuterTupleSlot = NULL;
+		else
+			slot = ExecProcNode(outerNode);
+
+		if (TupIsNull(slot))
+			break;
+
+		econtext->ecxt_outertuple = slot;
+		if (!call_ExecHashGetHashValue(hjstate, hashState, hashtable, econtext,
+									   hjstate->hj_OuterHashKeys,
+									   true,		/* outer tuple */
+									   keep_nulls,
+									   &hashvalue,
+									   &hashkeys_null))
+		{
+			/* That tuple couldn't match because of a NULL, so discard it */
+			continue;
+		}
+
+		oldcxt = MemoryContextSwitchTo(pb->cxt);
+		pb->tuples[pb->ntuples] = ExecCopySlotMemTuple(slot);
+		MemoryContextSwitchTo(oldcxt);
+
+		pb->hashvalues[pb->ntuples] = hashvalue;
+		pb->ntuples++;
+
+		/* Wide tuples make for a shorter vector */
+		if (MemoryContextGetCurrentSpace(pb->cxt) >= pb->spaceAllowed)
+			break;
+	}
+
+	/* Round one: bring the bucket array slots (and bloom filters) in. */
+	for (i = 0; i < pb->ntuples; i++)
+	{
+		uint32		bucketno = pb->hashvalues[i] & (nbuckets - 1);
+
+		HJ_PREFETCH(&hashtable->buckets[bucketno]);
+		if (gp_hashjoin_bloomfilter != 0)
+			HJ_PREFETCH(&hashtable->bloom[bucketno]);
+	}
+
+	/* Round two: bring the first tuple header of each chain in. */
+	for (i = 0; i < pb->ntuples; i++)
+	{
+		uint32		bucketno = pb->hashvalues[i] & (nbuckets - 1);
+		HashJoinTuple head = hashtable->buckets[bucketno];
+
+		if (head != NULL)
+			HJ_PREFETCH(head);
+	}
+
+	return pb->ntuples > 0;
+}
+
+/*
+ * ExecHashJoinResetProbeBatch
+ *		discard any outer tuples read ahead for batched probing
+ */
+static void
+ExecHashJoinResetProbeBatch(HashJoinState *hjstate)
+{
+	HashJoinProbeBatch *pb = hjstate->hj_ProbeBatch;
+
+	if (pb == NULL)
+		return;
+
+	MemoryContextReset(pb->cxt);
+	pb->ntuples = 0;
+	pb->next = 0;
+}
+
 /*
  * ExecHashJoinNewBatch
  *		switch to a new hashjoin batch
@@ -839,6 +1031,20 @@ start_over:
 		}
 		batch->outerside.workfile = NULL;
 	}
+	else	/* we just finished the first batch */
+	{
+		/*
+		 * Reset some of the skew optimization state variables, since we no
+		 * longer need to consider skew tuples after the first batch. The
+		 * memory context reset we are about to do will release the skew
+		 * hashtable itself.
+		 */
+		hashtable->skewEnabled = false;
+		hashtable->skewBucket = NULL;
+		hashtable->skewBucketNums = NULL;
+		hashtable->nSkewBuckets = 0;
+		hashtable->spaceUsedSkew = 0;
+	}
 
 	/*
 	 * We can always skip over any batches that are completely empty on both
@@ -1145,6 +1351,7 @@ ExecReScanHashJoin(HashJoinState *node, ExprContext *exprCtxt)
 	/* Always reset intra-tuple state */
 	node->hj_CurHashValue = 0;
 	node->hj_CurBucketNo = 0;
+	node->hj_CurSkewBucketNo = INVALID_SKEW_BUCKET_NO;
 	node->hj_CurTuple = NULL;
 
 	node->js.ps.ps_OuterTupleSlot = NULL;
@@ -1152,6 +1359,9 @@ ExecReScanHashJoin(HashJoinState *node, ExprContext *exprCtxt)
 	node->hj_MatchedOuter = false;
 	node->hj_FirstOuterTupleSlot = NULL;
 
+	ExecClearTuple(node->hj_OuterTupleSlot);
+	ExecHashJoinResetProbeBatch(node);
+
 	/*
 	 * if chgParam of subnode is not null then plan will be re-scanned by
 	 * first ExecProcNode.
@@ -1188,6 +1398,7 @@ static void ReleaseHashTable(HashJoinState *node)
 	/* Always reset intra-tuple state */
 	node->hj_CurHashValue = 0;
 	node->hj_CurBucketNo = 0;
+	node->hj_CurSkewBucketNo = INVALID_SKEW_BUCKET_NO;
 	node->hj_CurTuple = NULL;
 
 	node->js.ps.ps_OuterTupleSlot = NULL;
@@ -21,6 +21,7 @@
 #include "lib/stringinfo.h"             /* StringInfo */
 #include "miscadmin.h"
 #include "utils/tuplesort.h"
+#include "utils/tuplesort_mk.h"
 #include "cdb/cdbvars.h" /* CDB *//* gp_sort_flags */
 #include "utils/workfile_mgr.h"
 #include "executor/instrument.h"
@@ -169,6 +170,11 @@ ExecSort(SortState *node)
 		{
 			if (node->bounded)
 				tuplesort_set_bound_mk(tuplesortstate_mk, node->bound);
+#ifdef USE_CODEGEN
+			if (node->MKCompareDatum_gen_info.MKCompareDatum_fn != NULL)
+				tuplesort_set_compare_mk(tuplesortstate_mk,
+						node->MKCompareDatum_gen_info.MKCompareDatum_fn);
+#endif
 			node->tuplesortstate->sortstore_mk = tuplesortstate_mk;
 		}
 		else
@@ -7,9 +7,12 @@
  */
 #include "postgres.h"
 
+#include "cdb/cdbvars.h"
 #include "executor/executor.h"
+#include "executor/instrument.h"
 #include "nodes/execnodes.h"
 #include "executor/nodeTableScan.h"
+#include "miscadmin.h"
 #include "utils/elog.h"
 #include "parser/parsetree.h"
 
@@ -55,6 +58,61 @@ ExecTableScan(TableScanState *node)
 	return slot;
 }
 
+/*
+ * ExecTableScanFetch
+ *   Return the next tuple of the relation, before the quals are checked and
+ *   the projection is done, or NULL at the end of the scan.
+ *
+ * Generated code that fuses the scan with its parent calls this for each
+ * tuple, once the scan was begun by ExecTableScan.
+ */
+TupleTableSlot *
+ExecTableScanFetch(TableScanState *node)
+{
+	ScanState *scanState = (ScanState *)node;
+	TupleTableSlot *slot = NULL;
+	InstrProfile *profile = scanState->ps.profile;
+	InstrProfile *saveProfile = CurrentInstrProfile;
+	uint64		startCycles = 0;
+
+	CHECK_FOR_INTERRUPTS();
+
+	/*
+	 * Keep the always-on profile of the scan, as ExecProcNode would.  Each
+	 * fetch counts as a call, so for a fused scan the calls include the
+	 * tuples that its quals reject.
+	 */
+	if (profile)
+	{
+		profile->ncalls++;
+		if (--scanState->ps.profileCountdown <= 0)
+		{
+			scanState->ps.profileCountdown = gp_instrument_profile_interval;
+			startCycles = INSTR_CYCLES_GET_CURRENT();
+		}
+		CurrentInstrProfile = profile;
+	}
+
+	if (!QueryFinishPending)
+		slot = FetchTableScanRelation(scanState);
+
+	if (startCycles != 0)
+	{
+		profile->sampleCycles += INSTR_CYCLES_GET_CURRENT() - startCycles;
+		profile->nsamples++;
+	}
+	CurrentInstrProfile = saveProfile;
+
+	if (!TupIsNull(slot))
+		return slot;
+
+	if (!scanState->ps.delayEagerFree)
+	{
+		EndTableScanRelation(scanState);
+	}
+	return NULL;
+}
+
 void
 ExecEndTableScan(TableScanState *node)
 {
@@ -95,6 +95,41 @@ typedef struct FrameBufferEntry
 	List	   *func_values;
 } FrameBufferEntry;
 
+/*
+ * WindowMinMaxItem -- one candidate value in a WindowMinMaxDeque, along
+ * with the position of the frame buffer entry it came from.
+ */
+typedef struct WindowMinMaxItem
+{
+	NTupleStorePos pos;
+	Datum		value;
+} WindowMinMaxItem;
+
+/*
+ * WindowMinMaxDeque -- a monotonic deque to compute min()/max()-like
+ * aggregates, i.e. those with a sort operator, over a sliding frame.
+ *
+ * The items are kept in frame buffer order, and each item is strictly
+ * preferred by the sort operator over all items behind it, so the front
+ * item is the aggregate value for the frame. An entry entering the frame
+ * drops the items it beats from the back; an item passed by the trailing
+ * edge is dropped from the front. Every entry is pushed and popped at
+ * most once, which makes the cost per output row amortized constant
+ * instead of proportional to the frame width.
+ */
+typedef struct WindowMinMaxDeque
+{
+	WindowMinMaxItem *items;	/* circular array of 'capacity' items */
+	int			capacity;
+	int			head;			/* index of the front item */
+	int			count;
+
+	FmgrInfo	sortfn;			/* function of the aggregate's sort operator */
+	bool		typbyval;		/* type info of the transition values */
+	int16		typlen;
+	MemoryContext mcxt;			/* context for the copied values */
+} WindowMinMaxDeque;
+
 /*
  * WindowStatePerLevelData - per-level working state
  */
@@ -238,6 +273,20 @@ typedef struct WindowStatePerLevelData
 	*/
 	char *serial_array;
 	Size max_size;
+
+	/*
+	 * Indicate if some functions in this level use a WindowMinMaxDeque.
+	 *
+	 * The deques of this level hold the values of the frame buffer entries
+	 * between 'incr_first_pos' and 'incr_last_pos', if 'incr_valid' is set.
+	 * 'incr_reader' is used to read new entries into the deques. It is only
+	 * positioned while doing so, and never pins a page that may be trimmed.
+	 */
+	bool		has_minmax_deques;
+	bool		incr_valid;
+	NTupleStorePos incr_first_pos;
+	NTupleStorePos incr_last_pos;
+	NTupleStoreAccessor *incr_reader;
 }	WindowStatePerLevelData;
 
 /*
@@ -272,6 +321,7 @@ typedef struct WindowStatePerFunctionData
 	Oid			prelimfn_oid;
 	Oid			invtransfn_oid;
 	Oid			invprelimfn_oid;
+	Oid			sortop_oid;
 
 	FmgrInfo	transfn;
 	FmgrInfo	finalfn;
@@ -318,6 +368,13 @@ typedef struct WindowStatePerFunctionData
 	 * The total number of not NULL arguments for this function so far.
 	 */
 	uint64		numNotNulls;
+
+	/*
+	 * The monotonic deque to compute the frame value incrementally, for
+	 * aggregate functions with a sort operator and no inverse preliminary
+	 * function, such as min() and max(). NULL if not used.
+	 */
+	WindowMinMaxDeque *minmax;
 }	WindowStatePerFunctionData;
 
 #define FRAME_TRAIL_ROWS	0
@@ -492,6 +549,10 @@ static void computeFrameValue(WindowStatePerLevel level_state,
 				  NTupleStoreAccessor * trail_reader,
 				  NTupleStoreAccessor * lead_reader);
 
+static void computeTransValuesThroughDeque(WindowStatePerLevel level_state,
+							   WindowState * wstate);
+static void resetMinMaxDeques(WindowStatePerLevel level_state);
+
 static void createFrameBuffers(WindowState * wstate);
 static void resetFrameBuffers(WindowState * wstate);
 static void resetTransValues(WindowStatePerLevel level_state,
@@ -680,6 +741,12 @@ createFrameBuffers(WindowState * wstate)
 			ntuplestore_create_accessor(level_state->frame_buffer->tuplestore, false);
 		level_state->lead_reader =
 			ntuplestore_create_accessor(level_state->frame_buffer->tuplestore, false);
+		if (level_state->has_minmax_deques)
+		{
+			level_state->incr_reader =
+				ntuplestore_create_accessor(level_state->frame_buffer->tuplestore, false);
+			resetMinMaxDeques(level_state);
+		}
 
 		level_state->frame_buffer->level_state = level_state;
 	}
@@ -738,6 +805,8 @@ resetFrameBuffers(WindowState * wstate)
 				ntuplestore_destroy_accessor(level_state->trail_reader);
 			if (level_state->lead_reader)
 				ntuplestore_destroy_accessor(level_state->lead_reader);
+			if (level_state->incr_reader)
+				ntuplestore_destroy_accessor(level_state->incr_reader);
 
 			level_state->frame_buffer = resetFrameBuffer(level_state->frame_buffer);
 
@@ -746,8 +815,15 @@ resetFrameBuffers(WindowState * wstate)
 				ntuplestore_create_accessor(level_state->frame_buffer->tuplestore, false);
 			level_state->lead_reader =
 				ntuplestore_create_accessor(level_state->frame_buffer->tuplestore, false);
+			if (level_state->has_minmax_deques)
+				level_state->incr_reader =
+					ntuplestore_create_accessor(level_state->frame_buffer->tuplestore, false);
 		}
 
+		/* Positions in the old buffer mean nothing in the new one. */
+		if (level_state->has_minmax_deques)
+			resetMinMaxDeques(level_state);
+
 		level_state->num_trail_rows = 0;
 		level_state->num_lead_rows = 0;
 		level_state->lead_ready = false;
@@ -790,6 +866,11 @@ freeFrameBuffers(WindowState * wstate)
 				ntuplestore_destroy_accessor(level_state->trail_reader);
 			if (level_state->lead_reader)
 				ntuplestore_destroy_accessor(level_state->lead_reader);
+			if (level_state->incr_reader)
+			{
+				ntuplestore_destroy_accessor(level_state->incr_reader);
+				level_state->incr_reader = NULL;
+			}
 
 			freeFrameBuffer(level_state->frame_buffer);
 			level_state->frame_buffer = NULL;
@@ -1882,6 +1963,26 @@ freeTransValue(Datum *transValue,
 	*noTransValue = true;
 }
 
+/*
+ * frameIncludesLastAgg -- return true if the transition value of the
+ * values not yet appended to the frame buffer, funcstate->aggTransValue,
+ * falls into the current frame when the leading edge is past the end of
+ * the buffer.
+ */
+static bool
+frameIncludesLastAgg(WindowStatePerLevel level_state, WindowState * wstate)
+{
+	if (EDGE_EQ_CURRENT_ROW(level_state, wstate, level_state->frame->trail, false))
+		return true;
+
+	if (!EDGE_IS_BOUND(level_state->frame->lead) ||
+		EDGE_IS_BOUND_FOLLOWING(level_state->frame->lead) ||
+		EDGE_EQ_CURRENT_ROW(level_state, wstate, level_state->frame->lead, true))
+		return true;
+
+	return false;
+}
+
 /*
  * computeTransValuesThroughScan -- compute transition values
  * for those functions in the given level whose aggregate values
@@ -1937,7 +2038,8 @@ computeTransValuesThroughScan(WindowStatePerLevel level_state,
 		if (funcstate->trivial_frame ||
 			funcstate->winpeercount ||
 			(funcstate->isAgg && OidIsValid(funcstate->invprelimfn_oid)) ||
-			!funcstate->isAgg)
+			!funcstate->isAgg ||
+			funcstate->minmax != NULL)
 			continue;
 
 		freeTransValue(&funcstate->final_aggTransValue,
@@ -1958,8 +2060,6 @@ computeTransValuesThroughScan(WindowStatePerLevel level_state,
 
 	if (has_tuples)
 	{
-		bool		include_last_agg = false;
-
 		while (ntuplestore_acc_tell(level_state->trail_reader, NULL))
 		{
 			if (ntuplestore_acc_tell(level_state->lead_reader, NULL) &&
@@ -1986,7 +2086,8 @@ computeTransValuesThroughScan(WindowStatePerLevel level_state,
 					funcstate->winpeercount ||
 					(funcstate->isAgg &&
 					 OidIsValid(funcstate->invprelimfn_oid)) ||
-					!funcstate->isAgg)
+					!funcstate->isAgg ||
+					funcstate->minmax != NULL)
 					continue;
 
 				if (OidIsValid(funcstate->prelimfn_oid))
@@ -2039,16 +2140,9 @@ computeTransValuesThroughScan(WindowStatePerLevel level_state,
 		/*
 		 * Add the funcstate->aggTransValue if it is in the current frame.
 		 */
-		if (EDGE_EQ_CURRENT_ROW(level_state, wstate, level_state->frame->trail, false))
-			include_last_agg = true;
-
-		if (!EDGE_IS_BOUND(level_state->frame->lead) ||
-			EDGE_IS_BOUND_FOLLOWING(level_state->frame->lead) ||
-			EDGE_EQ_CURRENT_ROW(level_state, wstate, level_state->frame->lead, true))
-			include_last_agg = true;
-
 		if (!ntuplestore_acc_tell(level_state->lead_reader, NULL) &&
-			level_state->agg_filled && include_last_agg)
+			level_state->agg_filled &&
+			frameIncludesLastAgg(level_state, wstate))
 		{
 			foreach(lc, level_state->level_funcs)
 			{
@@ -2062,7 +2156,8 @@ computeTransValuesThroughScan(WindowStatePerLevel level_state,
 				if (funcstate->trivial_frame ||
 					funcstate->winpeercount ||
 					(funcstate->isAgg && OidIsValid(funcstate->invprelimfn_oid)) ||
-					!funcstate->isAgg)
+					!funcstate->isAgg ||
+					funcstate->minmax != NULL)
 					continue;
 
 				if (OidIsValid(funcstate->prelimfn_oid))
@@ -2107,6 +2202,336 @@ computeTransValuesThroughScan(WindowStatePerLevel level_state,
 		ntuplestore_acc_set_invalid(level_state->trail_reader);
 }
 
+/*
+ * cmpTupleStorePos -- compare two positions in the same tuplestore.
+ */
+static int
+cmpTupleStorePos(NTupleStorePos *a, NTupleStorePos *b)
+{
+	if (a->blockn != b->blockn)
+		return (a->blockn < b->blockn) ? -1 : 1;
+	if (a->slotn != b->slotn)
+		return (a->slotn < b->slotn) ? -1 : 1;
+	return 0;
+}
+
+/*
+ * createMinMaxDeque -- create an empty WindowMinMaxDeque for a given
+ * function. The values pushed into the deque are copied into the
+ * current memory context.
+ */
+static WindowMinMaxDeque *
+createMinMaxDeque(WindowStatePerFunction funcstate)
+{
+	WindowMinMaxDeque *deque =
+	(WindowMinMaxDeque *) palloc0(sizeof(WindowMinMaxDeque));
+
+	deque->capacity = 64;
+	deque->items = (WindowMinMaxItem *)
+		palloc(deque->capacity * sizeof(WindowMinMaxItem));
+	deque->head = 0;
+	deque->count = 0;
+
+	fmgr_info(get_opcode(funcstate->sortop_oid), &deque->sortfn);
+	deque->typbyval = funcstate->aggTranstypeByVal;
+	deque->typlen = funcstate->aggTranstypeLen;
+	deque->mcxt = CurrentMemoryContext;
+
+	return deque;
+}
+
+#define MINMAX_DEQUE_ITEM(deque, i) \
+	(&(deque)->items[((deque)->head + (i)) % (deque)->capacity])
+
+/*
+ * minMaxDequeRemove -- remove the front or the back item of a deque.
+ */
+static void
+minMaxDequeRemove(WindowMinMaxDeque *deque, bool front)
+{
+	WindowMinMaxItem *item;
+
+	Assert(deque->count > 0);
+
+	item = MINMAX_DEQUE_ITEM(deque, front ? 0 : deque->count - 1);
+	if (!deque->typbyval)
+		pfree(DatumGetPointer(item->value));
+
+	if (front)
+		deque->head = (deque->head + 1) % deque->capacity;
+	deque->count--;
+}
+
+/*
+ * minMaxDequePush -- push the value of the frame buffer entry at 'pos'
+ * into the back of a deque, dropping all items it is preferred over.
+ */
+static void
+minMaxDequePush(WindowMinMaxDeque *deque, NTupleStorePos *pos, Datum value)
+{
+	WindowMinMaxItem *item;
+	MemoryContext oldctx;
+
+	while (deque->count > 0)
+	{
+		item = MINMAX_DEQUE_ITEM(deque, deque->count - 1);
+		if (DatumGetBool(FunctionCall2(&deque->sortfn, item->value, value)))
+			break;
+		minMaxDequeRemove(deque, false);
+	}
+
+	oldctx = MemoryContextSwitchTo(deque->mcxt);
+
+	if (deque->count == deque->capacity)
+	{
+		WindowMinMaxItem *items;
+		int			i;
+
+		items = (WindowMinMaxItem *)
+			palloc(2 * deque->capacity * sizeof(WindowMinMaxItem));
+		for (i = 0; i < deque->count; i++)
+			items[i] = *MINMAX_DEQUE_ITEM(deque, i);
+
+		pfree(deque->items);
+		deque->items = items;
+		deque->capacity *= 2;
+		deque->head = 0;
+	}
+
+	item = MINMAX_DEQUE_ITEM(deque, deque->count);
+	item->pos = *pos;
+	item->value = datumCopy(value, deque->typbyval, deque->typlen);
+	deque->count++;
+
+	MemoryContextSwitchTo(oldctx);
+}
+
+/*
+ * resetMinMaxDeques -- empty all deques in a given level.
+ */
+static void
+resetMinMaxDeques(WindowStatePerLevel level_state)
+{
+	ListCell   *lc;
+
+	foreach(lc, level_state->level_funcs)
+	{
+		WindowStatePerFunction funcstate = (WindowStatePerFunction) lfirst(lc);
+
+		if (funcstate->minmax == NULL)
+			continue;
+
+		while (funcstate->minmax->count > 0)
+			minMaxDequeRemove(funcstate->minmax, true);
+	}
+
+	level_state->incr_valid = false;
+}
+
+/*
+ * computeTransValuesThroughDeque -- compute transition values for
+ * those functions in the given level that use a WindowMinMaxDeque.
+ *
+ * The frame covers the same frame buffer entries, and possibly the same
+ * funcstate->aggTransValue, as in computeTransValuesThroughScan. Instead
+ * of combining all of them, we only push the entries that entered the
+ * frame since the last call into the deques, and pop the ones that left.
+ */
+static void
+computeTransValuesThroughDeque(WindowStatePerLevel level_state,
+							   WindowState * wstate)
+{
+	NTupleStoreAccessor *reader = level_state->incr_reader;
+	FrameBufferEntry *curr_entry = level_state->curr_entry_buf;
+	ExprContext *econtext = wstate->ps.ps_ExprContext;
+	FunctionCallInfoData fcinfo;
+	NTupleStorePos first_pos;
+	NTupleStorePos last_pos;
+	NTupleStorePos pos;
+	bool		has_tuples;
+	bool		has_entries = false;
+	ListCell   *lc;
+
+	has_tuples = hasTuplesInFrame(level_state, wstate);
+
+	/*
+	 * Find the first and the last frame buffer entries in the frame. Since
+	 * the trail_reader points to the value before the trailing edge, the
+	 * first one is right after it.
+	 */
+	if (has_tuples)
+	{
+		if (ntuplestore_acc_tell(level_state->trail_reader, &pos))
+		{
+			ntuplestore_acc_seek(reader, &pos);
+			ntuplestore_acc_advance(reader, 1);
+		}
+		else if (!ntuplestore_acc_tell(level_state->lead_reader, NULL) &&
+				 (EDGE_IS_BOUND_PRECEDING(level_state->frame->lead) &&
+				  ((level_state->is_rows && level_state->lead_rows != 0) ||
+				   (!level_state->is_rows &&
+					!exec_eq_exprstate(wstate, level_state->lead_range_eq_expr)))))
+			has_tuples = false;
+		else
+			ntuplestore_acc_seek_first(reader);
+	}
+
+	if (has_tuples && ntuplestore_acc_tell(reader, &first_pos))
+	{
+		if (ntuplestore_acc_tell(level_state->lead_reader, &last_pos))
+			has_entries = (cmpTupleStorePos(&first_pos, &last_pos) <= 0);
+		else
+		{
+			ntuplestore_acc_seek_last(reader);
+			has_entries = ntuplestore_acc_tell(reader, &last_pos);
+		}
+	}
+
+	if (has_entries)
+	{
+		MemoryContext oldctx;
+
+		/*
+		 * Frame edges only move forward, but start over if one of them moved
+		 * backwards, or if the frame has moved past all entries we have seen.
+		 */
+		if (level_state->incr_valid &&
+			(cmpTupleStorePos(&first_pos, &level_state->incr_first_pos) < 0 ||
+			 cmpTupleStorePos(&last_pos, &level_state->incr_last_pos) < 0 ||
+			 cmpTupleStorePos(&level_state->incr_last_pos, &first_pos) < 0))
+			resetMinMaxDeques(level_state);
+
+		oldctx = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+		/* Pop the entries that left the frame. */
+		foreach(lc, level_state->level_funcs)
+		{
+			WindowStatePerFunction funcstate = (WindowStatePerFunction) lfirst(lc);
+			WindowMinMaxDeque *deque = funcstate->minmax;
+
+			if (deque == NULL)
+				continue;
+
+			while (deque->count > 0 &&
+				   cmpTupleStorePos(&MINMAX_DEQUE_ITEM(deque, 0)->pos,
+									&first_pos) < 0)
+				minMaxDequeRemove(deque, true);
+		}
+
+		/* Push the entries that entered the frame. */
+		if (level_state->incr_valid)
+		{
+			ntuplestore_acc_seek(reader, &level_state->incr_last_pos);
+			ntuplestore_acc_advance(reader, 1);
+		}
+		else
+			ntuplestore_acc_seek(reader, &first_pos);
+
+		while (ntuplestore_acc_tell(reader, &pos) &&
+			   cmpTupleStorePos(&pos, &last_pos) <= 0)
+		{
+#ifdef USE_ASSERT_CHECKING
+			bool		has_curr_entry =
+#endif
+			getCurrentValue(reader, level_state, curr_entry);
+
+			Assert(has_curr_entry);
+
+			foreach(lc, level_state->level_funcs)
+			{
+				WindowStatePerFunction funcstate = (WindowStatePerFunction) lfirst(lc);
+				WindowValue *curr_value;
+
+				if (funcstate->minmax == NULL)
+					continue;
+
+				curr_value = (WindowValue *) list_nth(curr_entry->func_values,
+													  funcstate->serial_index);
+				if (!curr_value->valueIsNull)
+					minMaxDequePush(funcstate->minmax, &pos, curr_value->value);
+			}
+
+			ntuplestore_acc_advance(reader, 1);
+		}
+
+		MemoryContextSwitchTo(oldctx);
+
+		level_state->incr_valid = true;
+		level_state->incr_first_pos = first_pos;
+		level_state->incr_last_pos = last_pos;
+	}
+
+	/* Don't keep a page pinned, it may be trimmed later. */
+	ntuplestore_acc_set_invalid(reader);
+
+	foreach(lc, level_state->level_funcs)
+	{
+		WindowStatePerFunction funcstate = (WindowStatePerFunction) lfirst(lc);
+
+		if (funcstate->minmax == NULL)
+			continue;
+
+		freeTransValue(&funcstate->final_aggTransValue,
+					   funcstate->aggTranstypeByVal,
+					   &funcstate->final_aggTransValueIsNull,
+					   &funcstate->final_aggNoTransValue,
+					   funcstate->final_aggShouldFree);
+
+		funcstate->final_aggTransValue =
+			datumCopyWithMemManager(0, funcstate->aggInitValue,
+									funcstate->aggTranstypeByVal,
+									funcstate->aggTranstypeLen,
+									&(wstate->mem_manager));
+		funcstate->final_aggTransValueIsNull = funcstate->aggInitValueIsNull;
+		funcstate->final_aggNoTransValue = funcstate->aggInitValueIsNull;
+		funcstate->final_aggShouldFree = !funcstate->aggInitValueIsNull;
+
+		if (has_entries && funcstate->minmax->count > 0)
+		{
+			fcinfo.arg[1] = MINMAX_DEQUE_ITEM(funcstate->minmax, 0)->value;
+			fcinfo.argnull[1] = false;
+
+			funcstate->final_aggTransValue =
+				invoke_agg_trans_func(&(funcstate->prelimfn),
+									  funcstate->prelimfn.fn_nargs - 1,
+									  funcstate->final_aggTransValue,
+									  &funcstate->final_aggNoTransValue,
+									  &(funcstate->final_aggTransValueIsNull),
+									  funcstate->aggTranstypeByVal,
+									  funcstate->aggTranstypeLen,
+									  &fcinfo, (void *)wstate,
+									  econtext->ecxt_per_tuple_memory,
+									  &(wstate->mem_manager));
+			funcstate->final_aggShouldFree = true;
+		}
+
+		/*
+		 * Add the funcstate->aggTransValue if it is in the current frame.
+		 */
+		if (has_tuples &&
+			!ntuplestore_acc_tell(level_state->lead_reader, NULL) &&
+			level_state->agg_filled &&
+			frameIncludesLastAgg(level_state, wstate))
+		{
+			fcinfo.arg[1] = funcstate->aggTransValue;
+			fcinfo.argnull[1] = funcstate->aggTransValueIsNull;
+
+			funcstate->final_aggTransValue =
+				invoke_agg_trans_func(&(funcstate->prelimfn),
+									  funcstate->prelimfn.fn_nargs - 1,
+									  funcstate->final_aggTransValue,
+									  &funcstate->final_aggNoTransValue,
+									  &(funcstate->final_aggTransValueIsNull),
+									  funcstate->aggTranstypeByVal,
+									  funcstate->aggTranstypeLen,
+									  &fcinfo, (void *)wstate,
+									  econtext->ecxt_per_tuple_memory,
+									  &(wstate->mem_manager));
+			funcstate->final_aggShouldFree = true;
+		}
+	}
+}
+
 /*
  * computeFrameValue -- compute transition values for each function
  * in a given key level from the data stored in its frame buffer.
@@ -2140,6 +2565,7 @@ computeFrameValue(WindowStatePerLevel level_state,
 	bool		read_edge_value = false;
 
 	bool		require_scanning = false;
+	bool		require_deque = false;
 
 	Assert(level_state->is_rows == buffer->is_rows);
 
@@ -2371,6 +2797,10 @@ computeFrameValue(WindowStatePerLevel level_state,
 				}
 			}
 		}
+		else if (funcstate->isAgg && funcstate->minmax != NULL)
+		{
+			require_deque = true;
+		}
 		else if (funcstate->isAgg && OidIsValid(funcstate->prelimfn_oid))
 		{
 			require_scanning = true;
@@ -2414,6 +2844,13 @@ computeFrameValue(WindowStatePerLevel level_state,
 	 */
 	if (require_scanning)
 		computeTransValuesThroughScan(level_state, wstate);
+
+	/*
+	 * Compute transition values for functions that maintain their frame
+	 * values incrementally in a deque.
+	 */
+	if (require_deque)
+		computeTransValuesThroughDeque(level_state, wstate);
 }
 
 /*
@@ -2662,6 +3099,15 @@ initWindowFuncState(WindowState * wstate, Window * node)
 				funcstate->invprelimfn.fn_expr = (Node *) invprelimfnexpr;
 			}
 
+			/*
+			 * The sort operator compares input values, so it can only be
+			 * applied to the transition values if they are of the same type.
+			 */
+			if (OidIsValid(aggform->aggsortop) &&
+				funcstate->numargs == 1 &&
+				inputTypes[0] == aggtranstype)
+				funcstate->sortop_oid = aggform->aggsortop;
+
 			get_typlenbyval(winref->restype,
 							&funcstate->resulttypeLen,
 							&funcstate->resulttypeByVal);
@@ -5750,6 +6196,41 @@ init_frames(WindowState * wstate)
 			 EDGE_IS_DELAYED(level_state->frame->trail));
 	}
 
+	/*
+	 * Use a monotonic deque for aggregate functions with a sort operator,
+	 * such as min() and max(), that would otherwise have to scan the whole
+	 * frame for every row. This requires the frame edges to move forward
+	 * only, which is the case unless they are delayed bounds.
+	 */
+	for (level = 0; level < wstate->numlevels; level++)
+	{
+		WindowStatePerLevel level_state = &wstate->level_state[level];
+
+		if (level_state->trivial_frames_only ||
+			level_state->has_delay_bound ||
+			level_state->empty_frame ||
+			level_state->frame->exclude != WINDOW_EXCLUSION_NULL)
+			continue;
+
+		foreach(lc, level_state->level_funcs)
+		{
+			WindowStatePerFunction funcstate =
+			(WindowStatePerFunction) lfirst(lc);
+
+			if (funcstate->isAgg &&
+				!funcstate->trivial_frame &&
+				!funcstate->cumul_frame &&
+				!funcstate->winpeercount &&
+				OidIsValid(funcstate->sortop_oid) &&
+				OidIsValid(funcstate->prelimfn_oid) &&
+				!OidIsValid(funcstate->invprelimfn_oid))
+			{
+				funcstate->minmax = createMinMaxDeque(funcstate);
+				level_state->has_minmax_deques = true;
+			}
+		}
+	}
+
 	/*
 	 * Set has_only_trans_funcs in each level state if all functions in this
 	 * level are aggregate functions that have no preliminary functions or
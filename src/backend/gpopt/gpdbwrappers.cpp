@@ -48,6 +48,7 @@
 #define ALLOW_PointerGetDatum
 #define ALLOW_aggregate_exists
 #define ALLOW_bms_add_member
+#define ALLOW_bms_equal
 #define ALLOW_copyObject
 #define ALLOW_datumGetSize
 #define ALLOW_deconstruct_array
@@ -56,6 +57,7 @@
 #define ALLOW_exprType
 #define ALLOW_exprTypmod
 #define ALLOW_extract_nodes_plan
+#define ALLOW_extract_plan_param_ids
 #define ALLOW_extract_nodes_expression
 #define ALLOW_free_attstatsslot
 #define ALLOW_func_strict
@@ -72,12 +74,14 @@
 #define ALLOW_get_array_type
 #define ALLOW_get_attstatsslot
 #define ALLOW_get_att_stats
+#define ALLOW_prefetch_att_stats
 #define ALLOW_get_commutator
 #define ALLOW_trigger_exists
 #define ALLOW_get_trigger_name
 #define ALLOW_get_trigger_relid
 #define ALLOW_get_trigger_funcid
 #define ALLOW_get_trigger_type
+#define ALLOW_get_trigger_oids
 #define ALLOW_trigger_enabled
 #define ALLOW_get_func_name
 #define ALLOW_get_func_output_arg_types
@@ -89,11 +93,13 @@
 #define ALLOW_get_opname
 #define ALLOW_get_partition_attrs
 #define ALLOW_rel_is_leaf_partition
+#define ALLOW_rel_is_child_partition
 #define ALLOW_rel_partition_get_master
 #define ALLOW_BuildLogicalIndexInfo
 #define ALLOW_get_parts
 #define ALLOW_countLeafPartTables
 #define ALLOW_get_relation_keys
+#define ALLOW_get_relnatts
 #define ALLOW_get_typ_typrelid
 #define ALLOW_get_type_name
 #define ALLOW_getgpsegmentCount
@@ -117,6 +123,7 @@
 #define ALLOW_list_nth_int
 #define ALLOW_list_nth_oid
 #define ALLOW_list_member_oid
+#define ALLOW_list_concat_unique_oid
 #define ALLOW_freeListAndNull
 #define ALLOW_lookup_type_cache
 #define ALLOW_makeString
@@ -195,6 +202,17 @@
 #define ALLOW_isMotionGather
 #define ALLOW_estimate_rel_size
 #define ALLOW_rel_partitioning_is_uniform
+#define ALLOW_MDSharedCacheIsUsable
+#define ALLOW_MDSharedCacheGeneration
+#define ALLOW_MDSharedCacheLookup
+#define ALLOW_MDSharedCacheInsert
+#define ALLOW_OptPlanCacheLookup
+#define ALLOW_OptPlanCacheInsert
+#define ALLOW_OptPlanCacheInvalidate
+#define ALLOW_OptPlanCacheReset
+#define ALLOW_OptStatsCacheLookup
+#define ALLOW_OptStatsCacheInsert
+#define ALLOW_GetOptimizerCostParams
 
 #include "gpopt/utils/gpdbdefs.h"
 
@@ -607,6 +625,21 @@ gpdb::PbmsAddMember
 	return NULL;
 }
 
+bool
+gpdb::FBmsEqual
+	(
+	const Bitmapset *a,
+	const Bitmapset *b
+	)
+{
+	GP_WRAP_START;
+	{
+		return bms_equal(a, b);
+	}
+	GP_WRAP_END;
+	return false;
+}
+
 void *
 gpdb::PvCopyObject
 	(
@@ -734,6 +767,21 @@ gpdb::PlExtractNodesPlan
 	return NIL;
 }
 
+Bitmapset *
+gpdb::PbmsExtractParamIdsPlan
+	(
+	Plan *pl,
+	Bitmapset *pbmsKnownPlanIds
+	)
+{
+	GP_WRAP_START;
+	{
+		return extract_plan_param_ids(pl, pbmsKnownPlanIds);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
 List *
 gpdb::PlExtractNodesExpression
 	(
@@ -1001,6 +1049,21 @@ gpdb::HtAttrStats
 	return NULL;
 }
 
+void
+gpdb::PrefetchAttrStats
+	(
+	Oid relid
+	)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic */
+		prefetch_att_stats(relid);
+		return;
+	}
+	GP_WRAP_END;
+}
+
 Oid
 gpdb::OidCommutatorOp
 	(
@@ -3049,16 +3112,31 @@ gpdb::UlLeafPartitions
 }
 
 /*
- * To detect changes to catalog tables that require resetting the Metadata
- * Cache, we use the normal PostgreSQL catalog cache invalidation mechanism.
+ * To detect changes to catalog tables that make Metadata Cache entries stale,
+ * we use the normal PostgreSQL catalog cache invalidation mechanism.
  * We register a callback to a cache on all the catalog tables that contain
  * information that's contained in the ORCA metadata cache.
-
- * There is no fine-grained mechanism in the metadata cache for invalidating
- * individual entries ATM, so we just blow the whole cache whenever anything
- * changes. The callback simply increments a counter. Whenever we start
- * planning a query, we check the counter to see if it has changed since the
- * last planned query, and reset the whole cache if it has.
+ *
+ * The relcache callback remembers the OIDs of the invalidated relations.
+ * Whenever we start planning a query, those relations are evicted from the
+ * metadata cache, together with their stats, triggers and check constraints.
+ * A change to the column statistics of a relation also sends a relcache
+ * invalidation for it (see PrepareForTupleInvalidation()).
+ *
+ * Types, functions, aggregates, operators and check constraints are cached
+ * under their own OID, and the syscaches keyed by that OID report their
+ * changes with the hash value of the OID. The callback remembers those, and
+ * when we start planning a query, we match them against the hash values of
+ * the objects fetched into the metadata cache since it was last reset.
+ * Only matching objects are evicted; events that match none of them, such
+ * as the new pg_type row of a table that was just created, don't cost
+ * anything. (A hash collision merely evicts an object that didn't change.)
+ * Operators are also referenced from cached comparisons and casts, which we
+ * don't track, so a change to a cached operator resets the whole cache.
+ *
+ * The other syscache events are about objects that are looked up by other
+ * keys, and can't be narrowed down to the entries they affect. Any of
+ * them, or more events than we have room for, resets the whole cache.
  *
  * To make sure we've covered all catalog tables that contain information
  * that's stored in the metadata cache, there are "catalog tables: xxx"
@@ -3067,20 +3145,112 @@ gpdb::UlLeafPartitions
  * anything fetched via the wrapper functions in this file can end up in the
  * metadata cache and hence need to have an invalidation callback registered.
  */
-static bool mdcache_invalidation_counter_registered = false;
-static int64 mdcache_invalidation_counter = 0;
-static int64 last_mdcache_invalidation_counter = 0;
+#define MDCACHE_MAX_PENDING_INVALIDATIONS	1024
+
+/* Syscaches keyed by the OID of an object cached under that OID */
+static const int mdcache_object_caches[] = {
+	AGGFNOID,			/* pg_aggregate */
+	CONSTROID,			/* pg_constraint */
+	OPEROID,			/* pg_operator */
+	PROCOID,			/* pg_proc */
+	TYPEOID,			/* pg_type */
+};
+
+typedef struct MDCacheObjectInvalidation
+{
+	int			cacheid;
+	uint32		hashValue;
+} MDCacheObjectInvalidation;
+
+static bool mdcache_invalidation_callbacks_registered = false;
+static bool mdcache_reset_pending = false;
+static bool mdcache_resolving_invalidations = false;
+static int	mdcache_num_pending_invalidations = 0;
+static Oid	mdcache_pending_invalidations[MDCACHE_MAX_PENDING_INVALIDATIONS];
+static int	mdcache_num_pending_object_invalidations = 0;
+static MDCacheObjectInvalidation mdcache_pending_object_invalidations[MDCACHE_MAX_PENDING_INVALIDATIONS];
+
+/* OIDs of the objects fetched into the metadata cache since its last reset */
+static HTAB *mdcache_objects = NULL;
+
+static bool
+mdcache_is_object_cache(int cacheid)
+{
+	int			i;
+
+	for (i = 0; i < lengthof(mdcache_object_caches); i++)
+	{
+		if (mdcache_object_caches[i] == cacheid)
+			return true;
+	}
+	return false;
+}
 
 static void
-mdsyscache_invalidation_counter_callback(Datum arg, int cacheid,  ItemPointer tuplePtr)
+mdsyscache_invalidation_callback(Datum arg, int cacheid, ItemPointer tuplePtr,
+								 uint32 hashValue)
 {
-	mdcache_invalidation_counter++;
+	int			i;
+
+	/* NULL means the whole syscache was flushed */
+	if (tuplePtr == NULL)
+	{
+		mdcache_reset_pending = true;
+		return;
+	}
+
+	/*
+	 * Column statistics are keyed by relation, and come with a relcache
+	 * event for it.
+	 */
+	if (cacheid == STATRELATT)
+		return;
+
+	if (!mdcache_is_object_cache(cacheid))
+		mdcache_reset_pending = true;
+
+	if (mdcache_reset_pending)
+		return;
+
+	for (i = 0; i < mdcache_num_pending_object_invalidations; i++)
+	{
+		if (mdcache_pending_object_invalidations[i].cacheid == cacheid &&
+			mdcache_pending_object_invalidations[i].hashValue == hashValue)
+			return;
+	}
+
+	if (mdcache_num_pending_object_invalidations == MDCACHE_MAX_PENDING_INVALIDATIONS)
+		mdcache_reset_pending = true;
+	else
+	{
+		mdcache_pending_object_invalidations[mdcache_num_pending_object_invalidations].cacheid = cacheid;
+		mdcache_pending_object_invalidations[mdcache_num_pending_object_invalidations].hashValue = hashValue;
+		mdcache_num_pending_object_invalidations++;
+	}
 }
 
 static void
-mdrelcache_invalidation_counter_callback(Datum arg, Oid relid)
+mdrelcache_invalidation_callback(Datum arg, Oid relid)
 {
-	mdcache_invalidation_counter++;
+	int			i;
+
+	/* InvalidOid means the whole relcache was flushed */
+	if (!OidIsValid(relid))
+		mdcache_reset_pending = true;
+
+	if (mdcache_reset_pending)
+		return;
+
+	for (i = 0; i < mdcache_num_pending_invalidations; i++)
+	{
+		if (mdcache_pending_invalidations[i] == relid)
+			return;
+	}
+
+	if (mdcache_num_pending_invalidations == MDCACHE_MAX_PENDING_INVALIDATIONS)
+		mdcache_reset_pending = true;
+	else
+		mdcache_pending_invalidations[mdcache_num_pending_invalidations++] = relid;
 }
 
 static void
@@ -3142,40 +3312,375 @@ register_mdcache_invalidation_callbacks(void)
 	for (i = 0; i < lengthof(metadata_caches); i++)
 	{
 		CacheRegisterSyscacheCallback(metadata_caches[i],
-									  &mdsyscache_invalidation_counter_callback,
+									  &mdsyscache_invalidation_callback,
 									  (Datum) 0);
 	}
 
 	/* also register the relcache callback */
-	CacheRegisterRelcacheCallback(&mdrelcache_invalidation_counter_callback,
+	CacheRegisterRelcacheCallback(&mdrelcache_invalidation_callback,
 								  (Datum) 0);
 }
 
-// Has there been any catalog changes since last call?
+/*
+ * Add a relation whose relation entry is stale, along with the entries
+ * derived from it. For a leaf partition, the entry of its partitioned table,
+ * which describes all partitions, is stale too.
+ */
+static void
+add_stale_relation(gpdb::SMDCacheInvalidations *pmdinval, Oid relid)
+{
+	if (list_member_oid(pmdinval->m_plRelOids, relid))
+		return;
+
+	/*
+	 * The optimizer keys column stats by column position, which we can't
+	 * tell from the attribute number, so all columns (including system
+	 * columns) of the relation are stale.
+	 */
+	pmdinval->m_plRelOids = lappend_oid(pmdinval->m_plRelOids, relid);
+	/* catalog tables: pg_class */
+	pmdinval->m_plRelNumCols = lappend_int(pmdinval->m_plRelNumCols,
+										   get_relnatts(relid) - FirstLowInvalidHeapAttributeNumber);
+
+	/*
+	 * Triggers and check constraints are cached as objects of their own, and
+	 * their changes are only reported as relcache events of the relation.
+	 */
+	/* catalog tables: pg_trigger */
+	pmdinval->m_plRelMemberOids = list_concat_unique_oid(pmdinval->m_plRelMemberOids,
+														 get_trigger_oids(relid));
+	/* catalog tables: pg_constraint */
+	pmdinval->m_plRelMemberOids = list_concat_unique_oid(pmdinval->m_plRelMemberOids,
+														 get_check_constraint_oids(relid));
+
+	/* catalog tables: pg_partition, pg_partition_rule */
+	if (rel_is_child_partition(relid))
+	{
+		Oid			masteroid = rel_partition_get_master(relid);
+
+		if (OidIsValid(masteroid))
+			add_stale_relation(pmdinval, masteroid);
+	}
+}
+
+static int
+mdcache_object_invalidation_cmp(const void *a, const void *b)
+{
+	const MDCacheObjectInvalidation *inva = (const MDCacheObjectInvalidation *) a;
+	const MDCacheObjectInvalidation *invb = (const MDCacheObjectInvalidation *) b;
+
+	if (inva->cacheid != invb->cacheid)
+		return (inva->cacheid < invb->cacheid) ? -1 : 1;
+	if (inva->hashValue != invb->hashValue)
+		return (inva->hashValue < invb->hashValue) ? -1 : 1;
+	return 0;
+}
+
+/*
+ * Add the cached objects that the pending syscache events are about. They
+ * are forgotten until they are fetched again.
+ */
+static void
+add_stale_objects(gpdb::SMDCacheInvalidations *pmdinval)
+{
+	MDCacheObjectInvalidation *invs;
+	int			ninvs = mdcache_num_pending_object_invalidations;
+	int			cacheids[lengthof(mdcache_object_caches)];
+	int			ncacheids = 0;
+	HASH_SEQ_STATUS status;
+	Oid		   *poid;
+	int			i;
+
+	/*
+	 * Computing the hash values may initialize the syscaches, which can
+	 * process more invalidation messages, so work on a copy.
+	 */
+	invs = (MDCacheObjectInvalidation *) palloc(ninvs * sizeof(MDCacheObjectInvalidation));
+	memcpy(invs, mdcache_pending_object_invalidations, ninvs * sizeof(MDCacheObjectInvalidation));
+	mdcache_num_pending_object_invalidations = 0;
+
+	qsort(invs, ninvs, sizeof(MDCacheObjectInvalidation), mdcache_object_invalidation_cmp);
+	for (i = 0; i < ninvs; i++)
+	{
+		if (ncacheids == 0 || cacheids[ncacheids - 1] != invs[i].cacheid)
+			cacheids[ncacheids++] = invs[i].cacheid;
+	}
+
+	if (mdcache_objects != NULL)
+	{
+		hash_seq_init(&status, mdcache_objects);
+		while ((poid = (Oid *) hash_seq_search(&status)) != NULL)
+		{
+			Oid			oid = *poid;
+
+			for (i = 0; i < ncacheids; i++)
+			{
+				MDCacheObjectInvalidation key;
+
+				key.cacheid = cacheids[i];
+				key.hashValue = GetSysCacheHashValue1(key.cacheid, ObjectIdGetDatum(oid));
+				if (bsearch(&key, invs, ninvs, sizeof(MDCacheObjectInvalidation),
+							mdcache_object_invalidation_cmp) == NULL)
+					continue;
+
+				if (key.cacheid == OPEROID)
+					mdcache_reset_pending = true;
+
+				pmdinval->m_plObjOids = lappend_oid(pmdinval->m_plObjOids, oid);
+				/* removing the entry just returned doesn't disturb the scan */
+				hash_search(mdcache_objects, &oid, HASH_REMOVE, NULL);
+				break;
+			}
+		}
+	}
+
+	pfree(invs);
+}
+
+void
+gpdb::MDCacheNoteObject
+	(
+	Oid oid
+	)
+{
+	GP_WRAP_START;
+	{
+		if (mdcache_objects == NULL)
+		{
+			HASHCTL		ctl;
+
+			MemSet(&ctl, 0, sizeof(ctl));
+			ctl.keysize = sizeof(Oid);
+			ctl.entrysize = sizeof(Oid);
+			ctl.hash = oid_hash;
+			mdcache_objects = hash_create("ORCA metadata cache objects", 256, &ctl,
+										  HASH_ELEM | HASH_FUNCTION);
+		}
+
+		(void) hash_search(mdcache_objects, &oid, HASH_ENTER, NULL);
+		return;
+	}
+	GP_WRAP_END;
+}
+
+// Collect the catalog objects changed since last call; has there been any
+// change that requires resetting the whole cache?
 bool
 gpdb::FMDCacheNeedsReset
 		(
-			void
+			SMDCacheInvalidations *pmdinval
 		)
 {
 	GP_WRAP_START;
 	{
-		if (!mdcache_invalidation_counter_registered)
+		bool		reset;
+		int			i;
+
+		if (!mdcache_invalidation_callbacks_registered)
 		{
 			register_mdcache_invalidation_callbacks();
-			mdcache_invalidation_counter_registered = true;
+			mdcache_invalidation_callbacks_registered = true;
 		}
-		if (last_mdcache_invalidation_counter == mdcache_invalidation_counter)
-			return false;
-		else
+
+		memset(pmdinval, 0, sizeof(*pmdinval));
+
+		/* If resolving failed last time, don't try again */
+		if (mdcache_resolving_invalidations)
+			mdcache_reset_pending = true;
+		mdcache_resolving_invalidations = true;
+
+		/*
+		 * Looking at the catalogs may process more invalidation messages,
+		 * which are appended to the arrays and resolved in this loop too.
+		 */
+		i = 0;
+		while (!mdcache_reset_pending &&
+			   (i < mdcache_num_pending_invalidations ||
+				mdcache_num_pending_object_invalidations > 0))
 		{
-			last_mdcache_invalidation_counter = mdcache_invalidation_counter;
-			return true;
+			if (i < mdcache_num_pending_invalidations)
+				add_stale_relation(pmdinval, mdcache_pending_invalidations[i++]);
+			else
+				add_stale_objects(pmdinval);
+		}
+
+		reset = mdcache_reset_pending;
+		mdcache_reset_pending = false;
+		mdcache_num_pending_invalidations = 0;
+		mdcache_num_pending_object_invalidations = 0;
+		mdcache_resolving_invalidations = false;
+
+		/* the objects fetched from now on will be tracked afresh */
+		if (reset && mdcache_objects != NULL)
+		{
+			hash_destroy(mdcache_objects);
+			mdcache_objects = NULL;
 		}
+
+		return reset;
 	}
 	GP_WRAP_END;
 
 	return true;
 }
 
+bool
+gpdb::FMDSharedCacheUsable(void)
+{
+	GP_WRAP_START;
+	{
+		return MDSharedCacheIsUsable();
+	}
+	GP_WRAP_END;
+	return false;
+}
+
+uint64
+gpdb::UllMDSharedCacheGeneration(void)
+{
+	GP_WRAP_START;
+	{
+		return MDSharedCacheGeneration();
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
+void *
+gpdb::PvMDSharedCacheLookup
+	(
+	const char *szMDId,
+	Size *pulLen
+	)
+{
+	GP_WRAP_START;
+	{
+		return MDSharedCacheLookup(szMDId, pulLen);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
+bool
+gpdb::FMDSharedCacheInsert
+	(
+	const char *szMDId,
+	Oid oidRel,
+	bool fPartitioned,
+	const void *pv,
+	Size ulLen,
+	uint64 ullGeneration
+	)
+{
+	GP_WRAP_START;
+	{
+		return MDSharedCacheInsert(szMDId, oidRel, fPartitioned, pv, ulLen, ullGeneration);
+	}
+	GP_WRAP_END;
+	return false;
+}
+
+PlannedStmt *
+gpdb::PplstmtOptPlanCacheLookup
+	(
+	const char *szFingerprint
+	)
+{
+	GP_WRAP_START;
+	{
+		return OptPlanCacheLookup(szFingerprint);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
+void
+gpdb::OptPlanCacheInsert
+	(
+	const char *szFingerprint,
+	Query *pquery,
+	PlannedStmt *pplstmt
+	)
+{
+	GP_WRAP_START;
+	{
+		::OptPlanCacheInsert(szFingerprint, pquery, pplstmt);
+		return;
+	}
+	GP_WRAP_END;
+}
+
+void
+gpdb::OptPlanCacheInvalidate
+	(
+	List *plRelOids
+	)
+{
+	GP_WRAP_START;
+	{
+		::OptPlanCacheInvalidate(plRelOids);
+		return;
+	}
+	GP_WRAP_END;
+}
+
+void
+gpdb::OptPlanCacheReset(void)
+{
+	GP_WRAP_START;
+	{
+		::OptPlanCacheReset();
+		return;
+	}
+	GP_WRAP_END;
+}
+
+void *
+gpdb::PvOptStatsCacheLookup
+	(
+	Oid relid,
+	AttrNumber attnum,
+	HeapTuple htStats,
+	float4 fRelTuples,
+	Size *pulLen
+	)
+{
+	GP_WRAP_START;
+	{
+		return OptStatsCacheLookup(relid, attnum, htStats, fRelTuples, pulLen);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
+void
+gpdb::OptStatsCacheInsert
+	(
+	Oid relid,
+	AttrNumber attnum,
+	HeapTuple htStats,
+	float4 fRelTuples,
+	const void *pv,
+	Size ulLen
+	)
+{
+	GP_WRAP_START;
+	{
+		::OptStatsCacheInsert(relid, attnum, htStats, fRelTuples, pv, ulLen);
+		return;
+	}
+	GP_WRAP_END;
+}
+
+List *
+gpdb::PlOptimizerCostParams()
+{
+	GP_WRAP_START;
+	{
+		return GetOptimizerCostParams();
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
 // EOF
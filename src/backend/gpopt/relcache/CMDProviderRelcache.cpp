@@ -17,11 +17,16 @@
 #include "postgres.h"
 #include "gpopt/relcache/CMDProviderRelcache.h"
 #include "gpopt/translate/CTranslatorRelcacheToDXL.h"
+#include "gpopt/translate/CTranslatorUtils.h"
+#include "gpopt/gpdbwrappers.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 
 #include "gpos/io/COstreamString.h"
 
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
 
 #include "naucrates/exception.h"
 
@@ -47,12 +52,91 @@ CMDProviderRelcache::CMDProviderRelcache
 	GPOS_ASSERT(NULL != m_pmp);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderRelcache::OidSharedCacheRel
+//
+//	@doc:
+//		Returns the relation whose changes make the given object stale in
+//		the metadata cache shared by all backends, or InvalidOid if only
+//		changes to other catalogs do. Objects of partitioned tables are
+//		translated from all partitions, and indexes of partitioned tables
+//		from the indexes of the partitions, so *pfPartitioned tells that
+//		changes to any relation make them stale.
+//
+//---------------------------------------------------------------------------
+OID
+CMDProviderRelcache::OidSharedCacheRel
+	(
+	IMDId *pmdid,
+	BOOL *pfPartitioned
+	)
+{
+	OID oidRel = InvalidOid;
+
+	switch (pmdid->Emdidt())
+	{
+		case IMDId::EmdidGPDB:
+		{
+			OID oid = CMDIdGPDB::PmdidConvert(pmdid)->OidObjectId();
+
+			if (gpdb::FIndexExists(oid))
+			{
+				*pfPartitioned = true;
+				return oid;
+			}
+
+			// triggers and check constraints change along with their relation
+			if (gpdb::FTriggerExists(oid))
+			{
+				oidRel = gpdb::OidTriggerRelid(oid);
+			}
+			else if (gpdb::FCheckConstraintExists(oid))
+			{
+				oidRel = gpdb::OidCheckConstraintRelid(oid);
+			}
+			else if (gpdb::FRelationExists(oid))
+			{
+				oidRel = oid;
+			}
+			else
+			{
+				// types, functions, operators and aggregates
+				*pfPartitioned = false;
+				return InvalidOid;
+			}
+			break;
+		}
+
+		case IMDId::EmdidRelStats:
+			oidRel = CMDIdGPDB::PmdidConvert(CMDIdRelStats::PmdidConvert(pmdid)->PmdidRel())->OidObjectId();
+			break;
+
+		case IMDId::EmdidColStats:
+			oidRel = CMDIdGPDB::PmdidConvert(CMDIdColStats::PmdidConvert(pmdid)->PmdidRel())->OidObjectId();
+			break;
+
+		default:
+			// casts and comparisons
+			*pfPartitioned = false;
+			return InvalidOid;
+	}
+
+	*pfPartitioned = gpdb::FRelPartIsRoot(oidRel) || gpdb::FRelPartIsInterior(oidRel);
+
+	return oidRel;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDProviderRelcache::PstrObject
 //
 //	@doc:
-//		Returns the DXL of the requested object in the provided memory pool
+//		Returns the DXL of the requested object in the provided memory pool.
+//		Objects already translated by another backend are taken from the
+//		metadata cache shared by all backends, and newly translated objects
+//		are added to it. Objects cached under their own oid are noted for
+//		the invalidation of the backend's metadata cache
 //
 //---------------------------------------------------------------------------
 CWStringBase *
@@ -64,6 +148,40 @@ CMDProviderRelcache::PstrObject
 	)
 	const
 {
+	// let the invalidation of the metadata cache tell changes to this
+	// object from changes to objects that aren't cached
+	if (IMDId::EmdidGPDB == pmdid->Emdidt())
+	{
+		gpdb::MDCacheNoteObject(CMDIdGPDB::PmdidConvert(pmdid)->OidObjectId());
+	}
+
+	BOOL fShared = gpdb::FMDSharedCacheUsable();
+	CHAR *szMDId = NULL;
+	uint64 ullGeneration = 0;
+
+	if (fShared)
+	{
+		szMDId = CTranslatorUtils::SzFromWsz(pmdid->Wsz());
+
+		Size ulLen = 0;
+		WCHAR *wszCached = (WCHAR *) gpdb::PvMDSharedCacheLookup(szMDId, &ulLen);
+		if (NULL != wszCached)
+		{
+			// the cached string includes the terminating null
+			GPOS_ASSERT(0 == ulLen % GPOS_SIZEOF(WCHAR));
+			CWStringDynamic *pstr = GPOS_NEW(m_pmp) CWStringDynamic(m_pmp, wszCached);
+
+			gpdb::GPDBFree(wszCached);
+			gpdb::GPDBFree(szMDId);
+
+			return pstr;
+		}
+
+		// objects changed while we translate must not be cached; this also
+		// brings our own caches up to date with the current generation
+		ullGeneration = gpdb::UllMDSharedCacheGeneration();
+	}
+
 	IMDCacheObject *pimdobj = CTranslatorRelcacheToDXL::Pimdobj(pmp, pmda, pmdid);
 
 	GPOS_ASSERT(NULL != pimdobj);
@@ -73,6 +191,23 @@ CMDProviderRelcache::PstrObject
 	// cleanup DXL object
 	pimdobj->Release();
 
+	if (fShared)
+	{
+		BOOL fPartitioned = false;
+		OID oidRel = OidSharedCacheRel(pmdid, &fPartitioned);
+
+		(void) gpdb::FMDSharedCacheInsert
+						(
+						szMDId,
+						oidRel,
+						fPartitioned,
+						pstr->Wsz(),
+						(pstr->UlLength() + 1) * GPOS_SIZEOF(WCHAR),
+						ullGeneration
+						);
+		gpdb::GPDBFree(szMDId);
+	}
+
 	return pstr;
 }
 
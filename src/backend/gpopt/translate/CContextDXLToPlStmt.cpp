@@ -53,7 +53,8 @@ CContextDXLToPlStmt::CContextDXLToPlStmt
 	m_pplSubPlan(plSubPlan),
 	m_ulResultRelation(0),
 	m_pintocl(NULL),
-	m_pdistrpolicy(NULL)
+	m_pdistrpolicy(NULL),
+	m_pbmsPlanIdsWithParams(NULL)
 {
 	m_phmuldxltrctxSharedScan = GPOS_NEW(m_pmp) HMUlDxltrctx(m_pmp);
 	m_phmulcteconsumerinfo = GPOS_NEW(m_pmp) HMUlCTEConsumerInfo(m_pmp);
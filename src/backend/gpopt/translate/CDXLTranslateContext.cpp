@@ -45,22 +45,28 @@ CDXLTranslateContext::CDXLTranslateContext
 //		CDXLTranslateContext::CDXLTranslateContext
 //
 //	@doc:
-//		Ctor
+//		Ctor. The params hashmap of the parent context is shared until one of
+//		the contexts inserts a new param mapping, see FInsertParamMapping.
+//		Building a private copy of it for every plan node made translating
+//		plans with many nodes, such as appends over thousands of partitions,
+//		quadratic in the number of nodes. The size hint is the expected number
+//		of target entry mappings in the context.
 //
 //---------------------------------------------------------------------------
 CDXLTranslateContext::CDXLTranslateContext
 	(
 	IMemoryPool *pmp,
 	BOOL fChildAggNode,
-	HMColParam *phmOriginal
+	HMColParam *phmOriginal,
+	ULONG ulSize
 	)
 	:
 	m_pmp(pmp),
 	m_fChildAggNode(fChildAggNode)
 {
-	m_phmulte = GPOS_NEW(m_pmp) HMUlTe(m_pmp);
-	m_phmcolparam = GPOS_NEW(m_pmp) HMColParam(m_pmp);
-	CopyParamHashmap(phmOriginal);
+	m_phmulte = GPOS_NEW(m_pmp) HMUlTe(m_pmp, ulSize);
+	phmOriginal->AddRef();
+	m_phmcolparam = phmOriginal;
 }
 
 //---------------------------------------------------------------------------
@@ -96,15 +102,15 @@ CDXLTranslateContext::FParentAggNode() const
 //		CDXLTranslateContext::CopyParamHashmap
 //
 //	@doc:
-//		copy the params hashmap
+//		replace the shared params hashmap with a private copy of it
 //
 //---------------------------------------------------------------------------
 void
-CDXLTranslateContext::CopyParamHashmap
-	(
-	HMColParam *phmOriginal
-	)
+CDXLTranslateContext::CopyParamHashmap()
 {
+	HMColParam *phmOriginal = m_phmcolparam;
+	m_phmcolparam = GPOS_NEW(m_pmp) HMColParam(m_pmp);
+
 	// iterate over full map
 	HMColParamIter hashmapiter(phmOriginal);
 	while (hashmapiter.FAdvance())
@@ -116,6 +122,8 @@ CDXLTranslateContext::CopyParamHashmap
 		pmecolidparamid->AddRef();
 		m_phmcolparam->FInsert(pulKey, pmecolidparamid);
 	}
+
+	phmOriginal->Release();
 }
 
 //---------------------------------------------------------------------------
@@ -196,6 +204,12 @@ CDXLTranslateContext::FInsertParamMapping
 	CMappingElementColIdParamId *pmecolidparamid
 	)
 {
+	if (1 < m_phmcolparam->UlRefCount())
+	{
+		// params hashmap is shared with other contexts, copy it before modifying
+		CopyParamHashmap();
+	}
+
 	// copy key
 	ULONG *pulKey = GPOS_NEW(m_pmp) ULONG(ulColId);
 
@@ -26,6 +26,7 @@
 #include "utils/lsyscache.h"
 #include "utils/uri.h"
 #include "gpos/base.h"
+#include "gpos/common/CAutoTimer.h"
 
 #include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/translate/CTranslatorDXLToPlStmt.h"
@@ -43,6 +44,7 @@
 #include "naucrates/md/IMDTypeInt4.h"
 #include "naucrates/md/IMDIndex.h"
 #include "naucrates/md/IMDRelationExternal.h"
+#include "naucrates/traceflags/traceflags.h"
 
 #include "gpopt/gpdbwrappers.h"
 
@@ -217,6 +219,8 @@ CTranslatorDXLToPlStmt::PplstmtFromDXL
 {
 	GPOS_ASSERT(NULL != pdxln);
 
+	CAutoTimer at("\n[OPT]: DXL To PlStmt Translation Time", GPOS_FTRACE(EopttracePrintOptStats));
+
 	CDXLTranslateContext dxltrctx(m_pmp, false);
 
 	DrgPdxltrctx *pdrgpdxltrctxPrevSiblings = GPOS_NEW(m_pmp) DrgPdxltrctx(m_pmp);
@@ -445,26 +449,40 @@ CTranslatorDXLToPlStmt::SetInitPlanSliceInformation(SubPlan * psubplan)
 //		CTranslatorDXLToPlStmt::SetParamIds
 //
 //	@doc:
-//		Set the bitmapset with the param_ids defined in the plan
+//		Set the bitmapset with the param_ids defined in the plan. Plans are
+//		translated bottom-up, so the param ids of the child plans have
+//		already been set and are reused instead of walking their subtrees.
+//		This relies on a plan node not being changed once its param ids are
+//		set: a Param added to a child afterwards would be missed by all of
+//		its ancestors. Debug builds check the result against a full walk.
 //
 //---------------------------------------------------------------------------
 void
 CTranslatorDXLToPlStmt::SetParamIds(Plan* pplan)
 {
+	Bitmapset *pbitmapset = gpdb::PbmsExtractParamIdsPlan(pplan, m_pctxdxltoplstmt->PbmsPlanIdsWithParams());
+
+#ifdef GPOS_DEBUG
 	List *plParams = gpdb::PlExtractNodesPlan(pplan, T_Param, true);
 
 	ListCell *plc = NULL;
-
-	Bitmapset  *pbitmapset = NULL;
-
+	Bitmapset *pbitmapsetFull = NULL;
 	ForEach (plc, plParams)
 	{
 		Param *pparam = (Param*) lfirst(plc);
-		pbitmapset = gpdb::PbmsAddMember(pbitmapset, pparam->paramid);
+		pbitmapsetFull = gpdb::PbmsAddMember(pbitmapsetFull, pparam->paramid);
 	}
+	GPOS_ASSERT(gpdb::FBmsEqual(pbitmapset, pbitmapsetFull) && "plan node changed after its param ids were set");
+#endif
 
 	pplan->extParam = pbitmapset;
 	pplan->allParam = pbitmapset;
+
+	// plan nodes added without a plan id are walked again by their parents
+	if (0 < pplan->plan_node_id)
+	{
+		m_pctxdxltoplstmt->AddPlanWithParams(pplan->plan_node_id);
+	}
 }
 
 
@@ -3564,8 +3582,14 @@ CTranslatorDXLToPlStmt::PappendFromDXLAppend
 	pplan->nMotionNodes = 0;
 	pappend->appendplans = NIL;
 	
-	// translate children
-	CDXLTranslateContext dxltrctxChild(m_pmp, false, pdxltrctxOut->PhmColParam());
+	CDXLNode *pdxlnPrL = (*pdxlnAppend)[EdxlappendIndexProjList];
+	CDXLNode *pdxlnFilter = (*pdxlnAppend)[EdxlappendIndexFilter];
+
+	// translate children; all of them map their output columns in the same
+	// context, so size its hash map for the columns of every child, or lookups
+	// degrade into long chain walks for appends over thousands of partitions
+	const ULONG ulMappings = (ulArity - EdxlappendIndexFirstChild) * (pdxlnPrL->UlArity() + 1);
+	CDXLTranslateContext dxltrctxChild(m_pmp, false, pdxltrctxOut->PhmColParam(), ulMappings);
 	for (ULONG ul = EdxlappendIndexFirstChild; ul < ulArity; ul++)
 	{
 		CDXLNode *pdxlnChild = (*pdxlnAppend)[ul];
@@ -3578,9 +3602,6 @@ CTranslatorDXLToPlStmt::PappendFromDXLAppend
 		pplan->nMotionNodes += pplanChild->nMotionNodes;
 	}
 
-	CDXLNode *pdxlnPrL = (*pdxlnAppend)[EdxlappendIndexProjList];
-	CDXLNode *pdxlnFilter = (*pdxlnAppend)[EdxlappendIndexFilter];
-
 	pplan->targetlist = NIL;
 	const ULONG ulLen = pdxlnPrL->UlArity();
 	for (ULONG ul = 0; ul < ulLen; ++ul)
@@ -5674,6 +5695,32 @@ CTranslatorDXLToPlStmt::JtFromEdxljt
 	return jt;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToPlStmt::AppendSettings
+//
+//	@doc:
+//		Append the settings read while translating a DXL plan to a string.
+//		A plan cached by its query fingerprint is only reusable if they did
+//		not change, so every GUC the translator reads must be listed here
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToPlStmt::AppendSettings
+	(
+	CWStringDynamic *pstr
+	)
+{
+	pstr->AppendFormat
+			(
+			GPOS_WSZ_LIT(" %d %d %d %d"),
+			optimizer_direct_dispatch,
+			optimizer_static_partition_selection,
+			gp_external_max_segs,
+			gp_external_enable_exec
+			);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorDXLToPlStmt::PplanCTAS
@@ -29,6 +29,8 @@
 #define ALLOW_list_head
 #define ALLOW_abort
 
+#include <algorithm>
+
 #include "postgres.h"
 #include "utils/array.h"
 #include "utils/rel.h"
@@ -2274,7 +2276,8 @@ CTranslatorRelcacheToDXL::PimdobjColStats
 	AttrNumber attrnum = (AttrNumber) pmdcol->IAttno();
 
 	// number of rows from pg_class
-	CDouble dRows(rel->rd_rel->reltuples);
+	float4 fRelTuples = rel->rd_rel->reltuples;
+	CDouble dRows(fRelTuples);
 
 	// extract column name and type
 	CMDName *pmdnameCol = GPOS_NEW(pmp) CMDName(pmp, pmdcol->Mdname().Pstr());
@@ -2321,7 +2324,61 @@ CTranslatorRelcacheToDXL::PimdobjColStats
 
 		return CDXLColStats::PdxlcolstatsDummy(pmp, pmdidColStats, pmdnameCol, dWidth);
 	}
+	pdrgpdxlbucket->Release();
+
+	CMDIdGPDB *pmdidAttType = GPOS_NEW(pmp) CMDIdGPDB(oidAttType);
+	IMDType *pmdtype = Pmdtype(pmp, pmdidAttType);
+
+	// reuse the statistics translated from the same version of the pg_statistic row
+	Size ulCachedSize = 0;
+	const BYTE *pba = (const BYTE *) gpdb::PvOptStatsCacheLookup(oidRelation, attrnum, heaptupleStats, fRelTuples, &ulCachedSize);
+	BYTE *pbaTranslated = NULL;
+	if (NULL == pba)
+	{
+		ULONG ulSize = 0;
+		pbaTranslated = PbaColStats(pmp, pmdtype, pmdrel, pmdcol, heaptupleStats, dRows, &ulSize, NULL /* pphistReference */);
+		gpdb::OptStatsCacheInsert(oidRelation, attrnum, heaptupleStats, fRelTuples, pbaTranslated, ulSize);
+		pba = pbaTranslated;
+	}
+
+	// create col stats object
+	pmdidColStats->AddRef();
+	CDXLColStats *pdxlcolstats = PdxlcolstatsCompact(pmp, pmdtype, pmdidColStats, pmdnameCol, pba);
 
+	if (NULL != pbaTranslated)
+	{
+		GPOS_DELETE_ARRAY(pbaTranslated);
+	}
+	gpdb::FreeHeapTuple(heaptupleStats);
+	pmdtype->Release();
+	pmdidAttType->Release();
+
+	return pdxlcolstats;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::PbaColStats
+//
+//	@doc:
+//		Translate the MCVs and histogram of a pg_statistic row into compact
+//		column statistics
+//
+//---------------------------------------------------------------------------
+BYTE *
+CTranslatorRelcacheToDXL::PbaColStats
+	(
+	IMemoryPool *pmp,
+	const IMDType *pmdtype,
+	const IMDRelation *pmdrel,
+	const IMDColumn *pmdcol,
+	HeapTuple heaptupleStats,
+	CDouble dRows,
+	ULONG *pulSize,
+	CHistogram **pphistReference
+	)
+{
+	OID oidAttType = CMDIdGPDB::PmdidConvert(pmdtype->Pmdid())->OidObjectId();
 
 	Datum	   *pdrgdatumMCVValues = NULL;
 	int			iNumMCVValues = 0;
@@ -2356,13 +2413,11 @@ CTranslatorRelcacheToDXL::PimdobjColStats
 
 	Form_pg_statistic fpsStats = (Form_pg_statistic) GETSTRUCT(heaptupleStats);
 
-	// null frequency and NDV
+	// null frequency
 	CDouble dNullFrequency(0.0);
-	int iNullNDV = 0;
 	if (CStatistics::DEpsilon < fpsStats->stanullfrac)
 	{
 		dNullFrequency = fpsStats->stanullfrac;
-		iNullNDV = 1;
 	}
 
 	// fix mcv and null frequencies (sometimes they can add up to more than 1.0)
@@ -2384,13 +2439,6 @@ CTranslatorRelcacheToDXL::PimdobjColStats
 	}
 	dDistinct = dDistinct.FpCeil();
 
-	// total MCV frequency
-	CDouble dMCFSum = 0.0;
-	for (ULONG ul = 0; ul < iNumMCVValues; ul++)
-	{
-		dMCFSum = dMCFSum + CDouble(pdrgfMCVFrequencies[ul]);
-	}
-
 	// get histogram datums from pg_statistic entry
 	(void) gpdb::FGetAttrStatsSlot
 			(
@@ -2404,72 +2452,286 @@ CTranslatorRelcacheToDXL::PimdobjColStats
 
 	// transform all the bits and pieces from pg_statistic
 	// to a single bucket structure
-	DrgPdxlbucket *pdrgpdxlbucketTransformed =
-			PdrgpdxlbucketTransformStats
+	BYTE *pba = PbaTransformStats
 					(
 					pmp,
-					oidAttType,
+					pmdtype,
+					dWidth,
 					dDistinct,
 					dNullFrequency,
 					pdrgdatumMCVValues,
 					pdrgfMCVFrequencies,
 					ULONG(iNumMCVValues),
 					pdrgdatumHistValues,
-					ULONG(iNumHistValues)
+					ULONG(iNumHistValues),
+					pulSize
 					);
 
-	GPOS_ASSERT(NULL != pdrgpdxlbucketTransformed);
-
-	CDouble dNDVBuckets(0.0);
-	CDouble dFreqBuckets(0.0);
-	const ULONG ulBuckets = pdrgpdxlbucketTransformed->UlLength();
-	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	if (NULL != pphistReference)
 	{
-	   CDXLBucket *pdxlbucket = (*pdrgpdxlbucketTransformed)[ul];
-	   dNDVBuckets = dNDVBuckets + pdxlbucket->DDistinct();
-	   dFreqBuckets = dFreqBuckets + pdxlbucket->DFrequency();
+		*pphistReference = PhistTransformStatsReference
+							(
+							pmp,
+							pmdtype,
+							dDistinct,
+							dNullFrequency,
+							pdrgdatumMCVValues,
+							pdrgfMCVFrequencies,
+							ULONG(iNumMCVValues),
+							pdrgdatumHistValues,
+							ULONG(iNumHistValues)
+							);
 	}
 
-	// there will be remaining tuples if the merged histogram and the NULLS do not cover
-	// the total number of distinct values
-	CDouble dDistinctRemain(0.0);
-	CDouble dFreqRemain(0.0);
+	// free up allocated datum and float4 arrays
+	gpdb::FreeAttrStatsSlot(oidAttType, pdrgdatumMCVValues, iNumMCVValues, pdrgfMCVFrequencies, iNumMCVFrequencies);
+	gpdb::FreeAttrStatsSlot(oidAttType, pdrgdatumHistValues, iNumHistValues, NULL, 0);
+
+	return pba;
+}
 
- 	if ((1 - CStatistics::DEpsilon > dFreqBuckets + dNullFrequency) &&
-	 	(0 < dDistinct - dNDVBuckets - iNullNDV))
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::PdxlcolstatsCompact
+//
+//	@doc:
+//		Create a column stats object from compact column statistics
+//
+//---------------------------------------------------------------------------
+CDXLColStats *
+CTranslatorRelcacheToDXL::PdxlcolstatsCompact
+	(
+	IMemoryPool *pmp,
+	const IMDType *pmdtype,
+	CMDIdColStats *pmdidColStats,
+	CMDName *pmdnameCol,
+	const BYTE *pba
+	)
+{
+	const SColStatsCompact *pcs = (const SColStatsCompact *) pba;
+	const SColStatsCompactBucket *rgbucket = (const SColStatsCompactBucket *)
+			(pba + MAXALIGN(sizeof(SColStatsCompact)));
+	const SColStatsCompactValue *rgvalue = (const SColStatsCompactValue *)
+			((const BYTE *) rgbucket + MAXALIGN(pcs->m_ulBuckets * sizeof(SColStatsCompactBucket)));
+
+	// adjacent buckets share their boundaries, and an MCV bounds up to three
+	// buckets, so every boundary value is translated once and shared
+	CDXLDatum **rgpdxldatumValue = GPOS_NEW_ARRAY(pmp, CDXLDatum *, pcs->m_ulValues + 1);
+	for (ULONG ul = 0; ul < pcs->m_ulValues; ul++)
 	{
- 		dDistinctRemain = std::max(CDouble(0.0), (dDistinct - dNDVBuckets - iNullNDV));
- 		dFreqRemain = std::max(CDouble(0.0), (1 - dFreqBuckets - dNullFrequency));
+		rgpdxldatumValue[ul] = NULL;
 	}
 
-	CUtils::AddRefAppend(pdrgpdxlbucket, pdrgpdxlbucketTransformed);
-
-	// free up allocated datum and float4 arrays
-	gpdb::FreeAttrStatsSlot(oidAttType, pdrgdatumMCVValues, iNumMCVValues, pdrgfMCVFrequencies, iNumMCVFrequencies);
-	gpdb::FreeAttrStatsSlot(oidAttType, pdrgdatumHistValues, iNumHistValues, NULL, 0);
+	DrgPdxlbucket *pdrgpdxlbucket = GPOS_NEW(pmp) DrgPdxlbucket(pmp);
+	for (ULONG ul = 0; ul < pcs->m_ulBuckets; ul++)
+	{
+		const SColStatsCompactBucket *pbucket = &rgbucket[ul];
+		CDXLDatum *rgpdxldatum[2];
+		const ULONG rgulBound[2] = {pbucket->m_ulLower, pbucket->m_ulUpper};
 
-	gpdb::FreeHeapTuple(heaptupleStats);
+		for (ULONG ulBound = 0; ulBound < 2; ulBound++)
+		{
+			ULONG ulValue = rgulBound[ulBound];
+			if (NULL == rgpdxldatumValue[ulValue])
+			{
+				const SColStatsCompactValue *pvalue = &rgvalue[ulValue];
+				Datum datum = DatumCompactValue(pmdtype, pba, pvalue);
+				rgpdxldatumValue[ulValue] = CTranslatorScalarToDXL::Pdxldatum(pmp, pmdtype, false /* fNull */, pvalue->m_ulLen, datum);
+			}
 
-	pdrgpdxlbucketTransformed->Release();
+			// the bucket takes its own reference
+			rgpdxldatumValue[ulValue]->AddRef();
+			rgpdxldatum[ulBound] = rgpdxldatumValue[ulValue];
+		}
 
-	// create col stats object
-	pmdidColStats->AddRef();
-	CDXLColStats *pdxlcolstats = GPOS_NEW(pmp) CDXLColStats
+		CDXLBucket *pdxlbucket = GPOS_NEW(pmp) CDXLBucket
 											(
-											pmp,
-											pmdidColStats,
-											pmdnameCol,
-											dWidth,
-											dNullFrequency,
-											dDistinctRemain,
-											dFreqRemain,
-											pdrgpdxlbucket,
-											false /* fColStatsMissing */
+											rgpdxldatum[0],
+											rgpdxldatum[1],
+											pbucket->m_fLowerClosed,
+											pbucket->m_fUpperClosed,
+											CDouble(pbucket->m_dFrequency),
+											CDouble(pbucket->m_dDistinct)
 											);
+		pdrgpdxlbucket->Append(pdxlbucket);
+	}
 
-	return pdxlcolstats;
+	for (ULONG ul = 0; ul < pcs->m_ulValues; ul++)
+	{
+		CRefCount::SafeRelease(rgpdxldatumValue[ul]);
+	}
+	GPOS_DELETE_ARRAY(rgpdxldatumValue);
+
+	return GPOS_NEW(pmp) CDXLColStats
+							(
+							pmp,
+							pmdidColStats,
+							pmdnameCol,
+							CDouble(pcs->m_dWidth),
+							CDouble(pcs->m_dNullFreq),
+							CDouble(pcs->m_dDistinctRemain),
+							CDouble(pcs->m_dFreqRemain),
+							pdrgpdxlbucket,
+							false /* fColStatsMissing */
+							);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::DatumCompactValue
+//
+//	@doc:
+//		Datum of a boundary value of compact column statistics; by-reference
+//		datums point into the compact form
+//
+//---------------------------------------------------------------------------
+Datum
+CTranslatorRelcacheToDXL::DatumCompactValue
+	(
+	const IMDType *pmdtype,
+	const BYTE *pba,
+	const SColStatsCompactValue *pvalue
+	)
+{
+	Datum datum = 0;
+	if (pmdtype->FByValue())
+	{
+		clib::PvMemCpy(&datum, pba + pvalue->m_ulOffset, sizeof(Datum));
+	}
+	else
+	{
+		datum = PointerGetDatum(pba + pvalue->m_ulOffset);
+	}
+
+	return datum;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		FStatsApproxEqual
+//
+//	@doc:
+//		Are a frequency or NDV and the reference one equal, up to rounding
+//
+//---------------------------------------------------------------------------
+static
+BOOL
+FStatsApproxEqual
+	(
+	CDouble d,
+	CDouble dReference
+	)
+{
+	CDouble dDiff = (d > dReference) ? d - dReference : dReference - d;
+	CDouble dScale = (dReference > CDouble(1.0)) ? dReference : CDouble(1.0);
+
+	return dDiff <= CStatistics::DEpsilon * dScale;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::FCheckColStatsMerge
+//
+//	@doc:
+//		Translate the statistics of a column both into the compact form and,
+//		the way the optimizer does it, into a histogram merged by
+//		CStatisticsUtils::PhistMergeMcvHist(), and check that the two have
+//		the same buckets. The differences are appended to the given string
+//
+//---------------------------------------------------------------------------
+BOOL
+CTranslatorRelcacheToDXL::FCheckColStatsMerge
+	(
+	IMemoryPool *pmp,
+	CMDAccessor *pmda,
+	IMDId *pmdid,
+	CWStringDynamic *pstrReport
+	)
+{
+	CMDIdColStats *pmdidColStats = CMDIdColStats::PmdidConvert(pmdid);
+	IMDId *pmdidRel = pmdidColStats->PmdidRel();
+	OID oidRelation = CMDIdGPDB::PmdidConvert(pmdidRel)->OidObjectId();
+
+	const IMDRelation *pmdrel = pmda->Pmdrel(pmdidRel);
+	const IMDColumn *pmdcol = pmdrel->Pmdcol(pmdidColStats->UlPos());
+	const WCHAR *wszCol = pmdcol->Mdname().Pstr()->Wsz();
+
+	Relation rel = gpdb::RelGetRelation(oidRelation);
+	if (NULL == rel)
+	{
+		GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound, pmdid->Wsz());
+	}
+	CDouble dRows(rel->rd_rel->reltuples);
+	gpdb::CloseRelation(rel);
+
+	HeapTuple heaptupleStats = gpdb::HtAttrStats(oidRelation, (AttrNumber) pmdcol->IAttno());
+	if (!HeapTupleIsValid(heaptupleStats))
+	{
+		pstrReport->AppendFormat(GPOS_WSZ_LIT("%ls: no statistics\n"), wszCol);
+		return false;
+	}
+
+	const IMDType *pmdtype = pmda->Pmdtype(pmdcol->PmdidType());
+
+	ULONG ulSize = 0;
+	CHistogram *phistReference = NULL;
+	BYTE *pba = PbaColStats(pmp, pmdtype, pmdrel, pmdcol, heaptupleStats, dRows, &ulSize, &phistReference);
+	gpdb::FreeHeapTuple(heaptupleStats);
+
+	const SColStatsCompact *pcs = (const SColStatsCompact *) pba;
+	const SColStatsCompactBucket *rgbucket = (const SColStatsCompactBucket *)
+			(pba + MAXALIGN(sizeof(SColStatsCompact)));
+	const SColStatsCompactValue *rgvalue = (const SColStatsCompactValue *)
+			((const BYTE *) rgbucket + MAXALIGN(pcs->m_ulBuckets * sizeof(SColStatsCompactBucket)));
+	const DrgPbucket *pdrgpbucket = phistReference->Pdrgpbucket();
+
+	BOOL fMatch = (pcs->m_ulBuckets == pdrgpbucket->UlLength());
+	if (!fMatch)
+	{
+		pstrReport->AppendFormat(GPOS_WSZ_LIT("%ls: %d buckets, expected %d\n"), wszCol, pcs->m_ulBuckets, pdrgpbucket->UlLength());
+	}
+
+	for (ULONG ul = 0; fMatch && ul < pcs->m_ulBuckets; ul++)
+	{
+		const SColStatsCompactBucket *pbucket = &rgbucket[ul];
+		const CBucket *pbucketReference = (*pdrgpbucket)[ul];
+
+		const SColStatsCompactValue *pvalueLower = &rgvalue[pbucket->m_ulLower];
+		const SColStatsCompactValue *pvalueUpper = &rgvalue[pbucket->m_ulUpper];
+		IDatum *pdatumLower = CTranslatorScalarToDXL::Pdatum(pmp, pmdtype, false /* fNull */, DatumCompactValue(pmdtype, pba, pvalueLower));
+		IDatum *pdatumUpper = CTranslatorScalarToDXL::Pdatum(pmp, pmdtype, false /* fNull */, DatumCompactValue(pmdtype, pba, pvalueUpper));
+
+		fMatch = pdatumLower->FStatsEqual(pbucketReference->PpLower()->Pdatum()) &&
+				 pdatumUpper->FStatsEqual(pbucketReference->PpUpper()->Pdatum()) &&
+				 pbucket->m_fLowerClosed == pbucketReference->FLowerClosed() &&
+				 pbucket->m_fUpperClosed == pbucketReference->FUpperClosed() &&
+				 FStatsApproxEqual(CDouble(pbucket->m_dFrequency), pbucketReference->DFrequency()) &&
+				 FStatsApproxEqual(CDouble(pbucket->m_dDistinct), pbucketReference->DDistinct());
+
+		if (!fMatch)
+		{
+			pstrReport->AppendFormat
+						(
+						GPOS_WSZ_LIT("%ls: bucket %d has frequency %f and %f distinct values, expected %f and %f\n"),
+						wszCol,
+						ul,
+						pbucket->m_dFrequency,
+						pbucket->m_dDistinct,
+						pbucketReference->DFrequency().DVal(),
+						pbucketReference->DDistinct().DVal()
+						);
+		}
+
+		pdatumLower->Release();
+		pdatumUpper->Release();
+	}
+
+	GPOS_DELETE(phistReference);
+	GPOS_DELETE_ARRAY(pba);
+
+	return fMatch;
+}
 
 //---------------------------------------------------------------------------
 //      @function:
@@ -2700,31 +2962,422 @@ CTranslatorRelcacheToDXL::PmdobjScCmp
 	return GPOS_NEW(pmp) CMDScCmpGPDB(pmp, pmdid, pmdname, pmdidLeft, pmdidRight, ecmpt, GPOS_NEW(pmp) CMDIdGPDB(oidScCmp));
 }
 
+//---------------------------------------------------------------------------
+//	@class:
+//		CMCVLess
+//
+//	@doc:
+//		Orders the indexes of MCVs by their values
+//
+//---------------------------------------------------------------------------
+class CMCVLess
+{
+	private:
+
+		// translated MCVs
+		IDatum **m_rgpdatum;
+
+	public:
+
+		// ctor
+		explicit
+		CMCVLess
+			(
+			IDatum **rgpdatum
+			)
+			:
+			m_rgpdatum(rgpdatum)
+		{}
+
+		BOOL operator()
+			(
+			ULONG ulLeft,
+			ULONG ulRight
+			)
+			const
+		{
+			return m_rgpdatum[ulLeft]->FStatsLessThan(m_rgpdatum[ulRight]);
+		}
+};
+
 //---------------------------------------------------------------------------
 //	@function:
-//		CTranslatorRelcacheToDXL::PdrgpdxlbucketTransformStats
+//		CTranslatorRelcacheToDXL::PbaTransformStats
 //
 //	@doc:
-//		transform stats from pg_stats form to optimizer's preferred form
+//		Transform stats from pg_stats form to optimizer's preferred form, and
+//		return them in the compact form described at SColStatsCompact.
+//
+//		The MCVs become singleton buckets. They are sorted, and merged into
+//		the histogram in a single pass over both: a histogram bucket that
+//		contains MCVs is split around them, and its frequency and number of
+//		distinct values are divided among the pieces in proportion to their
+//		width. The boundaries of all buckets are the original values from
+//		pg_statistic, so each value is translated only once.
 //
 //---------------------------------------------------------------------------
-DrgPdxlbucket *
-CTranslatorRelcacheToDXL::PdrgpdxlbucketTransformStats
+BYTE *
+CTranslatorRelcacheToDXL::PbaTransformStats
 	(
 	IMemoryPool *pmp,
-	OID oidAttType,
+	const IMDType *pmdtype,
+	CDouble dWidth,
 	CDouble dDistinct,
 	CDouble dNullFreq,
 	const Datum *pdrgdatumMCVValues,
 	const float4 *pdrgfMCVFrequencies,
 	ULONG ulNumMCVValues,
 	const Datum *pdrgdatumHistValues,
-	ULONG ulNumHistValues
+	ULONG ulNumHistValues,
+	ULONG *pulSize
 	)
 {
-	CMDIdGPDB *pmdidAttType = GPOS_NEW(pmp) CMDIdGPDB(oidAttType);
-	IMDType *pmdtype = Pmdtype(pmp, pmdidAttType);
+	// translate every value once; MCVs come first, histogram bounds after them
+	const ULONG ulValues = ulNumMCVValues + ulNumHistValues;
+	IDatum **rgpdatum = GPOS_NEW_ARRAY(pmp, IDatum *, ulValues + 1);
+	const Datum **rgpdatumValue = GPOS_NEW_ARRAY(pmp, const Datum *, ulValues + 1);
+	for (ULONG ul = 0; ul < ulValues; ul++)
+	{
+		rgpdatum[ul] = NULL;
+		rgpdatumValue[ul] = NULL;
+	}
+
+	// if less than operation is not supported on the MCVs, then no point
+	// building a histogram from them
+	BOOL fMCVComparable = true;
+	CDouble dMCVFreq = 0.0;
+	for (ULONG ul = 0; ul < ulNumMCVValues; ul++)
+	{
+		rgpdatumValue[ul] = &pdrgdatumMCVValues[ul];
+		rgpdatum[ul] = CTranslatorScalarToDXL::Pdatum(pmp, pmdtype, false /* fNull */, pdrgdatumMCVValues[ul]);
+		fMCVComparable = fMCVComparable && rgpdatum[ul]->FStatsComparable(rgpdatum[ul]);
+		dMCVFreq = dMCVFreq + CDouble(pdrgfMCVFrequencies[ul]);
+	}
+
+	if (!fMCVComparable)
+	{
+		dMCVFreq = 0.0;
+	}
+	BOOL fHasMCV = fMCVComparable && 0 < ulNumMCVValues && CStatistics::DEpsilon < dMCVFreq;
+
+	CDouble dHistFreq = 0.0;
+	if (1 < ulNumHistValues)
+	{
+		dHistFreq = CDouble(1.0) - dNullFreq - dMCVFreq;
+	}
+	BOOL fHasHist = 1 < ulNumHistValues && CStatistics::DEpsilon < dHistFreq;
+
+	for (ULONG ul = 0; fHasHist && ul < ulNumHistValues; ul++)
+	{
+		ULONG ulValue = ulNumMCVValues + ul;
+		rgpdatumValue[ulValue] = &pdrgdatumHistValues[ul];
+		rgpdatum[ulValue] = CTranslatorScalarToDXL::Pdatum(pmp, pmdtype, false /* fNull */, pdrgdatumHistValues[ul]);
+
+		// if less than operation is not supported on this datum,
+		// or the translated histogram does not conform to GPDB sort order (e.g. text column in Linux platform),
+		// then no point building a histogram
+
+		// TODO: 03/01/2014 translate histogram into Orca even if sort
+		// order is different in GPDB, and use const expression eval to compare
+		// datums in Orca (MPP-22780)
+		if (!rgpdatum[ulValue]->FStatsComparable(rgpdatum[ulValue]) ||
+			(0 < ul && !rgpdatum[ulValue - 1]->FStatsLessThan(rgpdatum[ulValue])))
+		{
+			fHasHist = false;
+		}
+	}
+
+	// sort the MCVs, folding the ones that are equal for the optimizer
+	ULONG *rgulMCV = GPOS_NEW_ARRAY(pmp, ULONG, ulNumMCVValues + 1);
+	DOUBLE *rgdMCVFreq = GPOS_NEW_ARRAY(pmp, DOUBLE, ulNumMCVValues + 1);
+	ULONG ulMCVs = 0;
+	if (fHasMCV)
+	{
+		ULONG *rgulSorted = GPOS_NEW_ARRAY(pmp, ULONG, ulNumMCVValues);
+		for (ULONG ul = 0; ul < ulNumMCVValues; ul++)
+		{
+			rgulSorted[ul] = ul;
+		}
+		std::sort(rgulSorted, rgulSorted + ulNumMCVValues, CMCVLess(rgpdatum));
+
+		for (ULONG ul = 0; ul < ulNumMCVValues; ul++)
+		{
+			ULONG ulMCV = rgulSorted[ul];
+			if (0 < ulMCVs && !rgpdatum[rgulMCV[ulMCVs - 1]]->FStatsLessThan(rgpdatum[ulMCV]))
+			{
+				rgdMCVFreq[ulMCVs - 1] += pdrgfMCVFrequencies[ulMCV];
+				continue;
+			}
+			rgulMCV[ulMCVs] = ulMCV;
+			rgdMCVFreq[ulMCVs] = pdrgfMCVFrequencies[ulMCV];
+			ulMCVs++;
+		}
+		GPOS_DELETE_ARRAY(rgulSorted);
+	}
+
+	// each MCV adds a singleton bucket and splits at most one histogram bucket
+	ULONG ulHistBuckets = fHasHist ? ulNumHistValues - 1 : 0;
+	SColStatsCompactBucket *rgbucket = GPOS_NEW_ARRAY(pmp, SColStatsCompactBucket, ulHistBuckets + 2 * ulMCVs + 1);
+	ULONG ulBuckets = 0;
+	ULONG ulNextMCV = 0;
+
+	CDouble dDistinctPerBucket = 0.0;
+	CDouble dFreqPerBucket = 0.0;
+	if (0 < ulHistBuckets)
+	{
+		dDistinctPerBucket = dDistinct / CDouble(ulHistBuckets);
+		dFreqPerBucket = dHistFreq / CDouble(ulHistBuckets);
+	}
+
+	for (ULONG ulHist = 0; ulHist < ulHistBuckets; ulHist++)
+	{
+		// GPDB histograms assume lower bounds to be closed and upper bounds
+		// to be open, except for the last bucket
+		SColStatsCompactBucket bucket;
+		bucket.m_ulLower = ulNumMCVValues + ulHist;
+		bucket.m_ulUpper = ulNumMCVValues + ulHist + 1;
+		bucket.m_fLowerClosed = true;
+		bucket.m_fUpperClosed = (ulHist == ulHistBuckets - 1);
+		bucket.m_dFrequency = dFreqPerBucket.DVal();
+		bucket.m_dDistinct = dDistinctPerBucket.DVal();
+
+		// MCVs below the bucket
+		while (ulNextMCV < ulMCVs &&
+			   rgpdatum[rgulMCV[ulNextMCV]]->FStatsLessThan(rgpdatum[bucket.m_ulLower]))
+		{
+			rgbucket[ulBuckets++] = BucketSingleton(rgulMCV[ulNextMCV], rgdMCVFreq[ulNextMCV]);
+			ulNextMCV++;
+		}
+
+		// MCVs within the bucket
+		while (ulNextMCV < ulMCVs)
+		{
+			ULONG ulMCV = rgulMCV[ulNextMCV];
+			IDatum *pdatumMCV = rgpdatum[ulMCV];
+			IDatum *pdatumUpper = rgpdatum[bucket.m_ulUpper];
+			if (pdatumUpper->FStatsLessThan(pdatumMCV))
+			{
+				break;
+			}
+
+			if (!pdatumMCV->FStatsLessThan(pdatumUpper))
+			{
+				// the MCV is the upper bound; it is left for after the bucket
+				bucket.m_fUpperClosed = false;
+				break;
+			}
+
+			if (!rgpdatum[bucket.m_ulLower]->FStatsLessThan(pdatumMCV))
+			{
+				// the MCV is the lower bound
+				bucket.m_fLowerClosed = false;
+			}
+			else
+			{
+				// split the bucket at the MCV
+				CDouble dFraction = DBucketFraction(rgpdatum[bucket.m_ulLower], pdatumUpper, pdatumMCV);
+
+				SColStatsCompactBucket bucketBelow = bucket;
+				bucketBelow.m_ulUpper = ulMCV;
+				bucketBelow.m_fUpperClosed = false;
+				bucketBelow.m_dFrequency = (dFraction * CDouble(bucket.m_dFrequency)).DVal();
+				bucketBelow.m_dDistinct = (dFraction * CDouble(bucket.m_dDistinct)).DVal();
+				rgbucket[ulBuckets++] = bucketBelow;
+
+				bucket.m_ulLower = ulMCV;
+				bucket.m_fLowerClosed = false;
+				bucket.m_dFrequency = bucket.m_dFrequency - bucketBelow.m_dFrequency;
+				bucket.m_dDistinct = bucket.m_dDistinct - bucketBelow.m_dDistinct;
+			}
+
+			rgbucket[ulBuckets++] = BucketSingleton(ulMCV, rgdMCVFreq[ulNextMCV]);
+			ulNextMCV++;
+		}
+
+		rgbucket[ulBuckets++] = bucket;
+	}
+
+	// MCVs above the histogram
+	for (; ulNextMCV < ulMCVs; ulNextMCV++)
+	{
+		rgbucket[ulBuckets++] = BucketSingleton(rgulMCV[ulNextMCV], rgdMCVFreq[ulNextMCV]);
+	}
+	GPOS_ASSERT(ulBuckets <= ulHistBuckets + 2 * ulMCVs);
 
+	// there will be remaining tuples if the merged histogram and the NULLS do not cover
+	// the total number of distinct values
+	CDouble dNDVBuckets(0.0);
+	CDouble dFreqBuckets(0.0);
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		dNDVBuckets = dNDVBuckets + CDouble(rgbucket[ul].m_dDistinct);
+		dFreqBuckets = dFreqBuckets + CDouble(rgbucket[ul].m_dFrequency);
+	}
+
+	INT iNullNDV = (CStatistics::DEpsilon < dNullFreq) ? 1 : 0;
+	CDouble dDistinctRemain(0.0);
+	CDouble dFreqRemain(0.0);
+	if ((1 - CStatistics::DEpsilon > dFreqBuckets + dNullFreq) &&
+		(0 < dDistinct - dNDVBuckets - iNullNDV))
+	{
+		dDistinctRemain = std::max(CDouble(0.0), (dDistinct - dNDVBuckets - iNullNDV));
+		dFreqRemain = std::max(CDouble(0.0), (1 - dFreqBuckets - dNullFreq));
+	}
+
+	// lay out the header, the buckets, the boundary value descriptors and
+	// the boundary values; only the values of the used MCVs and histogram
+	// bounds are stored
+	BOOL fByValue = pmdtype->FByValue();
+	INT iTypeLen = fByValue ? (INT) pmdtype->UlLength() : dynamic_cast<const CMDTypeGenericGPDB *>(pmdtype)->ILength();
+	ULONG *rgulLen = GPOS_NEW_ARRAY(pmp, ULONG, ulValues + 1);
+
+	ULONG ulSize = MAXALIGN(sizeof(SColStatsCompact)) +
+				   MAXALIGN(ulBuckets * sizeof(SColStatsCompactBucket)) +
+				   MAXALIGN(ulValues * sizeof(SColStatsCompactValue));
+	for (ULONG ul = 0; ul < ulValues; ul++)
+	{
+		BOOL fUsed = (ul < ulNumMCVValues) ? (0 < ulMCVs) : (0 < ulHistBuckets);
+		rgulLen[ul] = 0;
+		if (fUsed)
+		{
+			rgulLen[ul] = fByValue ? (ULONG) iTypeLen : (ULONG) gpdb::SDatumSize(*rgpdatumValue[ul], false, iTypeLen);
+			ulSize += MAXALIGN(fByValue ? sizeof(Datum) : rgulLen[ul]);
+		}
+	}
+
+	BYTE *pba = GPOS_NEW_ARRAY(pmp, BYTE, ulSize);
+	clib::PvMemSet(pba, 0, ulSize);
+
+	SColStatsCompact *pcs = (SColStatsCompact *) pba;
+	pcs->m_dWidth = dWidth.DVal();
+	pcs->m_dNullFreq = dNullFreq.DVal();
+	pcs->m_dDistinctRemain = dDistinctRemain.DVal();
+	pcs->m_dFreqRemain = dFreqRemain.DVal();
+	pcs->m_ulBuckets = ulBuckets;
+	pcs->m_ulValues = ulValues;
+
+	BYTE *pbaBuckets = pba + MAXALIGN(sizeof(SColStatsCompact));
+	clib::PvMemCpy(pbaBuckets, rgbucket, ulBuckets * sizeof(SColStatsCompactBucket));
+
+	SColStatsCompactValue *rgvalue = (SColStatsCompactValue *)
+			(pbaBuckets + MAXALIGN(ulBuckets * sizeof(SColStatsCompactBucket)));
+	ULONG ulOffset = (ULONG) (((BYTE *) rgvalue) - pba) + MAXALIGN(ulValues * sizeof(SColStatsCompactValue));
+	for (ULONG ul = 0; ul < ulValues; ul++)
+	{
+		rgvalue[ul].m_ulOffset = ulOffset;
+		rgvalue[ul].m_ulLen = rgulLen[ul];
+		if (0 == rgulLen[ul])
+		{
+			continue;
+		}
+
+		if (fByValue)
+		{
+			clib::PvMemCpy(pba + ulOffset, rgpdatumValue[ul], sizeof(Datum));
+			ulOffset += MAXALIGN(sizeof(Datum));
+		}
+		else
+		{
+			clib::PvMemCpy(pba + ulOffset, gpdb::PvPointerFromDatum(*rgpdatumValue[ul]), rgulLen[ul]);
+			ulOffset += MAXALIGN(rgulLen[ul]);
+		}
+	}
+	GPOS_ASSERT(ulOffset == ulSize);
+
+	// cleanup
+	for (ULONG ul = 0; ul < ulValues; ul++)
+	{
+		CRefCount::SafeRelease(rgpdatum[ul]);
+	}
+	GPOS_DELETE_ARRAY(rgpdatum);
+	GPOS_DELETE_ARRAY(rgpdatumValue);
+	GPOS_DELETE_ARRAY(rgulMCV);
+	GPOS_DELETE_ARRAY(rgdMCVFreq);
+	GPOS_DELETE_ARRAY(rgbucket);
+	GPOS_DELETE_ARRAY(rgulLen);
+
+	*pulSize = ulSize;
+	return pba;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::DBucketFraction
+//
+//	@doc:
+//		Fraction of the bucket between the given bounds that lies below the
+//		given value, assuming a uniform distribution within the bucket
+//
+//---------------------------------------------------------------------------
+CDouble
+CTranslatorRelcacheToDXL::DBucketFraction
+	(
+	IDatum *pdatumLower,
+	IDatum *pdatumUpper,
+	IDatum *pdatum
+	)
+{
+	CDouble dWidth = pdatumUpper->DStatsDistance(pdatumLower);
+	if (CStatistics::DEpsilon > dWidth)
+	{
+		return CDouble(0.5);
+	}
+
+	CDouble dFraction = pdatum->DStatsDistance(pdatumLower) / dWidth;
+	return std::min(CDouble(1.0), std::max(CDouble(0.0), dFraction));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::BucketSingleton
+//
+//	@doc:
+//		Singleton bucket of an MCV
+//
+//---------------------------------------------------------------------------
+CTranslatorRelcacheToDXL::SColStatsCompactBucket
+CTranslatorRelcacheToDXL::BucketSingleton
+	(
+	ULONG ulValue,
+	DOUBLE dFrequency
+	)
+{
+	SColStatsCompactBucket bucket;
+	bucket.m_ulLower = ulValue;
+	bucket.m_ulUpper = ulValue;
+	bucket.m_fLowerClosed = true;
+	bucket.m_fUpperClosed = true;
+	bucket.m_dFrequency = dFrequency;
+	bucket.m_dDistinct = 1.0;
+
+	return bucket;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::PhistTransformStatsReference
+//
+//	@doc:
+//		Transform stats from pg_stats form to a histogram by merging the
+//		histograms of the MCVs and of the histogram bounds with
+//		CStatisticsUtils::PhistMergeMcvHist(). PbaTransformStats merges them
+//		in a single pass instead; this is kept to check it against
+//
+//---------------------------------------------------------------------------
+CHistogram *
+CTranslatorRelcacheToDXL::PhistTransformStatsReference
+	(
+	IMemoryPool *pmp,
+	const IMDType *pmdtype,
+	CDouble dDistinct,
+	CDouble dNullFreq,
+	const Datum *pdrgdatumMCVValues,
+	const float4 *pdrgfMCVFrequencies,
+	ULONG ulNumMCVValues,
+	const Datum *pdrgdatumHistValues,
+	ULONG ulNumHistValues
+	)
+{
 	// translate MCVs to Orca histogram. Create an empty histogram if there are no MCVs.
 	CHistogram *phistGPDBMCV = PhistTransformGPDBMCV
 							(
@@ -2764,43 +3417,35 @@ CTranslatorRelcacheToDXL::PdrgpdxlbucketTransformStats
 						);
 	}
 
-	DrgPdxlbucket *pdrgpdxlbucket = NULL;
-
 	if (fHasHist && !fHasMCV)
 	{
 		// if histogram exists and dominates, use histogram only
-		pdrgpdxlbucket = Pdrgpdxlbucket(pmp, pmdtype, phistGPDBHist);
+		GPOS_DELETE(phistGPDBMCV);
+		return phistGPDBHist;
 	}
-	else if (!fHasHist && fHasMCV)
+
+	if (!fHasHist && fHasMCV)
 	{
 		// if MCVs exist and dominate, use MCVs only
-		pdrgpdxlbucket = Pdrgpdxlbucket(pmp, pmdtype, phistGPDBMCV);
+		return phistGPDBMCV;
 	}
-	else if (fHasHist && fHasMCV)
+
+	CHistogram *phist = NULL;
+	if (fHasHist && fHasMCV)
 	{
 		// both histogram and MCVs exist and have significant info, merge MCV and histogram buckets
-		CHistogram *phistMerged = CStatisticsUtils::PhistMergeMcvHist(pmp, phistGPDBMCV, phistGPDBHist);
-		pdrgpdxlbucket = Pdrgpdxlbucket(pmp, pmdtype, phistMerged);
-		GPOS_DELETE(phistMerged);
+		phist = CStatisticsUtils::PhistMergeMcvHist(pmp, phistGPDBMCV, phistGPDBHist);
+		GPOS_DELETE(phistGPDBHist);
 	}
 	else
 	{
 		// no MCVs nor histogram
-		GPOS_ASSERT(!fHasHist && !fHasMCV);
-		pdrgpdxlbucket = GPOS_NEW(pmp) DrgPdxlbucket(pmp);
+		phist = GPOS_NEW(pmp) CHistogram(GPOS_NEW(pmp) DrgPbucket(pmp));
 	}
 
-	// cleanup
-	pmdidAttType->Release();
-	pmdtype->Release();
 	GPOS_DELETE(phistGPDBMCV);
 
-	if (NULL != phistGPDBHist)
-	{
-		GPOS_DELETE(phistGPDBHist);
-	}
-
-	return pdrgpdxlbucket;
+	return phist;
 }
 
 //---------------------------------------------------------------------------
@@ -2928,47 +3573,6 @@ CTranslatorRelcacheToDXL::PhistTransformGPDBHist
 	return phist;
 }
 
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CTranslatorRelcacheToDXL::Pdrgpdxlbucket
-//
-//	@doc:
-//		Histogram to array of dxl buckets
-//
-//---------------------------------------------------------------------------
-DrgPdxlbucket *
-CTranslatorRelcacheToDXL::Pdrgpdxlbucket
-	(
-	IMemoryPool *pmp,
-	const IMDType *pmdtype,
-	const CHistogram *phist
-	)
-{
-	DrgPdxlbucket *pdrgpdxlbucket = GPOS_NEW(pmp) DrgPdxlbucket(pmp);
-	const DrgPbucket *pdrgpbucket = phist->Pdrgpbucket();
-	ULONG ulNumBuckets = pdrgpbucket->UlLength();
-	for (ULONG ul = 0; ul < ulNumBuckets; ul++)
-	{
-		CBucket *pbucket = (*pdrgpbucket)[ul];
-		IDatum *pdatumLB = pbucket->PpLower()->Pdatum();
-		CDXLDatum *pdxldatumLB = pmdtype->Pdxldatum(pmp, pdatumLB);
-		IDatum *pdatumUB = pbucket->PpUpper()->Pdatum();
-		CDXLDatum *pdxldatumUB = pmdtype->Pdxldatum(pmp, pdatumUB);
-		CDXLBucket *pdxlbucket = GPOS_NEW(pmp) CDXLBucket
-											(
-											pdxldatumLB,
-											pdxldatumUB,
-											pbucket->FLowerClosed(),
-											pbucket->FUpperClosed(),
-											pbucket->DFrequency(),
-											pbucket->DDistinct()
-											);
-		pdrgpdxlbucket->Append(pdxlbucket);
-	}
-	return pdrgpdxlbucket;
-}
-
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorRelcacheToDXL::Erelstorage
@@ -101,14 +101,21 @@ CTranslatorUtils::PreloadMD
 
 	CContextPreloadMD ctxpreloadmd(pmp, pmda);
 
-	// find all relations accessed by query and preload their
-	// relstats and colstats
+	// find all relations referenced by the query and the columns used in
+	// its quals, join conditions and grouping, and preload their relstats
+	// and colstats
 	(void) FPreloadMDStatsWalker
 				(
 				(Node *) pquery,
 				&ctxpreloadmd
 				);
 
+	HMIterUlPbs hmiterulpbs(ctxpreloadmd.m_phmulpbsRelAttnos);
+	while (hmiterulpbs.FAdvance())
+	{
+		PreloadMDStats(pmp, pmda, (OID) *(hmiterulpbs.Pk()), hmiterulpbs.Pt());
+	}
+
 	// preload types bool, oid, int2, int4 and int8
 	const IMDType *pmdtypeBool = pmda->PtMDType<IMDTypeBool>(sysid);
 	PreloadMDType(pmda, pmdtypeBool);
@@ -150,12 +157,25 @@ CTranslatorUtils::PreloadMDType
 	const IMDType *pmdtype
 	)
 {
-	(void) pmda->Pmdscop(pmdtype->PmdidCmp(IMDType::EcmptEq));
-	(void) pmda->Pmdscop(pmdtype->PmdidCmp(IMDType::EcmptNEq));
-	(void) pmda->Pmdscop(pmdtype->PmdidCmp(IMDType::EcmptL));
-	(void) pmda->Pmdscop(pmdtype->PmdidCmp(IMDType::EcmptLEq));
-	(void) pmda->Pmdscop(pmdtype->PmdidCmp(IMDType::EcmptG));
-	(void) pmda->Pmdscop(pmdtype->PmdidCmp(IMDType::EcmptGEq));
+	const IMDType::ECmpType rgecmpt[] =
+	{
+		IMDType::EcmptEq,
+		IMDType::EcmptNEq,
+		IMDType::EcmptL,
+		IMDType::EcmptLEq,
+		IMDType::EcmptG,
+		IMDType::EcmptGEq
+	};
+
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgecmpt); ul++)
+	{
+		// not every type has all comparison operators
+		IMDId *pmdidCmp = pmdtype->PmdidCmp(rgecmpt[ul]);
+		if (NULL != pmdidCmp && pmdidCmp->FValid())
+		{
+			(void) pmda->Pmdscop(pmdidCmp);
+		}
+	}
 }
 
 //---------------------------------------------------------------------------
@@ -163,8 +183,9 @@ CTranslatorUtils::PreloadMDType
 //		CTranslatorUtils::FPreloadMDStatsWalker
 //
 //	@doc:
-//		Walks the expression, descends into queries, finds relations
-//		mentioned in the query and preloads column stats for them.
+//		Walks the expression, descends into queries, and collects the
+//		relations mentioned in the query along with the columns whose
+//		statistics are used for cardinality estimation
 //
 //---------------------------------------------------------------------------
 BOOL
@@ -179,37 +200,84 @@ CTranslatorUtils::FPreloadMDStatsWalker
 		return false;
 	}
 
-	if (IsA(pnode, RangeTblEntry))
+	if (IsA(pnode, Var))
 	{
-		RangeTblEntry *prte = (RangeTblEntry *) pnode;
+		Var *pvar = (Var *) pnode;
+		if (!pctxpreloadmd->m_fCollectColumns)
+		{
+			return false;
+		}
+
+		// find the range table of the query the variable belongs to
+		CContextPreloadMD::SRangeTable *prt = pctxpreloadmd->m_prt;
+		for (ULONG ul = 0; NULL != prt && ul < pvar->varlevelsup; ul++)
+		{
+			prt = prt->m_prtParent;
+		}
 
-		// need to exclude views
-		if (prte->rtekind == RTE_RELATION)
+		// system columns have no statistics in pg_statistic
+		if (NULL == prt || 0 > pvar->varattno ||
+			0 >= pvar->varno || (INT) pvar->varno > gpdb::UlListLength(prt->m_plRtable))
 		{
-			PreloadMDStats(pctxpreloadmd->m_pmp, pctxpreloadmd->m_pmda, prte->relid);
+			return false;
 		}
-		else if (prte->rtekind == RTE_SUBQUERY)
+
+		RangeTblEntry *prte = (RangeTblEntry *) gpdb::PvListNth(prt->m_plRtable, pvar->varno - 1);
+		if (RTE_RELATION == prte->rtekind)
 		{
-			gpdb::FWalkQueryOrExpressionTree
-								(
-								(Node *) prte->subquery,
-								(BOOL (*)()) CTranslatorUtils::FPreloadMDStatsWalker,
-								pctxpreloadmd,
-								QTW_EXAMINE_RTES // query tree walker flags
-								);
+			(void) pctxpreloadmd->PbsAttnos(prte->relid)->FExchangeSet((ULONG) pvar->varattno);
+			return false;
+		}
+
+		if (0 == pvar->varattno)
+		{
+			return false;
+		}
+
+		// a column of a join or of a subquery in the from list, such as a
+		// view, needs the statistics of the columns it is computed from
+		CContextPreloadMD::SRangeTable *prtCurrent = pctxpreloadmd->m_prt;
+		BOOL fResult = false;
+		if (RTE_JOIN == prte->rtekind && (INT) pvar->varattno <= gpdb::UlListLength(prte->joinaliasvars))
+		{
+			pctxpreloadmd->m_prt = prt;
+			fResult = FPreloadMDStatsWalker((Node *) gpdb::PvListNth(prte->joinaliasvars, pvar->varattno - 1), pctxpreloadmd);
+		}
+		else if (RTE_SUBQUERY == prte->rtekind && (INT) pvar->varattno <= gpdb::UlListLength(prte->subquery->targetList))
+		{
+			TargetEntry *pte = (TargetEntry *) gpdb::PvListNth(prte->subquery->targetList, pvar->varattno - 1);
+			CContextPreloadMD::SRangeTable rt = {prte->subquery->rtable, prt};
+			pctxpreloadmd->m_prt = &rt;
+			fResult = FPreloadMDStatsWalker((Node *) pte->expr, pctxpreloadmd);
+		}
+		pctxpreloadmd->m_prt = prtCurrent;
+
+		return fResult;
+	}
+
+	if (IsA(pnode, RangeTblEntry))
+	{
+		RangeTblEntry *prte = (RangeTblEntry *) pnode;
+
+		// need to exclude views; subqueries are walked by PreloadMDStatsQuery
+		if (RTE_RELATION == prte->rtekind)
+		{
+			(void) pctxpreloadmd->PbsAttnos(prte->relid);
 		}
 		return false;
 	}
 
 	if (IsA(pnode, Query))
 	{
-		return gpdb::FWalkQueryOrExpressionTree
-					(
-					pnode,
-					(BOOL (*)()) CTranslatorUtils::FPreloadMDStatsWalker,
-					pctxpreloadmd,
-					QTW_EXAMINE_RTES // query tree walker flags
-					);
+		CContextPreloadMD::SRangeTable rt = {((Query *) pnode)->rtable, pctxpreloadmd->m_prt};
+		pctxpreloadmd->m_prt = &rt;
+		BOOL fCollectColumns = pctxpreloadmd->m_fCollectColumns;
+
+		PreloadMDStatsQuery((Query *) pnode, pctxpreloadmd);
+
+		pctxpreloadmd->m_fCollectColumns = fCollectColumns;
+		pctxpreloadmd->m_prt = rt.m_prtParent;
+		return false;
 	}
 
 	return gpdb::FWalkExpressionTree
@@ -220,12 +288,85 @@ CTranslatorUtils::FPreloadMDStatsWalker
 			);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorUtils::PreloadMDStatsExpr
+//
+//	@doc:
+//		Walks the expression, collecting the columns it references only if
+//		they are needed for cardinality estimation
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorUtils::PreloadMDStatsExpr
+	(
+	Node *pnode,
+	CContextPreloadMD *pctxpreloadmd,
+	BOOL fCollectColumns
+	)
+{
+	pctxpreloadmd->m_fCollectColumns = fCollectColumns;
+
+	(void) FPreloadMDStatsWalker(pnode, pctxpreloadmd);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorUtils::PreloadMDStatsQuery
+//
+//	@doc:
+//		Walks the parts of a query whose columns feed cardinality estimation:
+//		the where clause and the join conditions, the grouping and distinct
+//		columns, and the having clause. The remaining parts are only walked
+//		for the relations and the subqueries they reference, as a column
+//		that is merely projected is never looked up in the statistics
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorUtils::PreloadMDStatsQuery
+	(
+	Query *pquery,
+	CContextPreloadMD *pctxpreloadmd
+	)
+{
+	ListCell *plc = NULL;
+	ForEach (plc, pquery->rtable)
+	{
+		RangeTblEntry *prte = (RangeTblEntry *) lfirst(plc);
+		PreloadMDStatsExpr((Node *) prte, pctxpreloadmd, false /*fCollectColumns*/);
+		if (RTE_SUBQUERY == prte->rtekind)
+		{
+			PreloadMDStatsExpr((Node *) prte->subquery, pctxpreloadmd, false /*fCollectColumns*/);
+		}
+	}
+
+	ForEach (plc, pquery->cteList)
+	{
+		CommonTableExpr *pcte = (CommonTableExpr *) lfirst(plc);
+		PreloadMDStatsExpr(pcte->ctequery, pctxpreloadmd, false /*fCollectColumns*/);
+	}
+
+	ForEach (plc, pquery->targetList)
+	{
+		TargetEntry *pte = (TargetEntry *) lfirst(plc);
+		BOOL fGrouping = FGroupingColumn(pte, pquery->groupClause) || FSortingColumn(pte, pquery->distinctClause);
+		PreloadMDStatsExpr((Node *) pte->expr, pctxpreloadmd, fGrouping);
+	}
+
+	// the from list also holds the join conditions
+	PreloadMDStatsExpr((Node *) pquery->jointree, pctxpreloadmd, true /*fCollectColumns*/);
+	PreloadMDStatsExpr(pquery->havingQual, pctxpreloadmd, true /*fCollectColumns*/);
+	PreloadMDStatsExpr(pquery->limitOffset, pctxpreloadmd, false /*fCollectColumns*/);
+	PreloadMDStatsExpr(pquery->limitCount, pctxpreloadmd, false /*fCollectColumns*/);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorUtils::PreloadMDStats
 //
 //	@doc:
-//		Preloads the relstats and column stats for relation
+//		Preloads the relstats and the column stats of the given columns of a
+//		relation, attno 0 standing for all columns
 //
 //---------------------------------------------------------------------------
 void
@@ -233,27 +374,46 @@ CTranslatorUtils::PreloadMDStats
 	(
 	IMemoryPool *pmp,
 	CMDAccessor *pmda,
-	OID oidRelation
+	OID oidRelation,
+	const CBitSet *pbsAttnos
 	)
 {
 	CMDIdGPDB *pmdidgpdbRel = CDXLUtils::Pmdid(pmp, oidRelation);
 
-	// preload column stats
 	const IMDRelation *pmdrelation = pmda->Pmdrel(pmdidgpdbRel);
 
-	for (ULONG ulAttNo = 0; ulAttNo < pmdrelation->UlColumns(); ulAttNo++)
-	{
+	// read the pg_statistic rows of all columns in one scan, instead of one
+	// lookup for each column
+	gpdb::PrefetchAttrStats(oidRelation);
+
+	// preload column stats
+	const BOOL fAllColumns = pbsAttnos->FBit(0);
+	const ULONG ulColumns = pmdrelation->UlColumns();
+	for (ULONG ulPos = 0; ulPos < ulColumns; ulPos++)
+	{
+		const IMDColumn *pmdcol = pmdrelation->Pmdcol(ulPos);
+		INT iAttno = pmdcol->IAttno();
+		if (0 >= iAttno || pmdcol->FDropped() ||
+			!(fAllColumns || pbsAttnos->FBit((ULONG) iAttno)))
+		{
+			continue;
+		}
+
 		pmdidgpdbRel->AddRef();
-		CMDIdColStats *pmdidColStats = GPOS_NEW(pmp) CMDIdColStats(pmdidgpdbRel, ulAttNo);
-		(void *) pmda->Pmdcolstats(pmdidColStats);
+		CMDIdColStats *pmdidColStats = GPOS_NEW(pmp) CMDIdColStats(pmdidgpdbRel, ulPos);
+		(void) pmda->Pmdcolstats(pmdidColStats);
 		pmdidColStats->Release();
+
+		// comparison operators of the column type are needed to derive
+		// statistics from the histogram
+		PreloadMDType(pmda, pmda->Pmdtype(pmdcol->PmdidType()));
 	}
 
 	// preload relation stats
 	{
 		pmdidgpdbRel->AddRef();
 		CMDIdRelStats *pmdidRelStats = GPOS_NEW(pmp) CMDIdRelStats(pmdidgpdbRel);
-		(void *) pmda->Pmdrelstats(pmdidRelStats);
+		(void) pmda->Pmdrelstats(pmdidRelStats);
 		pmdidRelStats->Release();
 	}
 
@@ -41,6 +41,7 @@
 
 #include "gpos/_api.h"
 #include "gpos/common/CAutoP.h"
+#include "gpos/common/CBitSetIter.h"
 #include "gpos/error/CErrorHandlerStandard.h"
 #include "gpos/error/CLoggerStream.h"
 #include "gpos/io/COstreamFile.h"
@@ -63,6 +64,8 @@
 #include "gpopt/engine/CCTEConfig.h"
 #include "gpopt/mdcache/CAutoMDAccessor.h"
 #include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/mdcache/CMDKey.h"
+#include "gpos/memory/CCacheAccessor.h"
 #include "gpopt/minidump/CMiniDumperDXL.h"
 #include "gpopt/minidump/CMinidumperUtils.h"
 #include "gpopt/minidump/CSerializableStackTrace.h"
@@ -763,6 +766,53 @@ COptTasks::PdrgPssLoad
 	return pdrgpss;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::PdrgPssTimeBoxed
+//
+//	@doc:
+//		Limit the given search strategy, or the default one if NULL, to the
+//		given total time in milliseconds. A stage that runs out of time ends
+//		the search, and the best plan found so far is used
+//
+//---------------------------------------------------------------------------
+DrgPss *
+COptTasks::PdrgPssTimeBoxed
+	(
+	IMemoryPool *pmp,
+	DrgPss *pdrgpss,
+	ULONG ulTimeLimit
+	)
+{
+	if (NULL == pdrgpss)
+	{
+		pdrgpss = CSearchStage::PdrgpssDefault(pmp);
+	}
+
+	DrgPss *pdrgpssTimeBoxed = GPOS_NEW(pmp) DrgPss(pmp);
+	ULONG ulTimeLeft = ulTimeLimit;
+	const ULONG ulStages = pdrgpss->UlLength();
+	for (ULONG ul = 0; ul < ulStages && 0 < ulTimeLeft; ul++)
+	{
+		CSearchStage *pss = (*pdrgpss)[ul];
+		ULONG ulStageTime = pss->UlTimeThreshold();
+		if (ulStageTime > ulTimeLeft)
+		{
+			ulStageTime = ulTimeLeft;
+		}
+
+		pss->Pxfs()->AddRef();
+		pdrgpssTimeBoxed->Append
+							(
+							GPOS_NEW(pmp) CSearchStage(pss->Pxfs(), ulStageTime, pss->CostThreshold())
+							);
+		ulTimeLeft -= ulStageTime;
+	}
+	pdrgpss->Release();
+
+	return pdrgpssTimeBoxed;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::PoconfCreate
@@ -916,6 +966,69 @@ COptTasks::SetCostModelParams
 		CDouble dNLJFactor(optimizer_nestloop_factor);
 		pcm->Pcp()->SetParam(pcp->UlId(), dNLJFactor, dNLJFactor - 0.5, dNLJFactor + 0.5);
 	}
+
+	if (optimizer_cost_calibration)
+	{
+		SetCalibratedCostModelParams(pcm);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//		@function:
+//			COptTasks::SetCalibratedCostModelParams
+//
+//      @doc:
+//			Set the cost units measured by gp_calibrate_optimizer_cost_model().
+//			They are stored relative to the cost of scanning a byte, and are
+//			scaled by this cost model's TableScanCostUnit. Parameters that
+//			this cost model doesn't have are ignored; the legacy cost model
+//			has no per-byte scan cost, and is left alone.
+//
+//---------------------------------------------------------------------------
+void
+COptTasks::SetCalibratedCostModelParams
+	(
+	ICostModel *pcm
+	)
+{
+	GPOS_ASSERT(NULL != pcm);
+
+	List *plParams = gpdb::PlOptimizerCostParams();
+	if (NIL == plParams)
+	{
+		return;
+	}
+
+	ICostModelParams *pcmp = pcm->Pcp();
+	ICostModelParams::SCostParam *pcpScan = pcmp->PcpLookup("TableScanCostUnit");
+	if (NULL == pcpScan)
+	{
+		return;
+	}
+	CDouble dScanCostUnit = pcpScan->DVal();
+
+	ListCell *plc = NULL;
+	ForEach (plc, plParams)
+	{
+		Form_gp_optimizer_cost_params pform = (Form_gp_optimizer_cost_params) lfirst(plc);
+		ICostModelParams::SCostParam *pcp = pcmp->PcpLookup(NameStr(pform->paramname));
+		if (NULL == pcp)
+		{
+			continue;
+		}
+
+		// keep the bounds at the same distance, relative to the value
+		CDouble dVal = dScanCostUnit * CDouble(pform->paramvalue);
+		CDouble dLowerBound = dVal;
+		CDouble dUpperBound = dVal;
+		if (CDouble(0.0) < pcp->DVal())
+		{
+			dLowerBound = dVal * pcp->DLowerBound() / pcp->DVal();
+			dUpperBound = dVal * pcp->DUpperBound() / pcp->DVal();
+		}
+		pcmp->SetParam(pcp->UlId(), dVal, dLowerBound, dUpperBound);
+	}
 }
 
 
@@ -951,58 +1064,304 @@ COptTasks::Pcm
 
 //---------------------------------------------------------------------------
 //	@function:
-//		COptTasks::PvOptimizeTask
+//		COptTasks::EvictMDCacheEntry
 //
 //	@doc:
-//		task that does the optimizes query to physical DXL
+//		Remove the given object from the metadata cache, if it is there,
+//		and release the given mdid
 //
 //---------------------------------------------------------------------------
-void*
-COptTasks::PvOptimizeTask
+void
+COptTasks::EvictMDCacheEntry
 	(
-	void *pv
+	IMDId *pmdid
 	)
 {
-	GPOS_ASSERT(NULL != pv);
-	SOptContext *poctx = SOptContext::PoptctxtConvert(pv);
+	CMDKey mdkey(pmdid);
+	CCacheAccessor<IMDCacheObject*, CMDKey*> cacheaccessor(CMDCache::Pcache());
 
-	GPOS_ASSERT(NULL != poctx->m_pquery);
-	GPOS_ASSERT(NULL == poctx->m_szPlanDXL);
-	GPOS_ASSERT(NULL == poctx->m_pplstmt);
+	cacheaccessor.Lookup(&mdkey);
+	if (NULL != cacheaccessor.PtVal())
+	{
+		cacheaccessor.MarkForDeletion();
+	}
 
-	// initially assume no unexpected failure
-	poctx->m_fUnexpectedFailure = false;
+	pmdid->Release();
+}
 
-	AUTO_MEM_POOL(amp);
-	IMemoryPool *pmp = amp.Pmp();
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::EvictMDRelation
+//
+//	@doc:
+//		Remove the given relation from the metadata cache, if it is there,
+//		along with the triggers and check constraints it refers to, which
+//		may no longer exist
+//
+//---------------------------------------------------------------------------
+void
+COptTasks::EvictMDRelation
+	(
+	IMemoryPool *pmp,
+	OID oid
+	)
+{
+	DrgPmdid *pdrgpmdidMembers = GPOS_NEW(pmp) DrgPmdid(pmp);
+
+	{
+		CMDIdGPDB *pmdid = GPOS_NEW(pmp) CMDIdGPDB(oid);
+		CMDKey mdkey(pmdid);
+		CCacheAccessor<IMDCacheObject*, CMDKey*> cacheaccessor(CMDCache::Pcache());
+
+		cacheaccessor.Lookup(&mdkey);
+		const IMDRelation *pmdrel = dynamic_cast<const IMDRelation *>(cacheaccessor.PtVal());
+		if (NULL != pmdrel)
+		{
+			for (ULONG ul = 0; ul < pmdrel->UlTriggers(); ul++)
+			{
+				IMDId *pmdidTrigger = pmdrel->PmdidTrigger(ul);
+				pmdidTrigger->AddRef();
+				pdrgpmdidMembers->Append(pmdidTrigger);
+			}
 
-	// Does the metadatacache need to be reset?
-	//
+			for (ULONG ul = 0; ul < pmdrel->UlCheckConstraints(); ul++)
+			{
+				IMDId *pmdidCheckConstraint = pmdrel->PmdidCheckConstraint(ul);
+				pmdidCheckConstraint->AddRef();
+				pdrgpmdidMembers->Append(pmdidCheckConstraint);
+			}
+
+			cacheaccessor.MarkForDeletion();
+		}
+
+		pmdid->Release();
+	}
+
+	for (ULONG ul = 0; ul < pdrgpmdidMembers->UlLength(); ul++)
+	{
+		IMDId *pmdid = (*pdrgpmdidMembers)[ul];
+		pmdid->AddRef();
+		EvictMDCacheEntry(pmdid);
+	}
+
+	pdrgpmdidMembers->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::FRefreshMDCache
+//
+//	@doc:
+//		Initialize the metadata cache, or evict the objects changed in the
+//		catalog since the last query, or purge it if the changes cannot be
+//		narrowed down; also change its size if requested. Cached plans that
+//		depend on the changed objects are evicted too. Returns true if the
+//		cache was initialized.
+//
+//---------------------------------------------------------------------------
+BOOL
+COptTasks::FRefreshMDCache
+	(
+	IMemoryPool *pmp
+	)
+{
 	// On the first call, before the cache has been initialized, we
 	// don't care about the return value of FMDCacheNeedsReset(). But
 	// we need to call it anyway, to give it a chance to initialize
 	// the invalidation mechanism.
-	bool reset_mdcache = gpdb::FMDCacheNeedsReset();
+	gpdb::SMDCacheInvalidations mdinval;
+	bool reset_mdcache = gpdb::FMDCacheNeedsReset(&mdinval);
+
+	// cached plans only track the relations they use, so a change to any
+	// other cached object evicts them all
+	if (reset_mdcache || NIL != mdinval.m_plObjOids)
+	{
+		gpdb::OptPlanCacheReset();
+	}
+	else
+	{
+		gpdb::OptPlanCacheInvalidate(mdinval.m_plRelOids);
+	}
 
-	// initialize metadata cache, or purge if needed, or change size if requested
 	if (!CMDCache::FInitialized())
 	{
 		CMDCache::Init();
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		return true;
 	}
-	else if (reset_mdcache)
+
+	if (reset_mdcache)
 	{
 		CMDCache::Reset();
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		return false;
+	}
+
+	ListCell *plc = NULL;
+	ListCell *plcNumCols = NULL;
+	ForBoth (plc, mdinval.m_plRelOids, plcNumCols, mdinval.m_plRelNumCols)
+	{
+		OID oid = lfirst_oid(plc);
+		ULONG ulColumns = (ULONG) lfirst_int(plcNumCols);
+
+		EvictMDRelation(pmp, oid);
+		EvictMDCacheEntry(GPOS_NEW(pmp) CMDIdRelStats(GPOS_NEW(pmp) CMDIdGPDB(oid)));
+
+		for (ULONG ulPos = 0; ulPos < ulColumns; ulPos++)
+		{
+			EvictMDCacheEntry(GPOS_NEW(pmp) CMDIdColStats(GPOS_NEW(pmp) CMDIdGPDB(oid), ulPos));
+		}
+	}
+
+	ForEach (plc, mdinval.m_plRelMemberOids)
+	{
+		EvictMDCacheEntry(GPOS_NEW(pmp) CMDIdGPDB(lfirst_oid(plc)));
 	}
-	else if (CMDCache::ULLGetCacheQuota() != optimizer_mdcache_size * 1024L)
+
+	ForEach (plc, mdinval.m_plObjOids)
+	{
+		EvictMDCacheEntry(GPOS_NEW(pmp) CMDIdGPDB(lfirst_oid(plc)));
+	}
+
+	gpdb::FreeList(mdinval.m_plRelOids);
+	gpdb::FreeList(mdinval.m_plRelNumCols);
+	gpdb::FreeList(mdinval.m_plRelMemberOids);
+	gpdb::FreeList(mdinval.m_plObjOids);
+
+	if (CMDCache::ULLGetCacheQuota() != optimizer_mdcache_size * 1024L)
 	{
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
 	}
 
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::SzPlanFingerprint
+//
+//	@doc:
+//		Fingerprint of a query for the plan cache: the serialized query DXL,
+//		followed by all settings that affect its optimization
+//
+//---------------------------------------------------------------------------
+CHAR *
+COptTasks::SzPlanFingerprint
+	(
+	IMemoryPool *pmp,
+	CDXLNode *pdxlnQuery,
+	DrgPdxln *pdrgpdxlnQueryOutput,
+	DrgPdxln *pdrgpdxlnCTE,
+	CBitSet *pbsTraceFlags,
+	ULONG ulSegments,
+	ULONG ulSegmentsForCosting,
+	BOOL fMasterOnly,
+	BOOL fCanSetTag
+	)
+{
+	CWStringDynamic *pstr =
+			CDXLUtils::PstrSerializeQuery
+						(
+						pmp,
+						pdxlnQuery,
+						pdrgpdxlnQueryOutput,
+						pdrgpdxlnCTE,
+						false, // fSerializeHeaderFooter
+						false // fIndent
+						);
+
+	// optimizer GUCs that are mapped to trace flags
+	CBitSetIter bsi(*pbsTraceFlags);
+	while (bsi.FAdvance())
+	{
+		pstr->AppendFormat(GPOS_WSZ_LIT(" %d"), bsi.UlBit());
+	}
+
+	// the rest of the optimizer configuration, see PoconfCreate() and Pcm()
+	pstr->AppendFormat
+			(
+			GPOS_WSZ_LIT(" | %d %d %d %d %f %f %f %f %f %d %d %d %d %d %d %d %d %d %s"),
+			optimizer_cost_model,
+			optimizer_cost_calibration,
+			optimizer_plan_id,
+			optimizer_samples_number,
+			optimizer_cost_threshold,
+			optimizer_nestloop_factor,
+			optimizer_damping_factor_filter,
+			optimizer_damping_factor_join,
+			optimizer_damping_factor_groupby,
+			optimizer_cte_inlining_bound,
+			optimizer_join_arity_for_associativity_commutativity,
+			optimizer_array_expansion_threshold,
+			optimizer_join_order_threshold,
+			optimizer_time_limit,
+			ulSegments,
+			ulSegmentsForCosting,
+			fMasterOnly,
+			fCanSetTag,
+			NULL == optimizer_search_strategy_path ? "" : optimizer_search_strategy_path
+			);
+
+	// the calibrated cost units the plan was costed with, see
+	// SetCalibratedCostModelParams()
+	if (optimizer_cost_calibration)
+	{
+		List *plParams = gpdb::PlOptimizerCostParams();
+		ListCell *plc = NULL;
+		ForEach (plc, plParams)
+		{
+			Form_gp_optimizer_cost_params pform = (Form_gp_optimizer_cost_params) lfirst(plc);
+			pstr->AppendFormat(GPOS_WSZ_LIT(" %s=%.17g"), NameStr(pform->paramname), pform->paramvalue);
+		}
+	}
+
+	// settings read when translating the plan to a PlannedStmt
+	CTranslatorDXLToPlStmt::AppendSettings(pstr);
+
+	CHAR *sz = SzFromWsz(pstr->Wsz());
+	GPOS_DELETE(pstr);
+
+	return sz;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::PvOptimizeTask
+//
+//	@doc:
+//		task that does the optimizes query to physical DXL
+//
+//---------------------------------------------------------------------------
+void*
+COptTasks::PvOptimizeTask
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+	SOptContext *poctx = SOptContext::PoptctxtConvert(pv);
+
+	GPOS_ASSERT(NULL != poctx->m_pquery);
+	GPOS_ASSERT(NULL == poctx->m_szPlanDXL);
+	GPOS_ASSERT(NULL == poctx->m_pplstmt);
+
+	// initially assume no unexpected failure
+	poctx->m_fUnexpectedFailure = false;
+
+	AUTO_MEM_POOL(amp);
+	IMemoryPool *pmp = amp.Pmp();
+
+	// initialize metadata cache, or bring it up to date with catalog changes
+	(void) FRefreshMDCache(pmp);
+
 
 	// load search strategy
 	DrgPss *pdrgpss = PdrgPssLoad(pmp, optimizer_search_strategy_path);
+	if (0 < optimizer_time_limit)
+	{
+		pdrgpss = PdrgPssTimeBoxed(pmp, pdrgpss, (ULONG) optimizer_time_limit);
+	}
 
 	CBitSet *pbsTraceFlags = NULL;
 	CBitSet *pbsEnabled = NULL;
@@ -1066,51 +1425,92 @@ COptTasks::PvOptimizeTask
 						(!optimizer_enable_motions_masteronly_queries && !ptrquerytodxl->FHasDistributedTables());
 			CAutoTraceFlag atf(EopttraceDisableMotions, fMasterOnly);
 
-			pdxlnPlan = COptimizer::PdxlnOptimize
-									(
-									pmp,
-									&mda,
-									pdxlnQuery,
-									pdrgpdxlnQueryOutput,
-									pdrgpdxlnCTE,
-									pceeval,
-									ulSegments,
-									gp_session_id,
-									gp_command_count,
-									pdrgpss,
-									pocconf
-									);
-
-			if (poctx->m_fSerializePlanDXL)
+			// reuse the plan of an identical query optimized with the same settings
+			CHAR *szFingerprint = NULL;
+			if (poctx->m_fGeneratePlStmt && !poctx->m_fSerializePlanDXL && 0 < optimizer_plan_cache_size)
 			{
-				// serialize DXL to xml
-				CWStringDynamic *pstrPlan = CDXLUtils::PstrSerializePlan(pmp, pdxlnPlan, pocconf->Pec()->UllPlanId(), pocconf->Pec()->UllPlanSpaceSize(), true /*fSerializeHeaderFooter*/, true /*fIndent*/);
-				poctx->m_szPlanDXL = SzFromWsz(pstrPlan->Wsz());
-				GPOS_DELETE(pstrPlan);
+				szFingerprint = SzPlanFingerprint
+								(
+								pmp,
+								pdxlnQuery,
+								pdrgpdxlnQueryOutput,
+								pdrgpdxlnCTE,
+								pbsTraceFlags,
+								ulSegments,
+								ulSegmentsForCosting,
+								fMasterOnly,
+								poctx->m_pquery->canSetTag
+								);
+				poctx->m_pplstmt = gpdb::PplstmtOptPlanCacheLookup(szFingerprint);
 			}
 
-			// translate DXL->PlStmt only when needed
-			if (poctx->m_fGeneratePlStmt)
+			if (NULL == poctx->m_pplstmt)
 			{
-				// always use poctx->m_pquery->canSetTag as the ptrquerytodxl->Pquery() is a mutated Query object
-				// that may not have the correct canSetTag
-				poctx->m_pplstmt = (PlannedStmt *) gpdb::PvCopyObject(Pplstmt(pmp, &mda, pdxlnPlan, poctx->m_pquery->canSetTag));
-			}
+				// fetch the statistics of the referenced relations and columns
+				// in one go, rather than one object at a time during optimization
+				if (optimizer_prefetch_metadata)
+				{
+					CTranslatorUtils::PreloadMD(pmp, &mda, sysidDefault, (Query *) poctx->m_pquery);
+				}
+
+				pdxlnPlan = COptimizer::PdxlnOptimize
+										(
+										pmp,
+										&mda,
+										pdxlnQuery,
+										pdrgpdxlnQueryOutput,
+										pdrgpdxlnCTE,
+										pceeval,
+										ulSegments,
+										gp_session_id,
+										gp_command_count,
+										pdrgpss,
+										pocconf
+										);
+
+				if (poctx->m_fSerializePlanDXL)
+				{
+					// serialize DXL to xml
+					CWStringDynamic *pstrPlan = CDXLUtils::PstrSerializePlan(pmp, pdxlnPlan, pocconf->Pec()->UllPlanId(), pocconf->Pec()->UllPlanSpaceSize(), true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+					poctx->m_szPlanDXL = SzFromWsz(pstrPlan->Wsz());
+					GPOS_DELETE(pstrPlan);
+				}
+
+				// translate DXL->PlStmt only when needed
+				if (poctx->m_fGeneratePlStmt)
+				{
+					// always use poctx->m_pquery->canSetTag as the ptrquerytodxl->Pquery() is a mutated Query object
+					// that may not have the correct canSetTag
+					poctx->m_pplstmt = (PlannedStmt *) gpdb::PvCopyObject(Pplstmt(pmp, &mda, pdxlnPlan, poctx->m_pquery->canSetTag));
+				}
+
+				if (NULL != szFingerprint)
+				{
+					gpdb::OptPlanCacheInsert(szFingerprint, (Query *) poctx->m_pquery, poctx->m_pplstmt);
+				}
+
+				CStatisticsConfig *pstatsconf = pocconf->Pstatsconf();
+				pdrgmdidCol = GPOS_NEW(pmp) DrgPmdid(pmp);
+				pstatsconf->CollectMissingStatsColumns(pdrgmdidCol);
 
-			CStatisticsConfig *pstatsconf = pocconf->Pstatsconf();
-			pdrgmdidCol = GPOS_NEW(pmp) DrgPmdid(pmp);
-			pstatsconf->CollectMissingStatsColumns(pdrgmdidCol);
+				phmmdidRel = GPOS_NEW(pmp) HMMDIdMDId(pmp);
+				PrintMissingStatsWarning(pmp, &mda, pdrgmdidCol, phmmdidRel);
 
-			phmmdidRel = GPOS_NEW(pmp) HMMDIdMDId(pmp);
-			PrintMissingStatsWarning(pmp, &mda, pdrgmdidCol, phmmdidRel);
+				phmmdidRel->Release();
+				pdrgmdidCol->Release();
 
-			phmmdidRel->Release();
-			pdrgmdidCol->Release();
+				pdxlnPlan->Release();
+				pdxlnPlan = NULL;
+			}
+
+			if (NULL != szFingerprint)
+			{
+				gpdb::GPDBFree(szFingerprint);
+			}
 
 			pceeval->Release();
 			pdxlnQuery->Release();
 			pocconf->Release();
-			pdxlnPlan->Release();
 		}
 	}
 	GPOS_CATCH_EX(ex)
@@ -1549,30 +1949,8 @@ COptTasks::PvEvalExprFromDXLTask
 	CDXLNode *pdxlnResult = NULL;
 	BOOL fReleaseCache = false;
 
-	// Does the metadatacache need to be reset?
-	//
-	// On the first call, before the cache has been initialized, we
-	// don't care about the return value of FMDCacheNeedsReset(). But
-	// we need to call it anyway, to give it a chance to initialize
-	// the invalidation mechanism.
-	bool reset_mdcache = gpdb::FMDCacheNeedsReset();
-
-	// initialize metadata cache, or purge if needed, or change size if requested
-	if (!CMDCache::FInitialized())
-	{
-		CMDCache::Init();
-		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
-		fReleaseCache = true;
-	}
-	else if (reset_mdcache)
-	{
-		CMDCache::Reset();
-		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
-	}
-	else if (CMDCache::ULLGetCacheQuota() != optimizer_mdcache_size * 1024L)
-	{
-		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
-	}
+	// initialize metadata cache, or bring it up to date with catalog changes
+	fReleaseCache = FRefreshMDCache(pmp);
 
 	GPOS_TRY
 	{
@@ -1846,6 +2224,86 @@ COptTasks::SzRelStats
 	return ctxrelcache.m_szDXL;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::PvCheckColStatsMergeTask
+//
+//	@doc:
+//		Task that checks the merge of the MCVs and the histogram of every
+//		column of a relation against CStatisticsUtils::PhistMergeMcvHist()
+//
+//---------------------------------------------------------------------------
+void*
+COptTasks::PvCheckColStatsMergeTask
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	SContextRelcacheToDXL *pctxrelcache = SContextRelcacheToDXL::PctxrelcacheConvert(pv);
+	GPOS_ASSERT(NULL != pctxrelcache);
+	GPOS_ASSERT(1 == gpdb::UlListLength(pctxrelcache->m_plistOids));
+
+	AUTO_MEM_POOL(amp);
+	IMemoryPool *pmp = amp.Pmp();
+
+	// relcache MD provider
+	CMDProviderRelcache *pmdpr = GPOS_NEW(pmp) CMDProviderRelcache(pmp);
+	CAutoMDAccessor amda(pmp, pmdpr, sysidDefault);
+	ICostModel *pcm = Pcm(pmp, gpdb::UlSegmentCountGP());
+	CAutoOptCtxt aoc(pmp, amda.Pmda(), NULL /*pceeval*/, pcm);
+
+	Oid oidRelation = gpdb::OidListNth(pctxrelcache->m_plistOids, 0);
+	CMDIdGPDB *pmdid = GPOS_NEW(pmp) CMDIdGPDB(oidRelation, 1 /* major */, 0 /* minor */);
+
+	CWStringDynamic str(pmp);
+
+	Relation rel = gpdb::RelGetRelation(oidRelation);
+	ULONG ulPosCounter = 0;
+	for (ULONG ul = 0; ul < ULONG(rel->rd_att->natts); ul++)
+	{
+		if (!rel->rd_att->attrs[ul]->attisdropped)
+		{
+			pmdid->AddRef();
+			CMDIdColStats *pmdidColStats = GPOS_NEW(pmp) CMDIdColStats(pmdid, ulPosCounter);
+			ulPosCounter++;
+
+			if (CTranslatorRelcacheToDXL::FCheckColStatsMerge(pmp, amda.Pmda(), pmdidColStats, &str))
+			{
+				str.AppendFormat(GPOS_WSZ_LIT("%s: ok\n"), NameStr(rel->rd_att->attrs[ul]->attname));
+			}
+			pmdidColStats->Release();
+		}
+	}
+	gpdb::CloseRelation(rel);
+	pmdid->Release();
+
+	pctxrelcache->m_szDXL = SzFromWsz(str.Wsz());
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::SzCheckColStatsMerge
+//
+//	@doc:
+//		Check the merge of the MCVs and histograms of a relation's columns
+//
+//---------------------------------------------------------------------------
+char *
+COptTasks::SzCheckColStatsMerge
+	(
+	List *plistOids
+	)
+{
+	SContextRelcacheToDXL ctxrelcache(plistOids, ULONG_MAX /*ulCmpt*/, NULL /*szFilename*/);
+	Execute(&PvCheckColStatsMergeTask, &ctxrelcache);
+
+	return ctxrelcache.m_szDXL;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::FSetXform
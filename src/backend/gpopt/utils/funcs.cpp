@@ -60,6 +60,7 @@ PG_FUNCTION_INFO_V1(RestorePlanFromDXLFile);
 PG_FUNCTION_INFO_V1(DumpMDObjDXL);
 PG_FUNCTION_INFO_V1(DumpCatalogDXL);
 PG_FUNCTION_INFO_V1(DumpRelStatsDXL);
+PG_FUNCTION_INFO_V1(CheckColStatsMerge);
 PG_FUNCTION_INFO_V1(DumpMDCastDXL);
 PG_FUNCTION_INFO_V1(DumpMDScCmpDXL);
 
@@ -690,6 +691,30 @@ DumpRelStatsDXL(PG_FUNCTION_ARGS)
 }
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CheckColStatsMerge
+//
+//	@doc:
+//		Check that the MCVs and histograms of a relation's columns are merged
+//		into the same buckets as CStatisticsUtils::PhistMergeMcvHist() produces
+// 		Input: relation oid
+// 		Output: one line per column, "ok" or the differences found
+//
+//---------------------------------------------------------------------------
+
+extern "C" {
+Datum
+CheckColStatsMerge(PG_FUNCTION_ARGS)
+{
+	Oid oid = gpdb::OidFromDatum(PG_GETARG_DATUM(0));
+
+	char *szResult = COptTasks::SzCheckColStatsMerge(ListMake1Oid(oid));
+
+	PG_RETURN_TEXT_P(stringToText(szResult));
+}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		DumpMDCastDXL
@@ -1000,6 +1000,9 @@ _copyHash(Hash *from)
 	/*
 	 * copy remainder of node
 	 */
+	COPY_SCALAR_FIELD(rescannable);
+	COPY_NODE_FIELD(skewMCVs);
+	COPY_SCALAR_FIELD(skewMinMCVs);
 
 	return newnode;
 }
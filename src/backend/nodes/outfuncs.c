@@ -921,6 +921,8 @@ _outHash(StringInfo str, Hash *node)
 
 	_outPlanInfo(str, (Plan *) node);
 	WRITE_BOOL_FIELD(rescannable);          /*CDB*/
+	WRITE_NODE_FIELD(skewMCVs);
+	WRITE_INT_FIELD(skewMinMCVs);
 }
 
 #ifndef COMPILING_BINARY_FUNCS
@@ -2165,6 +2165,8 @@ _readHash(void)
 
 	readPlanInfo((Plan *)local_node);
     READ_BOOL_FIELD(rescannable);           /*CDB*/
+	READ_NODE_FIELD(skewMCVs);
+	READ_INT_FIELD(skewMinMCVs);
 
 	READ_DONE();
 }
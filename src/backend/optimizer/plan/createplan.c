@@ -20,7 +20,10 @@
 #include <limits.h>
 
 #include "catalog/pg_type.h"    /* INT8OID */
+#include "catalog/pg_statistic.h"	/* STATISTIC_KIND_MCV */
+#include "access/heapam.h"
 #include "access/skey.h"
+#include "executor/hashjoin.h"	/* SKEW_MIN_OUTER_FRACTION */
 #include "nodes/makefuncs.h"
 #include "executor/execHHashagg.h"
 #include "optimizer/clauses.h"
@@ -38,6 +41,7 @@
 #include "parser/parse_expr.h"
 #include "parser/parsetree.h"
 #include "parser/parse_oper.h"     /* ordering_oper_opid */
+#include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/uri.h"
 
@@ -108,6 +112,8 @@ static void fix_indexqual_references(List *indexquals, IndexPath *index_path,
 static Node *fix_indexqual_operand(Node *node, IndexOptInfo *index,
 					  Oid *opfamily);
 static List *get_switched_clauses(List *clauses, Relids outerrelids);
+static void set_hash_skew_mcvs(PlannerInfo *root, Hash *hash_plan,
+				   List *hashclauses);
 static List *order_qual_clauses(PlannerInfo *root, List *clauses);
 static void copy_path_costsize(PlannerInfo *root, Plan *dest, Path *src);
 static void copy_plan_costsize(Plan *dest, Plan *src);
@@ -3227,6 +3233,7 @@ create_hashjoin_plan(PlannerInfo *root,
 	 * Build the hash node and hash join node.
 	 */
 	hash_plan = make_hash(inner_plan);
+	set_hash_skew_mcvs(root, hash_plan, hashclauses);
 	join_plan = make_hashjoin(tlist,
 							  joinclauses,
 							  otherclauses,
@@ -4190,10 +4197,113 @@ make_hash(Plan *lefttree)
 	plan->righttree = NULL;
 
     node->rescannable = false;              /* CDB (unused for now) */
+	node->skewMCVs = NIL;
+	node->skewMinMCVs = 0;
 
 	return node;
 }
 
+/*
+ * set_hash_skew_mcvs
+ *	  Supply the outer join key's most common values for skew optimization.
+ *
+ * If there is a single join clause and we can identify the outer variable as
+ * a simple column reference with MCV statistics, attach the MCVs to the Hash
+ * node.  (Note: in principle we could do skew optimization with multiple join
+ * clauses, but we'd have to be able to determine the most common combinations
+ * of outer values, which we don't currently have enough stats for.)
+ *
+ * Unlike PostgreSQL, which looks the statistics up at execution time, we
+ * ship the values themselves: pg_statistic is only populated on the QD.
+ */
+static void
+set_hash_skew_mcvs(PlannerInfo *root, Hash *hash_plan, List *hashclauses)
+{
+	OpExpr	   *clause;
+	Node	   *node;
+	Var		   *var;
+	RangeTblEntry *rte;
+	HeapTuple	statsTuple;
+	Oid			vartype;
+	int32		vartypmod;
+	Datum	   *values;
+	int			nvalues;
+	float4	   *numbers;
+	int			nnumbers;
+
+	if (list_length(hashclauses) != 1)
+		return;
+
+	clause = (OpExpr *) linitial(hashclauses);
+	if (!is_opclause(clause))
+		return;
+
+	node = (Node *) linitial(clause->args);
+	if (IsA(node, RelabelType))
+		node = (Node *) ((RelabelType *) node)->arg;
+	if (!IsA(node, Var))
+		return;
+
+	var = (Var *) node;
+	if (var->varlevelsup != 0 || var->varattno <= 0)
+		return;
+
+	rte = planner_rt_fetch(var->varno, root);
+	if (rte->rtekind != RTE_RELATION || rte->inh)
+		return;
+
+	statsTuple = get_att_stats(rte->relid, var->varattno);
+	if (!HeapTupleIsValid(statsTuple))
+		return;
+
+	vartype = exprType(node);
+	vartypmod = exprTypmod(node);
+
+	if (get_attstatsslot(statsTuple, vartype, vartypmod,
+						 STATISTIC_KIND_MCV, InvalidOid,
+						 &values, &nvalues,
+						 &numbers, &nnumbers))
+	{
+		int16		typlen;
+		bool		typbyval;
+		double		frac = 0;
+		int			minmcvs = 0;
+		int			i;
+
+		/*
+		 * Find how many of the leading MCVs must be specially treated to
+		 * cover SKEW_MIN_OUTER_FRACTION of the outer relation.  If all of
+		 * them together don't, skew optimization isn't worthwhile.
+		 */
+		for (i = 0; i < nvalues && i < nnumbers; i++)
+		{
+			frac += numbers[i];
+			if (frac >= SKEW_MIN_OUTER_FRACTION)
+			{
+				minmcvs = i + 1;
+				break;
+			}
+		}
+
+		if (minmcvs > 0)
+		{
+			get_typlenbyval(vartype, &typlen, &typbyval);
+
+			for (i = 0; i < nvalues && i < nnumbers; i++)
+				hash_plan->skewMCVs =
+					lappend(hash_plan->skewMCVs,
+							makeConst(vartype, vartypmod, typlen,
+									  datumCopy(values[i], typbyval, typlen),
+									  false, typbyval));
+			hash_plan->skewMinMCVs = minmcvs;
+		}
+
+		free_attstatsslot(vartype, values, nvalues, numbers, nnumbers);
+	}
+
+	heap_freetuple(statsTuple);
+}
+
 MergeJoin *
 make_mergejoin(List *tlist,
 			   List *joinclauses,
@@ -519,6 +519,7 @@ PlannerConfig *DefaultPlannerConfig(void)
 	c1->gp_enable_sequential_window_plans = gp_enable_sequential_window_plans;
 	c1->gp_hashagg_streambottom = gp_hashagg_streambottom;
 	c1->gp_enable_agg_distinct = gp_enable_agg_distinct;
+	c1->gp_enable_agg_distinct_hash = gp_enable_agg_distinct_hash;
 	c1->gp_enable_dqa_pruning = gp_enable_dqa_pruning;
 	c1->gp_eager_dqa_pruning = gp_eager_dqa_pruning;
 	c1->gp_eager_one_phase_agg = gp_eager_one_phase_agg;
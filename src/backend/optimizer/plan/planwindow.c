@@ -201,6 +201,7 @@ typedef struct WindowContext
 	 /* Only for sequential plans */
 	bool			original_range;
 	Query		   *subquery;
+	int				dist_partkey_len; /* leading part keys to distribute on */
 	
 	/* Map (varno,varattno) <--> (integer) for use in Bitmapsets recording
 	 * use of vars from the window query's range table.
@@ -264,6 +265,8 @@ static Plan *plan_sequential_window_query(PlannerInfo *root, WindowContext *cont
 static Plan *plan_sequential_stage(PlannerInfo *root, WindowContext *context, 
 		int hi_windex, int lo_windex,
 		Plan *input_plan, CdbPathLocus *locus_ptr, List **pathkeys_ptr);
+static void order_sequential_stages(WindowContext *context, int nstages, int *stage_lo, int *stage_hi);
+static int choose_dist_partkey_len(PlannerInfo *root, WindowContext *context, int nstages, int *stage_lo, double input_rows);
 static Plan *assure_order(PlannerInfo *root, Plan *input_plan, List *sortclause, List **pathkeys_ptr);
 static List *translate_upper_tlist_sequential(List *orig_tlist, List *window_tlist, WindowContext *context);
 static Plan *plan_parallel_window_query(PlannerInfo *root, WindowContext *context, List **pathkeys_ptr);
@@ -406,6 +409,7 @@ static WindowContext *newWindowContext()
 
 	context->original_range = true;
 	context->subquery = NULL;
+	context->dist_partkey_len = 0;
 	
 	context->max_varno = 0;
 	context->varattno_offsets = NULL;
@@ -1035,9 +1039,33 @@ static void assign_window_info(WindowContext *context)
 	int i, j, k, n;
 	Index current;
 	ListCell *lc;
+	int *partkey_uses;
+	int *partkey_refs;
 	
 	Assert( context->nspecinfos > 0 );
 	
+	/* Count the distinct partitionings that use each partitioning key. 
+	 * Since the SpecInfos are sorted, equal partsets are adjacent.
+	 */
+	partkey_uses = (int *)palloc0((context->max_sortref + 1) * sizeof(int));
+	partkey_refs = (int *)palloc((context->max_sortref + 1) * sizeof(int));
+	for ( i = 0; i < context->nspecinfos; i++ )
+	{
+		Bitmapset *partset = context->specinfos[i].partset;
+		int sortgroupref;
+		
+		if ( i > 0 && bms_equal(context->specinfos[i-1].partset, partset) )
+			continue;
+		
+		sortgroupref = bms_first_from(partset, 0);
+		while ( sortgroupref >= 0 )
+		{
+			Assert( sortgroupref <= context->max_sortref );
+			partkey_uses[sortgroupref]++;
+			sortgroupref = bms_first_from(partset, sortgroupref+1);
+		}
+	}
+	
 	/* First divide the previously produced, sorted list of distinct
 	 * SpecInfo into groups with matching partitioning requirements 
 	 * and so that each group member's ordering key is a prefix of 
@@ -1064,6 +1092,7 @@ static void assign_window_info(WindowContext *context)
 		SpecInfo *final_sinfo = NULL;
 		WindowInfo *winfo = &context->windowinfos[i];
 		int sortgroupref = 0;
+		int nkeys, m;
 		
 		j = k; /* j indexes first SpecInfo in this WindowInfo */
 		
@@ -1083,18 +1112,34 @@ static void assign_window_info(WindowContext *context)
 
 		winfo->sortclause = NIL;
 
-		/* Append part keys into sortclause in the order defined by
+		/* Append part keys into sortclause, the keys used by more
+		 * partitionings first, then in the order defined by
 		 * final_sinfo->partset. This guarantees that same part keys
-		 * in all WindowInfos are in the same order.
+		 * in all WindowInfos are in the same order, and that keys
+		 * shared with other partitionings come first, so that one
+		 * distribution and one sort of the input can serve several
+		 * WindowInfos.
 		 */
+		nkeys = 0;
 		sortgroupref = bms_first_from(final_sinfo->partset, 0);
 		while (sortgroupref >= 0)
+		{
+			/* Insertion sort by descending use count; stable on ties. */
+			for ( m = nkeys; m > 0 && partkey_uses[partkey_refs[m-1]] < partkey_uses[sortgroupref]; m-- )
+				partkey_refs[m] = partkey_refs[m-1];
+			partkey_refs[m] = sortgroupref;
+			nkeys++;
+			
+			sortgroupref = bms_first_from(final_sinfo->partset, sortgroupref+1);
+		}
+		
+		for ( m = 0; m < nkeys; m++ )
 		{
 			foreach (lc, final_sinfo->partkey)
 			{
 				SortClause *sc = (SortClause *)lfirst(lc);
 				
-				if (sc->tleSortGroupRef == sortgroupref)
+				if (sc->tleSortGroupRef == partkey_refs[m])
 				{
 					winfo->sortclause = lappend(winfo->sortclause, sc);
 					break;
@@ -1102,8 +1147,6 @@ static void assign_window_info(WindowContext *context)
 			}
 
 			Assert(lc != NULL);
-			
-			sortgroupref = bms_first_from(final_sinfo->partset, sortgroupref+1);
 		}
 		
 		winfo->sortclause = list_concat(winfo->sortclause,
@@ -1112,6 +1155,9 @@ static void assign_window_info(WindowContext *context)
 		winfo->orderkeys_offset = list_length(final_sinfo->partkey);
 	}
 	
+	pfree(partkey_uses);
+	pfree(partkey_refs);
+	
 	/* Set up the partitioning and ordering key levels (WindowKeys)  */
 	for ( i = 0; i < context->nwindowinfos; i++ )
 	{	
@@ -2048,17 +2094,64 @@ static Plan *plan_sequential_window_query(PlannerInfo *root, WindowContext *cont
 	ListCell *lc;
 	QualCost tlist_cost;
 	int			i;
+	int			nstages;
+	int		   *stage_lo;
+	int		   *stage_hi;
 
 	Assert ( pathkeys_ptr != NULL );
 	Assert ( context->original_range );
 	
-	/* Plan common subquery. */
-	sort_hint = context->windowinfos[context->nwindowinfos-1].sortclause;
+	/* 
+	 * A stage is a set of WindowInfos with the same partitioning.
+	 *
+	 * We collect stages from the last window info to the first.
+	 * This is because the window info sort places non-partitioned windows 
+	 * first and we prefer to process these last. 
+	 */
+	stage_lo = (int *)palloc(context->nwindowinfos * sizeof(int));
+	stage_hi = (int *)palloc(context->nwindowinfos * sizeof(int));
+	nstages = 0;
+	for ( hi = context->nwindowinfos - 1; hi >= 0; hi = lo - 1 )
+	{
+		int j;
+		Bitmapset *partset = context->specinfos[context->windowinfos[hi].firstspecindex].partset;
+
+		lo = hi;		
+		for ( j = hi-1; j  >= 0; j-- )
+		{
+			WindowInfo *winfo = &context->windowinfos[j];
+			
+			if ( ! bms_equal( context->specinfos[winfo->firstspecindex].partset, partset ) )
+				break;
+				
+			lo = j;
+		}
+		
+		stage_lo[nstages] = lo;
+		stage_hi[nstages] = hi;
+		nstages++;
+	}
+	
+	/* Let consecutive stages share the distribution and sort order. */
+	order_sequential_stages(context, nstages, stage_lo, stage_hi);
+	
+	/* Plan common subquery.  Hint at the order of the last WindowInfo,
+	 * as always, unless order_sequential_stages moved another stage to the
+	 * front; then hint at the order that stage starts with.
+	 */
+	if ( stage_hi[0] == context->nwindowinfos - 1 )
+		sort_hint = context->windowinfos[context->nwindowinfos-1].sortclause;
+	else
+		sort_hint = context->windowinfos[stage_lo[0]].sortclause;
 	result_plan = plan_common_subquery(root, context->lower_tlist,
 									   sort_hint,
 									   &locus,
 									   &pathkeys);
 	
+	context->dist_partkey_len = choose_dist_partkey_len(root, context,
+														 nstages, stage_lo,
+														 result_plan->plan_rows);
+	
 	/* Record common subquery information in context. 
 	 *
 	 * It's not clear that we need this for the sequential strategy.
@@ -2098,38 +2191,21 @@ static Plan *plan_sequential_window_query(PlannerInfo *root, WindowContext *cont
 		}
 	}
 	
-	/* 
-	 * A stage is a set of WindowInfos with the same partitioning.
-	 *
-	 * We construct plan stages from the last window info to the first.
-	 * This is because the window info sort places non-partitioned windows 
-	 * first and we prefer to process these last. 
-	 */
-	for ( hi = context->nwindowinfos - 1; hi >= 0; hi = lo - 1 )
+	/* Plan the stages in the chosen order. */
+	for ( i = 0; i < nstages; i++ )
 	{
-		int j;
-		Bitmapset *partset = context->specinfos[context->windowinfos[hi].firstspecindex].partset;
-
-		lo = hi;		
-		for ( j = hi-1; j  >= 0; j-- )
-		{
-			WindowInfo *winfo = &context->windowinfos[j];
-			
-			if ( ! bms_equal( context->specinfos[winfo->firstspecindex].partset, partset ) )
-				break;
-				
-			lo = j;
-		}
-		
 		/* Plan a stage for WindowInfos from hi to lo. */
 		result_plan = plan_sequential_stage(root, 
 											context, 
-											hi, lo, 
+											stage_hi[i], stage_lo[i], 
 											result_plan, 
 											&locus, 
 											&pathkeys
 											);
 	}
+	
+	pfree(stage_lo);
+	pfree(stage_hi);
 			
 	/* Mutate the upper target list to compute the final result. */
 	targetlist = translate_upper_tlist_sequential(context->upper_tlist, 
@@ -2191,6 +2267,151 @@ static Plan *plan_sequential_window_query(PlannerInfo *root, WindowContext *cont
 }
 
 
+#define WindowInfo_Partset(context, windex) \
+	((context)->specinfos[(context)->windowinfos[windex].firstspecindex].partset)
+
+/* Move the stage at index 'from' to index 'to' (to <= from), shifting the
+ * stages in between up by one.
+ */
+static void move_stage(int *stage_lo, int *stage_hi, int from, int to)
+{
+	int lo = stage_lo[from];
+	int hi = stage_hi[from];
+	
+	for ( ; from > to; from-- )
+	{
+		stage_lo[from] = stage_lo[from-1];
+		stage_hi[from] = stage_hi[from-1];
+	}
+	stage_lo[to] = lo;
+	stage_hi[to] = hi;
+}
+
+/* Order the stages of a sequential window plan so that consecutive stages
+ * share the sort order of their input where possible.
+ *
+ * A Window node preserves the order of its input, so a stage needs no Sort
+ * if the sort clause of its first WindowInfo is a prefix of the one of the
+ * last WindowInfo of the stage before it.  We start with the partitioned 
+ * stage whose final order serves the most other stages, then repeatedly 
+ * pick a stage that needs no Sort, preferring the longest sort clause.  
+ * Ties keep the original order.  The non-partitioned stage, if any, stays
+ * last.
+ */
+static void order_sequential_stages(WindowContext *context, int nstages, int *stage_lo, int *stage_hi)
+{
+	int npart = nstages;
+	int i, j, best, best_count;
+	
+	if ( npart > 0 && bms_is_empty(WindowInfo_Partset(context, stage_lo[npart-1])) )
+		npart--;
+	
+	if ( npart < 2 )
+		return;
+	
+	best = 0;
+	best_count = -1;
+	for ( i = 0; i < npart; i++ )
+	{
+		List *order = context->windowinfos[stage_hi[i]].sortclause;
+		int count = 0;
+		
+		for ( j = 0; j < npart; j++ )
+		{
+			if ( j != i &&
+				 is_order_prefix_of(context->windowinfos[stage_lo[j]].sortclause, order) )
+				count++;
+		}
+		
+		if ( count > best_count )
+		{
+			best = i;
+			best_count = count;
+		}
+	}
+	move_stage(stage_lo, stage_hi, best, 0);
+	
+	for ( i = 1; i < npart; i++ )
+	{
+		List *order = context->windowinfos[stage_hi[i-1]].sortclause;
+		
+		best = -1;
+		for ( j = i; j < npart; j++ )
+		{
+			List *sortclause = context->windowinfos[stage_lo[j]].sortclause;
+			
+			if ( is_order_prefix_of(sortclause, order) &&
+				 (best < 0 || 
+				  list_length(sortclause) > list_length(context->windowinfos[stage_lo[best]].sortclause)) )
+				best = j;
+		}
+		
+		if ( best > i )
+			move_stage(stage_lo, stage_hi, best, i);
+	}
+}
+
+/* Choose the number of leading partitioning keys on which to distribute
+ * the input of the partitioned stages of a sequential window plan.
+ *
+ * If all partitioned stages have some partitioning keys in common, these
+ * come first in their sort clauses (see assign_window_info).  Distributing
+ * on them once collocates every stage, and saves a redistribution and a
+ * re-sort of the whole input per additional stage.  We only do this if the
+ * common keys have enough distinct values to keep all segments busy.
+ *
+ * Returns 0 to distribute each stage on its own partitioning keys.
+ */
+static int choose_dist_partkey_len(PlannerInfo *root, WindowContext *context, int nstages, int *stage_lo, double input_rows)
+{
+	Bitmapset *common = NULL;
+	List *common_exprs = NIL;
+	int npart = 0;
+	int sortgroupref;
+	double d;
+	int i;
+	
+	for ( i = 0; i < nstages; i++ )
+	{
+		Bitmapset *partset = WindowInfo_Partset(context, stage_lo[i]);
+		
+		if ( bms_is_empty(partset) )
+			continue;
+		
+		common = (npart == 0) ? bms_copy(partset) : bms_int_members(common, partset);
+		npart++;
+	}
+	
+	if ( npart < 2 || bms_is_empty(common) )
+	{
+		bms_free(common);
+		return 0;
+	}
+	
+	sortgroupref = bms_first_from(common, 0);
+	while ( sortgroupref >= 0 )
+	{
+		TargetEntry *tle = get_tle_by_resno(context->lower_tlist,
+											context->sortref_resno[sortgroupref]);
+		
+		common_exprs = lappend(common_exprs, tle->expr);
+		sortgroupref = bms_first_from(common, sortgroupref+1);
+	}
+	
+	d = estimate_num_groups(root, common_exprs, input_rows);
+	list_free(common_exprs);
+	
+	if ( d < 2.0 * planner_segment_count() )
+	{
+		bms_free(common);
+		return 0;
+	}
+	
+	i = bms_num_members(common);
+	bms_free(common);
+	return i;
+}
+
 /* Plan a single stage of a sequential window query plan.
  *
  * By construction, all the window functions computed by a stage have the 
@@ -2306,7 +2527,8 @@ static Plan *plan_sequential_stage(PlannerInfo *root,
 	winfo = &context->windowinfos[lo_windex];
 	window_plan = assure_collocation_and_order(root,
 											   input_plan,
-											   winfo->partkey_len,
+											   (winfo->partkey_len > 0 && context->dist_partkey_len > 0) ?
+											   context->dist_partkey_len : winfo->partkey_len,
 											   winfo->partkey_attrs,
 											   winfo->sortclause,
 											   input_locus,
@@ -2625,7 +2847,23 @@ static Plan *plan_sequential_stage(PlannerInfo *root,
 									context->subquery, &pathkeys, 
 									"coplan", win_names, 
 									&wquery);
-			
+
+			/* wrap_plan translated the pathkeys; do the same for the locus
+			 * so the next stage can see the input is already collocated.
+			 */
+			{
+				List *newvars = NIL;
+				ListCell *lc2;
+
+				foreach ( lc2, window_plan->targetlist )
+					newvars = lappend(newvars, ((TargetEntry*)lfirst(lc2))->expr);
+
+				*locus_ptr = cdbpathlocus_pull_above_projection(root, *locus_ptr, NULL,
+																((SubqueryScan*)window_plan)->subplan->targetlist,
+																newvars, win_varno);
+				list_free(newvars);
+			}
+
 			context->subquery = wquery; /* the "input query" for the next time through */
 			context->original_range = false; /* range is now our introduced range */
 		}
@@ -1385,6 +1385,75 @@ extract_nodes_expression_walker(Node *node, extract_context *context)
 	return expression_tree_walker(node, extract_nodes_expression_walker, (void *) context);
 }
 
+/**
+ * Helpers to collect the paramids of the Params in a plan tree
+ */
+typedef struct extract_param_ids_context
+{
+	plan_tree_base_prefix base; /* Required prefix for plan_tree_walker/mutator */
+	Plan	   *root;
+	Bitmapset  *knownPlanIds;
+	Bitmapset  *paramids;
+} extract_param_ids_context;
+
+static bool extract_param_ids_walker(Node *node, extract_param_ids_context *context);
+
+/**
+ * Returns the paramids of the Params in a plan tree, the same ones as
+ * extract_nodes_plan(pl, T_Param, true) finds. The walk doesn't descend
+ * into the plan nodes below pl whose plan_node_id is in knownPlanIds;
+ * their allParam is used instead. This lets a caller that builds a plan
+ * bottom-up compute the params of every node without walking the subtree
+ * of every node again, which is quadratic for deep or wide plans.
+ *
+ * The caller must not modify a known plan node, or anything below it,
+ * after its allParam was set; the cached set would go stale and the
+ * Params added later would be missed by every ancestor. The Pivotal Query
+ * Optimizer's translator checks this against a full walk in debug builds.
+ */
+Bitmapset *extract_plan_param_ids(Plan *pl, Bitmapset *knownPlanIds)
+{
+	extract_param_ids_context context;
+	Assert(pl);
+	context.base.node = NULL;
+	context.root = pl;
+	context.knownPlanIds = knownPlanIds;
+	context.paramids = NULL;
+	extract_param_ids_walker((Node *) pl, &context);
+	return context.paramids;
+}
+
+static bool
+extract_param_ids_walker(Node *node, extract_param_ids_context *context)
+{
+	if (NULL == node)
+	{
+		return false;
+	}
+
+	if (IsA(node, Param))
+	{
+		context->paramids = bms_add_member(context->paramids, ((Param *) node)->paramid);
+		return false;
+	}
+
+	/* Don't descend into SubPlans, same as extract_nodes_walker() */
+	if (IsA(node, SubPlan))
+	{
+		return false;
+	}
+
+	if (node != (Node *) context->root &&
+		nodeTag(node) >= T_Plan_Start && nodeTag(node) < T_Plan_End &&
+		bms_is_member(((Plan *) node)->plan_node_id, context->knownPlanIds))
+	{
+		context->paramids = bms_add_members(context->paramids, ((Plan *) node)->allParam);
+		return false;
+	}
+
+	return plan_tree_walker(node, extract_param_ids_walker, (void *) context);
+}
+
 /**
  * These are helpers to find node in queries
  */
@@ -38,6 +38,7 @@
 #include "cdb/cdbpersistentcheck.h"
 #include "cdb/cdbresynchronizechangetracking.h"
 #include "cdb/cdbvars.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "postmaster/autovacuum.h"
@@ -67,6 +68,7 @@
 #include "cdb/memquota.h"
 #include "executor/spi.h"
 #include "utils/workfile_mgr.h"
+#include "utils/mdsharedcache.h"
 #include "utils/session_state.h"
 
 shmem_startup_hook_type shmem_startup_hook = NULL;
@@ -140,6 +142,7 @@ CreateSharedMemoryAndSemaphores(bool makePrivate, int port)
 		if (Gp_role == GP_ROLE_DISPATCH)
 		{
 			size = add_size(size, AppendOnlyWriterShmemSize());
+			size = add_size(size, MDSharedCacheShmemSize());
 			
 			if(ResourceScheduler)
 			{
@@ -158,6 +161,7 @@ CreateSharedMemoryAndSemaphores(bool makePrivate, int port)
 		size = add_size(size, LWLockShmemSize());
 		size = add_size(size, ProcArrayShmemSize());
 		size = add_size(size, BackendStatusShmemSize());
+		size = add_size(size, InstrProfileShmemSize());
 		size = add_size(size, SharedSnapshotShmemSize());
 
 		size = add_size(size, SInvalShmemSize());
@@ -347,6 +351,7 @@ CreateSharedMemoryAndSemaphores(bool makePrivate, int port)
 
 	CreateSharedProcArray();
 	CreateSharedBackendStatus();
+	InstrProfileShmemInit();
 	
 	/*
 	 * Set up Shared snapshot slots
@@ -411,6 +416,8 @@ CreateSharedMemoryAndSemaphores(bool makePrivate, int port)
 	BTreeShmemInit();
 	SyncScanShmemInit();
 	workfile_mgr_cache_init();
+	if (Gp_role == GP_ROLE_DISPATCH)
+		MDSharedCacheShmemInit();
 
 #ifdef EXEC_BACKEND
 
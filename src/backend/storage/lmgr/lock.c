@@ -35,6 +35,7 @@
 #include "access/transam.h"
 #include "access/twophase.h"
 #include "access/twophase_rmgr.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 #include "pg_trace.h"
 #include "pgstat.h"
@@ -1271,6 +1272,7 @@ WaitOnLock(LOCALLOCK *locallock, ResourceOwner owner)
 	LOCKMETHODID lockmethodid = LOCALLOCK_LOCKMETHOD(*locallock);
 	LockMethod	lockMethodTable = LockMethods[lockmethodid];
 	char	   * volatile new_status = NULL;
+	uint64		waitStart;
 
 	LOCK_PRINT("WaitOnLock: sleeping on lock",
 			   locallock->lock, locallock->tag.mode);
@@ -1310,6 +1312,7 @@ WaitOnLock(LOCALLOCK *locallock, ResourceOwner owner)
 	 * not here.  We can use PG_TRY to clear the "waiting" status flags,
 	 * since doing that is unimportant if the process exits.
 	 */
+	waitStart = InstrWaitStart();
 	PG_TRY();
 	{
 		if (ProcSleep(locallock, lockMethodTable) != STATUS_OK)
@@ -1349,6 +1352,7 @@ WaitOnLock(LOCALLOCK *locallock, ResourceOwner owner)
 	PG_END_TRY();
 
 	awaitedLock = NULL;
+	InstrWaitEnd(INSTR_WAIT_LOCK, waitStart);
 
 	/* Report change to non-waiting status */
 	pgstat_report_waiting(PGBE_WAITING_NONE);
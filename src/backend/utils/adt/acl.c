@@ -98,7 +98,8 @@ static AclMode convert_tablespace_priv_string(text *priv_type_text);
 static AclMode convert_role_priv_string(text *priv_type_text);
 static AclResult pg_role_aclcheck(Oid role_oid, Oid roleid, AclMode mode);
 
-static void RoleMembershipCacheCallback(Datum arg, int cacheid, ItemPointer tuplePtr);
+static void RoleMembershipCacheCallback(Datum arg, int cacheid, ItemPointer tuplePtr,
+										uint32 hashValue);
 
 
 /*
@@ -3000,7 +3001,8 @@ initialize_acl(void)
  *		Syscache inval callback function
  */
 static void
-RoleMembershipCacheCallback(Datum arg, int cacheid, ItemPointer tuplePtr)
+RoleMembershipCacheCallback(Datum arg, int cacheid, ItemPointer tuplePtr,
+							uint32 hashValue)
 {
 	/* Force membership caches to be recomputed on next use */
 	cached_privs_role = InvalidOid;
@@ -90,10 +90,12 @@
 #include "access/xact.h"
 #include "catalog/catalog.h"
 #include "catalog/gp_policy.h"
+#include "catalog/pg_statistic.h"
 #include "miscadmin.h"
 #include "storage/sinval.h"
 #include "storage/smgr.h"
 #include "utils/inval.h"
+#include "utils/mdsharedcache.h"
 #include "utils/memutils.h"
 #include "utils/relcache.h"
 #include "utils/simex.h"
@@ -536,7 +538,8 @@ LocalExecuteInvalidationMessage(SharedInvalidationMessage *msg)
 
 				if (ccitem->id == msg->cc.id)
 					(*ccitem->function) (ccitem->arg,
-										 msg->cc.id, &msg->cc.tuplePtr);
+										 msg->cc.id, &msg->cc.tuplePtr,
+										 msg->cc.hashValue);
 			}
 		}
 	}
@@ -594,7 +597,7 @@ InvalidateSystemCaches(void)
 	{
 		struct SYSCACHECALLBACK *ccitem = syscache_callback_list + i;
 
-		(*ccitem->function) (ccitem->arg, ccitem->id, NULL);
+		(*ccitem->function) (ccitem->arg, ccitem->id, NULL, 0);
 	}
 
 	for (i = 0; i < relcache_callback_count; i++)
@@ -718,6 +721,19 @@ PrepareForTupleInvalidation(Relation relation, HeapTuple tuple)
 		relationId = indextup->indexrelid;
 		databaseId = MyDatabaseId;
 	}
+	else if (tupleRelId == StatisticRelationId)
+	{
+		Form_pg_statistic statup = (Form_pg_statistic) GETSTRUCT(tuple);
+
+		/*
+		 * The relcache doesn't include column statistics, but the optimizer's
+		 * metadata cache does, and it can only tell which relation a pg_statistic
+		 * change belongs to from a relcache inval.  ANALYZE updates pg_class as
+		 * well, so this normally adds no message of its own.
+		 */
+		relationId = statup->starelid;
+		databaseId = MyDatabaseId;
+	}
 	else
 		return;
 
@@ -975,6 +991,11 @@ AtEOXact_Inval(bool isCommit)
 
 		if (transInvalInfo->RelcacheInitFileInval)
 			RelationCacheInitFilePostInvalidate();
+
+		/* Retire optimizer metadata translated from the changed catalogs */
+		ProcessInvalidationMessages(&transInvalInfo->PriorCmdInvalidMsgs,
+									MDSharedCacheNoteInvalidation);
+		MDSharedCacheAtCommit();
 	}
 	else if (transInvalInfo != NULL)
 	{
@@ -1283,8 +1304,12 @@ CacheInvalidateRelcacheByRelid(Oid relid)
 /*
  * CacheRegisterSyscacheCallback
  *		Register the specified function to be called for all future
- *		invalidation events in the specified cache.  The cache ID and the
- *		TID of the tuple being invalidated will be passed to the function.
+ *		invalidation events in the specified cache.  The cache ID, the
+ *		TID of the tuple being invalidated and the hash value of its cache
+ *		key will be passed to the function.  The hash value can be matched
+ *		against GetSysCacheHashValue() of the keys the caller is interested
+ *		in; the TID may no longer point to the tuple by the time the event is
+ *		processed.
  *
  * NOTE: NULL will be passed for the TID if a cache reset request is received.
  * In this case the called routines should flush all cached state.
@@ -1433,6 +1433,35 @@ trigger_enabled(Oid triggerid)
 	return result;
 }
 
+/*
+ * get_trigger_oids
+ *		Given relation id, return the oids of the relation's triggers
+ */
+List *
+get_trigger_oids(Oid relid)
+{
+	Relation	rel;
+	HeapTuple	tp;
+	List	   *result = NIL;
+	ScanKeyData	scankey;
+	SysScanDesc sscan;
+
+	ScanKeyInit(&scankey, Anum_pg_trigger_tgrelid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				ObjectIdGetDatum(relid));
+	rel = heap_open(TriggerRelationId, AccessShareLock);
+	sscan = systable_beginscan(rel, TriggerRelidNameIndexId, true,
+							   SnapshotNow, 1, &scankey);
+
+	while (HeapTupleIsValid(tp = systable_getnext(sscan)))
+		result = lappend_oid(result, HeapTupleGetOid(tp));
+
+	systable_endscan(sscan);
+	heap_close(rel, AccessShareLock);
+
+	return result;
+}
+
 /*				---------- FUNCTION CACHE ----------					 */
 
 /*
@@ -3231,6 +3260,21 @@ get_att_stats(Oid relid, AttrNumber attrnum)
 							   Int16GetDatum(attrnum));
 }
 
+/*
+ * prefetch_att_stats
+ *		Load the statistics of all attributes of a relation into the syscache
+ *		with a single catalog scan, so that subsequent get_att_stats() calls
+ *		for the relation don't each need to scan pg_statistic.
+ */
+void
+prefetch_att_stats(Oid relid)
+{
+	CatCList   *catlist;
+
+	catlist = SearchSysCacheList1(STATRELATT, ObjectIdGetDatum(relid));
+	ReleaseSysCacheList(catlist);
+}
+
 /*				---------- PG_NAMESPACE CACHE ----------				 */
 
 /*
@@ -0,0 +1,571 @@
+/*-------------------------------------------------------------------------
+ *
+ * mdsharedcache.c
+ *	  Cross-backend cache of serialized optimizer metadata objects.
+ *
+ * Each backend running the Pivotal Query Optimizer keeps its own metadata
+ * cache, which starts out empty, so the first queries of every new session
+ * pay for translating all the catalog information they use. This module
+ * keeps the serialized (DXL) form of metadata objects in shared memory, so
+ * that a backend can pick up objects that another backend has already
+ * translated.
+ *
+ * Objects are keyed by database and metadata id. The metadata id includes
+ * the version of the object, so objects of different versions don't
+ * collide. The serialized objects are stored in a chain of fixed-size
+ * blocks, allocated from an arena of optimizer_mdcache_shared_size
+ * kilobytes. When the arena is full, the least recently used objects are
+ * evicted to make room for new ones.
+ *
+ * Objects are translated from the catalogs, so they go stale when the
+ * catalogs change. Every entry remembers the relation it was translated
+ * from, if any. A transaction that commits changes to a relation removes the
+ * entries of that relation, and those of partitioned tables, which are
+ * translated from all their partitions. A committed change to any of the
+ * other catalogs that metadata objects are translated from (types,
+ * functions, operators and so on) makes all existing entries invisible:
+ * they are removed when they are next inserted again, or evicted, as
+ * nobody touches them anymore. This is coarser than the invalidation of each
+ * backend's own cache, but each backend only learns about catalog changes
+ * when it next processes invalidation messages, and a backend that connects
+ * after the change never does.
+ *
+ * Every such commit also starts a new generation of the cache. A backend
+ * can only insert an object if no new generation started since it began
+ * translating the object, so that an object translated from catalog
+ * contents that were just changed doesn't sneak back in.
+ *
+ * Lookups only take the lock in shared mode, so they don't maintain an exact
+ * LRU order; instead, they mark the entries they find as recently used, and
+ * eviction gives marked entries a second chance, like the buffer manager's
+ * clock sweep.
+ *
+ * A transaction that has modified the database can see catalog changes
+ * that are not visible to others yet, so such transactions bypass the
+ * shared cache altogether.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/transam.h"
+#include "access/xact.h"
+#include "miscadmin.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "storage/sinval.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/mdsharedcache.h"
+#include "utils/syscache.h"
+
+/* Size of the blocks that serialized objects are stored in */
+#define MDSHAREDCACHE_BLOCKSIZE		4096
+
+/* No single object may take more than this fraction of the arena */
+#define MDSHAREDCACHE_MAX_OBJECT_FRACTION	4
+
+/*
+ * Most relations a committing transaction can change before all entries are
+ * made invisible, rather than removing those of each relation.
+ */
+#define MDSHAREDCACHE_MAX_CHANGED_RELS		64
+
+typedef struct MDSharedCacheKey
+{
+	Oid			dbid;
+	char		mdid[MDSHAREDCACHE_KEYSIZE];
+} MDSharedCacheKey;
+
+typedef struct MDSharedCacheEntry
+{
+	MDSharedCacheKey key;		/* hash key, must be first */
+	SHM_QUEUE	lruLink;		/* link in the LRU list */
+	uint64		generation;		/* generation the entry was inserted in */
+	Oid			relid;			/* relation the object is translated from */
+	bool		partitioned;	/* ... which is a partitioned table? */
+	bool		referenced;		/* looked up since last eviction sweep? */
+	Size		len;			/* length of the serialized object */
+	int			firstBlock;		/* first block of the object's data */
+	int			nblocks;		/* number of blocks in the chain */
+} MDSharedCacheEntry;
+
+typedef struct MDSharedCacheHeader
+{
+	uint64		generation;		/* current generation */
+	uint64		validGeneration;	/* entries of older ones are invisible */
+	SHM_QUEUE	lru;			/* entries, least recently used first */
+	int			nblocks;		/* size of the arena, in blocks */
+	int			nfreeblocks;	/* number of blocks on the free list */
+	int			freeBlock;		/* head of the free list, or -1 */
+	int			blockNext[1];	/* next block of each chain, VARIABLE LENGTH */
+} MDSharedCacheHeader;
+
+static MDSharedCacheHeader *mdcacheHeader = NULL;
+static char *mdcacheBlocks = NULL;
+static HTAB *mdcacheHash = NULL;
+
+/* Has the committing transaction changed any catalogs we care about? */
+static bool mdcacheInvalidationPending = false;
+
+/* ... so that all entries are stale? */
+static bool mdcacheInvalidateAll = false;
+
+/* ... or only those of these relations? */
+static int	mdcacheNumChangedRels = 0;
+static Oid	mdcacheChangedRels[MDSHAREDCACHE_MAX_CHANGED_RELS];
+
+static int
+mdcache_num_blocks(void)
+{
+	return (int) (((int64) optimizer_mdcache_shared_size * 1024L) /
+				  MDSHAREDCACHE_BLOCKSIZE);
+}
+
+/*
+ * Initialize an empty cache, with all blocks on the free list.
+ */
+static void
+mdcache_init_header(int nblocks)
+{
+	int			i;
+
+	mdcacheHeader->generation = 0;
+	mdcacheHeader->validGeneration = 0;
+	SHMQueueInit(&mdcacheHeader->lru);
+	mdcacheHeader->nblocks = nblocks;
+	mdcacheHeader->nfreeblocks = nblocks;
+	mdcacheHeader->freeBlock = 0;
+	for (i = 0; i < nblocks; i++)
+		mdcacheHeader->blockNext[i] = (i < nblocks - 1) ? i + 1 : -1;
+}
+
+/*
+ * MDSharedCacheShmemSize --- report amount of shared memory space needed
+ */
+Size
+MDSharedCacheShmemSize(void)
+{
+	int			nblocks = mdcache_num_blocks();
+	Size		size;
+
+	if (nblocks <= 0)
+		return 0;
+
+	size = add_size(offsetof(MDSharedCacheHeader, blockNext),
+					mul_size(nblocks, sizeof(int)));
+	size = add_size(size, mul_size(nblocks, MDSHAREDCACHE_BLOCKSIZE));
+	size = add_size(size, hash_estimate_size(nblocks,
+											 sizeof(MDSharedCacheEntry)));
+
+	return size;
+}
+
+/*
+ * MDSharedCacheShmemInit --- initialize this module's shared memory
+ */
+void
+MDSharedCacheShmemInit(void)
+{
+	int			nblocks = mdcache_num_blocks();
+	HASHCTL		info;
+	bool		found;
+
+	if (nblocks <= 0)
+		return;
+
+	mdcacheHeader = (MDSharedCacheHeader *)
+		ShmemInitStruct("ORCA Metadata Shared Cache",
+						offsetof(MDSharedCacheHeader, blockNext) +
+						nblocks * sizeof(int),
+						&found);
+
+	mdcacheBlocks = (char *)
+		ShmemInitStruct("ORCA Metadata Shared Cache Blocks",
+						mul_size(nblocks, MDSHAREDCACHE_BLOCKSIZE),
+						&found);
+
+	MemSet(&info, 0, sizeof(info));
+	info.keysize = sizeof(MDSharedCacheKey);
+	info.entrysize = sizeof(MDSharedCacheEntry);
+	info.hash = tag_hash;
+
+	mdcacheHash = ShmemInitHash("ORCA Metadata Shared Cache Hash",
+								nblocks, nblocks,
+								&info,
+								HASH_ELEM | HASH_FUNCTION);
+
+	if (!IsUnderPostmaster)
+	{
+		Assert(!found);
+		mdcache_init_header(nblocks);
+	}
+}
+
+/*
+ * Can the current transaction use the shared cache?
+ */
+bool
+MDSharedCacheIsUsable(void)
+{
+	return mdcacheHeader != NULL &&
+		OidIsValid(MyDatabaseId) &&
+		!TransactionIdIsValid(GetTopTransactionIdIfAny());
+}
+
+/*
+ * Fill in the hash key of a metadata id. Returns false if the id is too
+ * long to be cached.
+ */
+static bool
+mdcache_make_key(MDSharedCacheKey *key, const char *mdid)
+{
+	/* zero the padding, the key is hashed and compared as a whole */
+	MemSet(key, 0, sizeof(*key));
+	key->dbid = MyDatabaseId;
+
+	return strlcpy(key->mdid, mdid, sizeof(key->mdid)) < sizeof(key->mdid);
+}
+
+/*
+ * Is an entry visible, i.e. not made stale by a change to all catalogs?
+ */
+static bool
+mdcache_entry_is_valid(MDSharedCacheEntry *entry)
+{
+	return entry->generation >= mdcacheHeader->validGeneration;
+}
+
+/*
+ * Return the blocks of an entry to the free list, and remove the entry.
+ * Caller must hold MDSharedCacheLock exclusively.
+ */
+static void
+mdcache_remove_entry(MDSharedCacheEntry *entry)
+{
+	int			block = entry->firstBlock;
+
+	while (block >= 0)
+	{
+		int			next = mdcacheHeader->blockNext[block];
+
+		mdcacheHeader->blockNext[block] = mdcacheHeader->freeBlock;
+		mdcacheHeader->freeBlock = block;
+		mdcacheHeader->nfreeblocks++;
+		block = next;
+	}
+
+	SHMQueueDelete(&entry->lruLink);
+	hash_search(mdcacheHash, &entry->key, HASH_REMOVE, NULL);
+}
+
+/*
+ * Return the current generation of the cache. Pass it to
+ * MDSharedCacheInsert() for an object translated after this call.
+ *
+ * This also processes pending invalidation messages. A transaction sends its
+ * invalidation messages before it starts a new generation, so if it started
+ * one before we read the generation, our caches reflect its changes by the
+ * time we translate the object; if it starts one afterwards, the insert is
+ * refused.
+ */
+uint64
+MDSharedCacheGeneration(void)
+{
+	uint64		generation;
+
+	if (mdcacheHeader == NULL)
+		return 0;
+
+	LWLockAcquire(MDSharedCacheLock, LW_SHARED);
+	generation = mdcacheHeader->generation;
+	LWLockRelease(MDSharedCacheLock);
+
+	AcceptInvalidationMessages();
+
+	return generation;
+}
+
+/*
+ * Look up a serialized object. Returns a palloc'd copy of it, and its length
+ * in *len, or NULL if the object isn't cached.
+ */
+void *
+MDSharedCacheLookup(const char *mdid, Size *len)
+{
+	MDSharedCacheKey key;
+	MDSharedCacheEntry *entry;
+	char	   *result = NULL;
+
+	if (!MDSharedCacheIsUsable() || !mdcache_make_key(&key, mdid))
+		return NULL;
+
+	LWLockAcquire(MDSharedCacheLock, LW_SHARED);
+
+	entry = (MDSharedCacheEntry *) hash_search(mdcacheHash, &key,
+											   HASH_FIND, NULL);
+	if (entry != NULL && mdcache_entry_is_valid(entry))
+	{
+		Size		copied = 0;
+		int			block = entry->firstBlock;
+
+		result = palloc(entry->len);
+		while (copied < entry->len)
+		{
+			Size		chunk = Min(entry->len - copied, MDSHAREDCACHE_BLOCKSIZE);
+
+			Assert(block >= 0);
+			memcpy(result + copied,
+				   mdcacheBlocks + (Size) block * MDSHAREDCACHE_BLOCKSIZE,
+				   chunk);
+			copied += chunk;
+			block = mdcacheHeader->blockNext[block];
+		}
+		*len = entry->len;
+
+		/*
+		 * Concurrent lookups may set this too, and eviction only clears it
+		 * with the lock held exclusively, so a plain store is enough.
+		 */
+		entry->referenced = true;
+	}
+
+	LWLockRelease(MDSharedCacheLock);
+
+	return result;
+}
+
+/*
+ * Insert a serialized object, evicting the least recently used objects if
+ * needed. 'generation' is the result of MDSharedCacheGeneration() from
+ * before the object was translated; if a new generation has started since
+ * then, the object might be stale and is not inserted.
+ *
+ * 'relid' is the relation the object was translated from, whose changes
+ * make it stale, or InvalidOid if it isn't tied to a relation. If the
+ * relation is a partitioned table, pass 'partitioned', and a change to any
+ * relation makes the object stale.
+ *
+ * Returns true if the object is in the cache afterwards.
+ */
+bool
+MDSharedCacheInsert(const char *mdid, Oid relid, bool partitioned,
+					const void *data, Size len, uint64 generation)
+{
+	MDSharedCacheKey key;
+	MDSharedCacheEntry *entry;
+	bool		found;
+	int			nblocks;
+	int			i;
+	int		   *link;
+	Size		copied;
+
+	if (!MDSharedCacheIsUsable() || !mdcache_make_key(&key, mdid) || len == 0)
+		return false;
+
+	nblocks = (len + MDSHAREDCACHE_BLOCKSIZE - 1) / MDSHAREDCACHE_BLOCKSIZE;
+	if (nblocks > mdcacheHeader->nblocks / MDSHAREDCACHE_MAX_OBJECT_FRACTION)
+		return false;
+
+	LWLockAcquire(MDSharedCacheLock, LW_EXCLUSIVE);
+
+	if (mdcacheHeader->generation != generation)
+	{
+		LWLockRelease(MDSharedCacheLock);
+		return false;
+	}
+
+	/* Another backend might have beaten us to it */
+	entry = (MDSharedCacheEntry *) hash_search(mdcacheHash, &key,
+											   HASH_FIND, NULL);
+	if (entry != NULL)
+	{
+		if (mdcache_entry_is_valid(entry))
+		{
+			entry->referenced = true;
+			LWLockRelease(MDSharedCacheLock);
+			return true;
+		}
+		mdcache_remove_entry(entry);
+	}
+
+	/*
+	 * Evict from the head of the LRU list, giving entries that were looked
+	 * up since they last got there another round. A second round finds no
+	 * referenced entries, so this ends.
+	 */
+	while (mdcacheHeader->nfreeblocks < nblocks)
+	{
+		MDSharedCacheEntry *victim = (MDSharedCacheEntry *)
+			SHMQueueNext(&mdcacheHeader->lru, &mdcacheHeader->lru,
+						 offsetof(MDSharedCacheEntry, lruLink));
+
+		Assert(victim != NULL);
+		if (victim->referenced && mdcache_entry_is_valid(victim))
+		{
+			victim->referenced = false;
+			SHMQueueDelete(&victim->lruLink);
+			SHMQueueInsertBefore(&mdcacheHeader->lru, &victim->lruLink);
+		}
+		else
+			mdcache_remove_entry(victim);
+	}
+
+	/* There's an entry per used block at most, so this can't run out */
+	entry = (MDSharedCacheEntry *) hash_search(mdcacheHash, &key,
+											   HASH_ENTER_NULL, &found);
+	if (entry == NULL)
+	{
+		LWLockRelease(MDSharedCacheLock);
+		return false;
+	}
+	Assert(!found);
+
+	entry->generation = generation;
+	entry->relid = relid;
+	entry->partitioned = partitioned;
+	entry->referenced = false;
+	entry->len = len;
+	entry->nblocks = nblocks;
+	SHMQueueInsertBefore(&mdcacheHeader->lru, &entry->lruLink);
+
+	/* Take the blocks off the free list, and copy the object into them */
+	link = &entry->firstBlock;
+	copied = 0;
+	for (i = 0; i < nblocks; i++)
+	{
+		int			block = mdcacheHeader->freeBlock;
+		Size		chunk = Min(len - copied, MDSHAREDCACHE_BLOCKSIZE);
+
+		mdcacheHeader->freeBlock = mdcacheHeader->blockNext[block];
+		mdcacheHeader->nfreeblocks--;
+
+		memcpy(mdcacheBlocks + (Size) block * MDSHAREDCACHE_BLOCKSIZE,
+			   (const char *) data + copied,
+			   chunk);
+		copied += chunk;
+
+		*link = block;
+		link = &mdcacheHeader->blockNext[block];
+	}
+	*link = -1;
+
+	LWLockRelease(MDSharedCacheLock);
+
+	return true;
+}
+
+/*
+ * Check whether a committed invalidation message is about a catalog that
+ * metadata objects are translated from. This is called for each message of
+ * the committing transaction; MDSharedCacheAtCommit() then removes the
+ * entries they make stale.
+ *
+ * Any change to a catalog tuple produces a message for every syscache on the
+ * catalog, so it's enough to check one syscache of each catalog. This is the
+ * same set of catalogs that the optimizer's own cache listens to, see
+ * gpdbwrappers.cpp.
+ */
+void
+MDSharedCacheNoteInvalidation(SharedInvalidationMessage *msg)
+{
+	int			i;
+
+	if (mdcacheHeader == NULL || mdcacheInvalidateAll)
+		return;
+
+	if (msg->id == SHAREDINVALRELCACHE_ID)
+	{
+		Oid			relid = msg->rc.relId;
+
+		mdcacheInvalidationPending = true;
+
+		if (!OidIsValid(relid) ||
+			mdcacheNumChangedRels == MDSHAREDCACHE_MAX_CHANGED_RELS)
+		{
+			mdcacheInvalidateAll = true;
+			return;
+		}
+
+		for (i = 0; i < mdcacheNumChangedRels; i++)
+		{
+			if (mdcacheChangedRels[i] == relid)
+				return;
+		}
+		mdcacheChangedRels[mdcacheNumChangedRels++] = relid;
+		return;
+	}
+
+	if (msg->id < 0)
+		return;
+
+	switch (msg->cc.id)
+	{
+		case AGGFNOID:			/* pg_aggregate */
+		case AMOPOPID:			/* pg_amop */
+		case CASTSOURCETARGET:	/* pg_cast */
+		case CONSTROID:			/* pg_constraint */
+		case OPEROID:			/* pg_operator */
+		case OPFAMILYOID:		/* pg_opfamily */
+		case PARTOID:			/* pg_partition */
+		case PARTRULEOID:		/* pg_partition_rule */
+		case TYPEOID:			/* pg_type */
+		case PROCOID:			/* pg_proc */
+			mdcacheInvalidationPending = true;
+			mdcacheInvalidateAll = true;
+			break;
+
+		/*
+		 * pg_statistic changes come with a relcache message for their
+		 * relation, see PrepareForTupleInvalidation().
+		 */
+		default:
+			break;
+	}
+}
+
+/*
+ * Remove the entries made stale by the committing transaction, and start a
+ * new generation, if it changed any of the catalogs we care about.
+ */
+void
+MDSharedCacheAtCommit(void)
+{
+	if (!mdcacheInvalidationPending)
+		return;
+
+	LWLockAcquire(MDSharedCacheLock, LW_EXCLUSIVE);
+
+	mdcacheHeader->generation++;
+
+	if (mdcacheInvalidateAll)
+		mdcacheHeader->validGeneration = mdcacheHeader->generation;
+	else
+	{
+		HASH_SEQ_STATUS status;
+		MDSharedCacheEntry *entry;
+		int			i;
+
+		hash_seq_init(&status, mdcacheHash);
+		while ((entry = (MDSharedCacheEntry *) hash_seq_search(&status)) != NULL)
+		{
+			bool		stale = entry->partitioned;
+
+			for (i = 0; i < mdcacheNumChangedRels && !stale; i++)
+				stale = (entry->relid == mdcacheChangedRels[i]);
+
+			/* removing the entry just returned doesn't disturb the scan */
+			if (stale)
+				mdcache_remove_entry(entry);
+		}
+	}
+
+	LWLockRelease(MDSharedCacheLock);
+
+	mdcacheInvalidationPending = false;
+	mdcacheInvalidateAll = false;
+	mdcacheNumChangedRels = 0;
+}
@@ -0,0 +1,227 @@
+/*-------------------------------------------------------------------------
+ *
+ * optplancache.c
+ *	  Cache of plans produced by the Pivotal Query Optimizer.
+ *
+ * Dashboards and prepared statements send the same queries over and over,
+ * and optimizing them often takes longer than executing them. This module
+ * keeps the last optimizer_plan_cache_size plans produced by the optimizer
+ * in this backend, so that an identical query can reuse the plan.
+ *
+ * The optimizer identifies a query by a fingerprint: the serialized DXL of
+ * the query, as translated from the Query tree, followed by all the settings
+ * that affect optimization. The DXL refers to catalog objects by OID and
+ * doesn't contain anything that's irrelevant to planning, so queries that
+ * differ only in spelling or whitespace share a fingerprint. Parameters of
+ * prepared statements have been folded into constants by the time the query
+ * is translated, so a plan is only reused for the same parameter values.
+ *
+ * A cached plan depends on the relations and their statistics, which are
+ * tracked individually, and on all kinds of other catalog objects (types,
+ * functions, operators, casts), which are not. The optimizer tells us about
+ * catalog changes as it brings its metadata cache up to date, see
+ * COptTasks::FRefreshMDCache(): changes to relations evict the plans that
+ * use them, and any other change evicts all plans.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/hash.h"
+#include "lib/dllist.h"
+#include "optimizer/planmain.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/optplancache.h"
+
+typedef struct OptPlanCacheEntry
+{
+	uint32		hashvalue;		/* hash of the fingerprint, must be first */
+	char	   *fingerprint;	/* the fingerprint itself */
+	List	   *relationOids;	/* relations the plan depends on */
+	PlannedStmt *plan;			/* the plan */
+	MemoryContext context;		/* holds all of the above */
+	Dlelem		lruElem;		/* link in the LRU list */
+} OptPlanCacheEntry;
+
+static HTAB *OptPlanCacheHash = NULL;
+static MemoryContext OptPlanCacheContext = NULL;
+
+/* Cached plans, most recently used first */
+static Dllist OptPlanCacheLRU;
+
+static void
+init_opt_plan_cache(void)
+{
+	HASHCTL		ctl;
+
+	OptPlanCacheContext = AllocSetContextCreate(CacheMemoryContext,
+												"Optimizer Plan Cache",
+												ALLOCSET_DEFAULT_MINSIZE,
+												ALLOCSET_DEFAULT_INITSIZE,
+												ALLOCSET_DEFAULT_MAXSIZE);
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(uint32);
+	ctl.entrysize = sizeof(OptPlanCacheEntry);
+	ctl.hash = tag_hash;
+	ctl.hcxt = OptPlanCacheContext;
+	OptPlanCacheHash = hash_create("Optimizer Plan Cache", 64, &ctl,
+								   HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+
+	DLInitList(&OptPlanCacheLRU);
+}
+
+static void
+remove_entry(OptPlanCacheEntry *entry)
+{
+	DLRemove(&entry->lruElem);
+	MemoryContextDelete(entry->context);
+	hash_search(OptPlanCacheHash, &entry->hashvalue, HASH_REMOVE, NULL);
+}
+
+/*
+ * Return a copy of the cached plan of a query with the given fingerprint, in
+ * the current memory context, or NULL if there is none.
+ */
+PlannedStmt *
+OptPlanCacheLookup(const char *fingerprint)
+{
+	OptPlanCacheEntry *entry;
+	uint32		hashvalue;
+
+	if (OptPlanCacheHash == NULL || optimizer_plan_cache_size <= 0)
+		return NULL;
+
+	hashvalue = DatumGetUInt32(hash_any((const unsigned char *) fingerprint,
+										strlen(fingerprint)));
+	entry = (OptPlanCacheEntry *) hash_search(OptPlanCacheHash, &hashvalue,
+											  HASH_FIND, NULL);
+
+	/* a different query could have the same hash */
+	if (entry == NULL || strcmp(entry->fingerprint, fingerprint) != 0)
+		return NULL;
+
+	DLMoveToFront(&entry->lruElem);
+
+	return (PlannedStmt *) copyObject(entry->plan);
+}
+
+/*
+ * Cache the plan of a query with the given fingerprint. 'query' is the
+ * Query tree the plan was produced from, for finding out the relations the
+ * plan depends on.
+ */
+void
+OptPlanCacheInsert(const char *fingerprint, Query *query, PlannedStmt *plan)
+{
+	OptPlanCacheEntry *entry;
+	uint32		hashvalue;
+	char	   *fingerprint_copy;
+	MemoryContext cxt;
+	MemoryContext oldcxt;
+	List	   *relationOids;
+	List	   *invalItems;
+	ListCell   *lc;
+	bool		found;
+
+	if (optimizer_plan_cache_size <= 0)
+		return;
+
+	if (OptPlanCacheHash == NULL)
+		init_opt_plan_cache();
+
+	/*
+	 * Like the plans in plancache.c, the plan depends on the relations in its
+	 * range table, and on those that views in the query were expanded into.
+	 */
+	extract_query_dependencies(list_make1(query), &relationOids, &invalItems);
+	foreach(lc, plan->rtable)
+	{
+		RangeTblEntry *rte = (RangeTblEntry *) lfirst(lc);
+
+		if (rte->rtekind == RTE_RELATION)
+			relationOids = list_append_unique_oid(relationOids, rte->relid);
+	}
+
+	hashvalue = DatumGetUInt32(hash_any((const unsigned char *) fingerprint,
+										strlen(fingerprint)));
+
+	/* Replace any plan of another query with the same hash */
+	entry = (OptPlanCacheEntry *) hash_search(OptPlanCacheHash, &hashvalue,
+											  HASH_FIND, NULL);
+	if (entry != NULL)
+		remove_entry(entry);
+
+	while (hash_get_num_entries(OptPlanCacheHash) >= optimizer_plan_cache_size)
+		remove_entry((OptPlanCacheEntry *) DLE_VAL(DLGetTail(&OptPlanCacheLRU)));
+
+	cxt = AllocSetContextCreate(OptPlanCacheContext,
+								"Optimizer Cached Plan",
+								ALLOCSET_SMALL_MINSIZE,
+								ALLOCSET_SMALL_INITSIZE,
+								ALLOCSET_DEFAULT_MAXSIZE);
+	oldcxt = MemoryContextSwitchTo(cxt);
+	fingerprint_copy = pstrdup(fingerprint);
+	relationOids = list_copy(relationOids);
+	plan = (PlannedStmt *) copyObject(plan);
+	MemoryContextSwitchTo(oldcxt);
+
+	entry = (OptPlanCacheEntry *) hash_search(OptPlanCacheHash, &hashvalue,
+											  HASH_ENTER, &found);
+	Assert(!found);
+
+	entry->fingerprint = fingerprint_copy;
+	entry->relationOids = relationOids;
+	entry->plan = plan;
+	entry->context = cxt;
+	DLInitElem(&entry->lruElem, entry);
+	DLAddHead(&OptPlanCacheLRU, &entry->lruElem);
+}
+
+/*
+ * Evict the plans that depend on any of the given relations.
+ */
+void
+OptPlanCacheInvalidate(List *relids)
+{
+	HASH_SEQ_STATUS status;
+	OptPlanCacheEntry *entry;
+
+	if (OptPlanCacheHash == NULL || relids == NIL)
+		return;
+
+	/* dynahash allows removing the current entry during a scan */
+	hash_seq_init(&status, OptPlanCacheHash);
+	while ((entry = (OptPlanCacheEntry *) hash_seq_search(&status)) != NULL)
+	{
+		ListCell   *lc;
+
+		foreach(lc, relids)
+		{
+			if (list_member_oid(entry->relationOids, lfirst_oid(lc)))
+			{
+				remove_entry(entry);
+				break;
+			}
+		}
+	}
+}
+
+/*
+ * Evict all plans.
+ */
+void
+OptPlanCacheReset(void)
+{
+	if (OptPlanCacheHash == NULL)
+		return;
+
+	hash_destroy(OptPlanCacheHash);
+	MemoryContextDelete(OptPlanCacheContext);
+	OptPlanCacheHash = NULL;
+	OptPlanCacheContext = NULL;
+}
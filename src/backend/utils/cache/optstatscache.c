@@ -0,0 +1,179 @@
+/*-------------------------------------------------------------------------
+ *
+ * optstatscache.c
+ *	  Cache of column statistics translated for the Pivotal Query Optimizer.
+ *
+ * Turning the MCV and histogram arrays of a pg_statistic row into the
+ * optimizer's histogram buckets means deconstructing the arrays, translating
+ * every value and merging the MCVs into the histogram. For tables with many
+ * columns and large statistics targets that dominates the time spent fetching
+ * metadata, and it is repeated whenever the optimizer's metadata cache has
+ * dropped the column statistics, for example after ANALYZE of another column
+ * of the same table.
+ *
+ * This module keeps the translated statistics of a column, in a compact
+ * binary form produced and consumed by CTranslatorRelcacheToDXL, for up to
+ * optimizer_stats_cache_size kilobytes per backend. The contents are opaque
+ * here. An entry is only valid for the pg_statistic row version it was
+ * built from, identified by the row's xmin and TID, and for the reltuples
+ * of the relation at that time, which the number of distinct values can
+ * depend on. Entries built from an older version are dropped on lookup, so
+ * no invalidation callbacks are needed.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "lib/dllist.h"
+#include "storage/itemptr.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/optstatscache.h"
+
+typedef struct OptStatsCacheKey
+{
+	Oid			relid;
+	AttrNumber	attnum;
+} OptStatsCacheKey;
+
+typedef struct OptStatsCacheEntry
+{
+	OptStatsCacheKey key;		/* hash key, must be first */
+	TransactionId xmin;			/* version of the pg_statistic row */
+	ItemPointerData tid;
+	float4		reltuples;		/* reltuples of the relation */
+	Size		len;			/* length of data */
+	char	   *data;			/* translated statistics */
+	Dlelem		lruElem;		/* link in the LRU list */
+} OptStatsCacheEntry;
+
+static HTAB *OptStatsCacheHash = NULL;
+static MemoryContext OptStatsCacheContext = NULL;
+
+/* Cached statistics, most recently used first */
+static Dllist OptStatsCacheLRU;
+
+/* Total size of the cached statistics */
+static Size OptStatsCacheBytes = 0;
+
+static void
+init_opt_stats_cache(void)
+{
+	HASHCTL		ctl;
+
+	OptStatsCacheContext = AllocSetContextCreate(CacheMemoryContext,
+												 "Optimizer Stats Cache",
+												 ALLOCSET_DEFAULT_MINSIZE,
+												 ALLOCSET_DEFAULT_INITSIZE,
+												 ALLOCSET_DEFAULT_MAXSIZE);
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(OptStatsCacheKey);
+	ctl.entrysize = sizeof(OptStatsCacheEntry);
+	ctl.hash = tag_hash;
+	ctl.hcxt = OptStatsCacheContext;
+	OptStatsCacheHash = hash_create("Optimizer Stats Cache", 256, &ctl,
+									HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+
+	DLInitList(&OptStatsCacheLRU);
+	OptStatsCacheBytes = 0;
+}
+
+static void
+remove_entry(OptStatsCacheEntry *entry)
+{
+	DLRemove(&entry->lruElem);
+	OptStatsCacheBytes -= entry->len;
+	pfree(entry->data);
+	hash_search(OptStatsCacheHash, &entry->key, HASH_REMOVE, NULL);
+}
+
+/*
+ * Return the cached statistics of a column, or NULL if there are none for
+ * the given version of its pg_statistic row. The result points into the
+ * cache, and is only valid until the next OptStatsCacheInsert().
+ */
+void *
+OptStatsCacheLookup(Oid relid, AttrNumber attnum, HeapTuple statstup,
+					float4 reltuples, Size *len)
+{
+	OptStatsCacheKey key;
+	OptStatsCacheEntry *entry;
+
+	if (OptStatsCacheHash == NULL || optimizer_stats_cache_size <= 0)
+		return NULL;
+
+	MemSet(&key, 0, sizeof(key));
+	key.relid = relid;
+	key.attnum = attnum;
+	entry = (OptStatsCacheEntry *) hash_search(OptStatsCacheHash, &key,
+											   HASH_FIND, NULL);
+	if (entry == NULL)
+		return NULL;
+
+	if (entry->xmin != HeapTupleHeaderGetXmin(statstup->t_data) ||
+		!ItemPointerEquals(&entry->tid, &statstup->t_self) ||
+		entry->reltuples != reltuples)
+	{
+		remove_entry(entry);
+		return NULL;
+	}
+
+	DLMoveToFront(&entry->lruElem);
+
+	*len = entry->len;
+	return entry->data;
+}
+
+/*
+ * Cache the translated statistics of a column, built from the given version
+ * of its pg_statistic row.
+ */
+void
+OptStatsCacheInsert(Oid relid, AttrNumber attnum, HeapTuple statstup,
+					float4 reltuples, const void *data, Size len)
+{
+	OptStatsCacheKey key;
+	OptStatsCacheEntry *entry;
+	Size		limit = (Size) optimizer_stats_cache_size * 1024L;
+	char	   *data_copy;
+	bool		found;
+
+	if (optimizer_stats_cache_size <= 0 || len > limit)
+		return;
+
+	if (OptStatsCacheHash == NULL)
+		init_opt_stats_cache();
+
+	MemSet(&key, 0, sizeof(key));
+	key.relid = relid;
+	key.attnum = attnum;
+
+	entry = (OptStatsCacheEntry *) hash_search(OptStatsCacheHash, &key,
+											   HASH_FIND, NULL);
+	if (entry != NULL)
+		remove_entry(entry);
+
+	/* make room by evicting the least recently used statistics */
+	while (OptStatsCacheBytes + len > limit)
+		remove_entry((OptStatsCacheEntry *) DLE_VAL(DLGetTail(&OptStatsCacheLRU)));
+
+	data_copy = MemoryContextAlloc(OptStatsCacheContext, len);
+	memcpy(data_copy, data, len);
+
+	entry = (OptStatsCacheEntry *) hash_search(OptStatsCacheHash, &key,
+											   HASH_ENTER, &found);
+	Assert(!found);
+
+	entry->xmin = HeapTupleHeaderGetXmin(statstup->t_data);
+	entry->tid = statstup->t_self;
+	entry->reltuples = reltuples;
+	entry->len = len;
+	entry->data = data_copy;
+	DLInitElem(&entry->lruElem, entry);
+	DLAddHead(&OptStatsCacheLRU, &entry->lruElem);
+	OptStatsCacheBytes += len;
+}
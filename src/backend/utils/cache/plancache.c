@@ -70,8 +70,10 @@ static bool ScanQueryWalker(Node *node, bool *acquire);
 static bool rowmark_member(List *rowMarks, int rt_index);
 static bool plan_list_is_transient(List *stmt_list);
 static void PlanCacheRelCallback(Datum arg, Oid relid);
-static void PlanCacheFuncCallback(Datum arg, int cacheid, ItemPointer tuplePtr);
-static void PlanCacheSysCallback(Datum arg, int cacheid, ItemPointer tuplePtr);
+static void PlanCacheFuncCallback(Datum arg, int cacheid, ItemPointer tuplePtr,
+								  uint32 hashValue);
+static void PlanCacheSysCallback(Datum arg, int cacheid, ItemPointer tuplePtr,
+								 uint32 hashValue);
 
 
 /*
@@ -1040,7 +1042,8 @@ PlanCacheRelCallback(Datum arg, Oid relid)
  * now only user-defined functions are tracked this way.
  */
 static void
-PlanCacheFuncCallback(Datum arg, int cacheid, ItemPointer tuplePtr)
+PlanCacheFuncCallback(Datum arg, int cacheid, ItemPointer tuplePtr,
+					  uint32 hashValue)
 {
 	ListCell   *lc1;
 
@@ -1113,7 +1116,8 @@ PlanCacheFuncCallback(Datum arg, int cacheid, ItemPointer tuplePtr)
  * Just invalidate everything...
  */
 static void
-PlanCacheSysCallback(Datum arg, int cacheid, ItemPointer tuplePtr)
+PlanCacheSysCallback(Datum arg, int cacheid, ItemPointer tuplePtr,
+					 uint32 hashValue)
 {
 	ResetPlanCache();
 }
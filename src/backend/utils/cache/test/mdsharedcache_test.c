@@ -0,0 +1,244 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmockery.h"
+
+#include "../mdsharedcache.c"
+#include "utils/memutils.h"
+
+#define TEST_NBLOCKS	8
+
+/*
+ * Set up a cache of the given number of blocks in local memory, the way
+ * MDSharedCacheShmemInit() does in shared memory.
+ */
+static void
+setup_cache(int nblocks)
+{
+	HASHCTL		info;
+
+	mdcacheHeader = (MDSharedCacheHeader *)
+		malloc(offsetof(MDSharedCacheHeader, blockNext) + nblocks * sizeof(int));
+	mdcacheBlocks = (char *) malloc(nblocks * MDSHAREDCACHE_BLOCKSIZE);
+
+	MemSet(&info, 0, sizeof(info));
+	info.keysize = sizeof(MDSharedCacheKey);
+	info.entrysize = sizeof(MDSharedCacheEntry);
+	info.hash = tag_hash;
+	mdcacheHash = hash_create("Test MD shared cache", nblocks, &info,
+							  HASH_ELEM | HASH_FUNCTION);
+
+	mdcache_init_header(nblocks);
+
+	MyDatabaseId = 1;
+}
+
+static void
+teardown_cache(void)
+{
+	hash_destroy(mdcacheHash);
+	free(mdcacheBlocks);
+	free(mdcacheHeader);
+	mdcacheHash = NULL;
+	mdcacheBlocks = NULL;
+	mdcacheHeader = NULL;
+}
+
+static void
+expect_lock(LWLockMode mode)
+{
+	expect_value(LWLockAcquire, lockid, MDSharedCacheLock);
+	expect_value(LWLockAcquire, mode, mode);
+	will_be_called(LWLockAcquire);
+	expect_value(LWLockRelease, lockid, MDSharedCacheLock);
+	will_be_called(LWLockRelease);
+}
+
+static uint64
+get_generation(void)
+{
+	expect_lock(LW_SHARED);
+	will_be_called(AcceptInvalidationMessages);
+	return MDSharedCacheGeneration();
+}
+
+static bool
+insert(const char *mdid, Oid relid, bool partitioned)
+{
+	uint64		generation = get_generation();
+
+	expect_lock(LW_EXCLUSIVE);
+	return MDSharedCacheInsert(mdid, relid, partitioned,
+							   mdid, strlen(mdid) + 1, generation);
+}
+
+static bool
+is_cached(const char *mdid)
+{
+	Size		len;
+	char	   *data;
+
+	expect_lock(LW_SHARED);
+	data = MDSharedCacheLookup(mdid, &len);
+	if (data == NULL)
+		return false;
+
+	assert_int_equal(len, strlen(mdid) + 1);
+	assert_string_equal(data, mdid);
+	pfree(data);
+	return true;
+}
+
+static void
+commit_relcache_change(Oid relid)
+{
+	SharedInvalidationMessage msg;
+
+	msg.rc.id = SHAREDINVALRELCACHE_ID;
+	msg.rc.dbId = MyDatabaseId;
+	msg.rc.relId = relid;
+	MDSharedCacheNoteInvalidation(&msg);
+
+	expect_lock(LW_EXCLUSIVE);
+	MDSharedCacheAtCommit();
+}
+
+/*
+ * Lookups only take the lock in shared mode.
+ */
+void
+test__lookup_takes_shared_lock(void **state)
+{
+	setup_cache(TEST_NBLOCKS);
+
+	assert_true(insert("0.100.1.0", 100, false));
+	assert_true(is_cached("0.100.1.0"));
+	assert_false(is_cached("0.200.1.0"));
+
+	teardown_cache();
+}
+
+/*
+ * A change to a relation removes the entries of that relation and of
+ * partitioned tables, and leaves everything else alone.
+ */
+void
+test__relation_change_removes_its_entries(void **state)
+{
+	setup_cache(TEST_NBLOCKS);
+
+	assert_true(insert("0.100.1.0", 100, false));
+	assert_true(insert("2.100.1.0", 100, false));
+	assert_true(insert("0.200.1.0", 200, false));
+	assert_true(insert("0.300.1.0", 300, true));
+	assert_true(insert("0.23.1.0", InvalidOid, false));
+
+	commit_relcache_change(100);
+
+	assert_false(is_cached("0.100.1.0"));
+	assert_false(is_cached("2.100.1.0"));
+	assert_true(is_cached("0.200.1.0"));
+	assert_false(is_cached("0.300.1.0"));
+	assert_true(is_cached("0.23.1.0"));
+
+	teardown_cache();
+}
+
+/*
+ * A change to one of the other catalogs makes all entries invisible.
+ */
+void
+test__catalog_change_hides_all_entries(void **state)
+{
+	SharedInvalidationMessage msg;
+
+	setup_cache(TEST_NBLOCKS);
+
+	assert_true(insert("0.200.1.0", 200, false));
+	assert_true(insert("0.23.1.0", InvalidOid, false));
+
+	MemSet(&msg, 0, sizeof(msg));
+	msg.cc.id = TYPEOID;
+	msg.cc.dbId = MyDatabaseId;
+	MDSharedCacheNoteInvalidation(&msg);
+	expect_lock(LW_EXCLUSIVE);
+	MDSharedCacheAtCommit();
+
+	assert_false(is_cached("0.200.1.0"));
+	assert_false(is_cached("0.23.1.0"));
+
+	/* re-inserting replaces the invisible entry */
+	assert_true(insert("0.23.1.0", InvalidOid, false));
+	assert_true(is_cached("0.23.1.0"));
+
+	teardown_cache();
+}
+
+/*
+ * An object translated before a change was committed is not inserted.
+ */
+void
+test__insert_refused_after_new_generation(void **state)
+{
+	uint64		generation;
+
+	setup_cache(TEST_NBLOCKS);
+
+	generation = get_generation();
+	commit_relcache_change(100);
+
+	expect_lock(LW_EXCLUSIVE);
+	assert_false(MDSharedCacheInsert("0.100.1.0", 100, false,
+									 "0.100.1.0", 10, generation));
+	assert_false(is_cached("0.100.1.0"));
+
+	teardown_cache();
+}
+
+/*
+ * Eviction gives entries that were looked up another round.
+ */
+void
+test__eviction_spares_referenced_entries(void **state)
+{
+	char		mdid[MDSHAREDCACHE_KEYSIZE];
+	int			i;
+
+	setup_cache(TEST_NBLOCKS);
+
+	for (i = 0; i < TEST_NBLOCKS; i++)
+	{
+		snprintf(mdid, sizeof(mdid), "0.%d.1.0", 1000 + i);
+		assert_true(insert(mdid, 1000 + i, false));
+	}
+
+	/* all blocks are used; look up the oldest entry */
+	assert_true(is_cached("0.1000.1.0"));
+
+	assert_true(insert("0.2000.1.0", 2000, false));
+
+	assert_true(is_cached("0.1000.1.0"));
+	assert_false(is_cached("0.1001.1.0"));
+	assert_true(is_cached("0.1002.1.0"));
+	assert_true(is_cached("0.2000.1.0"));
+
+	teardown_cache();
+}
+
+int
+main(int argc, char* argv[])
+{
+	cmockery_parse_arguments(argc, argv);
+
+	const UnitTest tests[] = {
+		unit_test(test__lookup_takes_shared_lock),
+		unit_test(test__relation_change_removes_its_entries),
+		unit_test(test__catalog_change_hides_all_entries),
+		unit_test(test__insert_refused_after_new_generation),
+		unit_test(test__eviction_spares_referenced_entries)
+	};
+
+	MemoryContextInit();
+
+	return run_tests(tests);
+}
@@ -0,0 +1,421 @@
+/*-------------------------------------------------------------------------
+ *
+ * optcalibrate.c
+ *	  Calibration of the Pivotal Query Optimizer's cost model.
+ *
+ * The cost units of the optimizer's cost model were measured once, on one
+ * kind of hardware. On a cluster with faster disks, a faster network or more
+ * segments per host, reading, hashing, sorting and sending a byte don't cost
+ * the same relative to each other, which skews the optimizer's choice of join
+ * order and motions.
+ *
+ * gp_calibrate_optimizer_cost_model() runs a few queries against synthetic
+ * tables, each one exercising an operation on top of a sequential scan, and
+ * derives the cost of the operation per byte from the difference in run time.
+ * The costs are stored in gp_optimizer_cost_params relative to the cost of
+ * scanning a byte. Elapsed times are measured on the master for the whole
+ * cluster, so the ratios are independent of the number of segments, and of
+ * the scale of the optimizer's costs: the optimizer multiplies them by its own
+ * TableScanCostUnit, see COptTasks::SetCalibratedCostModelParams().
+ *
+ * The parameters are cached in each backend. The calibration sends a relcache
+ * invalidation for gp_optimizer_cost_params, which makes every backend reload
+ * them and drop the plans it cached with the old ones.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <math.h>
+
+#include "miscadmin.h"
+#include "access/heapam.h"
+#include "catalog/gp_optimizer_cost_params.h"
+#include "cdb/cdbvars.h"
+#include "executor/spi.h"
+#include "portability/instr_time.h"
+#include "utils/builtins.h"
+#include "utils/guc.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+#include "utils/optcalibrate.h"
+#include "utils/optplancache.h"
+
+/* Each query is run this many times, and the fastest run is used */
+#define CALIBRATION_RUNS		3
+
+/* Below this, start-up costs dominate the run time of the queries */
+#define MIN_CALIBRATION_ROWS	100000
+
+/* The small table of the hash join benchmark has 1/10 of the rows */
+#define SMALL_TABLE_FRACTION	10
+
+/*
+ * Bounds of a cost unit relative to that of scanning a byte. Beyond them, a
+ * measurement says more about noise than about the hardware.
+ */
+#define MIN_COST_UNIT_RATIO		0.001
+#define MAX_COST_UNIT_RATIO		1000.0
+
+typedef struct CostParam
+{
+	const char *name;
+	double		value;
+} CostParam;
+
+/* Cached contents of gp_optimizer_cost_params, in CacheMemoryContext */
+static List *CostParams = NIL;
+static bool CostParamsValid = false;
+static uint32 CostParamsInvalCount = 0;
+static bool CostParamsCallbackRegistered = false;
+
+static void
+run_command(const char *sql)
+{
+	if (SPI_execute(sql, false, 0) < 0)
+		elog(ERROR, "could not run calibration command: %s", sql);
+}
+
+static double
+query_float8(const char *sql)
+{
+	bool		isnull;
+	Datum		d;
+
+	if (SPI_execute(sql, true, 1) != SPI_OK_SELECT || SPI_processed != 1)
+		elog(ERROR, "could not run calibration query: %s", sql);
+
+	d = SPI_getbinval(SPI_tuptable->vals[0], SPI_tuptable->tupdesc, 1, &isnull);
+	if (isnull)
+		elog(ERROR, "calibration query returned NULL: %s", sql);
+
+	return DatumGetFloat8(d);
+}
+
+/*
+ * Return the elapsed time of the fastest of CALIBRATION_RUNS runs of a query,
+ * in seconds.
+ */
+static double
+time_query(const char *sql)
+{
+	double		best = -1.0;
+	int			i;
+
+	for (i = 0; i < CALIBRATION_RUNS; i++)
+	{
+		instr_time	starttime;
+		instr_time	elapsed;
+
+		CHECK_FOR_INTERRUPTS();
+
+		INSTR_TIME_SET_CURRENT(starttime);
+		if (SPI_execute(sql, true, 0) != SPI_OK_SELECT)
+			elog(ERROR, "could not run calibration query: %s", sql);
+		INSTR_TIME_SET_CURRENT(elapsed);
+		INSTR_TIME_SUBTRACT(elapsed, starttime);
+
+		if (best < 0.0 || INSTR_TIME_GET_DOUBLE(elapsed) < best)
+			best = INSTR_TIME_GET_DOUBLE(elapsed);
+	}
+
+	return best;
+}
+
+/*
+ * Add a measured cost unit, unless the measurement drowned in noise. A unit
+ * out of bounds is clamped to them.
+ */
+static int
+add_param(CostParam *params, int nparams, const char *name, double value)
+{
+	if (value <= 0.0 || isnan(value) || isinf(value))
+	{
+		ereport(WARNING,
+				(errmsg("could not measure optimizer cost parameter \"%s\"", name),
+				 errhint("Calibrate with a larger number of rows.")));
+		return nparams;
+	}
+
+	if (value < MIN_COST_UNIT_RATIO || value > MAX_COST_UNIT_RATIO)
+	{
+		double		clamped = Max(Min(value, MAX_COST_UNIT_RATIO), MIN_COST_UNIT_RATIO);
+
+		ereport(WARNING,
+				(errmsg("optimizer cost parameter \"%s\" measured as %g, using %g",
+						name, value, clamped),
+				 errhint("Calibrate with a larger number of rows.")));
+		value = clamped;
+	}
+
+	params[nparams].name = name;
+	params[nparams].value = value;
+	return nparams + 1;
+}
+
+/*
+ * Replace the contents of gp_optimizer_cost_params.
+ */
+static void
+store_params(CostParam *params, int nparams)
+{
+	Relation	rel;
+	HeapScanDesc scan;
+	HeapTuple	tuple;
+	Datum		values[Natts_gp_optimizer_cost_params];
+	bool		nulls[Natts_gp_optimizer_cost_params];
+	NameData	name;
+	int			i;
+
+	/* one calibration at a time */
+	rel = heap_open(GpOptimizerCostParamsRelationId, ExclusiveLock);
+
+	scan = heap_beginscan(rel, SnapshotNow, 0, NULL);
+	while ((tuple = heap_getnext(scan, ForwardScanDirection)) != NULL)
+		simple_heap_delete(rel, &tuple->t_self);
+	heap_endscan(scan);
+
+	MemSet(nulls, false, sizeof(nulls));
+	for (i = 0; i < nparams; i++)
+	{
+		namestrcpy(&name, params[i].name);
+		values[Anum_gp_optimizer_cost_params_paramname - 1] = NameGetDatum(&name);
+		values[Anum_gp_optimizer_cost_params_paramvalue - 1] = Float8GetDatum(params[i].value);
+
+		tuple = heap_form_tuple(RelationGetDescr(rel), values, nulls);
+		simple_heap_insert(rel, tuple);
+		heap_freetuple(tuple);
+	}
+
+	/* make all backends reload the parameters, see CostParamsRelCallback() */
+	CacheInvalidateRelcache(rel);
+
+	heap_close(rel, NoLock);
+}
+
+/*
+ * Measure the cost units of the optimizer's cost model on this cluster and
+ * store them in gp_optimizer_cost_params. The argument is the number of rows
+ * of the table the benchmarks run on. Returns the number of cost units
+ * stored.
+ */
+Datum
+gp_calibrate_optimizer_cost_model(PG_FUNCTION_ARGS)
+{
+	int32		nrows = PG_GETARG_INT32(0);
+	int32		nsmall = nrows / SMALL_TABLE_FRACTION;
+	int			nsegments;
+	int			save_nestlevel;
+	double		width;
+	double		bytes;
+	double		small_bytes;
+	double		scan_time;
+	double		join_time;
+	double		small_join_time;
+	double		hash_time;
+	double		small_hash_time;
+	double		sort_time;
+	double		motion_time;
+	double		scan_unit;
+	double		build_unit;
+	double		probe_unit;
+	double		sort_unit;
+	double		motion_unit;
+	CostParam	params[5];
+	int			nparams = 0;
+	char		sql[512];
+
+	if (!superuser())
+		ereport(ERROR,
+				(errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+				 errmsg("must be superuser to calibrate the optimizer cost model")));
+
+	if (Gp_role != GP_ROLE_DISPATCH)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("the optimizer cost model can only be calibrated on the master")));
+
+	if (nrows < MIN_CALIBRATION_ROWS)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of rows must be at least %d", MIN_CALIBRATION_ROWS)));
+
+	nsegments = getgpsegmentCount();
+
+	/*
+	 * The benchmarks rely on the plans the planner picks for them: hash joins
+	 * that build the hash table on the smaller input, and a redistribute
+	 * motion for a join on a column that is not the distribution key.
+	 */
+	save_nestlevel = NewGUCNestLevel();
+	(void) set_config_option("optimizer", "off",
+							 PGC_USERSET, PGC_S_SESSION, GUC_ACTION_SAVE, true);
+	(void) set_config_option("enable_mergejoin", "off",
+							 PGC_USERSET, PGC_S_SESSION, GUC_ACTION_SAVE, true);
+	(void) set_config_option("enable_nestloop", "off",
+							 PGC_USERSET, PGC_S_SESSION, GUC_ACTION_SAVE, true);
+
+	if (SPI_connect() != SPI_OK_CONNECT)
+		elog(ERROR, "SPI_connect failed");
+
+	snprintf(sql, sizeof(sql),
+			 "CREATE TEMP TABLE gp_calibrate_big AS "
+			 "SELECT i AS a, i AS d, repeat('x', 32) || i AS c "
+			 "FROM generate_series(1, %d) i DISTRIBUTED BY (a)", nrows);
+	run_command(sql);
+	snprintf(sql, sizeof(sql),
+			 "CREATE TEMP TABLE gp_calibrate_small AS "
+			 "SELECT * FROM gp_calibrate_big WHERE a <= %d DISTRIBUTED BY (a)", nsmall);
+	run_command(sql);
+	run_command("ANALYZE gp_calibrate_big");
+	run_command("ANALYZE gp_calibrate_small");
+
+	width = query_float8("SELECT avg(pg_column_size(a) + pg_column_size(d) + pg_column_size(c))::float8 "
+						 "FROM gp_calibrate_big");
+	bytes = width * nrows;
+	small_bytes = width * nsmall;
+
+	/* sequential scan */
+	scan_time = time_query("SELECT count(c) FROM gp_calibrate_big");
+
+	/* co-located hash joins, building on equally large and on smaller input */
+	join_time = time_query("SELECT count(t1.c), count(t2.c) FROM gp_calibrate_big t1 "
+						   "JOIN gp_calibrate_big t2 ON t1.a = t2.a");
+	small_join_time = time_query("SELECT count(t1.c), count(t2.c) FROM gp_calibrate_big t1 "
+								 "JOIN gp_calibrate_small t2 ON t1.a = t2.a");
+
+	/* sort */
+	sort_time = time_query("SELECT count(c) FROM "
+						   "(SELECT * FROM gp_calibrate_big ORDER BY c) s");
+
+	/* the first hash join, with one input redistributed */
+	motion_time = time_query("SELECT count(t1.c), count(t2.c) FROM gp_calibrate_big t1 "
+							 "JOIN gp_calibrate_big t2 ON t1.a = t2.d");
+
+	run_command("DROP TABLE gp_calibrate_small");
+	run_command("DROP TABLE gp_calibrate_big");
+
+	SPI_finish();
+
+	AtEOXact_GUC(true, save_nestlevel);
+
+	/*
+	 * Both joins hash one input and probe with all of the big table, so the
+	 * difference between them is the cost of building the larger hash table.
+	 */
+	scan_unit = scan_time / bytes;
+	hash_time = join_time - 2 * scan_time;
+	small_hash_time = small_join_time - scan_time - scan_unit * small_bytes;
+	build_unit = (hash_time - small_hash_time) / (bytes - small_bytes);
+	probe_unit = (hash_time - build_unit * bytes) / bytes;
+
+	/* sorting costs a byte per comparison level */
+	sort_unit = (sort_time - scan_time) /
+		(bytes * (log((double) nrows / Max(nsegments, 1)) / log(2.0)));
+
+	/*
+	 * The benchmark can't tell the cost of sending from that of receiving;
+	 * split it evenly.
+	 */
+	motion_unit = (motion_time - join_time) / bytes / 2;
+
+	nparams = add_param(params, nparams, "HJHashTableWidthCostUnit", build_unit / scan_unit);
+	nparams = add_param(params, nparams, "HJHashingTupWidthCostUnit", probe_unit / scan_unit);
+	nparams = add_param(params, nparams, "SortTupWidthCostUnit", sort_unit / scan_unit);
+	nparams = add_param(params, nparams, "RedistributeSendCostUnit", motion_unit / scan_unit);
+	nparams = add_param(params, nparams, "RedistributeRecvCostUnit", motion_unit / scan_unit);
+
+	store_params(params, nparams);
+
+	PG_RETURN_INT32(nparams);
+}
+
+/*
+ * Relcache invalidation callback: forget the cached parameters when
+ * gp_optimizer_cost_params changes. The plans in the optimizer's plan cache
+ * were costed with the old parameters, drop them too. The parameters are
+ * also part of a plan's fingerprint, so a plan is never reused with other
+ * parameters, even if the table is changed without an invalidation.
+ */
+static void
+CostParamsRelCallback(Datum arg, Oid relid)
+{
+	if (relid != InvalidOid && relid != GpOptimizerCostParamsRelationId)
+		return;
+
+	CostParamsValid = false;
+	CostParamsInvalCount++;
+	OptPlanCacheReset();
+}
+
+static void
+load_cost_params(void)
+{
+	Relation	rel;
+	HeapScanDesc scan;
+	HeapTuple	tuple;
+	List	   *params = NIL;
+	MemoryContext oldcxt;
+	uint32		invalCount;
+
+	if (!CostParamsCallbackRegistered)
+	{
+		CacheRegisterRelcacheCallback(CostParamsRelCallback, (Datum) 0);
+		CostParamsCallbackRegistered = true;
+	}
+
+	/*
+	 * The cache is only valid if the read succeeds, and no invalidation was
+	 * processed while we read the table; otherwise the parameters are read
+	 * again on next use.
+	 */
+	invalCount = CostParamsInvalCount;
+
+	rel = heap_open(GpOptimizerCostParamsRelationId, AccessShareLock);
+	scan = heap_beginscan(rel, SnapshotNow, 0, NULL);
+
+	oldcxt = MemoryContextSwitchTo(CacheMemoryContext);
+	while ((tuple = heap_getnext(scan, ForwardScanDirection)) != NULL)
+	{
+		Form_gp_optimizer_cost_params stored = (Form_gp_optimizer_cost_params) GETSTRUCT(tuple);
+		Form_gp_optimizer_cost_params param;
+
+		/* the table can be edited by hand; ignore values calibration can't produce */
+		if (!(stored->paramvalue >= MIN_COST_UNIT_RATIO &&
+			  stored->paramvalue <= MAX_COST_UNIT_RATIO))
+		{
+			ereport(WARNING,
+					(errmsg("ignoring optimizer cost parameter \"%s\" with value %g",
+							NameStr(stored->paramname), stored->paramvalue)));
+			continue;
+		}
+
+		param = palloc(sizeof(FormData_gp_optimizer_cost_params));
+		memcpy(param, stored, sizeof(FormData_gp_optimizer_cost_params));
+		params = lappend(params, param);
+	}
+	MemoryContextSwitchTo(oldcxt);
+
+	heap_endscan(scan);
+	heap_close(rel, AccessShareLock);
+
+	list_free_deep(CostParams);
+	CostParams = params;
+	CostParamsValid = (invalCount == CostParamsInvalCount);
+}
+
+/*
+ * Return the calibrated cost model parameters, a list of
+ * Form_gp_optimizer_cost_params. The list belongs to the cache, and is only
+ * valid until the next call.
+ */
+List *
+GetOptimizerCostParams(void)
+{
+	if (!CostParamsValid)
+		load_cost_params();
+
+	return CostParams;
+}
@@ -490,7 +490,13 @@ bool		optimizer_print_query;
 bool		optimizer_print_plan;
 bool		optimizer_print_xform;
 bool		optimizer_metadata_caching;
+bool		optimizer_prefetch_metadata;
+bool		optimizer_cost_calibration;
 int		optimizer_mdcache_size;
+int		optimizer_mdcache_shared_size;
+int		optimizer_plan_cache_size;
+int		optimizer_stats_cache_size;
+int		optimizer_time_limit;
 bool		optimizer_disable_xform_result_printing;
 bool		optimizer_print_memo_after_exploration;
 bool		optimizer_print_memo_after_implementation;
@@ -579,9 +585,20 @@ bool		codegen_exec_variable_list;
 bool		codegen_slot_getattr;
 bool		codegen_exec_eval_expr;
 bool		codegen_advance_aggregate;
+bool		codegen_exec_hash_get_hash_value;
+bool		codegen_calc_hash_value;
+bool		codegen_agg_hash_entry_match;
+bool		codegen_memtuple_deform;
+bool		codegen_mk_compare_datum;
+bool		codegen_agg_scan_pipeline;
+bool		codegen_copy_input_attributes;
+bool		codegen_inline_builtins;
+bool		codegen_async_compile;
 int		codegen_varlen_tolerance;
 int		codegen_optimization_level;
 static char 	*codegen_optimization_level_str = NULL;
+int		codegen_cache_size;
+char	   *codegen_cache_directory;
 
 
 /* Security */
@@ -914,6 +931,26 @@ struct config_bool ConfigureNamesBool_gp[] =
 		false, NULL, NULL
 	},
 
+	{
+		{"gp_enable_explain_profile", PGC_USERSET, CLIENT_CONN_OTHER,
+			gettext_noop("Show the sampled profile of each plan node in EXPLAIN ANALYZE."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_enable_explain_profile,
+		false, NULL, NULL
+	},
+
+	{
+		{"gp_enable_explain_waits", PGC_USERSET, CLIENT_CONN_OTHER,
+			gettext_noop("Show the time each slice waited on the interconnect, I/O and locks in EXPLAIN ANALYZE."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_enable_explain_waits,
+		false, NULL, NULL
+	},
+
 	{
 		{"gp_dump_memory_usage", PGC_USERSET, CLIENT_CONN_OTHER,
 			gettext_noop("Save memory usage in each segment."),
@@ -998,6 +1035,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true, NULL, NULL
 	},
 
+	{
+		{"gp_enable_agg_distinct_hash", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Eliminate duplicates of a distinct-qualified aggregate with a per-group hash table."),
+			gettext_noop("Avoids sorting the aggregate input when the aggregate does not depend on input order."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&gp_enable_agg_distinct_hash,
+		true, NULL, NULL
+	},
+
 	{
 		{"gp_enable_motion_deadlock_sanity", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Enable verbose check at planning time."),
@@ -2675,6 +2722,26 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true, NULL, NULL
 	},
 
+	{
+		{"optimizer_prefetch_metadata", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Load the statistics used by a query into the optimizer's metadata cache before optimization."),
+			NULL,
+			GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&optimizer_prefetch_metadata,
+		true, NULL, NULL
+	},
+
+	{
+		{"optimizer_cost_calibration", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Use the cost model parameters measured by gp_calibrate_optimizer_cost_model() in the optimizer."),
+			NULL,
+			GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&optimizer_cost_calibration,
+		true, NULL, NULL
+	},
+
 	{
 		{"optimizer_disable_missing_stats_collection", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Disable collecting of columns with missing statistics."),
@@ -3391,6 +3458,132 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 #else
 		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_exec_hash_get_hash_value", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable codegen for ExecHashGetHashValue"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_exec_hash_get_hash_value,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_calc_hash_value", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable codegen for the hash values of HashAgg"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_calc_hash_value,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_agg_hash_entry_match", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable codegen for the grouping key comparisons of HashAgg"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_agg_hash_entry_match,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_memtuple_deform", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable codegen for deforming the memtuples of append-only row tables and HashAgg entries"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_memtuple_deform,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_mk_compare_datum", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable codegen for the comparator of multi-key sorts"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_mk_compare_datum,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_agg_scan_pipeline", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable codegen for plain aggregates fused with their table scan"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_agg_scan_pipeline,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_copy_input_attributes", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable codegen for the conversion of the attributes of COPY FROM text and CSV input"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_copy_input_attributes,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_inline_builtins", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable inlining of built-in functions into generated expressions from their LLVM bitcode"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_inline_builtins,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
+#endif
+		assign_codegen, NULL
+	},
+	{
+		{"codegen_async_compile", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Compile generated code in a background thread, running the regular functions until it is ready"),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_async_compile,
+#ifdef USE_CODEGEN
+		true,
+#else
+		false,
 #endif
 		assign_codegen, NULL
 	},
@@ -4291,6 +4484,16 @@ struct config_int ConfigureNamesInt_gp[] =
 		1, 0, 1, NULL, NULL
 	},
 
+	{
+		{"gp_hashjoin_probe_batch_size", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Number of outer tuples Hashjoin hashes and prefetches together before probing"),
+			gettext_noop("Batching hides memory latency when the hashtable exceeds the CPU caches. Set to 0 to probe one tuple at a time."),
+			GUC_NOT_IN_SAMPLE | GUC_NO_SHOW_ALL | GUC_GPDB_ADDOPT
+		},
+		&gp_hashjoin_probe_batch_size,
+		0, 0, 1024, NULL, NULL
+	},
+
 	{
 		{"gp_motion_slice_noop", PGC_USERSET, GP_ARRAY_TUNING,
 			gettext_noop("Make motion nodes in certain slices noop"),
@@ -4332,6 +4535,16 @@ struct config_int ConfigureNamesInt_gp[] =
 		1, 1, 3600, gpvars_assign_gp_gpperfmon_send_interval, NULL
 	},
 
+	{
+		{"gp_instrument_profile_interval", PGC_USERSET, STATS_MONITORING,
+			gettext_noop("Sets every how many calls of a plan node one is timed for the always-on profile."),
+			gettext_noop("0 disables the profile of the plan nodes."),
+			GUC_GPDB_ADDOPT
+		},
+		&gp_instrument_profile_interval,
+		100, 0, INT_MAX, NULL, NULL
+	},
+
 	{
 		{"wal_send_client_timeout", PGC_SIGHUP, GP_ARRAY_TUNING,
 			gettext_noop("The time in milliseconds for a backend process to wait on the WAL Send server to finish a request to the QD mirroring standby."),
@@ -4709,6 +4922,47 @@ struct config_int ConfigureNamesInt_gp[] =
 		0, 0, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"optimizer_mdcache_shared_size", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the size of the MDCache shared by all sessions."),
+			gettext_noop("Zero disables the shared MDCache."),
+			GUC_UNIT_KB | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_mdcache_shared_size,
+		0, 0, MAX_KILOBYTES, NULL, NULL
+	},
+
+	{
+		{"optimizer_plan_cache_size", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the number of optimizer plans cached for reuse by identical queries."),
+			gettext_noop("Zero disables the plan cache."),
+			GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&optimizer_plan_cache_size,
+		0, 0, INT_MAX, NULL, NULL
+	},
+
+	{
+		{"optimizer_stats_cache_size", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the size of the cache of column statistics translated for the optimizer."),
+			gettext_noop("Zero disables the cache."),
+			GUC_UNIT_KB | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&optimizer_stats_cache_size,
+		4096, 0, MAX_KILOBYTES, NULL, NULL
+	},
+
+	{
+		{"optimizer_time_limit", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the time the optimizer may spend searching for a plan."),
+			gettext_noop("When the time runs out, the best plan found so far is used. "
+						 "Zero means no limit."),
+			GUC_UNIT_MS | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&optimizer_time_limit,
+		0, 0, INT_MAX, NULL, NULL
+	},
+
 	{
 		{"memory_profiler_dataset_size", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Set the size in GB"),
@@ -4784,6 +5038,21 @@ struct config_int ConfigureNamesInt_gp[] =
 		0, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"codegen_cache_size", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Sets the maximum memory used by each backend to cache the compiled machine code of generated functions."),
+			gettext_noop("0 disables the in-memory cache."),
+			GUC_UNIT_KB | GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&codegen_cache_size,
+#ifdef USE_CODEGEN
+		8192,
+#else
+		0,
+#endif
+		0, MAX_KILOBYTES, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0, 0, 0, NULL, NULL
@@ -4833,6 +5102,16 @@ struct config_real ConfigureNamesReal_gp[] =
 		0, 0, DBL_MAX, NULL, NULL
 	},
 
+	{
+		{"gp_motion_skew_threshold", PGC_USERSET, STATS_MONITORING,
+			gettext_noop("Max/avg ratio of the rows sent to each segment by a Redistribute Motion beyond which it is reported as skewed."),
+			gettext_noop("The senders LOG the skew, and EXPLAIN ANALYZE shows it. 0 disables the check."),
+			GUC_GPDB_ADDOPT
+		},
+		&gp_motion_skew_threshold,
+		2.0, 0, DBL_MAX, NULL, NULL
+	},
+
 	{
 		{"gp_hashagg_rewrite_limit", PGC_USERSET, QUERY_TUNING_OTHER,
 			gettext_noop("(Obsolete) Planner will not choose hashed aggregation if "
@@ -5552,6 +5831,16 @@ struct config_string ConfigureNamesString_gp[] =
 		assign_codegen_optimization_level, NULL
 	},
 
+	{
+		{"codegen_cache_directory", PGC_SUSET, DEVELOPER_OPTIONS,
+			gettext_noop("Sets the directory in which the compiled machine code of generated functions is cached across backends."),
+			gettext_noop("It must be owned by the server user and have mode 0700. An empty string disables the on-disk cache."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_SUPERUSER_ONLY
+		},
+		&codegen_cache_directory,
+		"", NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, NULL, NULL, NULL
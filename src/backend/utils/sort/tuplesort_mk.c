@@ -674,6 +674,7 @@ create_mksort_context(
         mkctxt->mt_bind = create_memtuple_binding(tupdesc); 
 
     mkctxt->cpfr = tupsort_cpfr;
+    mkctxt->compare = tupsort_compare_datum;
     mkctxt->freeTup = freeTupleFn;
     mkctxt->estimatedExtraForPrep = 0;
 
@@ -992,6 +993,20 @@ tuplesort_set_bound_mk(Tuplesortstate_mk *state, int64 bound)
 	 */
 }
 
+/*
+ * tuplesort_set_compare_mk
+ *
+ *	Install a comparator to use instead of tupsort_compare_datum, e.g. one
+ *	that was generated for the sort keys of this sort.  Must be called before
+ *	inserting any tuples.
+ */
+void
+tuplesort_set_compare_mk(Tuplesortstate_mk *state, MKCompare compare)
+{
+	Assert(compare != NULL);
+	state->mkctxt.compare = compare;
+}
+
 /*
  * tuplesort_end
  *
@@ -144,7 +144,7 @@ static inline int32 mkheap_compare(MKHeap *heap, MKEntry *a, MKEntry *b)
             int32 lv = mke_get_lv(a);
             Assert(lv < heap->mkctxt->total_lv);
             Assert(lv == mke_get_lv(b));
-            ret = tupsort_compare_datum(a, b, heap->mkctxt->lvctxt+lv, heap->mkctxt);
+            ret = (*heap->mkctxt->compare)(a, b, heap->mkctxt->lvctxt+lv, heap->mkctxt);
         }
 
         /*
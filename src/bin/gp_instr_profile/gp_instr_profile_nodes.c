@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2016 Pivotal Inc. All Rights Reserved
+ *
+ * ---------------------------------------------------------------------
+ *
+ * The dynamically linked library created from this source can be reference by
+ * creating a function in psql that references it. For example,
+ *
+ * CREATE FUNCTION gp_toolkit.__gp_plan_node_profile_f()
+ *	RETURNS SETOF record
+ *	AS '$libdir/gp_instr_profile', 'gp_instr_profile_nodes'
+ *	LANGUAGE C IMMUTABLE;
+ */
+
+#include "postgres.h"
+#include "funcapi.h"
+#include "cdb/cdbvars.h"
+#include "executor/instrument.h"
+#include "nodes/plannodes.h"
+#include "nodes/print.h"
+#include "utils/builtins.h"
+#include "miscadmin.h"
+
+/* The number of columns as defined in gp_plan_node_profile view */
+#define NUM_PLAN_NODE_PROFILE_ELEM 14
+
+Datum gp_instr_profile_nodes(PG_FUNCTION_ARGS);
+
+/* Position of the SRF in the slots of the always-on profile */
+typedef struct ProfileIterator
+{
+	int			slotno;			/* slot to return the nodes of */
+	int			nodeno;			/* next node to return in the slot */
+	InstrProfileSlot slot;		/* copy of the slot */
+	bool		valid;			/* the copy is of a profiled query */
+} ProfileIterator;
+
+PG_MODULE_MAGIC;
+PG_FUNCTION_INFO_V1(gp_instr_profile_nodes);
+
+/*
+ * Function returning the always-on profile of the plan nodes of the queries
+ * that are running on one segment, one row for each node of each backend
+ */
+Datum
+gp_instr_profile_nodes(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	ProfileIterator *iter;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		/* create a function context for cross-call persistence */
+		funcctx = SRF_FIRSTCALL_INIT();
+
+		/* Switch to memory context appropriate for multiple function calls */
+		MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		/*
+		 * Build a tuple descriptor for our result type
+		 * The number and type of attributes have to match the definition of the
+		 * view gp_plan_node_profile
+		 */
+		TupleDesc tupdesc = CreateTemplateTupleDesc(NUM_PLAN_NODE_PROFILE_ELEM, false /* hasoid */);
+
+		TupleDescInitEntry(tupdesc, (AttrNumber) 1, "segid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 2, "pid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 3, "sessionid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 4, "commandid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 5, "slice",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 6, "plan_node_id",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 7, "node_type",
+				TEXTOID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 8, "calls",
+				INT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 9, "samples",
+				INT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 10, "est_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 11, "spill_bytes",
+				INT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 12, "hash_collisions",
+				INT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 13, "motion_stall_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 14, "decompress_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+
+		Assert(NUM_PLAN_NODE_PROFILE_ELEM == 14);
+
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+		iter = (ProfileIterator *) palloc0(sizeof(*iter));
+		iter->slotno = -1;
+		funcctx->user_fctx = iter;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	iter = (ProfileIterator *) funcctx->user_fctx;
+
+	while (true)
+	{
+		InstrProfile *profile;
+		Plan		plan;
+
+		/* Move on to the next profiled backend at the end of a slot */
+		if (!iter->valid || iter->nodeno >= iter->slot.nnodes)
+		{
+			iter->slotno++;
+			if (iter->slotno >= InstrProfileSlotCount())
+			{
+				/* Reached the end of the slot array, we're done */
+				SRF_RETURN_DONE(funcctx);
+			}
+
+			iter->valid = InstrProfileSlotCopy(iter->slotno, &iter->slot);
+			iter->nodeno = 0;
+			continue;
+		}
+
+		profile = &iter->slot.nodes[iter->nodeno++];
+		if (profile->nodeTag == T_Invalid)
+			continue;
+
+		Datum		values[NUM_PLAN_NODE_PROFILE_ELEM];
+		bool		nulls[NUM_PLAN_NODE_PROFILE_ELEM];
+		MemSet(nulls, 0, sizeof(nulls));
+
+		/* plannode_type only looks at the tag of the plan */
+		NodeSetTag(&plan, profile->nodeTag);
+
+		values[0] = Int32GetDatum(Gp_segment);
+		values[1] = Int32GetDatum(iter->slot.pid);
+		values[2] = Int32GetDatum(iter->slot.sessionId);
+		values[3] = Int32GetDatum(iter->slot.commandCount);
+		values[4] = Int32GetDatum(iter->slot.sliceId);
+		values[5] = Int32GetDatum(iter->nodeno - 1);
+		values[6] = CStringGetTextDatum(plannode_type(&plan));
+		values[7] = Int64GetDatum(profile->ncalls);
+		values[8] = Int64GetDatum(profile->nsamples);
+		if (profile->nsamples > 0)
+			values[9] = Float8GetDatum(InstrProfileCyclesToSeconds(profile->sampleCycles) *
+									   profile->ncalls / profile->nsamples);
+		else
+			nulls[9] = true;
+		values[10] = Int64GetDatum(profile->spillBytes);
+		values[11] = Int64GetDatum(profile->hashCollisions);
+		values[12] = Float8GetDatum(InstrProfileCyclesToSeconds(profile->motionStallCycles));
+		values[13] = Float8GetDatum(InstrProfileCyclesToSeconds(profile->decompressCycles));
+
+		HeapTuple tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+		Datum result = HeapTupleGetDatum(tuple);
+		SRF_RETURN_NEXT(funcctx, result);
+	}
+}
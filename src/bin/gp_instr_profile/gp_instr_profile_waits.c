@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016 Pivotal Inc. All Rights Reserved
+ *
+ * ---------------------------------------------------------------------
+ *
+ * The dynamically linked library created from this source can be reference by
+ * creating a function in psql that references it. For example,
+ *
+ * CREATE FUNCTION gp_toolkit.__gp_slice_waits_f()
+ *	RETURNS SETOF record
+ *	AS '$libdir/gp_instr_profile', 'gp_instr_profile_waits'
+ *	LANGUAGE C IMMUTABLE;
+ */
+
+#include "postgres.h"
+#include "funcapi.h"
+#include "cdb/cdbvars.h"
+#include "executor/instrument.h"
+#include "miscadmin.h"
+
+/* The number of columns as defined in gp_slice_waits view */
+#define NUM_SLICE_WAITS_ELEM (5 + INSTR_NUM_WAIT_CLASSES)
+
+Datum gp_instr_profile_waits(PG_FUNCTION_ARGS);
+
+PG_FUNCTION_INFO_V1(gp_instr_profile_waits);
+
+/*
+ * Function returning the time the queries that are running on one segment
+ * waited, by class of wait, one row for each backend
+ */
+Datum
+gp_instr_profile_waits(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	int		   *slotno;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		/* create a function context for cross-call persistence */
+		funcctx = SRF_FIRSTCALL_INIT();
+
+		/* Switch to memory context appropriate for multiple function calls */
+		MemoryContext oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		/*
+		 * Build a tuple descriptor for our result type
+		 * The number and type of attributes have to match the definition of the
+		 * view gp_slice_waits
+		 */
+		TupleDesc tupdesc = CreateTemplateTupleDesc(NUM_SLICE_WAITS_ELEM, false /* hasoid */);
+
+		TupleDescInitEntry(tupdesc, (AttrNumber) 1, "segid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 2, "pid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 3, "sessionid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 4, "commandid",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 5, "slice",
+				INT4OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 6, "motion_recv_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 7, "motion_send_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 8, "read_io_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 9, "workfile_write_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 10, "lock_time",
+				FLOAT8OID, -1 /* typmod */, 0 /* attdim */);
+
+		Assert(NUM_SLICE_WAITS_ELEM == 10);
+
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+		slotno = (int *) palloc(sizeof(*slotno));
+		*slotno = 0;
+		funcctx->user_fctx = slotno;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	slotno = (int *) funcctx->user_fctx;
+
+	while (*slotno < InstrProfileSlotCount())
+	{
+		InstrProfileSlot slot;
+		int			i;
+
+		if (!InstrProfileSlotCopy((*slotno)++, &slot))
+			continue;
+
+		Datum		values[NUM_SLICE_WAITS_ELEM];
+		bool		nulls[NUM_SLICE_WAITS_ELEM];
+		MemSet(nulls, 0, sizeof(nulls));
+
+		values[0] = Int32GetDatum(Gp_segment);
+		values[1] = Int32GetDatum(slot.pid);
+		values[2] = Int32GetDatum(slot.sessionId);
+		values[3] = Int32GetDatum(slot.commandCount);
+		values[4] = Int32GetDatum(slot.sliceId);
+		for (i = 0; i < INSTR_NUM_WAIT_CLASSES; i++)
+			values[5 + i] = Float8GetDatum(InstrProfileCyclesToSeconds(slot.waitCycles[i]));
+
+		HeapTuple tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+		Datum result = HeapTupleGetDatum(tuple);
+		SRF_RETURN_NEXT(funcctx, result);
+	}
+
+	/* Reached the end of the slot array, we're done */
+	SRF_RETURN_DONE(funcctx);
+}
@@ -56,6 +56,6 @@
  */
 
 /*							3yyymmddN */
-#define CATALOG_VERSION_NO	301610211
+#define CATALOG_VERSION_NO	301610212
 
 #endif
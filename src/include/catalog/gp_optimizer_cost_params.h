@@ -0,0 +1,59 @@
+/*-------------------------------------------------------------------------
+ *
+ * gp_optimizer_cost_params.h
+ *	  definition of the calibrated optimizer cost model parameters
+ *	  relation (gp_optimizer_cost_params)
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ * NOTES
+ *	  The table holds the cost units of the Pivotal Query Optimizer's cost
+ *	  model as measured on this cluster by gp_calibrate_optimizer_cost_model().
+ *	  Each value is a cost relative to that of sequentially scanning one byte,
+ *	  the optimizer's TableScanCostUnit, so the measurements don't depend on
+ *	  the scale the optimizer's costs are expressed in. The optimizer only
+ *	  consults the table on the master, see optcalibrate.c.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef GP_OPTIMIZER_COST_PARAMS_H
+#define GP_OPTIMIZER_COST_PARAMS_H
+
+#include "catalog/genbki.h"
+
+/*
+ * Defines for gp_optimizer_cost_params table
+ */
+#define GpOptimizerCostParamsRelationName	"gp_optimizer_cost_params"
+
+/* ----------------
+ *		gp_optimizer_cost_params definition.  cpp turns this into
+ *		typedef struct FormData_gp_optimizer_cost_params
+ * ----------------
+ */
+#define GpOptimizerCostParamsRelationId	6110
+
+CATALOG(gp_optimizer_cost_params,6110) BKI_SHARED_RELATION BKI_WITHOUT_OIDS
+{
+	NameData	paramname;		/* name of the optimizer cost parameter */
+	float8		paramvalue;		/* value relative to TableScanCostUnit */
+} FormData_gp_optimizer_cost_params;
+
+/* no foreign keys */
+
+/* ----------------
+ *		Form_gp_optimizer_cost_params corresponds to a pointer to a tuple with
+ *		the format of gp_optimizer_cost_params relation.
+ * ----------------
+ */
+typedef FormData_gp_optimizer_cost_params *Form_gp_optimizer_cost_params;
+
+/* ----------------
+ *		compiler constants for gp_optimizer_cost_params
+ * ----------------
+ */
+#define Natts_gp_optimizer_cost_params				2
+#define Anum_gp_optimizer_cost_params_paramname		1
+#define Anum_gp_optimizer_cost_params_paramvalue	2
+
+#endif   /* GP_OPTIMIZER_COST_PARAMS_H */
@@ -1757,6 +1757,8 @@ CREATE FUNCTION gp_nondbspecific_ptcat_verification() RETURNS bool LANGUAGE inte
  CREATE FUNCTION enable_xform(text) RETURNS text LANGUAGE internal IMMUTABLE STRICT AS 'enable_xform' WITH (OID=6088, DESCRIPTION="enables transformations in the optimizer");
 
  CREATE FUNCTION gp_opt_version() RETURNS text LANGUAGE internal IMMUTABLE STRICT AS 'gp_opt_version' WITH (OID=6089, DESCRIPTION="Returns the optimizer and gpos library versions");
+
+ CREATE FUNCTION gp_calibrate_optimizer_cost_model(int4) RETURNS int4 LANGUAGE internal VOLATILE STRICT MODIFIES SQL DATA AS 'gp_calibrate_optimizer_cost_model' WITH (OID=6117, DESCRIPTION="Measures the optimizer cost model parameters on this cluster");
  
  
   -- functions for the complex data type
@@ -2909,6 +2909,10 @@ DESCR("enables transformations in the optimizer");
 DATA(insert OID = 6089 ( gp_opt_version  PGNSP PGUID 12 1 0 0 f f t f i 0 0 25 f "" _null_ _null_ _null_ _null_ gp_opt_version _null_ _null_ _null_ n ));
 DESCR("Returns the optimizer and gpos library versions");
 
+/* gp_calibrate_optimizer_cost_model(int4) => int4 */ 
+DATA(insert OID = 6117 ( gp_calibrate_optimizer_cost_model  PGNSP PGUID 12 1 0 0 f f t f v 1 0 23 f "23" _null_ _null_ _null_ _null_ gp_calibrate_optimizer_cost_model _null_ _null_ _null_ m ));
+DESCR("Measures the optimizer cost model parameters on this cluster");
+
 
   /* functions for the complex data type */
 /* complex_in(cstring) => complex */ 
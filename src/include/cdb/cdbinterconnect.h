@@ -449,6 +449,15 @@ typedef struct MotionNodeEntry
 	uint64          stat_tuples_available;  /* Total tuples awaiting receive. */
 	uint64          stat_tuples_available_hwm;              /* High-water-mark of this
 		* value. */
+	/*
+	 * Per-route statistics of a sending motion node, allocated on its first
+	 * send to a single route (i.e. not a broadcast).
+	 */
+	int             stat_num_routes;
+	uint64         *stat_route_tuples_sent;	/* Tuples sent, by route. */
+	uint64         *stat_route_bytes_sent;	/* Bytes of tuple-data sent, by route. */
+	bool            stat_route_skew_logged;	/* Skew was reported already. */
+
 	uint64          sel_rd_wait;            /* Total time (usec) spent in select wait trying to read */
 	uint64          sel_wr_wait;            /* Total time spent (usec) in select wait trying to write */
 
@@ -54,6 +54,8 @@ extern int Gp_max_tuple_chunk_size;
 
 extern MotionNodeEntry *getMotionNodeEntry(MotionLayerState *mlStates, int16 motNodeID, char *errString  __attribute__((unused)) );
 
+extern uint64 getMotionNodeTupleBytesRecvd(MotionLayerState *mlStates, int16 motNodeID);
+
 /* Initialization of motion layer for this query */
 extern void initMotionLayerStructs(MotionLayerState **ml_states);
 
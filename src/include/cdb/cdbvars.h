@@ -816,6 +816,27 @@ extern bool gp_enable_sequential_window_plans;
  */
 extern bool gp_enable_explain_allstat;
 
+/* May Greenplum show the always-on profile of the nodes (see InstrProfile)
+ * in EXPLAIN ANALYZE?
+ */
+extern bool gp_enable_explain_profile;
+
+/* May Greenplum show the time each slice waited on the interconnect, I/O
+ * and locks (see InstrWaitClass) in EXPLAIN ANALYZE?
+ */
+extern bool gp_enable_explain_waits;
+
+/* Max/avg ratio of the tuples a Redistribute Motion sends to each segment
+ * beyond which the senders LOG the skew, and EXPLAIN ANALYZE shows it.
+ * 0 disables the check.
+ */
+extern double gp_motion_skew_threshold;
+
+/* Every how many calls of a plan node ExecProcNode times one with the cycle
+ * counter, for the always-on profile.  0 disables the profile.
+ */
+extern int	gp_instrument_profile_interval;
+
 /* May Greenplum restrict ORDER BY sorts to the first N rows if the ORDER BY
  * is wrapped by a LIMIT clause (where N=OFFSET+LIMIT)?
  *
@@ -893,6 +914,9 @@ extern double gp_hashagg_rewrite_limit;
 /* If we use two stage hashagg, we can stream the bottom half */
 extern bool gp_hashagg_streambottom;
 
+/* May an Agg node eliminate DISTINCT aggregate duplicates with a hash table? */
+extern bool gp_enable_agg_distinct_hash;
+
 /* The default number of batches to use when the hybrid hashed aggregation
  * algorithm (re-)spills in-memory groups to disk.
  */
@@ -901,6 +925,9 @@ extern int gp_hashagg_default_nbatches;
 /* Hashjoin use bloom filter */
 extern int gp_hashjoin_bloomfilter;
 
+/* Number of outer tuples Hashjoin hashes and prefetches as a batch */
+extern int gp_hashjoin_probe_batch_size;
+
 /* Get statistics for partitioned parent from a child */
 extern bool 	gp_statistics_pullup_from_child_partition;
 
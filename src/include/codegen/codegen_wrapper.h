@@ -34,6 +34,16 @@ struct PlanState;
 struct AggState;
 struct MemoryManagerContainer;
 struct AggStatePerGroupData;
+struct HashState;
+struct HashJoinTableData;
+struct List;
+struct MemTupleData;
+struct MemTupleBinding;
+struct tupleDesc;
+struct MKEntry;
+struct MKLvContext;
+struct MKContext;
+struct CopyStateData;
 /*
  * Enum used to mimic ExprDoneCond in ExecEvalExpr function pointer.
  */
@@ -45,6 +55,13 @@ typedef void (*AdvanceAggregatesFn) (struct AggState *aggstate, /*struct AggStat
 typedef void (*ExecVariableListFn) (struct ProjectionInfo *projInfo, Datum *values, bool *isnull);
 typedef Datum (*ExecEvalExprFn) (struct ExprState *expression, struct ExprContext *econtext, bool *isNull, /*ExprDoneCond*/ tmp_enum *isDone);
 typedef Datum (*SlotGetAttrFn) (struct TupleTableSlot *slot, int attnum, bool *isnull);
+typedef bool (*ExecHashGetHashValueFn) (struct HashState *hashState, /*HashJoinTable*/struct HashJoinTableData *hashtable, struct ExprContext *econtext, struct List *hashkeys, bool outer_tuple, bool keep_nulls, uint32 *hashvalue, bool *hashkeys_null);
+typedef uint32 (*CalcHashValueFn) (struct AggState *aggstate, struct TupleTableSlot *inputslot);
+typedef bool (*AggHashEntryMatchFn) (struct AggState *aggstate, struct TupleTableSlot *inputslot, /*MemTuple*/struct MemTupleData *entry_tuple);
+typedef void (*MemTupleDeformFn) (/*MemTuple*/struct MemTupleData *mtup, struct MemTupleBinding *pbind, int natts, Datum *values, bool *isnull);
+typedef int32 (*MKCompareDatumFn) (struct MKEntry *v1, struct MKEntry *v2, struct MKLvContext *lvctxt, struct MKContext *mkctxt);
+typedef bool (*AggScanPipelineFn) (struct AggState *aggstate, /*struct AggStatePerGroup*/struct AggStatePerGroupData *pergroup, struct MemoryManagerContainer *mem_manager);
+typedef void (*CopyInputAttributesFn) (struct CopyStateData *cstate, int *attr_offsets, Datum *values, bool *nulls);
 
 #ifndef USE_CODEGEN
 
@@ -58,6 +75,8 @@ typedef Datum (*SlotGetAttrFn) (struct TupleTableSlot *slot, int attnum, bool *i
 #define CodeGeneratorManagerDestroy(manager);
 #define GetActiveCodeGeneratorManager() NULL
 #define SetActiveCodeGeneratorManager(manager);
+#define CHECK_FOR_COMPILED_FUNCTIONS()
+#define CodeGeneratorManagerAbortAsyncCompile(nestLevel)
 
 #define START_CODE_GENERATOR_MANAGER(newManager)
 #define END_CODE_GENERATOR_MANAGER()
@@ -67,6 +86,20 @@ typedef Datum (*SlotGetAttrFn) (struct TupleTableSlot *slot, int attnum, bool *i
 #define enroll_ExecVariableList_codegen(regular_func, ptr_to_chosen_func, proj_info, slot)
 #define call_AdvanceAggregates(aggstate, pergroup, mem_manager) advance_aggregates(aggstate, pergroup, mem_manager)
 #define enroll_AdvanceAggregates_codegen(regular_func, ptr_to_chosen_func, aggstate)
+#define call_ExecHashGetHashValue(owner, hashState, hashtable, econtext, hashkeys, outer_tuple, keep_nulls, hashvalue, hashkeys_null) \
+		ExecHashGetHashValue(hashState, hashtable, econtext, hashkeys, outer_tuple, keep_nulls, hashvalue, hashkeys_null)
+#define enroll_ExecHashGetHashValue_codegen(regular_func, ptr_to_chosen_func, owner, hashkeys, hashoperators, outer_tuple)
+#define call_CalcHashValue(aggstate, inputslot) calc_hash_value(aggstate, inputslot)
+#define enroll_CalcHashValue_codegen(regular_func, ptr_to_chosen_func, aggstate)
+#define call_AggHashEntryMatch(aggstate, inputslot, entry_tuple) agg_hash_entry_match(aggstate, inputslot, entry_tuple)
+#define enroll_AggHashEntryMatch_codegen(regular_func, ptr_to_chosen_func, aggstate)
+#define call_MemTupleDeform(owner, mtup, pbind, natts, values, isnull) memtuple_getsomeattrs(mtup, pbind, natts, values, isnull)
+#define enroll_MemTupleDeform_codegen(regular_func, ptr_to_chosen_func, owner, tupdesc, num_atts)
+#define enroll_MKCompareDatum_codegen(regular_func, ptr_to_chosen_func, owner, nkeys, sortFunctions, reverse)
+#define call_AggScanPipeline(aggstate, pergroup, mem_manager) agg_scan_pipeline(aggstate, pergroup, mem_manager)
+#define enroll_AggScanPipeline_codegen(regular_func, ptr_to_chosen_func, aggstate)
+#define call_CopyInputAttributes(cstate, attr_offsets, values, nulls) CopyInputAttributes(cstate, attr_offsets, values, nulls)
+#define enroll_CopyInputAttributes_codegen(regular_func, ptr_to_chosen_func, cstate, tupdesc)
 #else
 
 /*
@@ -124,6 +157,27 @@ CodeGeneratorManagerGenerateCode(void* manager);
 unsigned int
 CodeGeneratorManagerPrepareGeneratedFunctions(void* manager);
 
+/*
+ * Set by the background compiler thread when the module of a manager whose
+ * functions were prepared asynchronously is compiled
+ */
+extern volatile bool CodegenAsyncCompileDone;
+
+/*
+ * Swaps in the compiled functions of all the managers whose module was
+ * compiled in the background since the last call
+ */
+void
+CodeGeneratorManagerInstallCompiledFunctions(void);
+
+/*
+ * Cancels the background compilations of the managers of the queries of an
+ * aborting (sub)transaction, at nestLevel or deeper, so that the compiled
+ * functions are never installed into their freed executor state
+ */
+void
+CodeGeneratorManagerAbortAsyncCompile(int nestLevel);
+
 /*
  * Notifies a manager that the underlying operator has a parameter change
  */
@@ -200,6 +254,68 @@ AdvanceAggregatesCodegenEnroll(AdvanceAggregatesFn regular_func_ptr,
 		AdvanceAggregatesFn* ptr_to_regular_func_ptr,
 		struct AggState *aggstate);
 
+/*
+ * Enroll and returns the pointer to ExecHashGetHashValueGenerator
+ */
+void*
+ExecHashGetHashValueCodegenEnroll(ExecHashGetHashValueFn regular_func_ptr,
+		ExecHashGetHashValueFn* ptr_to_regular_func_ptr,
+		struct List *hashkeys,
+		struct List *hashoperators,
+		bool outer_tuple);
+
+/*
+ * Enroll and returns the pointer to CalcHashValueGenerator
+ */
+void*
+CalcHashValueCodegenEnroll(CalcHashValueFn regular_func_ptr,
+		CalcHashValueFn* ptr_to_regular_func_ptr,
+		struct AggState *aggstate);
+
+/*
+ * Enroll and returns the pointer to AggHashEntryMatchGenerator
+ */
+void*
+AggHashEntryMatchCodegenEnroll(AggHashEntryMatchFn regular_func_ptr,
+		AggHashEntryMatchFn* ptr_to_regular_func_ptr,
+		struct AggState *aggstate);
+
+/*
+ * Enroll and returns the pointer to MemTupleDeformGenerator
+ */
+void*
+MemTupleDeformCodegenEnroll(MemTupleDeformFn regular_func_ptr,
+		MemTupleDeformFn* ptr_to_regular_func_ptr,
+		struct tupleDesc *tupdesc,
+		int natts);
+
+/*
+ * Enroll and returns the pointer to MKCompareDatumGenerator
+ */
+void*
+MKCompareDatumCodegenEnroll(MKCompareDatumFn regular_func_ptr,
+		MKCompareDatumFn* ptr_to_regular_func_ptr,
+		int nkeys,
+		Oid *sortFunctions,
+		bool *reverse);
+
+/*
+ * Enroll and returns the pointer to AggScanPipelineGenerator
+ */
+void*
+AggScanPipelineCodegenEnroll(AggScanPipelineFn regular_func_ptr,
+		AggScanPipelineFn* ptr_to_regular_func_ptr,
+		struct AggState *aggstate);
+
+/*
+ * Enroll and returns the pointer to CopyInputAttributesGenerator
+ */
+void*
+CopyInputAttributesCodegenEnroll(CopyInputAttributesFn regular_func_ptr,
+		CopyInputAttributesFn* ptr_to_regular_func_ptr,
+		struct CopyStateData *cstate,
+		struct tupleDesc *tupdesc);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -227,6 +343,17 @@ AdvanceAggregatesCodegenEnroll(AdvanceAggregatesFn regular_func_ptr,
 	} while (0);
 
 
+/*
+ * Swap in the functions that were compiled in the background, if any. Called
+ * by the executor between tuples, so that the switch from the regular to the
+ * generated functions never happens in the middle of one.
+ */
+#define CHECK_FOR_COMPILED_FUNCTIONS() \
+	do { \
+		if (CodegenAsyncCompileDone) \
+			CodeGeneratorManagerInstallCompiledFunctions(); \
+	} while (0)
+
 /*
  * Initialize LLVM library
  */
@@ -257,6 +384,49 @@ AdvanceAggregatesCodegenEnroll(AdvanceAggregatesFn regular_func_ptr,
 #define call_AdvanceAggregates(aggstate, pergroup, mem_manager) \
 		aggstate->AdvanceAggregates_gen_info.AdvanceAggregates_fn(aggstate, pergroup, mem_manager)
 
+/*
+ * Call agg_scan_pipeline using function pointer AggScanPipeline_fn.
+ * Function pointer may point to regular version or generated function
+ */
+#define call_AggScanPipeline(aggstate, pergroup, mem_manager) \
+		aggstate->AggScanPipeline_gen_info.AggScanPipeline_fn(aggstate, pergroup, mem_manager)
+
+/*
+ * Call ExecHashGetHashValue using function pointer ExecHashGetHashValue_fn of
+ * owner, the HashState for the inner side or the HashJoinState for the outer
+ * side. Function pointer may point to regular version or generated function
+ */
+#define call_ExecHashGetHashValue(owner, hashState, hashtable, econtext, hashkeys, outer_tuple, keep_nulls, hashvalue, hashkeys_null) \
+		(owner)->ExecHashGetHashValue_gen_info.ExecHashGetHashValue_fn(hashState, hashtable, econtext, hashkeys, outer_tuple, keep_nulls, hashvalue, hashkeys_null)
+
+/*
+ * Call calc_hash_value using function pointer CalcHashValue_fn.
+ * Function pointer may point to regular version or generated function
+ */
+#define call_CalcHashValue(aggstate, inputslot) \
+		aggstate->CalcHashValue_gen_info.CalcHashValue_fn(aggstate, inputslot)
+
+/*
+ * Call agg_hash_entry_match using function pointer AggHashEntryMatch_fn.
+ * Function pointer may point to regular version or generated function
+ */
+#define call_AggHashEntryMatch(aggstate, inputslot, entry_tuple) \
+		aggstate->AggHashEntryMatch_gen_info.AggHashEntryMatch_fn(aggstate, inputslot, entry_tuple)
+
+/*
+ * Call memtuple_getsomeattrs using function pointer MemTupleDeform_fn of owner.
+ * Function pointer may point to regular version or generated function
+ */
+#define call_MemTupleDeform(owner, mtup, pbind, natts, values, isnull) \
+		(owner)->MemTupleDeform_gen_info.MemTupleDeform_fn(mtup, pbind, natts, values, isnull)
+
+/*
+ * Call CopyInputAttributes using function pointer CopyInputAttributes_fn.
+ * Function pointer may point to regular version or generated function
+ */
+#define call_CopyInputAttributes(cstate, attr_offsets, values, nulls) \
+		(cstate)->CopyInputAttributes_gen_info.CopyInputAttributes_fn(cstate, attr_offsets, values, nulls)
+
 /*
  * Enrollment macros
  * The enrollment process also ensures that the generated function pointer
@@ -277,6 +447,42 @@ AdvanceAggregatesCodegenEnroll(AdvanceAggregatesFn regular_func_ptr,
 				regular_func, ptr_to_regular_func_ptr, aggstate); \
 				Assert(aggstate->AdvanceAggregates_gen_info.AdvanceAggregates_fn == regular_func); \
 
+#define enroll_ExecHashGetHashValue_codegen(regular_func, ptr_to_regular_func_ptr, owner, hashkeys, hashoperators, outer_tuple) \
+		(owner)->ExecHashGetHashValue_gen_info.code_generator = ExecHashGetHashValueCodegenEnroll( \
+				regular_func, ptr_to_regular_func_ptr, hashkeys, hashoperators, outer_tuple); \
+				Assert((owner)->ExecHashGetHashValue_gen_info.ExecHashGetHashValue_fn == regular_func); \
+
+#define enroll_CalcHashValue_codegen(regular_func, ptr_to_regular_func_ptr, aggstate) \
+		aggstate->CalcHashValue_gen_info.code_generator = CalcHashValueCodegenEnroll( \
+				regular_func, ptr_to_regular_func_ptr, aggstate); \
+				Assert(aggstate->CalcHashValue_gen_info.CalcHashValue_fn == regular_func); \
+
+#define enroll_AggHashEntryMatch_codegen(regular_func, ptr_to_regular_func_ptr, aggstate) \
+		aggstate->AggHashEntryMatch_gen_info.code_generator = AggHashEntryMatchCodegenEnroll( \
+				regular_func, ptr_to_regular_func_ptr, aggstate); \
+				Assert(aggstate->AggHashEntryMatch_gen_info.AggHashEntryMatch_fn == regular_func); \
+
+#define enroll_MemTupleDeform_codegen(regular_func, ptr_to_regular_func_ptr, owner, tupdesc, num_atts) \
+		(owner)->MemTupleDeform_gen_info.code_generator = MemTupleDeformCodegenEnroll( \
+				regular_func, ptr_to_regular_func_ptr, tupdesc, num_atts); \
+				(owner)->MemTupleDeform_gen_info.natts = (num_atts); \
+				Assert((owner)->MemTupleDeform_gen_info.MemTupleDeform_fn == regular_func); \
+
+#define enroll_MKCompareDatum_codegen(regular_func, ptr_to_regular_func_ptr, owner, nkeys, sortFunctions, reverse) \
+		(owner)->MKCompareDatum_gen_info.code_generator = MKCompareDatumCodegenEnroll( \
+				regular_func, ptr_to_regular_func_ptr, nkeys, sortFunctions, reverse); \
+				Assert((owner)->MKCompareDatum_gen_info.MKCompareDatum_fn == regular_func); \
+
+#define enroll_AggScanPipeline_codegen(regular_func, ptr_to_regular_func_ptr, aggstate) \
+		aggstate->AggScanPipeline_gen_info.code_generator = AggScanPipelineCodegenEnroll( \
+				regular_func, ptr_to_regular_func_ptr, aggstate); \
+				Assert(aggstate->AggScanPipeline_gen_info.AggScanPipeline_fn == regular_func); \
+
+#define enroll_CopyInputAttributes_codegen(regular_func, ptr_to_regular_func_ptr, cstate, tupdesc) \
+		(cstate)->CopyInputAttributes_gen_info.code_generator = CopyInputAttributesCodegenEnroll( \
+				regular_func, ptr_to_regular_func_ptr, cstate, tupdesc); \
+				Assert((cstate)->CopyInputAttributes_gen_info.CopyInputAttributes_fn == regular_func); \
+
 #endif //USE_CODEGEN
 
 #endif  // CODEGEN_WRAPPER_H_
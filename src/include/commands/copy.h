@@ -91,6 +91,18 @@ typedef enum CopyErrMode
 } CopyErrMode;
 
 
+/*
+ * Conversion of the attributes of a line of COPY FROM, see
+ * CopyInputAttributes
+ */
+typedef struct CopyInputAttributesCodegenInfo
+{
+	/* Pointer to store CopyInputAttributesCodegen from Codegen */
+	void* code_generator;
+	/* Function pointer that points to either regular or generated CopyInputAttributes */
+	CopyInputAttributesFn CopyInputAttributes_fn;
+} CopyInputAttributesCodegenInfo;
+
 /*
  * This struct contains all the state variables used throughout a COPY
  * operation. For simplicity, we use the same struct for all variants of COPY,
@@ -164,6 +176,12 @@ typedef struct CopyStateData
 	FmgrInfo   *out_functions;	/* lookup info for output functions */
 	MemoryContext rowcontext;	/* per-row evaluation context */
 
+	/*
+	 * Working state for COPY FROM, see CopyInputAttributes
+	 */
+	FmgrInfo   *in_functions;	/* lookup info for input functions */
+	Oid		   *typioparams;	/* element types to pass to them */
+
 	/*
 	 * These variables are used to reduce overhead in textual COPY FROM.
 	 *
@@ -241,6 +259,12 @@ typedef struct CopyStateData
 	PartitionNode *partitions; /* partitioning meta data from dispatcher */
 	List		  *ao_segnos;  /* AO table meta data from dispatcher */
 	bool          skip_ext_partition;  /* skip external partition */
+
+	void	   *CodegenManager;	/* code generator manager of COPY FROM */
+#ifdef USE_CODEGEN
+	/* conversion of the attributes of a text or CSV line */
+	CopyInputAttributesCodegenInfo CopyInputAttributes_gen_info;
+#endif
 	/* end Greenplum Database specific variables */
 
 } CopyStateData;
@@ -267,6 +291,8 @@ extern void CopyReadAttributesText(CopyState cstate, char * __restrict nulls,
 			 int * __restrict attr_offsets, int num_phys_attrs, Form_pg_attribute * __restrict attr);
 extern void CopyReadAttributesCSV(CopyState cstate, char *nulls, int *attr_offsets,
 					  int num_phys_attrs, Form_pg_attribute *attr);
+extern void CopyInputAttributes(CopyState cstate, int *attr_offsets,
+								Datum *values, bool *nulls);
 extern void CopyOneRowTo(CopyState cstate, Oid tupleOid,
 						 Datum *values, bool *nulls);
 extern void CopyOneCustomRowTo(CopyState cstate, bytea *value);
@@ -227,6 +227,10 @@ extern void destroy_agg_hash_table(AggState *aggstate);
 
 extern HashAggEntry *agg_hash_iter(AggState *aggstate);
 
+extern uint32 calc_hash_value(AggState *aggstate, TupleTableSlot *inputslot);
+extern bool agg_hash_entry_match(AggState *aggstate, TupleTableSlot *inputslot,
+								 MemTuple entry_tuple);
+
 extern bool 
 calcHashAggTableSizes(double memquota,	/* Memory quota in bytes. */
 					   double ngroups,	/* Est # of groups. */
@@ -318,6 +318,7 @@ extern Relation OpenScanRelationByOid(Oid relid);
 extern void CloseScanRelation(Relation rel);
 extern int getTableType(Relation rel);
 extern TupleTableSlot *ExecTableScanRelation(ScanState *scanState);
+extern TupleTableSlot *FetchTableScanRelation(ScanState *scanState);
 extern void BeginTableScanRelation(ScanState *scanState);
 extern void EndTableScanRelation(ScanState *scanState);
 extern void ReScanRelation(ScanState *scanState);
@@ -16,6 +16,7 @@
 #define HASHJOIN_H
 
 #include "fmgr.h"
+#include "access/memtup.h"
 #include "executor/execWorkfile.h"
 #include "cdb/cdbpublic.h"                 /* CdbExplain_Agg */
 #include "utils/workfile_mgr.h"
@@ -60,6 +61,12 @@ struct StringInfoData;                  /* #include "lib/stringinfo.h" */
  * inner batch file.  Subsequently, while reading either inner or outer batch
  * files, we might find tuples that no longer belong to the current batch;
  * if so, we just dump them out to the correct batch file.
+ *
+ * If a batch is dominated by a single hash value whose tuples alone exceed
+ * spaceAllowed, no amount of doubling can make it fit.  We notice this when
+ * increasing nbatch, remember the offending hash value in the batch, and
+ * stop charging its tuples against the batch's doubling threshold, so that
+ * only the splittable remainder can trigger further increases.
  * ----------------------------------------------------------------
  */
 
@@ -78,6 +85,36 @@ typedef struct HashJoinTupleData
 #define HJTUPLE_MINTUPLE(hjtup)  \
 	((MemTuple) ((char *) (hjtup) + HJTUPLE_OVERHEAD))
 
+/*
+ * If the outer relation's distribution is sufficiently nonuniform, we attempt
+ * to optimize the join by treating the hash values corresponding to the outer
+ * relation's MCVs specially.  Inner relation tuples matching these hash
+ * values go into the "skew" hashtable instead of the main hashtable, and
+ * outer relation tuples with these hash values are matched against that
+ * table instead of the main one.  Thus, tuples with these hash values are
+ * effectively handled as part of the first batch and will never go to disk.
+ * The skew hashtable is limited to SKEW_WORK_MEM_PERCENT of the total memory
+ * allowed for the join; while building the hashtables, we decrease the number
+ * of MCVs being specially treated if needed to stay under this limit.
+ *
+ * Note: you might wonder why we look at the outer relation stats for this,
+ * rather than the inner.  One reason is that the outer relation is typically
+ * bigger, so we get more I/O savings by optimizing for its most common values.
+ * Also, for similarly-sized relations, the planner prefers to put the more
+ * uniformly distributed relation on the inside, so we're more likely to find
+ * interesting skew in the outer relation.
+ */
+typedef struct HashSkewBucket
+{
+	uint32		hashvalue;		/* common hash value */
+	struct HashJoinTupleData *tuples;	/* linked list of inner-relation tuples */
+} HashSkewBucket;
+
+#define SKEW_BUCKET_OVERHEAD  MAXALIGN(sizeof(HashSkewBucket))
+#define INVALID_SKEW_BUCKET_NO	(-1)
+#define SKEW_WORK_MEM_PERCENT  2
+#define SKEW_MIN_OUTER_FRACTION  0.01
+
 
 /* Statistics collection workareas for EXPLAIN ANALYZE */
 typedef struct HashJoinBatchStats
@@ -105,6 +142,12 @@ typedef struct HashJoinTableStats
     int                     nonemptybatches;    /* num of nontrivial batches */
     Size                    workmem_max;        /* work_mem high water mark */
     CdbExplain_Agg          chainlength;        /* hash chain length stats */
+
+    /* Skew optimization statistics */
+    int                     nskewbuckets;       /* skew buckets at start */
+    uint64                  skewinner;          /* inner rows kept in skew buckets */
+    uint64                  skewouter;          /* outer rows probing skew buckets */
+    int                     nunsplittable;      /* batches found unsplittable */
 } HashJoinTableStats;
 
 
@@ -136,11 +179,50 @@ typedef struct HashJoinBatchData
     Size                innerspace;     /* work_mem bytes for inner tuples */
     unsigned            innertuples;    /* inner number of tuples */
 
+    /* A single hash value too big to fit in spaceAllowed, see above */
+    bool                unsplittable;
+    uint32              hotvalue;       /* the offending hash value */
+    Size                hotspace;       /* work_mem bytes for its tuples */
+
     HashJoinBatchSide   innerside;
     HashJoinBatchSide   outerside;
 } HashJoinBatchData;
 
 
+/*
+ * HashJoinProbeBatch
+ *
+ * When gp_hashjoin_probe_batch_size > 0, the first pass over the outer
+ * relation reads a vector of outer tuples ahead, computes all their hash
+ * values, and prefetches the corresponding bucket heads before any of them is
+ * probed.  The cache misses of successive probes then overlap instead of
+ * being paid one after the other, which matters once the hash table no longer
+ * fits in the CPU caches.  A vector holds fewer tuples if they would exceed
+ * spaceAllowed.
+ */
+typedef struct HashJoinProbeBatch
+{
+	int			size;			/* capacity of the arrays below */
+	int			ntuples;		/* number of outer tuples buffered */
+	int			next;			/* index of next tuple to hand out */
+	MemTuple   *tuples;			/* copies of the buffered outer tuples */
+	uint32	   *hashvalues;		/* their hash values */
+	MemoryContext cxt;			/* holds the copies; reset at each refill */
+	Size		spaceAllowed;	/* limit on the space of cxt */
+} HashJoinProbeBatch;
+
+/*
+ * The read-ahead copies are limited to PROBE_BATCH_MEM_PERCENT of the memory
+ * allowed for the join, which is taken off the hash table's share.
+ */
+#define PROBE_BATCH_MEM_PERCENT  2
+
+#if defined(__GNUC__)
+#define HJ_PREFETCH(addr)	__builtin_prefetch(addr)
+#else
+#define HJ_PREFETCH(addr)	((void) 0)
+#endif
+
 /*
  * HashJoinTableData
  */
@@ -154,6 +236,12 @@ typedef struct HashJoinTableData
 	uint64     				  *bloom; /* bloom[i] is bloomfilter for buckets[i] */
 	/* buckets array is per-batch storage, as are all the tuples */
 
+	bool		skewEnabled;	/* are we using skew optimization? */
+	HashSkewBucket **skewBucket;	/* hashtable of skew buckets */
+	int			skewBucketLen;	/* size of skewBucket array (a power of 2!) */
+	int			nSkewBuckets;	/* number of active skew buckets */
+	int		   *skewBucketNums; /* array indexes of active skew buckets */
+
 	int			nbatch;			/* number of batches */
 	int			curbatch;		/* current batch #; 0 during 1st pass */
 
@@ -181,6 +269,8 @@ typedef struct HashJoinTableData
 	bool	   *hashStrict;		/* is each hash join operator strict? */
 
 	Size		spaceAllowed;	/* upper limit for space used */
+	Size		spaceUsedSkew;	/* skew hash table's current space usage */
+	Size		spaceAllowedSkew;	/* upper limit for skew hashtable */
 
 	MemoryContext hashCxt;		/* context for whole-hash-join storage */
 	MemoryContext batchCxt;		/* context for this-batch-only storage */
@@ -46,4 +46,100 @@ extern void InstrStartNode(Instrumentation *instr);
 extern void InstrStopNode(Instrumentation *instr, double nTuples);
 extern void InstrEndLoop(Instrumentation *instr);
 
+/*
+ * GPDB: Always-on profile of a plan node.
+ *
+ * Unlike Instrumentation, which is only allocated for EXPLAIN ANALYZE, the
+ * profile is kept for every node of the top-level query of each backend,
+ * in shared memory so that gp_toolkit can show it while the query runs.
+ * It only has counters that are cheap enough to maintain for every query:
+ * ExecProcNode counts the calls of the node and times one in every
+ * gp_instrument_profile_interval of them with the cycle counter, and a few
+ * hot spots of the executor add their counts to CurrentInstrProfile, the
+ * profile of the node that is running.
+ *
+ * The counters are only written by the backend that owns them; readers may
+ * see them in the middle of an update, which is fine for statistics.
+ */
+typedef struct InstrProfile
+{
+	int			nodeTag;		/* NodeTag of the Plan, or T_Invalid if unused */
+	uint64		ncalls;			/* # of ExecProcNode calls */
+	uint64		nsamples;		/* # of those calls that were timed */
+	uint64		sampleCycles;	/* cycles spent in the timed calls */
+	uint64		spillBytes;		/* bytes written to workfiles */
+	uint64		hashCollisions;	/* hash table entries compared in vain */
+	uint64		motionStallCycles;	/* cycles waiting on the interconnect */
+	uint64		decompressCycles;	/* cycles decompressing AO blocks */
+} InstrProfile;
+
+/*
+ * GPDB: Classes of waits whose time is accounted for the top-level query of
+ * each backend, with InstrWaitStart() and InstrWaitEnd().
+ */
+typedef enum InstrWaitClass
+{
+	INSTR_WAIT_MOTION_RECV,		/* receiving tuples from the interconnect */
+	INSTR_WAIT_MOTION_SEND,		/* waiting for an interconnect send buffer */
+	INSTR_WAIT_READ_IO,			/* reading append-only segment files */
+	INSTR_WAIT_WORKFILE_WRITE,	/* writing workfiles */
+	INSTR_WAIT_LOCK,			/* waiting for heavyweight locks */
+	INSTR_NUM_WAIT_CLASSES
+} InstrWaitClass;
+
+extern const char *const InstrWaitClassNames[INSTR_NUM_WAIT_CLASSES];
+
+/* Nodes beyond this plan_node_id are not profiled */
+#define INSTR_PROFILE_MAX_NODES 64
+
+/* Profile of the query that runs in one backend */
+typedef struct InstrProfileSlot
+{
+	/*
+	 * The identity of the query is protected by changecount, like
+	 * PgBackendStatus: it is bumped before and after each change, so that
+	 * readers can retry if it is odd or changes while they copy the slot.
+	 */
+	int			changecount;
+	int			pid;
+	int			sessionId;		/* 0 if no query is being profiled */
+	int			commandCount;
+	int			sliceId;
+	int			nnodes;			/* # of entries of nodes in use */
+	uint64		waitCycles[INSTR_NUM_WAIT_CLASSES];	/* by InstrWaitClass */
+	InstrProfile nodes[INSTR_PROFILE_MAX_NODES];	/* by plan_node_id */
+} InstrProfileSlot;
+
+struct EState;
+struct Plan;
+
+extern InstrProfile *CurrentInstrProfile;
+extern uint64 *InstrWaitCycles;
+
+extern Size InstrProfileShmemSize(void);
+extern void InstrProfileShmemInit(void);
+extern void InstrProfileQueryStart(struct EState *estate);
+extern void InstrProfileQueryEnd(struct EState *estate);
+extern InstrProfile *InstrProfileAlloc(struct EState *estate, struct Plan *plan);
+extern void AtEOXact_InstrProfile(void);
+extern int	InstrProfileSlotCount(void);
+extern bool InstrProfileSlotCopy(int slotno, InstrProfileSlot *dst);
+extern double InstrProfileCyclesToSeconds(uint64 cycles);
+
+/*
+ * Account the time since startCycles, as returned by InstrWaitStart(), to a
+ * class of waits of the current query.
+ */
+static inline uint64
+InstrWaitStart(void)
+{
+	return INSTR_CYCLES_GET_CURRENT();
+}
+
+static inline void
+InstrWaitEnd(InstrWaitClass waitClass, uint64 startCycles)
+{
+	InstrWaitCycles[waitClass] += INSTR_CYCLES_GET_CURRENT() - startCycles;
+}
+
 #endif   /* INSTRUMENT_H */
@@ -134,6 +134,28 @@ typedef struct AggStatePerAggData
 	 */
 
 	void *sortstate;	/* sort object, if DISTINCT or ORDER BY */
+
+	/*
+	 * Hash-based DISTINCT elimination.  A single-input DISTINCT aggregate
+	 * whose equality operator is hashable and whose result does not depend
+	 * on input order (it has a preliminary function) keeps the values of
+	 * the current group in distinctTable and feeds each one to the
+	 * transition function the first time it is seen, so no sort is needed.
+	 * If the table outgrows distinctMemLimit, it stops growing: values not
+	 * already in it go into sortstate (which spills through workfiles) and
+	 * are deduplicated against the table when the group is finalized.  The
+	 * table is kept across groups; only entries stamped with the current
+	 * distinctGroupNo are in the set.
+	 */
+	bool		useDistinctHash;
+	bool		distinctSpilled;	/* sortstate holds the overflow */
+	int64		distinctGroupNo;
+	AttrNumber	distinctColIdx;
+	FmgrInfo   *distinctEqfns;
+	FmgrInfo   *distinctHashfns;
+	Size		distinctMemLimit;
+	MemoryContext distinctcxt;
+	TupleHashTable distinctTable;
 } AggStatePerAggData;
 
 /*
@@ -176,6 +198,9 @@ initialize_aggregates(AggState *aggstate,
 extern void 
 advance_aggregates(AggState *aggstate, AggStatePerGroup pergroup,
 				   MemoryManagerContainer *mem_manager);
+extern bool
+agg_scan_pipeline(AggState *aggstate, AggStatePerGroup pergroup,
+				  MemoryManagerContainer *mem_manager);
 
 extern List *find_hash_columns(AggState *aggstate);
 
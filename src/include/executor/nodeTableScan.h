@@ -11,6 +11,7 @@
 extern int	ExecCountSlotsTableScan(TableScan *node);
 extern TableScanState *ExecInitTableScan(TableScan *node, EState *estate, int eflags);
 extern TupleTableSlot *ExecTableScan(TableScanState *node);
+extern TupleTableSlot *ExecTableScanFetch(TableScanState *node);
 extern void ExecEndTableScan(TableScanState *node);
 extern void ExecTableMarkPos(TableScanState *node);
 extern void ExecTableRestrPos(TableScanState *node);
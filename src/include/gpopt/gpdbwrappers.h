@@ -136,6 +136,9 @@ namespace gpdb {
 	// add member to Bitmapset
 	Bitmapset *PbmsAddMember(Bitmapset *a, int x);
 
+	// are the two Bitmapsets equal
+	bool FBmsEqual(const Bitmapset *a, const Bitmapset *b);
+
 	// create a copy of an object
 	void *PvCopyObject(void *from);
 
@@ -151,6 +154,9 @@ namespace gpdb {
 	// extract nodes with specific tag from a plan tree
 	List *PlExtractNodesPlan(Plan *pl, int nodeTag, bool descendIntoSubqueries);
 
+	// extract the param ids of a plan tree, reusing those of the given plan nodes
+	Bitmapset *PbmsExtractParamIdsPlan(Plan *pl, Bitmapset *pbmsKnownPlanIds);
+
 	// extract nodes with specific tag from an expression tree
 	List *PlExtractNodesExpression(Node *node, int nodeTag, bool descendIntoSubqueries);
 	
@@ -190,6 +196,9 @@ namespace gpdb {
 	// attribute statistics
 	HeapTuple HtAttrStats(Oid relid, AttrNumber attnum);
 
+	// load the statistics of all attributes of a relation into the syscache
+	void PrefetchAttrStats(Oid relid);
+
 	// function oids
 	List *PlFunctionOids(void);
 
@@ -610,9 +619,67 @@ namespace gpdb {
 	// return the number of leaf partition for a given table oid
 	gpos::ULONG UlLeafPartitions(Oid oidRelation);
 
-	// Does the metadata cache need to be reset (because of a catalog
-	// table has been changed?)
-	bool FMDCacheNeedsReset(void);
+	// catalog objects whose metadata cache entries have become stale
+	struct SMDCacheInvalidations
+	{
+		// relations whose relation, relation stats and column stats entries
+		// are stale
+		List *m_plRelOids;
+
+		// for each relation, an upper bound on the column positions the
+		// optimizer may have fetched stats for
+		List *m_plRelNumCols;
+
+		// triggers and check constraints of those relations
+		List *m_plRelMemberOids;
+
+		// types, functions, operators, aggregates and check constraints
+		// changed in the catalog since they were fetched
+		List *m_plObjOids;
+	};
+
+	// remember that the object with the given oid was fetched into the
+	// metadata cache, so that FMDCacheNeedsReset() can tell its changes
+	void MDCacheNoteObject(Oid oid);
+
+	// Collect the catalog objects changed since the last call into
+	// pmdinval. Returns true if the changes could not be narrowed down to
+	// individual objects and the whole metadata cache needs to be reset.
+	bool FMDCacheNeedsReset(SMDCacheInvalidations *pmdinval);
+
+	// can the current transaction use the metadata cache shared by all backends
+	bool FMDSharedCacheUsable(void);
+
+	// current generation of the shared metadata cache, to pass to FMDSharedCacheInsert
+	uint64 UllMDSharedCacheGeneration(void);
+
+	// look up a serialized metadata object in the shared cache; returns a palloc'd copy
+	void *PvMDSharedCacheLookup(const char *szMDId, Size *pulLen);
+
+	// insert a serialized metadata object into the shared cache; changes to
+	// relation oidRel, or to any relation if fPartitioned, make it stale
+	bool FMDSharedCacheInsert(const char *szMDId, Oid oidRel, bool fPartitioned, const void *pv, Size ulLen, uint64 ullGeneration);
+
+	// look up the cached plan of a query with the given fingerprint; returns a copy
+	PlannedStmt *PplstmtOptPlanCacheLookup(const char *szFingerprint);
+
+	// cache the plan of a query with the given fingerprint
+	void OptPlanCacheInsert(const char *szFingerprint, Query *pquery, PlannedStmt *pplstmt);
+
+	// evict the cached plans that depend on any of the given relations
+	void OptPlanCacheInvalidate(List *plRelOids);
+
+	// evict all cached plans
+	void OptPlanCacheReset(void);
+
+	// look up the translated statistics of a column built from the given pg_statistic row
+	void *PvOptStatsCacheLookup(Oid relid, AttrNumber attnum, HeapTuple htStats, float4 fRelTuples, Size *pulLen);
+
+	// cache the translated statistics of a column built from the given pg_statistic row
+	void OptStatsCacheInsert(Oid relid, AttrNumber attnum, HeapTuple htStats, float4 fRelTuples, const void *pv, Size ulLen);
+
+	// cost model parameters measured on this cluster, see gp_optimizer_cost_params
+	List *PlOptimizerCostParams();
 
 } //namespace gpdb
 
@@ -53,6 +53,11 @@ namespace gpmd
 			// private copy ctor
 			CMDProviderRelcache(const CMDProviderRelcache&);
 
+			// relation whose changes make the given object stale in the
+			// metadata cache shared by all backends, if any
+			static
+			OID OidSharedCacheRel(IMDId *pmdid, BOOL *pfPartitioned);
+
 		public:
 			// ctor/dtor
 			explicit
@@ -131,6 +131,9 @@ namespace gpdxl
 			
 			// CTAS distribution policy
 			GpPolicy  *m_pdistrpolicy;
+
+			// ids of the plan nodes whose param ids have been computed
+			Bitmapset *m_pbmsPlanIdsWithParams;
 			
 		public:
 			// ctor/dtor
@@ -203,6 +206,18 @@ namespace gpdxl
 			void IncrementPartitionSelectors(ULONG ulScanId);
 
 			void AddSubplan(Plan * );
+
+			// record that the param ids of the given plan node have been computed
+			void AddPlanWithParams(ULONG ulPlanId)
+			{
+				m_pbmsPlanIdsWithParams = gpdb::PbmsAddMember(m_pbmsPlanIdsWithParams, (int) ulPlanId);
+			}
+
+			// ids of the plan nodes whose param ids have been computed
+			Bitmapset *PbmsPlanIdsWithParams() const
+			{
+				return m_pbmsPlanIdsWithParams;
+			}
 				
 			// add CTAS information
 			void AddCtasInfo(IntoClause *pintocl, GpPolicy *pdistrpolicy);
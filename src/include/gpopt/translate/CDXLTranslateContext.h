@@ -65,7 +65,8 @@ namespace gpdxl
 			// mappings ColId->TargetEntry used for intermediate DXL nodes
 			HMUlTe *m_phmulte;
 
-			// mappings ColId->ParamId used for outer refs in subplans
+			// mappings ColId->ParamId used for outer refs in subplans, shared with
+			// the parent context until a new mapping is inserted
 			HMColParam *m_phmcolparam;
 
 			// is the node for which this context is built a child of an aggregate node
@@ -75,14 +76,14 @@ namespace gpdxl
 			// to use OUTER instead of 0 for Var::varno in Agg target lists (MPP-12034)
 			BOOL m_fChildAggNode;
 
-			// copy the params hashmap
-			void CopyParamHashmap(HMColParam *phmOriginal);
+			// replace the shared params hashmap with a private copy
+			void CopyParamHashmap();
 
 		public:
 			// ctor/dtor
 			CDXLTranslateContext(IMemoryPool *pmp, BOOL fChildAggNode);
 
-			CDXLTranslateContext(IMemoryPool *pmp, BOOL fChildAggNode, HMColParam *phmOriginal);
+			CDXLTranslateContext(IMemoryPool *pmp, BOOL fChildAggNode, HMColParam *phmOriginal, ULONG ulSize = 128);
 
 			~CDXLTranslateContext();
 
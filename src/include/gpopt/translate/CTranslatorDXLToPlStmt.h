@@ -28,6 +28,7 @@
 #include "nodes/plannodes.h"
 
 #include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
 
 #include "naucrates/dxl/operators/dxlops.h"
 #include "naucrates/dxl/CIdGenerator.h"
@@ -270,6 +271,9 @@ namespace gpdxl
 			// translate the join types from its DXL representation to the GPDB one
 			static JoinType JtFromEdxljt(EdxlJoinType edxljt);
 
+			// append the settings that affect plan translation to a string
+			static void AppendSettings(CWStringDynamic *pstr);
+
 		private:
 
 			// initialize index of operator translators
@@ -19,8 +19,10 @@
 #define GPDXL_CTranslatorRelcacheToDXL_H
 
 #include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
 #include "c.h"
 #include "postgres.h"
+#include "access/htup.h"
 #include "access/tupdesc.h"
 #include "catalog/gp_policy.h"
 
@@ -209,52 +211,146 @@ namespace gpdxl
 			static
 			IMDCacheObject *PmdobjScCmp(IMemoryPool *pmp, IMDId *pmdid);
 
+			//---------------------------------------------------------------------------
+			//	@struct:
+			//		SColStatsCompact
+			//
+			//	@doc:
+			//		Header of the compact binary form of translated column statistics,
+			//		which are cached across queries. It is followed by the buckets and
+			//		by the values of the bucket boundaries, each part MAXALIGN'ed
+			//
+			//---------------------------------------------------------------------------
+			struct SColStatsCompact
+			{
+				DOUBLE m_dWidth;
+				DOUBLE m_dNullFreq;
+				DOUBLE m_dDistinctRemain;
+				DOUBLE m_dFreqRemain;
+
+				// number of buckets
+				ULONG m_ulBuckets;
+
+				// number of boundary values
+				ULONG m_ulValues;
+			};
+
+			// bucket of compact column statistics
+			struct SColStatsCompactBucket
+			{
+				DOUBLE m_dFrequency;
+				DOUBLE m_dDistinct;
+
+				// boundaries, as indexes of boundary values
+				ULONG m_ulLower;
+				ULONG m_ulUpper;
+
+				BOOL m_fLowerClosed;
+				BOOL m_fUpperClosed;
+			};
+
+			// boundary value of compact column statistics: the datum, or the
+			// data it points to, stored at the given offset from the header
+			struct SColStatsCompactValue
+			{
+				ULONG m_ulOffset;
+				ULONG m_ulLen;
+			};
+
+			// translate a pg_statistic row into compact column statistics
+			static
+			BYTE *PbaColStats
+				(
+				IMemoryPool *pmp,
+				const IMDType *pmdtype,
+				const IMDRelation *pmdrel,
+				const IMDColumn *pmdcol,
+				HeapTuple heaptupleStats,
+				CDouble dRows,
+				ULONG *pulSize,
+				CHistogram **pphistReference
+				);
+
+			// transform stats from pg_stats form to compact column statistics,
+			// merging the MCVs into the histogram
+			static
+			BYTE *PbaTransformStats
+				(
+				IMemoryPool *pmp,
+				const IMDType *pmdtype,
+				CDouble dWidth,
+				CDouble dDistinct,
+				CDouble dNullFreq,
+				const Datum *pdrgdatumMCVValues,
+				const float4 *pdrgfMCVFrequencies,
+				ULONG ulNumMCVValues,
+				const Datum *pdrgdatumHistValues,
+				ULONG ulNumHistValues,
+				ULONG *pulSize
+				);
+
+			// transform stats from pg_stats form to a histogram the way the
+			// optimizer itself does, with CStatisticsUtils::PhistMergeMcvHist();
+			// used as a reference for PbaTransformStats
+			static
+			CHistogram *PhistTransformStatsReference
+				(
+				IMemoryPool *pmp,
+				const IMDType *pmdtype,
+				CDouble dDistinct,
+				CDouble dNullFreq,
+				const Datum *pdrgdatumMCVValues,
+				const float4 *pdrgfMCVFrequencies,
+				ULONG ulNumMCVValues,
+				const Datum *pdrgdatumHistValues,
+				ULONG ulNumHistValues
+				);
+
 			// transform GPDB's MCV information to optimizer's histogram structure
 			static
 			CHistogram *PhistTransformGPDBMCV
-								(
-								IMemoryPool *pmp,
-								const IMDType *pmdtype,
-								const Datum *pdrgdatumMCVValues,
-								const float4 *pdrgfMCVFrequencies,
-								ULONG ulNumMCVValues
-								);
+				(
+				IMemoryPool *pmp,
+				const IMDType *pmdtype,
+				const Datum *pdrgdatumMCVValues,
+				const float4 *pdrgfMCVFrequencies,
+				ULONG ulNumMCVValues
+				);
 
 			// transform GPDB's hist information to optimizer's histogram structure
 			static
 			CHistogram *PhistTransformGPDBHist
-								(
-								IMemoryPool *pmp,
-								const IMDType *pmdtype,
-								const Datum *pdrgdatumHistValues,
-								ULONG ulNumHistValues,
-								CDouble dDistinctHist,
-								CDouble dFreqHist
-								);
-
-			// histogram to array of dxl buckets
-			static
-			DrgPdxlbucket *Pdrgpdxlbucket
-								(
-								IMemoryPool *pmp,
-								const IMDType *pmdtype,
-								const CHistogram *phist
-								);
-
-			// transform stats from pg_stats form to optimizer's preferred form
-			static
-			DrgPdxlbucket *PdrgpdxlbucketTransformStats
-								(
-								IMemoryPool *pmp,
-								OID oidAttType,
-								CDouble dDistinct,
-								CDouble dNullFreq,
-								const Datum *pdrgdatumMCVValues,
-								const float4 *pdrgfMCVFrequencies,
-								ULONG ulNumMCVValues,
-								const Datum *pdrgdatumHistValues,
-								ULONG ulNumHistValues
-								);
+				(
+				IMemoryPool *pmp,
+				const IMDType *pmdtype,
+				const Datum *pdrgdatumHistValues,
+				ULONG ulNumHistValues,
+				CDouble dDistinctHist,
+				CDouble dFreqHist
+				);
+
+			// fraction of a histogram bucket that lies below the given value
+			static
+			CDouble DBucketFraction(IDatum *pdatumLower, IDatum *pdatumUpper, IDatum *pdatum);
+
+			// singleton bucket of an MCV
+			static
+			SColStatsCompactBucket BucketSingleton(ULONG ulValue, DOUBLE dFrequency);
+
+			// datum of a boundary value of compact column statistics
+			static
+			Datum DatumCompactValue(const IMDType *pmdtype, const BYTE *pba, const SColStatsCompactValue *pvalue);
+
+			// create a column stats object from compact column statistics
+			static
+			CDXLColStats *PdxlcolstatsCompact
+				(
+				IMemoryPool *pmp,
+				const IMDType *pmdtype,
+				CMDIdColStats *pmdidColStats,
+				CMDName *pmdnameCol,
+				const BYTE *pba
+				);
 
 			// get partition keys for a relation
 			static
@@ -408,6 +504,12 @@ namespace gpdxl
 			static
 			IMDRelation *Pmdrel(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid);
 
+			// check that the MCVs and the histogram of a column are merged into
+			// the same buckets as CStatisticsUtils::PhistMergeMcvHist() produces,
+			// describing the differences in the given string
+			static
+			BOOL FCheckColStatsMerge(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdidColStats, CWStringDynamic *pstrReport);
+
 			// add system columns (oid, tid, xmin, etc) in table descriptors
 			static
 			void AddSystemColumns(IMemoryPool *pmp, DrgPmdcol *pdrgpmdcol, BOOL fhasOid, BOOL fAOTable);
@@ -104,25 +104,72 @@ namespace gpdxl
 
 		public:
 
+			// hash map from relation oid to the set of its referenced attnos
+			typedef CHashMap<ULONG, CBitSet, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
+				CleanupDelete<ULONG>, CleanupRelease<CBitSet> > HMUlPbs;
+
+			typedef CHashMapIter<ULONG, CBitSet, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
+				CleanupDelete<ULONG>, CleanupRelease<CBitSet> > HMIterUlPbs;
+
 			typedef struct CContextPreloadMD
 			{
 				public:
+					// range table of a query, linked to that of the enclosing query
+					struct SRangeTable
+					{
+						List *m_plRtable;
+
+						SRangeTable *m_prtParent;
+					};
+
 					// memory pool
 					IMemoryPool *m_pmp;
 
 					// MD accessor for function names
 					CMDAccessor *m_pmda;
 
+					// range table of the innermost query being walked
+					SRangeTable *m_prt;
+
+					// whether the columns referenced in the expression being
+					// walked are needed for cardinality estimation
+					BOOL m_fCollectColumns;
+
+					// relations referenced in the query and their referenced
+					// columns, attno 0 stands for all columns
+					HMUlPbs *m_phmulpbsRelAttnos;
+
 					CContextPreloadMD
 						(
 						IMemoryPool *pmp,
 						CMDAccessor *pmda
 						)
-						: m_pmp(pmp), m_pmda(pmda)
-					{}
+						: m_pmp(pmp), m_pmda(pmda), m_prt(NULL), m_fCollectColumns(false), m_phmulpbsRelAttnos(NULL)
+					{
+						m_phmulpbsRelAttnos = GPOS_NEW(pmp) HMUlPbs(pmp);
+					}
 
 					~CContextPreloadMD()
-					{}
+					{
+						m_phmulpbsRelAttnos->Release();
+					}
+
+					// referenced attnos of the given relation
+					CBitSet *PbsAttnos
+						(
+						OID oidRel
+						)
+					{
+						ULONG ulOid = oidRel;
+						CBitSet *pbs = m_phmulpbsRelAttnos->PtLookup(&ulOid);
+						if (NULL == pbs)
+						{
+							pbs = GPOS_NEW(m_pmp) CBitSet(m_pmp);
+							(void) m_phmulpbsRelAttnos->FInsert(GPOS_NEW(m_pmp) ULONG(ulOid), pbs);
+						}
+
+						return pbs;
+					}
 
 			} CContextPreloadMD;
 
@@ -248,7 +295,13 @@ namespace gpdxl
 			BOOL FPreloadMDStatsWalker(Node *pnode, CContextPreloadMD *pstrtxpreloadmd);
 
 			static
-			void PreloadMDStats(IMemoryPool *pmp, CMDAccessor *pmda, OID oidRelation);
+			void PreloadMDStatsExpr(Node *pnode, CContextPreloadMD *pctxpreloadmd, BOOL fCollectColumns);
+
+			static
+			void PreloadMDStatsQuery(Query *pquery, CContextPreloadMD *pctxpreloadmd);
+
+			static
+			void PreloadMDStats(IMemoryPool *pmp, CMDAccessor *pmda, OID oidRelation, const CBitSet *pbsAttnos);
 
 			// preload basic information in the MD cache, including base types
 			// and MD objects referenced in the given query
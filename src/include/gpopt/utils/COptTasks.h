@@ -34,6 +34,11 @@ namespace gpdxl
 	class CDXLNode;
 }
 
+namespace gpmd
+{
+	class IMDId;
+}
+
 namespace gpopt
 {
 	class CExpression;
@@ -195,6 +200,10 @@ class COptTasks
 		static
 		void* PvDXLFromRelStatsTask(void *pv);
 
+		// check the merge of MCVs and histograms of the columns of a relation
+		static
+		void* PvCheckColStatsMergeTask(void *pv);
+
 		// evaluates an expression given as a serialized DXL string and returns the serialized DXL result
 		static
 		void* PvEvalExprFromDXLTask(void *pv);
@@ -203,6 +212,18 @@ class COptTasks
 		static
 		COptimizerConfig *PoconfCreate(IMemoryPool *pmp, ICostModel *pcm);
 
+		// remove an object from the metadata cache
+		static
+		void EvictMDCacheEntry(gpmd::IMDId *pmdid);
+
+		// remove a relation and the objects it refers to from the metadata cache
+		static
+		void EvictMDRelation(IMemoryPool *pmp, OID oid);
+
+		// initialize the metadata cache or bring it up to date with catalog changes
+		static
+		BOOL FRefreshMDCache(IMemoryPool *pmp);
+
 		// optimize a query to a physical DXL
 		static
 		void* PvOptimizeTask(void *pv);
@@ -219,6 +240,10 @@ class COptTasks
 		static
 		DrgPss *PdrgPssLoad(IMemoryPool *pmp, char *szPath);
 
+		// limit a search strategy to the given time
+		static
+		DrgPss *PdrgPssTimeBoxed(IMemoryPool *pmp, DrgPss *pdrgpss, ULONG ulTimeLimit);
+
 		// allocate memory for string
 		static
 		CHAR *SzAllocate(IMemoryPool *pmp, ULONG ulSize);
@@ -243,6 +268,10 @@ class COptTasks
 		static
 		void SetCostModelParams(ICostModel *pcm);
 
+		// set the cost units measured on this cluster
+		static
+		void SetCalibratedCostModelParams(ICostModel *pcm);
+
 		// generate an instance of optimizer cost model
 		static
 		ICostModel *Pcm(IMemoryPool *pmp, ULONG ulSegments);
@@ -251,6 +280,10 @@ class COptTasks
 		static
 		void PrintMissingStatsWarning(IMemoryPool *pmp, CMDAccessor *pmda, DrgPmdid *pdrgmdidCol, HMMDIdMDId *phmmdidRel);
 
+		// fingerprint of a query for the plan cache
+		static
+		CHAR *SzPlanFingerprint(IMemoryPool *pmp, CDXLNode *pdxlnQuery, DrgPdxln *pdrgpdxlnQueryOutput, DrgPdxln *pdrgpdxlnCTE, CBitSet *pbsTraceFlags, ULONG ulSegments, ULONG ulSegmentsForCosting, BOOL fMasterOnly, BOOL fCanSetTag);
+
 	public:
 
 		// convert Query->DXL->LExpr->Optimize->PExpr->DXL
@@ -293,6 +326,12 @@ class COptTasks
 		static
 		char *SzRelStats(List *oids);
 
+		// check that the MCVs and histograms of the columns of a relation are
+		// merged the same way as the optimizer merges them, and report the
+		// result of every column
+		static
+		char *SzCheckColStatsMerge(List *oids);
+
 		// enable/disable a given xforms
 		static
 		bool FSetXform(char *szXform, bool fDisable);
@@ -29,6 +29,8 @@ extern "C" {
 #include "executor/nodeMotion.h"
 #include "parser/parsetree.h"
 #include "utils/inval.h"
+#include "utils/hsearch.h"
+#include "utils/syscache.h"
 #include "utils/lsyscache.h"
 #include "utils/datum.h"
 #include "utils/array.h"
@@ -52,6 +54,11 @@ extern "C" {
 #include "optimizer/tlist.h"
 #include "nodes/makefuncs.h"
 #include "catalog/pg_operator.h"
+#include "catalog/pg_aggregate.h"
+#include "catalog/pg_cast.h"
+#include "catalog/pg_constraint.h"
+#include "catalog/pg_statistic.h"
+#include "catalog/gp_optimizer_cost_params.h"
 #include "lib/stringinfo.h"
 #include "utils/elog.h"
 #include "utils/rel.h"
@@ -64,6 +71,10 @@ extern "C" {
 #include "parser/parse_coerce.h"
 #include "utils/selfuncs.h"
 #include "utils/faultinjector.h"
+#include "utils/mdsharedcache.h"
+#include "utils/optplancache.h"
+#include "utils/optstatscache.h"
+#include "utils/optcalibrate.h"
 
 extern
 Query *preprocess_query_optimizer(Query *pquery, ParamListInfo boundParams);
@@ -1408,6 +1408,12 @@ typedef struct PlanState
 	void      (*cdbexplainfun)(struct PlanState *planstate, struct StringInfoData *buf);
 	/* callback before ExecutorEnd */
 
+	/*
+	 * Always-on profile (see InstrProfile), or NULL if not profiled
+	 */
+	struct InstrProfile *profile;
+	int			profileCountdown;	/* # of calls until the next timed one */
+
 	/*
 	 * GpMon packet
 	 */
@@ -2020,6 +2026,16 @@ typedef struct AOCSScanState
  * During execution, the 'opaque' is mapped to different XXXOpaqueData
  * for different table type.
  */
+typedef struct MemTupleDeformCodegenInfo
+{
+	/* Pointer to store MemTupleDeformCodegen from Codegen */
+	void* code_generator;
+	/* Function pointer that points to either regular or generated memtuple_getsomeattrs */
+	MemTupleDeformFn MemTupleDeform_fn;
+	/* Number of leading attributes to deform */
+	int natts;
+} MemTupleDeformCodegenInfo;
+
 typedef struct TableScanState
 {
 	ScanState	ss;
@@ -2028,6 +2044,11 @@ typedef struct TableScanState
 	 * Opaque data that is associated with different table type.
 	 */
 	void	   *opaque;
+
+#ifdef USE_CODEGEN
+	/* deforming of the memtuples of an append-only row table */
+	MemTupleDeformCodegenInfo MemTupleDeform_gen_info;
+#endif
 } TableScanState;
 
 /*
@@ -2182,7 +2203,8 @@ typedef struct MergeJoinState
  *		hj_HashTable			hash table for the hashjoin
  *								(NULL if table not built yet)
  *		hj_CurHashValue			hash value for current outer tuple
- *		hj_CurBucketNo			bucket# for current outer tuple
+ *		hj_CurBucketNo			regular bucket# for current outer tuple
+ *		hj_CurSkewBucketNo		skew bucket# for current outer tuple
  *		hj_CurTuple				last inner tuple matched to current outer
  *								tuple, or NULL if starting search
  *								(CurHashValue, CurBucketNo and CurTuple are
@@ -2198,6 +2220,8 @@ typedef struct MergeJoinState
  *		hj_MatchedOuter			true if found a join match for current outer
  *		hj_OuterNotEmpty		true if outer relation known not empty
  *		hj_nonequijoin			true to force hash table to keep nulls
+ *		hj_ProbeBatch			outer tuples read ahead for batched probing,
+ *								or NULL if gp_hashjoin_probe_batch_size is 0
  * ----------------
  */
 
@@ -2205,6 +2229,14 @@ typedef struct MergeJoinState
 typedef struct HashJoinTupleData *HashJoinTuple;
 typedef struct HashJoinTableData *HashJoinTable;
 
+typedef struct ExecHashGetHashValueCodegenInfo
+{
+	/* Pointer to store ExecHashGetHashValueCodegen from Codegen */
+	void* code_generator;
+	/* Function pointer that points to either regular or generated ExecHashGetHashValue */
+	ExecHashGetHashValueFn ExecHashGetHashValue_fn;
+} ExecHashGetHashValueCodegenInfo;
+
 typedef struct HashJoinState
 {
 	JoinState	js;				/* its first field is NodeTag */
@@ -2213,6 +2245,7 @@ typedef struct HashJoinState
 	HashJoinTable hj_HashTable;
 	uint32		hj_CurHashValue;
 	int			hj_CurBucketNo;
+	int			hj_CurSkewBucketNo;
 	HashJoinTuple hj_CurTuple;
 	List	   *hj_OuterHashKeys;		/* list of ExprState nodes */
 	List	   *hj_InnerHashKeys;		/* list of ExprState nodes */
@@ -2227,9 +2260,15 @@ typedef struct HashJoinState
 	bool		hj_InnerEmpty;  /* set to true if inner side is empty */
 	bool		prefetch_inner;
 	bool		hj_nonequijoin;
+	struct HashJoinProbeBatch *hj_ProbeBatch;
 
 	/* set if the operator created workfiles */
 	bool workfiles_created;
+
+#ifdef USE_CODEGEN
+	/* hash values of the outer tuples */
+	ExecHashGetHashValueCodegenInfo ExecHashGetHashValue_gen_info;
+#endif
 } HashJoinState;
 
 
@@ -2308,6 +2347,14 @@ extern void shareinput_create_bufname_prefix(char* p, int size, int share_id);
  *	 SortState information
  * ----------------
  */
+typedef struct MKCompareDatumCodegenInfo
+{
+	/* Pointer to store MKCompareDatumCodegen from Codegen */
+	void* code_generator;
+	/* Function pointer that points to either regular or generated tupsort_compare_datum */
+	MKCompareDatumFn MKCompareDatum_fn;
+} MKCompareDatumCodegenInfo;
+
 typedef struct SortState
 {
 	ScanState	ss;				/* its first field is NodeTag */
@@ -2327,6 +2374,10 @@ typedef struct SortState
 
 	void	   *share_lk_ctxt;
 
+#ifdef USE_CODEGEN
+	/* comparator of the multi-key sort */
+	MKCompareDatumCodegenInfo MKCompareDatum_gen_info;
+#endif
 } SortState;
 
 /* ---------------------
@@ -2350,6 +2401,30 @@ typedef struct AdvanceAggregatesCodegenInfo
 	AdvanceAggregatesFn AdvanceAggregates_fn;
 } AdvanceAggregatesCodegenInfo;
 
+typedef struct CalcHashValueCodegenInfo
+{
+	/* Pointer to store CalcHashValueCodegen from Codegen */
+	void* code_generator;
+	/* Function pointer that points to either regular or generated calc_hash_value */
+	CalcHashValueFn CalcHashValue_fn;
+} CalcHashValueCodegenInfo;
+
+typedef struct AggHashEntryMatchCodegenInfo
+{
+	/* Pointer to store AggHashEntryMatchCodegen from Codegen */
+	void* code_generator;
+	/* Function pointer that points to either regular or generated agg_hash_entry_match */
+	AggHashEntryMatchFn AggHashEntryMatch_fn;
+} AggHashEntryMatchCodegenInfo;
+
+typedef struct AggScanPipelineCodegenInfo
+{
+	/* Pointer to store AggScanPipelineCodegen from Codegen */
+	void* code_generator;
+	/* Function pointer that points to either regular or generated agg_scan_pipeline */
+	AggScanPipelineFn AggScanPipeline_fn;
+} AggScanPipelineCodegenInfo;
+
 /* these structs are private in nodeAgg.c: */
 typedef struct AggStatePerAggData *AggStatePerAgg;
 typedef struct AggStatePerGroupData *AggStatePerGroup;
@@ -2400,6 +2475,12 @@ typedef struct AggState
 
 #ifdef USE_CODEGEN
 	AdvanceAggregatesCodegenInfo AdvanceAggregates_gen_info;
+	CalcHashValueCodegenInfo CalcHashValue_gen_info;
+	AggHashEntryMatchCodegenInfo AggHashEntryMatch_gen_info;
+	/* deforming of the hash table entries */
+	MemTupleDeformCodegenInfo MemTupleDeform_gen_info;
+	/* plain aggregation fused with the outer table scan */
+	AggScanPipelineCodegenInfo AggScanPipeline_gen_info;
 #endif
 } AggState;
 
@@ -2493,6 +2574,11 @@ typedef struct HashState
 	bool		hs_quit_if_hashkeys_null;	/* quit building hash table if hashkeys are all null */
 	bool		hs_hashkeys_null;	/* found an instance wherein hashkeys are all null */
 	/* hashkeys is same as parent's hj_InnerHashKeys */
+
+#ifdef USE_CODEGEN
+	/* hash values of the inner tuples, enrolled by the parent HashJoin */
+	ExecHashGetHashValueCodegenInfo ExecHashGetHashValue_gen_info;
+#endif
 } HashState;
 
 /* ----------------
@@ -36,6 +36,7 @@ typedef struct PlannerConfig
 	bool		gp_enable_sequential_window_plans;
 	bool 		gp_hashagg_streambottom;
 	bool		gp_enable_agg_distinct;
+	bool		gp_enable_agg_distinct_hash;
 	bool		gp_enable_dqa_pruning;
 	bool		gp_eager_dqa_pruning;
 	bool		gp_eager_one_phase_agg;
@@ -1020,6 +1020,18 @@ typedef struct Hash
 {
 	Plan		plan;
 	bool		rescannable;            /* CDB: true => save rows for rescan */
+
+	/*
+	 * Skew optimization.  If the hash join has a single clause whose outer
+	 * side is a simple column with MCV statistics, the planner ships the most
+	 * common values (as Consts, in decreasing frequency order) so that the
+	 * executor can keep the matching inner tuples in memory.  Statistics are
+	 * only available on the QD, hence we cannot look them up at execution.
+	 * skewMinMCVs is the number of leading MCVs needed to cover
+	 * SKEW_MIN_OUTER_FRACTION of the outer relation.
+	 */
+	List	   *skewMCVs;		/* list of Const, or NIL */
+	int			skewMinMCVs;
 	/* all other info is in the parent HashJoin node */
 } Hash;
 
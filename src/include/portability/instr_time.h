@@ -42,6 +42,11 @@
  *
  * Beware of multiple evaluations of the macro arguments.
  *
+ * GPDB: INSTR_CYCLES_GET_CURRENT() reads a free-running cycle counter, for
+ * sampling code paths where even gettimeofday() is too expensive.  The
+ * counter has no fixed unit; on platforms without one, it counts
+ * microseconds.  Only differences of it are meaningful.
+ *
  *
  * Copyright (c) 2001-2010, PostgreSQL Global Development Group
  *
@@ -155,4 +160,21 @@ GetTimerFrequency(void)
 }
 #endif   /* WIN32 */
 
+static inline uint64
+INSTR_CYCLES_GET_CURRENT(void)
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	uint32		lo;
+	uint32		hi;
+
+	__asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+	return ((uint64) hi << 32) | lo;
+#else
+	instr_time	now;
+
+	INSTR_TIME_SET_CURRENT(now);
+	return INSTR_TIME_GET_MICROSEC(now);
+#endif
+}
+
 #endif   /* INSTR_TIME_H */
@@ -1261,4 +1261,7 @@ extern Datum enable_xform(PG_FUNCTION_ARGS);
 /* Optimizer's version */
 extern Datum gp_opt_version(PG_FUNCTION_ARGS);
 
+/* Optimizer cost model calibration, utils/gp/optcalibrate.c */
+extern Datum gp_calibrate_optimizer_cost_model(PG_FUNCTION_ARGS);
+
 #endif   /* BUILTINS_H */
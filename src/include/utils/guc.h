@@ -386,7 +386,13 @@ extern bool optimizer_print_query;
 extern bool optimizer_print_plan;
 extern bool optimizer_print_xform;
 extern bool optimizer_metadata_caching;
+extern bool optimizer_prefetch_metadata;
+extern bool optimizer_cost_calibration;
 extern int optimizer_mdcache_size;
+extern int optimizer_mdcache_shared_size;
+extern int optimizer_plan_cache_size;
+extern int optimizer_stats_cache_size;
+extern int optimizer_time_limit;
 extern bool optimizer_disable_xform_result_printing;
 extern bool	optimizer_print_memo_after_exploration;
 extern bool	optimizer_print_memo_after_implementation;
@@ -478,6 +484,8 @@ extern bool codegen;
 extern bool codegen_validate_functions;
 extern int codegen_varlen_tolerance;
 extern int codegen_optimization_level;
+extern int codegen_cache_size;
+extern char *codegen_cache_directory;
 
 /**
  * Enable logging of DPE match in optimizer.
@@ -0,0 +1,32 @@
+/*-------------------------------------------------------------------------
+ *
+ * mdsharedcache.h
+ *	  Cross-backend cache of serialized optimizer metadata objects.
+ *
+ * See mdsharedcache.c for comments.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef MDSHAREDCACHE_H
+#define MDSHAREDCACHE_H
+
+#include "storage/sinval.h"
+
+/* Longest metadata id string that can be used as a key, including the NUL */
+#define MDSHAREDCACHE_KEYSIZE		128
+
+extern Size MDSharedCacheShmemSize(void);
+extern void MDSharedCacheShmemInit(void);
+
+extern bool MDSharedCacheIsUsable(void);
+extern uint64 MDSharedCacheGeneration(void);
+extern void *MDSharedCacheLookup(const char *mdid, Size *len);
+extern bool MDSharedCacheInsert(const char *mdid, Oid relid, bool partitioned,
+								const void *data, Size len, uint64 generation);
+
+extern void MDSharedCacheNoteInvalidation(SharedInvalidationMessage *msg);
+extern void MDSharedCacheAtCommit(void);
+
+#endif   /* MDSHAREDCACHE_H */
@@ -0,0 +1,19 @@
+/*-------------------------------------------------------------------------
+ *
+ * optcalibrate.h
+ *	  Calibration of the Pivotal Query Optimizer's cost model.
+ *
+ * See optcalibrate.c for comments.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef OPTCALIBRATE_H
+#define OPTCALIBRATE_H
+
+#include "nodes/pg_list.h"
+
+extern List *GetOptimizerCostParams(void);
+
+#endif   /* OPTCALIBRATE_H */
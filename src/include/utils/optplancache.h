@@ -0,0 +1,24 @@
+/*-------------------------------------------------------------------------
+ *
+ * optplancache.h
+ *	  Cache of plans produced by the Pivotal Query Optimizer.
+ *
+ * See optplancache.c for comments.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef OPTPLANCACHE_H
+#define OPTPLANCACHE_H
+
+#include "nodes/parsenodes.h"
+#include "nodes/plannodes.h"
+
+extern PlannedStmt *OptPlanCacheLookup(const char *fingerprint);
+extern void OptPlanCacheInsert(const char *fingerprint, Query *query,
+							   PlannedStmt *plan);
+extern void OptPlanCacheInvalidate(List *relids);
+extern void OptPlanCacheReset(void);
+
+#endif   /* OPTPLANCACHE_H */
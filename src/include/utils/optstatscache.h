@@ -0,0 +1,24 @@
+/*-------------------------------------------------------------------------
+ *
+ * optstatscache.h
+ *	  Cache of column statistics translated for the Pivotal Query Optimizer.
+ *
+ * See optstatscache.c for comments.
+ *
+ * Copyright (c) 2016, Pivotal Software Inc.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef OPTSTATSCACHE_H
+#define OPTSTATSCACHE_H
+
+#include "access/htup.h"
+
+extern void *OptStatsCacheLookup(Oid relid, AttrNumber attnum,
+								 HeapTuple statstup, float4 reltuples,
+								 Size *len);
+extern void OptStatsCacheInsert(Oid relid, AttrNumber attnum,
+								HeapTuple statstup, float4 reltuples,
+								const void *data, Size len);
+
+#endif   /* OPTSTATSCACHE_H */
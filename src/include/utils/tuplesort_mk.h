@@ -250,6 +250,11 @@ typedef struct MKContext {
      */
     MKCopyFree  cpfr;
 
+    /* Compares the prepared, non-null datums of one level; tupsort_compare_datum
+     * unless a generated comparator for the sort keys has been installed.
+     */
+    MKCompare   compare;
+
     /**
      * MUST be set
      *
@@ -308,6 +313,7 @@ static inline void mk_prepare_array(MKEntry *a, int i, int j, int32 lv, struct M
 
 extern void tupsort_cpfr(MKEntry *dst, MKEntry *src, MKLvContext *ctxt);
 extern int tupsort_compare_datum(MKEntry *v1, MKEntry *v2, MKLvContext *ctxt, MKContext *mkContext);
+extern void tuplesort_set_compare_mk(struct Tuplesortstate_mk *state, MKCompare compare);
 
 extern void create_mksort_context(
         MKContext *mkctxt,
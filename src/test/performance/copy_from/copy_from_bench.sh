@@ -0,0 +1,61 @@
+#!/bin/sh
+#
+# Benchmark of COPY FROM text and CSV into tables of integer and of mixed
+# columns, with the generated attribute conversion (the developer GUC
+# codegen_copy_input_attributes) on and off.
+#
+# Runs against the database named by PGDATABASE, creating and dropping the
+# tables it uses. The data files are written to the current directory and
+# loaded through psql's \copy, so the rows are parsed by the segments. The
+# script reports the rows per second of each run.
+#
+
+PSQL="psql -X -q -v ON_ERROR_STOP=1"
+RUNS=${RUNS:-3}
+ROWS=${ROWS:-2000000}
+
+setup()
+{
+	echo "DROP TABLE IF EXISTS copy_int;"
+	echo "CREATE TABLE copy_int (a int, b int, c bigint, d smallint,"
+	echo "  e int, f bigint, g int, h int) DISTRIBUTED BY (a);"
+	echo "DROP TABLE IF EXISTS copy_mixed;"
+	echo "CREATE TABLE copy_mixed (a int, b bigint, c float8, d date,"
+	echo "  e text, f numeric) DISTRIBUTED BY (a);"
+
+	echo "\\copy (SELECT i, i % 1000, i * 7, i % 100, -i, i * 13, i % 7, i % 11 FROM generate_series(1, $ROWS) i) TO 'copy_int.data'"
+	echo "\\copy (SELECT i, i * 7, i / 3.0, date '2000-01-01' + i % 1000, 'row ' || i, i / 7.0 FROM generate_series(1, $ROWS) i) TO 'copy_mixed.data' CSV"
+}
+
+teardown()
+{
+	echo "DROP TABLE copy_int;"
+	echo "DROP TABLE copy_mixed;"
+}
+
+bench()
+{
+	for gen in off on; do
+		r=0
+		while [ $r -lt $RUNS ]; do
+			(
+				echo "SET codegen = on;"
+				echo "SET codegen_copy_input_attributes = $gen;"
+				echo "TRUNCATE $2;"
+				echo "\\timing"
+				echo "\\copy $2 FROM '$2.data' $3"
+			) | $PSQL | grep '^Time:' |
+			awk -v name="$1" -v gen=$gen -v rows=$ROWS \
+				'{ printf "%s, codegen_copy_input_attributes=%s: %.0f rows/s\n", name, gen, rows * 1000 / $2 }'
+			r=`expr $r + 1`
+		done
+	done
+}
+
+setup | $PSQL || exit 1
+
+bench "8 integer columns, text" copy_int ""
+bench "mixed columns, CSV" copy_mixed "CSV"
+
+teardown | $PSQL
+rm -f copy_int.data copy_mixed.data
@@ -0,0 +1,112 @@
+#!/bin/sh
+#
+# Benchmark of the translation of Pivotal Query Optimizer plans into
+# PlannedStmts for partitioned tables with 1000 and 10000 partitions, and
+# for an append over 1000 tables.
+#
+# Runs against the database named by PGDATABASE, creating and dropping the
+# tables it uses. With optimizer_print_optimization_stats on, the optimizer
+# writes its timings to the master's log; for every query the script
+# reports the average elapsed time of the EXPLAIN and the average "DXL To
+# PlStmt Translation Time" found in the log under MASTER_DATA_DIRECTORY.
+#
+# To compare two builds, run the script against each of them, saving the
+# output, and pass both files to dxl_translate_compare.sh:
+#
+#   ./dxl_translate_bench.sh > before.log    (on the old build)
+#   ./dxl_translate_bench.sh > after.log     (on the new build)
+#   ./dxl_translate_compare.sh before.log after.log
+#
+
+PSQL="psql -X -q -v ON_ERROR_STOP=1"
+RUNS=${RUNS:-5}
+
+setup()
+{
+	for nparts in 1000 10000; do
+		echo "DROP TABLE IF EXISTS dxl_part_$nparts;"
+		echo "CREATE TABLE dxl_part_$nparts (k int, a int, b text)"
+		echo "DISTRIBUTED BY (a)"
+		echo "PARTITION BY RANGE (k) (START (0) END ($nparts) EVERY (1));"
+	done
+
+	echo "DROP VIEW IF EXISTS dxl_union;"
+	i=0
+	while [ $i -lt 1000 ]; do
+		echo "DROP TABLE IF EXISTS dxl_union_$i;"
+		echo "CREATE TABLE dxl_union_$i (k int, a int, b text) DISTRIBUTED BY (a);"
+		i=`expr $i + 1`
+	done
+
+	echo "CREATE VIEW dxl_union AS"
+	i=0
+	while [ $i -lt 999 ]; do
+		echo "SELECT * FROM dxl_union_$i UNION ALL"
+		i=`expr $i + 1`
+	done
+	echo "SELECT * FROM dxl_union_999;"
+}
+
+teardown()
+{
+	echo "DROP VIEW dxl_union;"
+	echo "DROP TABLE dxl_part_1000;"
+	echo "DROP TABLE dxl_part_10000;"
+	i=0
+	while [ $i -lt 1000 ]; do
+		echo "DROP TABLE dxl_union_$i;"
+		i=`expr $i + 1`
+	done
+}
+
+LOGDIR=${MASTER_DATA_DIRECTORY:?MASTER_DATA_DIRECTORY is not set}/pg_log
+
+# the log the master is currently writing to
+current_log()
+{
+	ls -t $LOGDIR/*.csv | head -1
+}
+
+bench()
+{
+	log=`current_log`
+	skip=`wc -l < $log`
+
+	elapsed=$(
+		(
+			echo "SET optimizer = on;"
+			echo "SET optimizer_print_optimization_stats = on;"
+			echo "\\timing"
+			r=0
+			while [ $r -lt $RUNS ]; do
+				echo "EXPLAIN $2;"
+				r=`expr $r + 1`
+			done
+		) | $PSQL | awk '/^Time:/ { sum += $2; n++ } END { if (n) printf "%.3f", sum / n }'
+	)
+
+	translation=$(
+		tail -n +`expr $skip + 1` $log |
+		sed -n 's/.*DXL To PlStmt Translation Time[^0-9]*\([0-9][0-9.]*\).*/\1/p' |
+		awk '{ sum += $1; n++ } END { if (n) printf "%.3f", sum / n }'
+	)
+
+	echo "$1|${elapsed:-n/a}|${translation:-n/a}"
+}
+
+setup | $PSQL || exit 1
+
+echo "query|elapsed ms|translation ms"
+
+bench "1000 partitions, full scan" \
+	"SELECT * FROM dxl_part_1000"
+bench "10000 partitions, full scan" \
+	"SELECT * FROM dxl_part_10000"
+bench "10000 partitions, static elimination" \
+	"SELECT * FROM dxl_part_10000 WHERE k < 5000"
+bench "10000 partitions, join on partition key" \
+	"SELECT * FROM dxl_part_10000 p, dxl_part_1000 q WHERE p.k = q.a"
+bench "append over 1000 tables" \
+	"SELECT * FROM dxl_union WHERE a = 1"
+
+teardown | $PSQL > /dev/null
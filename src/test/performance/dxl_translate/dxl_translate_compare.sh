@@ -0,0 +1,21 @@
+#!/bin/sh
+#
+# Puts side by side the output of two runs of dxl_translate_bench.sh,
+# usually one before and one after a change to the translator, with the
+# ratio of the translation times.
+#
+# Usage: dxl_translate_compare.sh before.log after.log
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 before.log after.log" >&2
+	exit 1
+fi
+
+awk -F'|' '
+NR == FNR { before[$1] = $3; next }
+FNR == 1 { printf "%-45s %15s %15s %8s\n", "query", "before ms", "after ms", "ratio"; next }
+($1 in before) {
+	ratio = (before[$1] + 0 > 0 && $3 + 0 > 0) ? sprintf("%.2f", $3 / before[$1]) : "n/a"
+	printf "%-45s %15s %15s %8s\n", $1, before[$1], $3, ratio
+}' "$1" "$2"
@@ -0,0 +1,255 @@
+/*-------------------------------------------------------------------------
+ *
+ * hashjoin_probe_bench.c
+ *	  Standalone micro-benchmark for hash join probing with and without
+ *	  batched bucket prefetching (gp_hashjoin_probe_batch_size).
+ *
+ * The inner side is laid out like nodeHash.c does it: a power-of-2 array of
+ * bucket heads, each pointing to a chain of separately allocated tuples that
+ * start with a HashJoinTupleData-style header (next pointer, hash value).
+ * The outer side is a stream of random keys, roughly half of which match.
+ *
+ * The "single" mode probes one outer key at a time: hash it, load the
+ * bucket head, walk the chain.  The "batched" mode does what
+ * ExecHashJoinFillProbeBatch() does: hash a vector of keys, prefetch the
+ * bucket array slots, then prefetch the chain heads, and only then walk
+ * the chains one by one.
+ *
+ * Usage: hashjoin_probe_bench [inner_rows [outer_rows [batch_size]]]
+ *
+ * Portions Copyright (c) 2017, Pivotal Software Inc
+ *
+ *-------------------------------------------------------------------------
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__GNUC__)
+#define PREFETCH(addr)	__builtin_prefetch(addr)
+#else
+#define PREFETCH(addr)	((void) 0)
+#endif
+
+#define TUPLE_PAYLOAD	40		/* bytes of fake MemTuple data per tuple */
+
+typedef struct BenchTuple
+{
+	struct BenchTuple *next;	/* link to next tuple in same bucket */
+	uint32_t	hashvalue;		/* tuple's hash code */
+	int64_t		key;			/* join key */
+	char		payload[TUPLE_PAYLOAD];
+} BenchTuple;
+
+typedef struct BenchTable
+{
+	uint32_t	nbuckets;
+	BenchTuple **buckets;
+} BenchTable;
+
+/* murmur3 finalizer: cheap, and randomizes all output bits */
+static inline uint32_t
+hash_key(int64_t key)
+{
+	uint64_t	h = (uint64_t) key;
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return (uint32_t) h;
+}
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static inline uint64_t
+next_random(void)
+{
+	/* xorshift64* */
+	rng_state ^= rng_state >> 12;
+	rng_state ^= rng_state << 25;
+	rng_state ^= rng_state >> 27;
+	return rng_state * 2685821657736338717ULL;
+}
+
+static double
+now_seconds(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Build the inner hash table.  Tuples are allocated in one arena but linked
+ * in random order, so that walking a chain touches unrelated cache lines,
+ * as it does after the palloc churn of a real build.
+ */
+static BenchTable *
+build_table(long ninner, BenchTuple **arena_out)
+{
+	BenchTable *table = malloc(sizeof(BenchTable));
+	BenchTuple *arena = malloc(ninner * sizeof(BenchTuple));
+	long	   *order = malloc(ninner * sizeof(long));
+	long		i;
+	uint32_t	nbuckets = 1024;
+
+	/* about one tuple per bucket, like gp_hashjoin_tuples_per_bucket=1..5 */
+	while (nbuckets < (uint32_t) ninner)
+		nbuckets <<= 1;
+
+	table->nbuckets = nbuckets;
+	table->buckets = calloc(nbuckets, sizeof(BenchTuple *));
+
+	for (i = 0; i < ninner; i++)
+		order[i] = i;
+	for (i = ninner - 1; i > 0; i--)
+	{
+		long		j = next_random() % (i + 1);
+		long		tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+
+	for (i = 0; i < ninner; i++)
+	{
+		BenchTuple *tup = &arena[order[i]];
+		uint32_t	bucketno;
+
+		/* inner keys are the even numbers */
+		tup->key = i * 2;
+		tup->hashvalue = hash_key(tup->key);
+		memset(tup->payload, 0, TUPLE_PAYLOAD);
+
+		bucketno = tup->hashvalue & (nbuckets - 1);
+		tup->next = table->buckets[bucketno];
+		table->buckets[bucketno] = tup;
+	}
+
+	free(order);
+	*arena_out = arena;
+	return table;
+}
+
+static inline long
+probe_one(BenchTable *table, int64_t key, uint32_t hashvalue)
+{
+	BenchTuple *tup = table->buckets[hashvalue & (table->nbuckets - 1)];
+	long		matches = 0;
+
+	for (; tup != NULL; tup = tup->next)
+	{
+		if (tup->hashvalue == hashvalue && tup->key == key)
+			matches++;
+	}
+	return matches;
+}
+
+static long
+probe_single(BenchTable *table, const int64_t *outer, long nouter)
+{
+	long		matches = 0;
+	long		i;
+
+	for (i = 0; i < nouter; i++)
+		matches += probe_one(table, outer[i], hash_key(outer[i]));
+
+	return matches;
+}
+
+static long
+probe_batched(BenchTable *table, const int64_t *outer, long nouter,
+			  int batch_size)
+{
+	uint32_t   *hashvalues = malloc(batch_size * sizeof(uint32_t));
+	uint32_t	mask = table->nbuckets - 1;
+	long		matches = 0;
+	long		start;
+
+	for (start = 0; start < nouter; start += batch_size)
+	{
+		int			n = (nouter - start < batch_size) ? nouter - start : batch_size;
+		int			i;
+
+		for (i = 0; i < n; i++)
+		{
+			hashvalues[i] = hash_key(outer[start + i]);
+			PREFETCH(&table->buckets[hashvalues[i] & mask]);
+		}
+
+		for (i = 0; i < n; i++)
+		{
+			BenchTuple *head = table->buckets[hashvalues[i] & mask];
+
+			if (head != NULL)
+				PREFETCH(head);
+		}
+
+		for (i = 0; i < n; i++)
+			matches += probe_one(table, outer[start + i], hashvalues[i]);
+	}
+
+	free(hashvalues);
+	return matches;
+}
+
+int
+main(int argc, char **argv)
+{
+	long		ninner = (argc > 1) ? atol(argv[1]) : 8 * 1024 * 1024;
+	long		nouter = (argc > 2) ? atol(argv[2]) : 32 * 1024 * 1024;
+	int			batch_size = (argc > 3) ? atoi(argv[3]) : 32;
+	BenchTuple *arena;
+	BenchTable *table;
+	int64_t    *outer;
+	long		i;
+	double		t0, t_single, t_batched;
+	long		m_single, m_batched;
+
+	if (ninner <= 0 || nouter <= 0 || batch_size <= 0)
+	{
+		fprintf(stderr, "usage: %s [inner_rows [outer_rows [batch_size]]]\n", argv[0]);
+		return 1;
+	}
+
+	table = build_table(ninner, &arena);
+
+	outer = malloc(nouter * sizeof(int64_t));
+	for (i = 0; i < nouter; i++)
+		outer[i] = next_random() % (ninner * 2);
+
+	/* warm up both code paths once on a prefix */
+	probe_single(table, outer, nouter < 100000 ? nouter : 100000);
+	probe_batched(table, outer, nouter < 100000 ? nouter : 100000, batch_size);
+
+	t0 = now_seconds();
+	m_single = probe_single(table, outer, nouter);
+	t_single = now_seconds() - t0;
+
+	t0 = now_seconds();
+	m_batched = probe_batched(table, outer, nouter, batch_size);
+	t_batched = now_seconds() - t0;
+
+	if (m_single != m_batched)
+	{
+		fprintf(stderr, "match count mismatch: %ld vs %ld\n", m_single, m_batched);
+		return 1;
+	}
+
+	printf("inner rows %ld (%.1f MB), outer rows %ld, batch size %d, matches %ld\n",
+		   ninner, (ninner * sizeof(BenchTuple) + table->nbuckets * sizeof(void *)) / 1048576.0,
+		   nouter, batch_size, m_single);
+	printf("single:  %10.0f probes/s\n", nouter / t_single);
+	printf("batched: %10.0f probes/s (%.2fx)\n", nouter / t_batched, t_single / t_batched);
+
+	free(outer);
+	free(arena);
+	free(table->buckets);
+	free(table);
+	return 0;
+}
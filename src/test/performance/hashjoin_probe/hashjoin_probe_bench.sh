@@ -0,0 +1,57 @@
+#!/bin/sh
+#
+# Benchmark of hash join probing through the executor, one outer tuple at a
+# time (gp_hashjoin_probe_batch_size = 0) and in vectors of read-ahead tuples.
+#
+# Runs against the database named by PGDATABASE, creating and dropping the
+# tables it uses. The inner table is sized so that its hash table is much
+# larger than the CPU caches, but fits in statement_mem, so the join does not
+# spill. The script reports the outer tuples probed per second of each run.
+#
+
+PSQL="psql -X -q -v ON_ERROR_STOP=1"
+RUNS=${RUNS:-3}
+INNER_ROWS=${INNER_ROWS:-4000000}
+OUTER_ROWS=${OUTER_ROWS:-20000000}
+BATCH_SIZES=${BATCH_SIZES:-"0 16 64 256"}
+STATEMENT_MEM=${STATEMENT_MEM:-2GB}
+
+setup()
+{
+	echo "DROP TABLE IF EXISTS hj_probe_inner;"
+	echo "DROP TABLE IF EXISTS hj_probe_outer;"
+	echo "CREATE TABLE hj_probe_inner (k int, v int) DISTRIBUTED BY (k);"
+	echo "CREATE TABLE hj_probe_outer (k int, v int) DISTRIBUTED BY (k);"
+	echo "INSERT INTO hj_probe_inner SELECT i, i FROM generate_series(1, $INNER_ROWS) i;"
+	echo "INSERT INTO hj_probe_outer SELECT (i * 7919) % $INNER_ROWS, i FROM generate_series(1, $OUTER_ROWS) i;"
+	echo "ANALYZE hj_probe_inner;"
+	echo "ANALYZE hj_probe_outer;"
+}
+
+teardown()
+{
+	echo "DROP TABLE hj_probe_inner;"
+	echo "DROP TABLE hj_probe_outer;"
+}
+
+setup | $PSQL || exit 1
+
+for size in $BATCH_SIZES; do
+	r=0
+	while [ $r -lt $RUNS ]; do
+		(
+			echo "SET optimizer = off;"
+			echo "SET enable_mergejoin = off;"
+			echo "SET enable_nestloop = off;"
+			echo "SET statement_mem = '$STATEMENT_MEM';"
+			echo "SET gp_hashjoin_probe_batch_size = $size;"
+			echo "\\timing"
+			echo "SELECT count(*) FROM hj_probe_outer o JOIN hj_probe_inner i ON o.k = i.k;"
+		) | $PSQL | grep '^Time:' |
+		awk -v size=$size -v rows=$OUTER_ROWS \
+			'{ printf "gp_hashjoin_probe_batch_size=%d: %.0f probes/s\n", size, rows * 1000 / $2 }'
+		r=`expr $r + 1`
+	done
+done
+
+teardown | $PSQL
@@ -0,0 +1,23 @@
+--
+-- Helpers for tests that check what EXPLAIN or EXPLAIN ANALYZE reports.
+-- gpdiff reduces EXPLAIN output to the plan's node names, so tests that
+-- need to see anything else, like the details of a node or the slice and
+-- statement statistics, match patterns against the text returned here.
+--
+
+-- The EXPLAIN, or EXPLAIN ANALYZE, output of a query, one line per plan
+-- line. gpdiff takes a statement that mentions EXPLAIN before the query
+-- for an EXPLAIN, so the caller passes the query alone. The Settings line
+-- lists the session's non-default settings, so it's left out.
+create function plan_text(query text, with_analyze bool) returns text as $$
+declare
+  r record;
+  plan text := '';
+begin
+  for r in execute 'explain ' || case when with_analyze then 'analyze ' else '' end || query loop
+    if r."QUERY PLAN" not like '%Settings:%' then
+      plan := plan || r."QUERY PLAN" || E'\n';
+    end if;
+  end loop;
+  return plan;
+end $$ language plpgsql;
@@ -210,3 +210,35 @@ SELECT distinct C.z, count(distinct FS.x), count(distinct FS.y) FROM (SELECT i A
 
 
 drop table foo_mdqa;
+
+-- DISTINCT aggregates whose distinct sets outgrow their share of the
+-- operator memory pass the rest of the group through a sort. The results
+-- must match the sort-only path.
+create table dqa_spill (g int, a int, b text) distributed by (g);
+insert into dqa_spill select i % 3, i % 50000, (i % 30000)::text from generate_series(1, 100000) i;
+set statement_mem = 2560;
+select g, count(distinct a), sum(distinct a), count(distinct b) from dqa_spill group by g order by g;
+select count(distinct a), sum(distinct a), count(distinct b) from dqa_spill;
+select count(*), sum(c) from (select g, a % 100, count(distinct b) as c from dqa_spill group by 1, 2) s;
+set gp_enable_agg_distinct_hash = off;
+select g, count(distinct a), sum(distinct a), count(distinct b) from dqa_spill group by g order by g;
+select count(distinct a), sum(distinct a), count(distinct b) from dqa_spill;
+select count(*), sum(c) from (select g, a % 100, count(distinct b) as c from dqa_spill group by 1, 2) s;
+reset gp_enable_agg_distinct_hash;
+reset statement_mem;
+drop table dqa_spill;
+
+-- When every DISTINCT aggregate can use a hash set, grouped DQAs on
+-- several arguments are computed by a single GroupAggregate over the input
+-- redistributed on the grouping key, not by a join of one coplan per
+-- argument.
+create table dqa_single (g int, a int, b int) distributed by (a);
+insert into dqa_single select i % 4, i % 10, i / 10 from generate_series(1, 100) i;
+analyze dqa_single;
+set gp_eager_agg_distinct_pruning = off;
+set optimizer = off;
+select g, count(distinct a), count(distinct b) from dqa_single group by g order by g;
+explain select g, count(distinct a), count(distinct b) from dqa_single group by g;
+reset optimizer;
+reset gp_eager_agg_distinct_pruning;
+drop table dqa_single;
@@ -1379,6 +1379,130 @@ reset client_min_messages;
 drop table foo;
 -- end_ignore
 
+-- Altering a trigger between two plans must not leave the trigger stale in
+-- the metadata cache. Enabled DML triggers make ORCA fall back to the planner.
+create table orca.mdcache_trig (a int, b int) distributed by (a);
+create function orca.mdcache_trig_fn() returns trigger as $$
+begin
+  return new;
+end $$ language plpgsql;
+create trigger mdcache_trig_t before insert on orca.mdcache_trig
+  for each row execute procedure orca.mdcache_trig_fn();
+select plan_text('insert into orca.mdcache_trig values (1, 1)', false) like '%Optimizer status: PQO%' as planned_by_orca;
+alter table orca.mdcache_trig disable trigger mdcache_trig_t;
+select plan_text('insert into orca.mdcache_trig values (1, 1)', false) like '%Optimizer status: PQO%' as planned_by_orca;
+alter table orca.mdcache_trig enable trigger mdcache_trig_t;
+select plan_text('insert into orca.mdcache_trig values (1, 1)', false) like '%Optimizer status: PQO%' as planned_by_orca;
+drop table orca.mdcache_trig;
+drop function orca.mdcache_trig_fn();
+
+-- The plan cache must not return a plan translated under different settings
+-- of the GUCs that are only read when translating the plan.
+create table orca.plancache_dd (a int, b int) distributed by (a);
+select plan_text('select * from orca.plancache_dd where a = 1', false) like '%Gather Motion 1:1%' as direct_dispatch;
+set optimizer_direct_dispatch = off;
+select plan_text('select * from orca.plancache_dd where a = 1', false) like '%Gather Motion 1:1%' as direct_dispatch;
+reset optimizer_direct_dispatch;
+select plan_text('select * from orca.plancache_dd where a = 1', false) like '%Gather Motion 1:1%' as direct_dispatch;
+drop table orca.plancache_dd;
+
+-- Creating a table between two queries must keep the metadata and the
+-- cached plans of the other relations, while a change to a function they use
+-- must not. Planning a query on a relation without statistics raises a
+-- NOTICE, which a plan taken from the plan cache doesn't.
+create table orca.mdcache_keep (a int, b int) distributed by (a);
+insert into orca.mdcache_keep select i, i % 5 from generate_series(1, 20) i;
+analyze orca.mdcache_keep;
+set allow_system_table_mods = dml;
+delete from pg_statistic where starelid = 'orca.mdcache_keep'::regclass;
+reset allow_system_table_mods;
+create function orca.mdcache_keep_fn(int) returns bool as $$
+begin
+  return $1 >= 0;
+end $$ language plpgsql immutable;
+set optimizer_plan_cache_size = 100;
+select count(*) from orca.mdcache_keep where a = 10 and orca.mdcache_keep_fn(b);
+select count(*) from orca.mdcache_keep where a = 10 and orca.mdcache_keep_fn(b);
+create temp table mdcache_keep_tmp (a int, b int) distributed by (a);
+select count(*) from orca.mdcache_keep where a = 10 and orca.mdcache_keep_fn(b);
+create or replace function orca.mdcache_keep_fn(int) returns bool as $$
+begin
+  return $1 >= 0;
+end $$ language plpgsql immutable;
+select count(*) from orca.mdcache_keep where a = 10 and orca.mdcache_keep_fn(b);
+reset optimizer_plan_cache_size;
+drop table mdcache_keep_tmp;
+drop table orca.mdcache_keep;
+drop function orca.mdcache_keep_fn(int);
+
+-- Prefetching the statistics of the columns used in the quals, the join
+-- conditions and the grouping of a query must not change its plan or its
+-- results, including for columns reached through views, sublinks and CTEs.
+create table orca.prefetch_fact (a int, b int, c text) distributed by (a);
+create table orca.prefetch_dim (a int, d int) distributed by (a);
+insert into orca.prefetch_fact select i, i % 10, 'x' || i from generate_series(1, 1000) i;
+insert into orca.prefetch_dim select i, i % 3 from generate_series(1, 100) i;
+analyze orca.prefetch_fact;
+analyze orca.prefetch_dim;
+create view orca.prefetch_v as select a, b + 1 as b1, c from orca.prefetch_fact;
+set optimizer_plan_cache_size = 0;
+-- set_config() switches the prefetch as the arguments of each plan_text()
+-- call are evaluated
+select plan_text(q || substr(set_config('optimizer_prefetch_metadata', 'on', false), 1, 0), false) =
+       plan_text(q || substr(set_config('optimizer_prefetch_metadata', 'off', false), 1, 0), false) as same_plan
+  from (values
+  ('select v.b1, count(*) from orca.prefetch_v v join orca.prefetch_dim d using (a) where d.d = 1 group by v.b1 having count(*) > 3'),
+  ('select count(distinct c) from orca.prefetch_fact f where f.b in (select d from orca.prefetch_dim where a < 10)'),
+  ('with w as (select b, count(*) as n from orca.prefetch_fact group by b) select d.d, w.n from orca.prefetch_dim d join w on w.b = d.d where d.a <= 3')
+  ) as t(q);
+set optimizer_prefetch_metadata = off;
+select v.b1, count(*) from orca.prefetch_v v join orca.prefetch_dim d using (a) where d.d = 1 group by v.b1 having count(*) > 3 order by 1;
+set optimizer_prefetch_metadata = on;
+select v.b1, count(*) from orca.prefetch_v v join orca.prefetch_dim d using (a) where d.d = 1 group by v.b1 having count(*) > 3 order by 1;
+select count(distinct c) from orca.prefetch_fact f where f.b in (select d from orca.prefetch_dim where a < 10);
+with w as (select b, count(*) as n from orca.prefetch_fact group by b) select d.d, w.n from orca.prefetch_dim d join w on w.b = d.d where d.a <= 3 order by 1;
+reset optimizer_prefetch_metadata;
+reset optimizer_plan_cache_size;
+drop view orca.prefetch_v;
+drop table orca.prefetch_fact;
+drop table orca.prefetch_dim;
+
+-- optimizer_time_limit bounds the search. A join of many tables is still
+-- planned by ORCA within the budget.
+create table orca.time_limit (a int) distributed by (a);
+insert into orca.time_limit select i from generate_series(1, 10) i;
+analyze orca.time_limit;
+set optimizer_time_limit = 1000;
+select count(*) from orca.time_limit t1 join orca.time_limit t2 using (a) join orca.time_limit t3 using (a) join orca.time_limit t4 using (a) join orca.time_limit t5 using (a) join orca.time_limit t6 using (a) join orca.time_limit t7 using (a) join orca.time_limit t8 using (a) join orca.time_limit t9 using (a) join orca.time_limit t10 using (a) join orca.time_limit t11 using (a) join orca.time_limit t12 using (a);
+select plan_text('select count(*) from orca.time_limit t1 join orca.time_limit t2 using (a) join orca.time_limit t3 using (a) join orca.time_limit t4 using (a) join orca.time_limit t5 using (a) join orca.time_limit t6 using (a) join orca.time_limit t7 using (a) join orca.time_limit t8 using (a) join orca.time_limit t9 using (a) join orca.time_limit t10 using (a) join orca.time_limit t11 using (a) join orca.time_limit t12 using (a)', false) like '%Optimizer status: PQO%' as planned_by_orca;
+reset optimizer_time_limit;
+-- Stages past the budget are dropped. In this search strategy the first
+-- stage can't implement a scan, so only the second stage finds a plan.
+copy (select line from (values
+  (1, '<?xml version="1.0" encoding="UTF-8"?>'),
+  (2, '<dxl:DXLMessage xmlns:dxl="http://greenplum.com/dxl/2010/12/">'),
+  (3, '<dxl:SearchStrategy>'),
+  (4, '<dxl:SearchStage TimeThreshold="60000" CostThreshold="0">'),
+  (5, '<dxl:Xform Name="CXformExpandNAryJoin"/>'),
+  (6, '</dxl:SearchStage>'),
+  (7, '<dxl:SearchStage TimeThreshold="60000" CostThreshold="0">'),
+  (8, '<dxl:Xform Name="CXformGet2TableScan"/>'),
+  (9, '</dxl:SearchStage>'),
+  (10, '</dxl:SearchStrategy>'),
+  (11, '</dxl:DXLMessage>')) as s(n, line) order by n) to '/tmp/orca_time_limit_strategy.xml';
+set optimizer_search_strategy_path = '/tmp/orca_time_limit_strategy.xml';
+select plan_text('select * from orca.time_limit', false) like '%Optimizer status: PQO%' as planned_by_orca;
+-- the second stage gets the 30 s left
+set optimizer_time_limit = 90000;
+select plan_text('select * from orca.time_limit', false) like '%Optimizer status: PQO%' as planned_by_orca;
+-- the first stage uses up the budget, so the second one is dropped and the
+-- query falls back to the planner
+set optimizer_time_limit = 60000;
+select plan_text('select * from orca.time_limit', false) like '%Optimizer status: PQO%' as planned_by_orca;
+reset optimizer_time_limit;
+reset optimizer_search_strategy_path;
+drop table orca.time_limit;
+
 -- clean up
 drop schema orca cascade;
 reset optimizer_segments;
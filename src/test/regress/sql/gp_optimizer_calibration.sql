@@ -0,0 +1,69 @@
+--
+-- gp_calibrate_optimizer_cost_model() measures the optimizer's cost units on
+-- this cluster and stores them in gp_optimizer_cost_params.
+--
+select gp_calibrate_optimizer_cost_model(1000);
+
+-- The measurements depend on the machine; only check that what is stored is
+-- within bounds.
+set client_min_messages = error;
+select gp_calibrate_optimizer_cost_model(100000) between 0 and 5 as calibrated;
+reset client_min_messages;
+select count(*) = count(distinct paramname) as unique_names,
+       coalesce(bool_and(paramvalue between 0.001 and 1000), true) as in_bounds
+  from gp_optimizer_cost_params;
+
+-- Plan with the calibrated cost model
+set optimizer_cost_calibration = on;
+select count(*) from generate_series(1, 10) i join generate_series(1, 10) j on i = j;
+reset optimizer_cost_calibration;
+
+-- Only superusers may calibrate
+create role gp_calibrate_user;
+set session authorization gp_calibrate_user;
+select gp_calibrate_optimizer_cost_model(100000);
+reset session authorization;
+drop role gp_calibrate_user;
+
+-- A calibration must drop the cached plans costed with the old parameters.
+-- Start from known parameters, in a new session that reads them.
+set optimizer_cost_calibration = off;
+set allow_system_table_mods = dml;
+delete from gp_optimizer_cost_params;
+insert into gp_optimizer_cost_params values ('RedistributeSendCostUnit', 1000), ('RedistributeRecvCostUnit', 1000);
+reset allow_system_table_mods;
+\c -
+create table calibration_plan_r (a int, b int) distributed by (a);
+create table calibration_plan_s (a int, b int) distributed by (a);
+insert into calibration_plan_r select i, i % 100 from generate_series(1, 10000) i;
+insert into calibration_plan_s select i, i % 100 from generate_series(1, 10000) i;
+analyze calibration_plan_r;
+analyze calibration_plan_s;
+set optimizer_plan_cache_size = 100;
+select plan_text('select count(*) from calibration_plan_r r join calibration_plan_s s on r.b = s.b', false) <> '' as planned;
+set client_min_messages = error;
+select gp_calibrate_optimizer_cost_model(100000) between 0 and 5 as calibrated;
+reset client_min_messages;
+
+-- Write other known parameters, without the invalidation that calibrating
+-- sends; with the calibration off, they aren't read while they are written.
+-- The plan cache must not return the plan it had before calibrating.
+set optimizer_cost_calibration = off;
+set allow_system_table_mods = dml;
+delete from gp_optimizer_cost_params;
+insert into gp_optimizer_cost_params values ('RedistributeSendCostUnit', 0.001), ('RedistributeRecvCostUnit', 0.001);
+reset allow_system_table_mods;
+reset optimizer_cost_calibration;
+select plan_text(q || substr(set_config('optimizer_plan_cache_size', '100', false), 1, 0), false) =
+       plan_text(q || substr(set_config('optimizer_plan_cache_size', '0', false), 1, 0), false) as same_plan
+  from (values ('select count(*) from calibration_plan_r r join calibration_plan_s s on r.b = s.b')) as t(q);
+reset optimizer_plan_cache_size;
+
+-- Leave the default cost model to the tests that follow
+set optimizer_cost_calibration = off;
+set allow_system_table_mods = dml;
+delete from gp_optimizer_cost_params;
+reset allow_system_table_mods;
+reset optimizer_cost_calibration;
+drop table calibration_plan_r;
+drop table calibration_plan_s;
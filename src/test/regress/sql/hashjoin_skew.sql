@@ -0,0 +1,52 @@
+--
+-- Hash joins that spill with a skewed join key: the inner tuples of the
+-- outer side's most common values are kept in skew buckets, and a batch
+-- whose single hash value exceeds work_mem is not split over and over.
+--
+-- The planner ships the MCVs in the Hash node, so use it.
+set optimizer = off;
+set enable_mergejoin = off;
+set enable_nestloop = off;
+set statement_mem = '2560kB';
+
+-- Half of the outer rows have one of 5 values, 10% each
+create table hashjoin_skew_probe (k int, pad text) distributed by (k);
+create table hashjoin_skew_build (k int, pad text) distributed by (k);
+insert into hashjoin_skew_probe
+  select case when i % 2 = 0 then i % 10 else i end, repeat('x', 40)
+  from generate_series(1, 200000) i;
+insert into hashjoin_skew_build
+  select i, repeat('x', 40) from generate_series(1, 100000) i;
+analyze hashjoin_skew_probe;
+analyze hashjoin_skew_build;
+
+select plan_text('select count(*) from hashjoin_skew_probe p join hashjoin_skew_build b on p.k = b.k', true)
+  like '%Skew optimization used%' as skew_optimization_used;
+
+-- 80000 rows with k in (2, 4, 6, 8), and the 50000 odd k up to 100000
+select count(*) from hashjoin_skew_probe p join hashjoin_skew_build b on p.k = b.k;
+
+-- 60000 inner rows share k = 1, more than work_mem by themselves
+truncate hashjoin_skew_build;
+insert into hashjoin_skew_build
+  select case when i <= 60000 then 1 else i - 59999 end, repeat('x', 40)
+  from generate_series(1, 100000) i;
+truncate hashjoin_skew_probe;
+insert into hashjoin_skew_probe
+  select i, repeat('x', 40) from generate_series(1, 200000) i;
+analyze hashjoin_skew_probe;
+analyze hashjoin_skew_build;
+
+select plan_text('select count(*) from hashjoin_skew_probe p join hashjoin_skew_build b on p.k = b.k', true)
+  like '%could not be split further%' as batch_not_split;
+
+-- The 60000 rows of k = 1, and one for each k from 2 to 40001
+select count(*) from hashjoin_skew_probe p join hashjoin_skew_build b on p.k = b.k;
+
+reset statement_mem;
+reset enable_nestloop;
+reset enable_mergejoin;
+reset optimizer;
+
+drop table hashjoin_skew_probe;
+drop table hashjoin_skew_build;
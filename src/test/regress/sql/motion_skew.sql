@@ -0,0 +1,24 @@
+--
+-- EXPLAIN ANALYZE reports Redistribute Motions that send most of their rows
+-- to one segment.
+--
+create table motion_skew_src (a int, b int) distributed by (a);
+create table motion_skew_dst (a int, b int) distributed by (b);
+insert into motion_skew_src
+  select i, case when i % 10 = 0 then i else 1 end from generate_series(1, 10000) i;
+
+-- 90% of the rows have b = 1. The threshold is low enough for any number of
+-- segments.
+set gp_motion_skew_threshold = 1.5;
+select plan_text('insert into motion_skew_dst select * from motion_skew_src', true) like '%Skew: max/avg%' as skew_reported;
+
+-- Redistributing on a + 1 spreads the rows evenly
+select plan_text('insert into motion_skew_dst select a, a + 1 from motion_skew_src', true) like '%Skew: max/avg%' as skew_reported;
+
+-- 0 disables the report
+set gp_motion_skew_threshold = 0;
+select plan_text('insert into motion_skew_dst select * from motion_skew_src', true) like '%Skew: max/avg%' as skew_reported;
+reset gp_motion_skew_threshold;
+
+drop table motion_skew_src;
+drop table motion_skew_dst;
@@ -1631,3 +1631,15 @@ FROM
   GROUP BY name,device_model
   HAVING COUNT(DISTINCT CASE WHEN ppp > 0 THEN device_id ELSE NULL END)>0
 ) b;
+
+-- Nested partitionings (a) and (a, b); olap_window_seq checks the same
+-- results under the sequential strategy.
+create table window_nested (a int, b int, c int) distributed by (c);
+insert into window_nested select i % 8, i / 12, i from generate_series(1, 24) i;
+analyze window_nested;
+
+select a, b, c, rank() over (partition by a order by b) as r1,
+       rank() over (partition by a, b order by c) as r2
+from window_nested order by a, b, c;
+
+drop table window_nested;
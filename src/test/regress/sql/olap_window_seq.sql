@@ -1652,3 +1652,57 @@ select foo.a, sum(b) over (partition by bar.a order by bar.b) from foo, bar wher
 explain select foo.a, sum(b) over (partition by bar.a order by bar.b) from foo, bar where foo.a = bar.a;
 
 drop table foo, bar;
+
+-- min() and max() over sliding frames, which are computed incrementally
+create table minmax_frames (id int, k int, v int) distributed by (id);
+insert into minmax_frames values
+  (1, 1, 5), (2, 1, null), (3, 2, 3), (4, 2, 3), (5, 3, null),
+  (6, 3, null), (7, 4, 8), (8, 4, 1), (9, 6, 8), (10, 7, 2);
+
+-- ROWS frames that slide over NULLs and ties
+select id, v, min(v) over (order by id rows between 2 preceding and 1 following) as lo,
+       max(v) over (order by id rows between 2 preceding and 1 following) as hi
+from minmax_frames order by id;
+
+-- a frame of NULLs only has no min or max
+select id, v, min(v) over (order by id rows between current row and 1 following) as lo,
+       max(v) over (order by id rows between current row and 1 following) as hi
+from minmax_frames order by id;
+
+-- shrinking frames
+select id, v, min(v) over (order by id rows between current row and unbounded following) as lo,
+       max(v) over (order by id rows between current row and unbounded following) as hi
+from minmax_frames order by id;
+
+-- RANGE frames, where the peers of a row enter and leave the frame together
+select id, k, v, min(v) over (order by k range between 1 preceding and current row) as lo,
+       max(v) over (order by k range between 1 preceding and current row) as hi
+from minmax_frames order by id;
+
+select id, k, v, min(v) over (order by k range between current row and 1 following) as lo,
+       max(v) over (order by k range between current row and 1 following) as hi
+from minmax_frames order by id;
+
+select id, k, v, min(v) over (order by k range between current row and current row) as lo,
+       max(v) over (order by k range between current row and current row) as hi
+from minmax_frames order by id;
+
+drop table minmax_frames;
+
+-- Nested partitionings share one redistribution on their common key, and
+-- the (a, b) stage goes first so its order also serves the (a) stage.
+create table window_nested (a int, b int, c int) distributed by (c);
+insert into window_nested select i % 8, i / 12, i from generate_series(1, 24) i;
+analyze window_nested;
+
+select a, b, c, rank() over (partition by a order by b) as r1,
+       rank() over (partition by a, b order by c) as r2
+from window_nested order by a, b, c;
+
+set optimizer = off;
+explain select a, b, c, rank() over (partition by a order by b) as r1,
+       rank() over (partition by a, b order by c) as r2
+from window_nested;
+reset optimizer;
+
+drop table window_nested;
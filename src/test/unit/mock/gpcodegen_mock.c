@@ -35,6 +35,21 @@ CodeGeneratorManagerPrepareGeneratedFunctions(void* manager)
 	return 1;
 }
 
+volatile bool CodegenAsyncCompileDone = false;
+
+// swaps in the functions compiled in the background
+void
+CodeGeneratorManagerInstallCompiledFunctions(void)
+{
+	elog(ERROR, "mock implementation of CodeGeneratorManager_InstallCompiledFunctions called");
+}
+
+// cancels the background compilations of an aborting transaction
+void
+CodeGeneratorManagerAbortAsyncCompile(int nestLevel)
+{
+}
+
 // notifies a manager that the underlying operator has a parameter change
 unsigned int
 CodeGeneratorManagerNotifyParameterChange(void* manager)
@@ -120,3 +135,79 @@ AdvanceAggregatesCodegenEnroll(AdvanceAggregatesFn regular_func_ptr,
 	return NULL;
 }
 
+
+// Enroll and returns the pointer to ExecHashGetHashValueGenerator
+void*
+ExecHashGetHashValueCodegenEnroll(ExecHashGetHashValueFn regular_func_ptr,
+		ExecHashGetHashValueFn* ptr_to_regular_func_ptr,
+		struct List *hashkeys,
+		struct List *hashoperators,
+		bool outer_tuple) {
+	*ptr_to_regular_func_ptr = regular_func_ptr;
+	elog(ERROR, "mock implementation of ExecHashGetHashValueCodegenEnroll called");
+	return NULL;
+}
+
+// Enroll and returns the pointer to CalcHashValueGenerator
+void*
+CalcHashValueCodegenEnroll(CalcHashValueFn regular_func_ptr,
+		CalcHashValueFn* ptr_to_regular_func_ptr,
+		struct AggState *aggstate) {
+	*ptr_to_regular_func_ptr = regular_func_ptr;
+	elog(ERROR, "mock implementation of CalcHashValueCodegenEnroll called");
+	return NULL;
+}
+
+// Enroll and returns the pointer to AggHashEntryMatchGenerator
+void*
+AggHashEntryMatchCodegenEnroll(AggHashEntryMatchFn regular_func_ptr,
+		AggHashEntryMatchFn* ptr_to_regular_func_ptr,
+		struct AggState *aggstate) {
+	*ptr_to_regular_func_ptr = regular_func_ptr;
+	elog(ERROR, "mock implementation of AggHashEntryMatchCodegenEnroll called");
+	return NULL;
+}
+
+// Enroll and returns the pointer to MemTupleDeformGenerator
+void*
+MemTupleDeformCodegenEnroll(MemTupleDeformFn regular_func_ptr,
+		MemTupleDeformFn* ptr_to_regular_func_ptr,
+		struct tupleDesc *tupdesc,
+		int natts) {
+	*ptr_to_regular_func_ptr = regular_func_ptr;
+	elog(ERROR, "mock implementation of MemTupleDeformCodegenEnroll called");
+	return NULL;
+}
+
+// Enroll and returns the pointer to MKCompareDatumGenerator
+void*
+MKCompareDatumCodegenEnroll(MKCompareDatumFn regular_func_ptr,
+		MKCompareDatumFn* ptr_to_regular_func_ptr,
+		int nkeys,
+		Oid *sortFunctions,
+		bool *reverse) {
+	*ptr_to_regular_func_ptr = regular_func_ptr;
+	elog(ERROR, "mock implementation of MKCompareDatumCodegenEnroll called");
+	return NULL;
+}
+
+// Enroll and returns the pointer to AggScanPipelineGenerator
+void*
+AggScanPipelineCodegenEnroll(AggScanPipelineFn regular_func_ptr,
+		AggScanPipelineFn* ptr_to_regular_func_ptr,
+		struct AggState *aggstate) {
+	*ptr_to_regular_func_ptr = regular_func_ptr;
+	elog(ERROR, "mock implementation of AggScanPipelineCodegenEnroll called");
+	return NULL;
+}
+
+// Enroll and returns the pointer to CopyInputAttributesGenerator
+void*
+CopyInputAttributesCodegenEnroll(CopyInputAttributesFn regular_func_ptr,
+		CopyInputAttributesFn* ptr_to_regular_func_ptr,
+		struct CopyStateData *cstate,
+		struct tupleDesc *tupdesc) {
+	*ptr_to_regular_func_ptr = regular_func_ptr;
+	elog(ERROR, "mock implementation of CopyInputAttributesCodegenEnroll called");
+	return NULL;
+}